@@ -0,0 +1,99 @@
+#ifndef _SPSC_RING_H_
+#define _SPSC_RING_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <atomic>
+
+// Lock-free byte ring for one producer thread and one consumer thread.
+// Head and tail run free and are masked on access: each side stores only
+// its own index, with release, after the bytes it moved, and loads the
+// other one with acquire before touching the buffer.
+template <size_t N>
+class SpscRing
+{
+    static_assert(N != 0 && (N & (N - 1)) == 0, "SpscRing size must be a power of two");
+
+  public:
+    // Producer side
+    size_t availableForStore() const {
+        return N - (_head.load(std::memory_order_relaxed) - _tail.load(std::memory_order_acquire));
+    }
+
+    size_t write(const uint8_t* data, size_t len) {
+        size_t head = _head.load(std::memory_order_relaxed);
+        size_t space = N - (head - _tail.load(std::memory_order_acquire));
+        if (len > space) {
+            len = space;
+        }
+        size_t pos = head & (N - 1);
+        size_t first = N - pos;
+        if (first > len) {
+            first = len;
+        }
+        memcpy(&_buffer[pos], data, first);
+        memcpy(_buffer, &data[first], len - first);
+        _head.store(head + len, std::memory_order_release);
+        return len;
+    }
+
+    // Consumer side
+    size_t available() const {
+        return _head.load(std::memory_order_acquire) - _tail.load(std::memory_order_relaxed);
+    }
+
+    size_t read(uint8_t* data, size_t len) {
+        size_t tail = _tail.load(std::memory_order_relaxed);
+        size_t count = _head.load(std::memory_order_acquire) - tail;
+        if (len > count) {
+            len = count;
+        }
+        size_t pos = tail & (N - 1);
+        size_t first = N - pos;
+        if (first > len) {
+            first = len;
+        }
+        memcpy(data, &_buffer[pos], first);
+        memcpy(&data[first], _buffer, len - first);
+        _tail.store(tail + len, std::memory_order_release);
+        return len;
+    }
+
+    int peek() const {
+        size_t tail = _tail.load(std::memory_order_relaxed);
+        if (_head.load(std::memory_order_acquire) == tail) {
+            return -1;
+        }
+        return _buffer[tail & (N - 1)];
+    }
+
+    // Contiguous readable bytes from *data, the producer leaves them alone
+    // until consume()
+    size_t peekSpan(const uint8_t** data) const {
+        size_t tail = _tail.load(std::memory_order_relaxed);
+        size_t count = _head.load(std::memory_order_acquire) - tail;
+        size_t pos = tail & (N - 1);
+        if (count > N - pos) {
+            count = N - pos;
+        }
+        *data = &_buffer[pos];
+        return count;
+    }
+
+    void consume(size_t len) {
+        size_t tail = _tail.load(std::memory_order_relaxed);
+        size_t count = _head.load(std::memory_order_acquire) - tail;
+        if (len > count) {
+            len = count;
+        }
+        _tail.store(tail + len, std::memory_order_release);
+    }
+
+  private:
+    uint8_t _buffer[N];
+    std::atomic<size_t> _head{0};
+    std::atomic<size_t> _tail{0};
+};
+
+#endif /* _SPSC_RING_H_ */
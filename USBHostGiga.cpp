@@ -48,56 +48,287 @@ void Mouse::begin() {
 extern "C" USBH_HandleTypeDef hUsbHostHS;
 
 HostSerial* _hostSerial = nullptr;
-static uint8_t buf[64];
+// The serial adapter may sit on the host port or behind a hub. Cleared by
+// the USB thread when it goes away.
+static std::atomic<USBH_HandleTypeDef*> _cdc{nullptr};
 
-extern "C" void USBH_CDC_ReceiveCallback(USBH_HandleTypeDef* phost) {    
-    _hostSerial->rx_cb(buf, sizeof(buf) + USBH_CDC_GetLastReceivedDataSize(phost));
-    //USBH_CDC_Receive(&hUsbHostHS, buf, sizeof(buf));
+#define HOST_SERIAL_TX_DONE 0x1
+#define HOST_SERIAL_RX_DATA 0x2
+
+// Only the adapter begin() picked; other CDC devices are not ours
+extern "C" void USBH_CDC_TransmitCallback(USBH_HandleTypeDef* phost) {
+    if (_hostSerial == nullptr || phost != _cdc) {
+        return;
+    }
+    _hostSerial->tx_cb();
 }
 
-void HostSerial::rx_cb(uint8_t* data, size_t len) {
-    _mut.lock();
-    for (int i = 0; i < len; i++) {
-        rxBuffer.store_char(data[i]);
+extern "C" void USBH_CDC_ReceiveCallback(USBH_HandleTypeDef* phost) {
+    if (_hostSerial == nullptr || phost != _cdc) {
+        return;
+    }
+    _hostSerial->rx_cb(USBH_CDC_GetLastReceivedDataSize(phost));
+}
+
+extern "C" void USBH_CDC_ProcessCallback(USBH_HandleTypeDef* phost) {
+    if (_hostSerial == nullptr || phost != _cdc) {
+        return;
+    }
+    _hostSerial->process_cb();
+}
+
+// The adapter itself, or the composite device it is a function of
+extern "C" void USBH_UserDisconnection(USBH_HandleTypeDef* phost) {
+    USBH_HandleTypeDef* cdc = _cdc;
+    if (_hostSerial != nullptr && cdc != nullptr && (cdc == phost || cdc->pDevice == phost)) {
+        _hostSerial->disconnect_cb();
+    }
+}
+
+// USB thread: arms the idle buffer unless a transfer is pending or the ring
+// could not take a whole receive. The device is then NAKed until the sketch
+// reads and wakes the USB thread.
+void HostSerial::rx_start() {
+    USBH_HandleTypeDef* cdc = _cdc;
+    if (cdc == nullptr || _rxArmed.load(std::memory_order_relaxed)) {
+        return;
+    }
+    if (HOST_SERIAL_RX_BUFFER_SIZE - _rxRing.available() >= _rxSize &&
+        USBH_CDC_Receive(cdc, _rxPacket[_rxIndex], _rxSize) == USBH_OK) {
+        _rxArmed.store(true, std::memory_order_release);
+    }
+}
+
+// USB thread: len bytes landed in the armed buffer. The other buffer is
+// armed before they are copied to the ring.
+void HostSerial::rx_cb(size_t len) {
+    uint8_t* data = _rxPacket[_rxIndex];
+    _rxIndex ^= 1;
+    bool armed = _rxRing.availableForStore() >= len + _rxSize &&
+                 USBH_CDC_Receive(_cdc, _rxPacket[_rxIndex], _rxSize) == USBH_OK;
+    _rxRing.write(data, len);
+    if (!armed) {
+        _rxArmed.store(false, std::memory_order_release);
+        rx_start();
     }
+    _events.set(HOST_SERIAL_RX_DATA);
+}
+
+// USB thread: the adapter is gone. What was queued is dropped and the
+// waiting calls return; begin() waits for the next adapter.
+void HostSerial::disconnect_cb() {
+    _mut.lock();
+    _cdc = nullptr;
+    _txHead = 0;
+    _txTail = 0;
+    _txCount = 0;
+    _txInFlight = 0;
     _mut.unlock();
+    _rxArmed.store(false, std::memory_order_release);
+    _events.set(HOST_SERIAL_TX_DONE | HOST_SERIAL_RX_DATA);
 }
 
-extern "C" ApplicationTypeDef Appli_state;
+// USB thread: starts what the sketch queued since the last pass
+void HostSerial::process_cb() {
+    rx_start();
+    _mut.lock();
+    tx_start();
+    _mut.unlock();
+}
+
+// Sketch thread: the stack is only driven by the USB thread, which is
+// woken up to run process_cb()
+void HostSerial::wake() {
+#if (USBH_USE_OS == 1U)
+    USBH_HandleTypeDef* cdc = _cdc;
+    if (cdc != nullptr) {
+        USBH_OS_PostEvent(cdc, USBH_CLASS_EVENT);
+    }
+#endif
+}
 
 void HostSerial::begin(unsigned long unused, uint16_t config) {
+    USBH_HandleTypeDef* cdc;
+
     MX_USB_HOST_Init();
-    while (Appli_state != APPLICATION_READY) {
+    while ((cdc = USBH_FindDevice(&hUsbHostHS, USB_CDC_CLASS, 0)) == nullptr) {
         delay(100);
     }
     _hostSerial = this;
 
+    // Whole packets, at least one
+    auto CDC_Handle = (CDC_HandleTypeDef*)cdc->pActiveClass->pData;
+    size_t packet = CDC_Handle->DataItf.InEpSize;
+    size_t size = (HOST_SERIAL_RX_CHUNK_SIZE + packet - 1) / packet * packet;
+    if (size != _rxSize) {
+        for (auto& buf : _rxPacket) {
+            delete[] buf;
+            buf = new uint8_t[size];
+        }
+        _rxSize = size;
+    }
+
     static CDC_LineCodingTypeDef linecoding;
     linecoding.b.dwDTERate = 115200;
     linecoding.b.bDataBits = 8;
-    USBH_CDC_SetLineCoding(&hUsbHostHS, &linecoding);
-    USBH_CDC_SetControlLineState(&hUsbHostHS, 1, 1);
-    USBH_CDC_Receive(&hUsbHostHS, buf, sizeof(buf));
+    USBH_CDC_SetLineCoding(cdc, &linecoding);
+    USBH_CDC_SetControlLineState(cdc, 1, 1);
+    _cdc = cdc;
+    wake();
 }
 
 int HostSerial::available() {
-    //USBH_CDC_Stop(&hUsbHostHS);
-    _mut.lock();
-    auto ret = rxBuffer.available();
-    if (ret == 0) {
-        USBH_CDC_Receive(&hUsbHostHS, buf, sizeof(buf));
+    auto ret = _rxRing.available();
+    if (!_rxArmed.load(std::memory_order_acquire)) {
+        wake();
     }
-    _mut.unlock();
     return ret;
 }
 
 int HostSerial::read() {
+    uint8_t c;
+    auto ret = _rxRing.read(&c, 1);
+    if (!_rxArmed.load(std::memory_order_acquire)) {
+        wake();
+    }
+    return (ret != 0) ? c : -1;
+}
+
+int HostSerial::peek() {
+    return _rxRing.peek();
+}
+
+size_t HostSerial::readBytes(uint8_t* buffer, size_t length) {
+    size_t count = 0;
+    unsigned long start = millis();
+
+    for (;;) {
+        count += _rxRing.read(&buffer[count], length - count);
+        if (!_rxArmed.load(std::memory_order_acquire)) {
+            wake();
+        }
+        if (count == length || millis() - start >= _timeout) {
+            return count;
+        }
+        _events.wait_any_for(HOST_SERIAL_RX_DATA, std::chrono::milliseconds(1));
+    }
+}
+
+size_t HostSerial::peekSpan(const uint8_t** data) {
+    return _rxRing.peekSpan(data);
+}
+
+void HostSerial::consume(size_t length) {
+    _rxRing.consume(length);
+    if (!_rxArmed.load(std::memory_order_acquire)) {
+        wake();
+    }
+}
+
+// USB thread, with _mut held: hands the contiguous bytes after _txTail to
+// the class unless a transfer is still in flight
+void HostSerial::tx_start() {
+    if (_txInFlight != 0 || _txCount == 0 || _cdc == nullptr) {
+        return;
+    }
+    size_t len = HOST_SERIAL_TX_BUFFER_SIZE - _txTail;
+    if (len > _txCount) {
+        len = _txCount;
+    }
+    if (USBH_CDC_Transmit(_cdc, &_txBuffer[_txTail], len) == USBH_OK) {
+        _txInFlight = len;
+    }
+}
+
+// USB thread: the chunk in flight went out, release it and send the rest
+void HostSerial::tx_cb() {
     _mut.lock();
-    auto ret = rxBuffer.read_char();
+    _txTail = (_txTail + _txInFlight) % HOST_SERIAL_TX_BUFFER_SIZE;
+    _txCount -= _txInFlight;
+    _txInFlight = 0;
+    tx_start();
+    _mut.unlock();
+    _events.set(HOST_SERIAL_TX_DONE);
+}
+
+size_t HostSerial::write(uint8_t c) {
+    return write(&c, 1);
+}
+
+// Returns early when the adapter goes away, or when the ring stays full for
+// the stream timeout
+size_t HostSerial::write(const uint8_t* buffer, size_t size) {
+    size_t written = 0;
+    unsigned long start = millis();
+
+    while (written < size) {
+        if (_cdc == nullptr) {
+            break;
+        }
+        _mut.lock();
+        size_t len = HOST_SERIAL_TX_BUFFER_SIZE - _txCount;
+        if (len > size - written) {
+            len = size - written;
+        }
+        size_t first = HOST_SERIAL_TX_BUFFER_SIZE - _txHead;
+        if (first > len) {
+            first = len;
+        }
+        memcpy(&_txBuffer[_txHead], &buffer[written], first);
+        memcpy(_txBuffer, &buffer[written + first], len - first);
+        _txHead = (_txHead + len) % HOST_SERIAL_TX_BUFFER_SIZE;
+        _txCount += len;
+        written += len;
+        bool idle = (_txInFlight == 0);
+        _mut.unlock();
+        if (idle && len != 0) {
+            wake();
+        }
+
+        if (len != 0) {
+            start = millis();
+        } else if (millis() - start >= _timeout) {
+            break;
+        } else {
+            // Ring full: wait for the USB thread to send a chunk
+            _events.wait_any_for(HOST_SERIAL_TX_DONE, std::chrono::milliseconds(10));
+        }
+    }
+    return written;
+}
+
+int HostSerial::availableForWrite() {
+    _mut.lock();
+    auto ret = HOST_SERIAL_TX_BUFFER_SIZE - _txCount;
     _mut.unlock();
     return ret;
 }
 
-size_t HostSerial::write(uint8_t) {
-        //USBH_CDC_Transmit()
-};
\ No newline at end of file
+// Gives up like write() when the device takes nothing for the stream timeout
+void HostSerial::flush() {
+    size_t last = 0;
+    unsigned long start = millis();
+
+    for (;;) {
+        if (_cdc == nullptr) {
+            return;
+        }
+        _mut.lock();
+        size_t count = _txCount;
+        bool idle = (_txInFlight == 0);
+        _mut.unlock();
+        if (count == 0) {
+            return;
+        }
+        if (idle) {
+            wake();
+        }
+        if (count != last) {
+            last = count;
+            start = millis();
+        } else if (millis() - start >= _timeout) {
+            return;
+        }
+        _events.wait_any_for(HOST_SERIAL_TX_DONE, std::chrono::milliseconds(10));
+    }
+}
\ No newline at end of file
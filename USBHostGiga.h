@@ -5,6 +5,7 @@
 #include "usbh_hid_keybd.h"
 #include "usbh_hid_mouse.h"
 #include "usbh_cdc.h"
+#include "SpscRing.h"
 
 #ifdef __cplusplus
 
@@ -145,6 +146,23 @@ public:
     static RingBufferNGeneric<64, HID_MOUSE_Info_TypeDef> rxBuffer;
 };
 
+#ifndef HOST_SERIAL_TX_BUFFER_SIZE
+#define HOST_SERIAL_TX_BUFFER_SIZE 1024
+#endif
+
+// A power of two
+#ifndef HOST_SERIAL_RX_BUFFER_SIZE
+#define HOST_SERIAL_RX_BUFFER_SIZE 1024
+#endif
+
+// Bytes asked per USBH_CDC_Receive(), rounded up to a multiple of the bulk
+// packet size of the device. The default asks for one packet: a device need
+// not end a burst with a short packet, a longer receive holds a full last
+// packet back until more data comes.
+#ifndef HOST_SERIAL_RX_CHUNK_SIZE
+#define HOST_SERIAL_RX_CHUNK_SIZE 64
+#endif
+
 class HostSerial : public arduino::HardwareSerial {
 public:
     void begin(unsigned long a = 0, uint16_t config = 0);
@@ -153,17 +171,51 @@ public:
     }
     int available();
     int read();
-    void end() {}
-    void flush() {}
-    int peek(void) {
-        return rxBuffer.peek();
+    // Waits up to the stream timeout for length bytes, copied from the
+    // ring in at most two pieces
+    size_t readBytes(uint8_t* buffer, size_t length);
+    size_t readBytes(char* buffer, size_t length) {
+        return readBytes((uint8_t*)buffer, length);
     }
+    // Contiguous bytes readable in place from *data, valid until consume()
+    size_t peekSpan(const uint8_t** data);
+    void consume(size_t length);
+    void end() {}
+    void flush();
+    int peek(void);
     size_t write(uint8_t c);
+    size_t write(const uint8_t* buffer, size_t size);
+    using Print::write;
+    int availableForWrite();
     operator bool() {
         return true;
     }
-    void rx_cb(uint8_t* data, size_t len);
+    void rx_cb(size_t len);
+    void tx_cb();
+    void disconnect_cb();
+    void process_cb();
 private:
-    RingBufferN<128> rxBuffer;
+    void rx_start();
+    void tx_start();
+    void wake();
     rtos::Mutex _mut;
+    // Filled by the USB thread, read by the sketch without locking
+    SpscRing<HOST_SERIAL_RX_BUFFER_SIZE> _rxRing;
+    // Ping-pong receive: the USB thread re-arms one buffer as soon as the
+    // other one completes, while the ring has room for both. Whoever sets
+    // _rxArmed owns _rxIndex and the idle buffer.
+    // Both are _rxSize bytes, allocated by begin() once the packet size
+    // of the device is known.
+    uint8_t* _rxPacket[2] = {nullptr, nullptr};
+    uint8_t _rxIndex = 0;
+    size_t _rxSize = 0;
+    std::atomic<bool> _rxArmed{false};
+    // Bytes waiting for the USB thread, sent from _txTail in as few
+    // USBH_CDC_Transmit() calls as the ring wrap allows
+    uint8_t _txBuffer[HOST_SERIAL_TX_BUFFER_SIZE];
+    size_t _txHead = 0;
+    size_t _txTail = 0;
+    size_t _txCount = 0;
+    size_t _txInFlight = 0;
+    rtos::EventFlags _events;
 };
\ No newline at end of file
@@ -0,0 +1,434 @@
+/**
+  ******************************************************************************
+  * @file    bench_cdc.c
+  * @brief   CDC class throughput and latency benchmark on the simulated
+  *          controller.
+  *
+  *          The CDC-ACM loopback is enumerated on the root port, then each
+  *          direction is driven for a fixed virtual time per chunk size:
+  *            - tx: USBH_CDC_Transmit() is called again from
+  *              USBH_CDC_TransmitCallback(), the device consumes everything
+  *              it receives
+  *            - rx: USBH_CDC_Receive() is called again from
+  *              USBH_CDC_ReceiveCallback(), the device always has data
+  *            - echo: one chunk is sent and received back through the
+  *              loopback before the next one goes out
+  *          A transfer lasts from the USBH_CDC_Transmit()/Receive() call to
+  *          its callback; for echo, from the transmit call to the last byte
+  *          received back. Throughput and latency are in virtual time, the
+  *          CPU time is the host process time of the run (simulator
+  *          included) divided by the bytes moved. Results are printed as
+  *          CSV. Received data is checked against the sequence sent.
+  *
+  *          usage: bench_cdc [-d tx|rx|echo|all] [-s chunk] [-t ms] [-p pass_us]
+  *                           [-j seed]
+  *
+  *          Without -s, chunks of 1 to 4096 bytes are measured. -j draws the
+  *          time of each USBH_Process() pass from [0.5, 1.5] times -p, which
+  *          spreads the latency percentiles.
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "usbh_sim_dev.h"
+#include "usbh_cdc.h"
+
+#define BENCH_TIMEOUT          USBH_SIM_MS(5000U)
+#define BENCH_MAX_CHUNK        16384U
+
+typedef enum
+{
+  BENCH_TX = 0,
+  BENCH_RX,
+  BENCH_ECHO,
+} BENCH_DirectionTypeDef;
+
+static const char *const DirectionName[] = { "tx", "rx", "echo" };
+static const uint32_t SweepChunks[] = { 1U, 4U, 16U, 64U, 256U, 1024U, 4096U };
+
+static USBH_HandleTypeDef hUsbHost;
+static USBH_SIM_CdcDevTypeDef Serial;
+static uint8_t ClassActive;
+
+static uint8_t TxBuf[BENCH_MAX_CHUNK];
+static uint8_t RxBuf[BENCH_MAX_CHUNK];
+static BENCH_DirectionTypeDef Direction;
+static uint32_t Chunk;
+static uint8_t Running;
+static uint64_t Bytes;
+static uint64_t Started;         /* virtual time the transfer was started */
+static uint32_t EchoCount;       /* bytes of the chunk back from the loopback */
+static uint32_t Errors;
+static uint8_t Source;           /* next byte the device sends */
+static uint8_t Expected;         /* next byte the host should receive */
+static uint32_t PassTime;
+static uint64_t Rng;
+
+/* Latency of each transfer, in ns */
+static uint64_t *Latency;
+static uint32_t LatencyCount;
+static uint32_t LatencySize;
+
+static void BENCH_Device(void);
+
+static void UserProcess(USBH_HandleTypeDef *phost, uint8_t id)
+{
+  UNUSED(phost);
+
+  if (id == HOST_USER_CLASS_ACTIVE)
+  {
+    ClassActive = 1U;
+  }
+}
+
+static uint32_t BENCH_Jitter(uint32_t nominal)
+{
+  /* xorshift64, uniform in [0.5, 1.5] * nominal */
+  Rng ^= Rng << 13;
+  Rng ^= Rng >> 7;
+  Rng ^= Rng << 17;
+
+  return (uint32_t)((nominal / 2U) + (Rng % ((uint64_t)nominal + 1U)));
+}
+
+static void BENCH_Poll(void)
+{
+  if (Rng != 0U)
+  {
+    USBH_SIM_GetHost()->Config.PassTime = BENCH_Jitter(PassTime);
+  }
+  BENCH_Device();
+  USBH_SIM_Poll(&hUsbHost);
+}
+
+static void BENCH_Record(void)
+{
+  uint64_t now = USBH_SIM_Now();
+
+  if (LatencyCount == LatencySize)
+  {
+    LatencySize = (LatencySize == 0U) ? 4096U : (LatencySize * 2U);
+    Latency = realloc(Latency, LatencySize * sizeof(uint64_t));
+    if (Latency == NULL)
+    {
+      fprintf(stderr, "out of memory\n");
+      exit(1);
+    }
+  }
+  Latency[LatencyCount++] = now - Started;
+  Started = now;
+}
+
+static void BENCH_Check(const uint8_t *pbuf, uint32_t length)
+{
+  uint32_t idx;
+
+  for (idx = 0U; idx < length; idx++)
+  {
+    if (pbuf[idx] != Expected)
+    {
+      Errors++;
+      Expected = pbuf[idx];
+    }
+    Expected++;
+  }
+}
+
+/* Next chunk to send, continuing the byte sequence */
+static void BENCH_Fill(void)
+{
+  uint32_t idx;
+
+  for (idx = 0U; idx < Chunk; idx++)
+  {
+    TxBuf[idx] = Source++;
+  }
+}
+
+void USBH_CDC_TransmitCallback(USBH_HandleTypeDef *phost)
+{
+  if (Direction != BENCH_TX)
+  {
+    return;
+  }
+
+  Bytes += Chunk;
+  BENCH_Record();
+
+  if (Running != 0U)
+  {
+    (void)USBH_CDC_Transmit(phost, TxBuf, Chunk);
+  }
+}
+
+void USBH_CDC_ReceiveCallback(USBH_HandleTypeDef *phost)
+{
+  uint32_t length = USBH_CDC_GetLastReceivedDataSize(phost);
+
+  if (Direction == BENCH_RX)
+  {
+    BENCH_Check(RxBuf, length);
+    Bytes += length;
+    BENCH_Record();
+
+    if (Running != 0U)
+    {
+      (void)USBH_CDC_Receive(phost, RxBuf, Chunk);
+    }
+    return;
+  }
+
+  /* Echo: the chunk may come back in several pieces */
+  BENCH_Check(&RxBuf[EchoCount], length);
+  EchoCount += length;
+
+  if (EchoCount < Chunk)
+  {
+    (void)USBH_CDC_Receive(phost, &RxBuf[EchoCount], Chunk - EchoCount);
+    return;
+  }
+
+  Bytes += Chunk;
+  BENCH_Record();
+  EchoCount = 0U;
+
+  if (Running != 0U)
+  {
+    BENCH_Fill();
+    (void)USBH_CDC_Transmit(phost, TxBuf, Chunk);
+    (void)USBH_CDC_Receive(phost, RxBuf, Chunk);
+  }
+}
+
+/* The device side: drain what the host sent, or keep data ready for it */
+static void BENCH_Device(void)
+{
+  if (Direction == BENCH_TX)
+  {
+    Serial.Tail = Serial.Head;
+  }
+  else if (Direction == BENCH_RX)
+  {
+    while ((Serial.Head - Serial.Tail) < Serial.Capacity)
+    {
+      Serial.Fifo[Serial.Head % USBH_SIM_CDC_FIFO_SIZE] = Source++;
+      Serial.Head++;
+    }
+  }
+  else
+  {
+    /* the loopback echoes by itself */
+  }
+}
+
+static int BENCH_Compare(const void *a, const void *b)
+{
+  uint64_t x = *(const uint64_t *)a;
+  uint64_t y = *(const uint64_t *)b;
+
+  return (x > y) - (x < y);
+}
+
+static double BENCH_Percentile(uint32_t percent)
+{
+  uint32_t idx;
+
+  if (LatencyCount == 0U)
+  {
+    return 0.0;
+  }
+  idx = (uint32_t)(((uint64_t)(LatencyCount - 1U) * percent + 50U) / 100U);
+
+  return (double)Latency[idx] / 1e3;
+}
+
+static double BENCH_CpuTime(void)
+{
+  struct timespec ts;
+
+  (void)clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+
+  return ((double)ts.tv_sec * 1e9) + (double)ts.tv_nsec;
+}
+
+static int BENCH_Run(BENCH_DirectionTypeDef dir, uint32_t chunk, uint32_t time_ms)
+{
+  USBH_SIM_HostTypeDef *phc = USBH_SIM_GetHost();
+  CDC_HandleTypeDef *CDC_Handle = (CDC_HandleTypeDef *)hUsbHost.pActiveClass->pData;
+  uint64_t start = USBH_SIM_Now();
+  uint64_t end = start + USBH_SIM_MS(time_ms);
+  uint64_t urbs = phc->Stats.Urbs;
+  uint64_t passes = phc->Stats.Passes;
+  uint64_t bus = phc->Stats.BusTime;
+  double cpu = BENCH_CpuTime();
+  double seconds;
+
+  Direction = dir;
+  Chunk = chunk;
+  Bytes = 0U;
+  LatencyCount = 0U;
+  EchoCount = 0U;
+  Expected = Source;
+  Started = start;
+  Running = 1U;
+
+  if (dir == BENCH_TX)
+  {
+    (void)USBH_CDC_Transmit(&hUsbHost, TxBuf, Chunk);
+  }
+  else if (dir == BENCH_RX)
+  {
+    (void)USBH_CDC_Receive(&hUsbHost, RxBuf, Chunk);
+  }
+  else
+  {
+    BENCH_Fill();
+    (void)USBH_CDC_Transmit(&hUsbHost, TxBuf, Chunk);
+    (void)USBH_CDC_Receive(&hUsbHost, RxBuf, Chunk);
+  }
+
+  while (USBH_SIM_Now() < end)
+  {
+    BENCH_Poll();
+  }
+
+  /* The transfers in flight finish uncounted */
+  Running = 0U;
+  end = USBH_SIM_Now();
+  cpu = BENCH_CpuTime() - cpu;
+  seconds = (double)(end - start) / 1e9;
+  qsort(Latency, LatencyCount, sizeof(uint64_t), BENCH_Compare);
+
+  printf("%s,%u,%llu,%.1f,%.1f,%u,%.1f,%.1f,%.1f,%.1f,%.1f,%llu,%llu,%.1f\n",
+         DirectionName[dir], (unsigned)Chunk, (unsigned long long)Bytes, seconds * 1e3,
+         (double)Bytes / seconds / 1e3, (unsigned)LatencyCount,
+         BENCH_Percentile(50U), BENCH_Percentile(90U), BENCH_Percentile(99U),
+         BENCH_Percentile(100U), (Bytes != 0U) ? (cpu / (double)Bytes) : 0.0,
+         (unsigned long long)(phc->Stats.Urbs - urbs),
+         (unsigned long long)(phc->Stats.Passes - passes),
+         (double)(phc->Stats.BusTime - bus) * 100.0 / (double)(end - start));
+
+  end = USBH_SIM_Now() + USBH_SIM_MS(100U);
+  while ((USBH_SIM_Now() < end) &&
+         ((CDC_Handle->data_tx_state != CDC_IDLE) || (CDC_Handle->data_rx_state != CDC_IDLE)))
+  {
+    BENCH_Poll();
+  }
+
+  /* Whatever the loopback still holds belongs to no transfer */
+  Serial.Tail = Serial.Head;
+
+  return (Bytes == 0U) ? -1 : 0;
+}
+
+int main(int argc, char **argv)
+{
+  USBH_SIM_ConfigTypeDef cfg;
+  const char *which = "all";
+  uint32_t time_ms = 200U;
+  uint32_t chunk = 0U;
+  uint64_t deadline;
+  int status = 0;
+  int dir;
+  uint32_t idx;
+
+  USBH_SIM_GetDefaultConfig(&cfg);
+
+  for (dir = 1; dir < argc; dir++)
+  {
+    if ((strcmp(argv[dir], "-d") == 0) && ((dir + 1) < argc))
+    {
+      which = argv[++dir];
+    }
+    else if ((strcmp(argv[dir], "-s") == 0) && ((dir + 1) < argc))
+    {
+      chunk = (uint32_t)strtoul(argv[++dir], NULL, 0);
+      if ((chunk == 0U) || (chunk > BENCH_MAX_CHUNK))
+      {
+        fprintf(stderr, "chunk must be 1 to %u bytes\n", (unsigned)BENCH_MAX_CHUNK);
+        return 2;
+      }
+    }
+    else if ((strcmp(argv[dir], "-t") == 0) && ((dir + 1) < argc))
+    {
+      time_ms = (uint32_t)strtoul(argv[++dir], NULL, 0);
+    }
+    else if ((strcmp(argv[dir], "-p") == 0) && ((dir + 1) < argc))
+    {
+      cfg.PassTime = (uint32_t)USBH_SIM_US(strtoul(argv[++dir], NULL, 0));
+    }
+    else if ((strcmp(argv[dir], "-j") == 0) && ((dir + 1) < argc))
+    {
+      Rng = strtoull(argv[++dir], NULL, 0) | 1U;
+    }
+    else
+    {
+      fprintf(stderr, "usage: %s [-d tx|rx|echo|all] [-s chunk] [-t ms] [-p pass_us] [-j seed]\n",
+              argv[0]);
+      return 2;
+    }
+  }
+
+  for (idx = 0U; idx < BENCH_MAX_CHUNK; idx++)
+  {
+    TxBuf[idx] = (uint8_t)idx;
+  }
+
+  PassTime = cfg.PassTime;
+  USBH_SIM_CdcInit(&Serial);
+  USBH_SIM_Configure(&cfg);
+  (void)USBH_Init(&hUsbHost, UserProcess, 0U);
+  (void)USBH_RegisterClass(&hUsbHost, USBH_CDC_CLASS);
+  USBH_SIM_Attach(&hUsbHost, &Serial.Dev);
+  (void)USBH_Start(&hUsbHost);
+
+  deadline = USBH_SIM_Now() + BENCH_TIMEOUT;
+  while ((ClassActive == 0U) && (USBH_SIM_Now() < deadline))
+  {
+    USBH_SIM_Poll(&hUsbHost);
+  }
+
+  if (ClassActive == 0U)
+  {
+    fprintf(stderr, "enumeration did not complete (gState %d, EnumState %d)\n",
+            (int)hUsbHost.gState, (int)hUsbHost.EnumState);
+    return 1;
+  }
+
+  printf("direction,chunk,bytes,time_ms,kB_s,transfers,lat_p50_us,lat_p90_us,lat_p99_us,"
+         "lat_max_us,cpu_ns_per_byte,urbs,passes,bus_pct\n");
+
+  for (dir = (int)BENCH_TX; dir <= (int)BENCH_ECHO; dir++)
+  {
+    if ((strcmp(which, "all") != 0) && (strcmp(which, DirectionName[dir]) != 0))
+    {
+      continue;
+    }
+
+    if (chunk != 0U)
+    {
+      status |= BENCH_Run((BENCH_DirectionTypeDef)dir, chunk, time_ms);
+    }
+    else
+    {
+      for (idx = 0U; idx < (sizeof(SweepChunks) / sizeof(SweepChunks[0])); idx++)
+      {
+        status |= BENCH_Run((BENCH_DirectionTypeDef)dir, SweepChunks[idx], time_ms);
+      }
+    }
+  }
+
+  free(Latency);
+
+  if (Errors != 0U)
+  {
+    fprintf(stderr, "%u bytes received out of sequence\n", (unsigned)Errors);
+    status = -1;
+  }
+
+  return (status == 0) ? 0 : 1;
+}
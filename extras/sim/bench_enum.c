@@ -0,0 +1,371 @@
+/**
+  ******************************************************************************
+  * @file    bench_enum.c
+  * @brief   Enumeration latency benchmark on the simulated controller.
+  *
+  *          Each run plugs a virtual device into the root port and polls
+  *          USBH_Process() until the class reaches HOST_CLASS. The virtual
+  *          time of every pass, blocking USBH_Delay() calls included, is
+  *          charged to the gState (and EnumState during HOST_ENUMERATION) the
+  *          pass started in; the idle time before the next pass is charged to
+  *          the state the pass left behind. Results are printed as CSV.
+  *
+  *          usage: bench_enum [-n runs] [-d keyboard|mouse|cdc|all]
+  *                            [-p pass_us] [-j seed] [-r] [-c]
+  *
+  *          -j enables jitter: the device control latency and the pass time
+  *          are drawn per run from [0.5, 1.5] times their nominal values.
+  *          -r prints one line per run instead of the per-state summary.
+  *          -c keeps the descriptor cache from one run to the next, so that
+  *          every run but the first is a cache hit; by default it is cleared
+  *          before each run. The cache counters go to stderr.
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "usbh_sim_dev.h"
+#include "usbh_hid.h"
+#include "usbh_cdc.h"
+#include "usbh_desc_cache.h"
+
+#define BENCH_TIMEOUT          USBH_SIM_MS(10000U)
+#define BENCH_NUM_GSTATES      ((uint32_t)HOST_ABORT_STATE + 1U)
+#define BENCH_NUM_ENUMSTATES   ((uint32_t)ENUM_CHECK_CACHE + 1U)
+#define BENCH_NUM_SLOTS        (BENCH_NUM_GSTATES + BENCH_NUM_ENUMSTATES)
+
+typedef struct
+{
+  uint64_t Sum;
+  uint64_t Min;
+  uint64_t Max;
+  uint64_t Delay;
+  uint64_t Passes;
+  uint32_t Runs;
+} BENCH_SlotTypeDef;
+
+typedef struct
+{
+  uint64_t Time[BENCH_NUM_SLOTS];
+  uint64_t Delay[BENCH_NUM_SLOTS];
+  uint64_t Passes[BENCH_NUM_SLOTS];
+} BENCH_RunTypeDef;
+
+static const char *const GStateName[BENCH_NUM_GSTATES] =
+{
+  "HOST_IDLE", "HOST_DEV_WAIT_FOR_ATTACHMENT", "HOST_DEV_ATTACHED",
+  "HOST_DEV_DISCONNECTED", "HOST_DETECT_DEVICE_SPEED", "HOST_ENUMERATION",
+  "HOST_CLASS_REQUEST", "HOST_INPUT", "HOST_SET_CONFIGURATION",
+  "HOST_SET_WAKEUP_FEATURE", "HOST_CHECK_CLASS", "HOST_CLASS",
+  "HOST_SUSPENDED", "HOST_ABORT_STATE"
+};
+
+static const char *const EnumStateName[BENCH_NUM_ENUMSTATES] =
+{
+  "ENUM_IDLE", "ENUM_GET_FULL_DEV_DESC", "ENUM_SET_ADDR", "ENUM_GET_CFG_DESC",
+  "ENUM_GET_FULL_CFG_DESC", "ENUM_GET_MFC_STRING_DESC",
+  "ENUM_GET_PRODUCT_STRING_DESC", "ENUM_GET_SERIALNUM_STRING_DESC",
+  "ENUM_CHECK_CACHE"
+};
+
+static USBH_HandleTypeDef hUsbHost;
+static USBH_SIM_HidDevTypeDef Keyboard;
+static USBH_SIM_HidDevTypeDef Mouse;
+static USBH_SIM_CdcDevTypeDef Serial;
+static uint64_t Rng;
+
+static void UserProcess(USBH_HandleTypeDef *phost, uint8_t id)
+{
+  UNUSED(phost);
+  UNUSED(id);
+}
+
+static uint32_t BENCH_Jitter(uint32_t nominal)
+{
+  /* xorshift64, uniform in [0.5, 1.5] * nominal */
+  Rng ^= Rng << 13;
+  Rng ^= Rng >> 7;
+  Rng ^= Rng << 17;
+
+  return (uint32_t)((nominal / 2U) + (Rng % ((uint64_t)nominal + 1U)));
+}
+
+static uint32_t BENCH_Slot(USBH_HandleTypeDef *phost)
+{
+  if (phost->gState == HOST_ENUMERATION)
+  {
+    return BENCH_NUM_GSTATES + (uint32_t)phost->EnumState;
+  }
+
+  return (uint32_t)phost->gState;
+}
+
+static const char *BENCH_SlotName(uint32_t slot)
+{
+  return (slot < BENCH_NUM_GSTATES) ? GStateName[slot] : EnumStateName[slot - BENCH_NUM_GSTATES];
+}
+
+/* Unplug the current device and let the core return to HOST_IDLE */
+static void BENCH_Unplug(void)
+{
+  USBH_SIM_Detach(&hUsbHost);
+
+  while ((hUsbHost.gState != HOST_IDLE) || (hUsbHost.device.is_disconnected != 0U))
+  {
+    USBH_SIM_Poll(&hUsbHost);
+  }
+  USBH_SIM_Advance(&hUsbHost, USBH_SIM_MS(10U));
+}
+
+static int BENCH_Run(USBH_SIM_DeviceTypeDef *pdev, BENCH_RunTypeDef *prun)
+{
+  USBH_SIM_HostTypeDef *phc = USBH_SIM_GetHost();
+  uint64_t deadline;
+  uint64_t t0;
+  uint64_t d0;
+  uint32_t slot;
+
+  (void)memset(prun, 0, sizeof(BENCH_RunTypeDef));
+
+  USBH_SIM_Attach(&hUsbHost, pdev);
+  deadline = phc->Now + BENCH_TIMEOUT;
+
+  while (hUsbHost.gState != HOST_CLASS)
+  {
+    if ((phc->Now >= deadline) || (hUsbHost.gState == HOST_ABORT_STATE))
+    {
+      return -1;
+    }
+
+    /* pass: charged to the state it runs */
+    slot = BENCH_Slot(&hUsbHost);
+    t0 = phc->Now;
+    d0 = phc->Stats.DelayTime;
+    (void)USBH_Process(&hUsbHost);
+    phc->Stats.Passes++;
+    prun->Time[slot] += phc->Now - t0;
+    prun->Delay[slot] += phc->Stats.DelayTime - d0;
+    prun->Passes[slot]++;
+
+    /* idle until the next pass: charged to the state waiting to run */
+    slot = BENCH_Slot(&hUsbHost);
+    t0 = phc->Now;
+    USBH_SIM_Advance(&hUsbHost, phc->Config.PassTime);
+    prun->Time[slot] += phc->Now - t0;
+  }
+
+  return 0;
+}
+
+static void BENCH_Accumulate(BENCH_SlotTypeDef *pslots, const BENCH_RunTypeDef *prun)
+{
+  uint64_t total = 0U;
+  uint32_t slot;
+
+  for (slot = 0U; slot < BENCH_NUM_SLOTS; slot++)
+  {
+    total += prun->Time[slot];
+    pslots[BENCH_NUM_SLOTS].Delay += prun->Delay[slot];
+    pslots[BENCH_NUM_SLOTS].Passes += prun->Passes[slot];
+    if (prun->Passes[slot] == 0U)
+    {
+      continue;
+    }
+    if ((pslots[slot].Runs == 0U) || (prun->Time[slot] < pslots[slot].Min))
+    {
+      pslots[slot].Min = prun->Time[slot];
+    }
+    if (prun->Time[slot] > pslots[slot].Max)
+    {
+      pslots[slot].Max = prun->Time[slot];
+    }
+    pslots[slot].Sum += prun->Time[slot];
+    pslots[slot].Delay += prun->Delay[slot];
+    pslots[slot].Passes += prun->Passes[slot];
+    pslots[slot].Runs++;
+  }
+
+  slot = BENCH_NUM_SLOTS;
+  if ((pslots[slot].Runs == 0U) || (total < pslots[slot].Min))
+  {
+    pslots[slot].Min = total;
+  }
+  if (total > pslots[slot].Max)
+  {
+    pslots[slot].Max = total;
+  }
+  pslots[slot].Sum += total;
+  pslots[slot].Runs++;
+}
+
+static int BENCH_Device(const char *name, USBH_SIM_DeviceTypeDef *pdev, uint32_t runs,
+                        uint32_t pass_ns, int jitter, int raw, int cache)
+{
+  const USBH_DescCacheStatsTypeDef *pstats = USBH_DescCache_GetStats();
+  BENCH_SlotTypeDef slots[BENCH_NUM_SLOTS + 1U];
+  BENCH_RunTypeDef run;
+  uint32_t latency = pdev->CtlLatency;
+  uint64_t total;
+  uint32_t idx;
+  uint32_t slot;
+
+  (void)memset(slots, 0, sizeof(slots));
+  USBH_DescCache_Clear();
+
+  for (idx = 0U; idx < runs; idx++)
+  {
+    if (cache == 0)
+    {
+      USBH_DescCache_Clear();
+    }
+    if (jitter != 0)
+    {
+      pdev->CtlLatency = BENCH_Jitter(latency);
+      USBH_SIM_GetHost()->Config.PassTime = BENCH_Jitter(pass_ns);
+    }
+
+    if (BENCH_Run(pdev, &run) != 0)
+    {
+      fprintf(stderr, "%s: run %u did not reach HOST_CLASS (gState %d, EnumState %d)\n",
+              name, (unsigned)idx, (int)hUsbHost.gState, (int)hUsbHost.EnumState);
+      return -1;
+    }
+    BENCH_Unplug();
+
+    if (raw != 0)
+    {
+      total = 0U;
+      for (slot = 0U; slot < BENCH_NUM_SLOTS; slot++)
+      {
+        total += run.Time[slot];
+      }
+      printf("%s,%u,%.3f", name, (unsigned)idx, (double)total / 1e3);
+      for (slot = 0U; slot < BENCH_NUM_SLOTS; slot++)
+      {
+        printf(",%.3f", (double)run.Time[slot] / 1e3);
+      }
+      printf("\n");
+    }
+    BENCH_Accumulate(slots, &run);
+  }
+
+  pdev->CtlLatency = latency;
+  USBH_SIM_GetHost()->Config.PassTime = pass_ns;
+
+  if (cache != 0)
+  {
+    fprintf(stderr, "%s: cache %u hits, %u misses, %u requests saved\n", name,
+            (unsigned)pstats->Hits, (unsigned)pstats->Misses, (unsigned)pstats->SavedRequests);
+  }
+
+  if (raw == 0)
+  {
+    for (slot = 0U; slot <= BENCH_NUM_SLOTS; slot++)
+    {
+      if (slots[slot].Runs == 0U)
+      {
+        continue;
+      }
+      printf("%s,%s,%u,%.3f,%.3f,%.3f,%.3f,%.1f\n", name,
+             (slot < BENCH_NUM_SLOTS) ? BENCH_SlotName(slot) : "TOTAL",
+             (unsigned)slots[slot].Runs,
+             (double)slots[slot].Sum / slots[slot].Runs / 1e3,
+             (double)slots[slot].Min / 1e3, (double)slots[slot].Max / 1e3,
+             (double)slots[slot].Delay / slots[slot].Runs / 1e3,
+             (double)slots[slot].Passes / slots[slot].Runs);
+    }
+  }
+
+  return 0;
+}
+
+int main(int argc, char **argv)
+{
+  USBH_SIM_ConfigTypeDef cfg;
+  const char *which = "all";
+  uint32_t runs = 100U;
+  int jitter = 0;
+  int raw = 0;
+  int cache = 0;
+  int status = 0;
+  int idx;
+  uint32_t slot;
+
+  USBH_SIM_GetDefaultConfig(&cfg);
+
+  for (idx = 1; idx < argc; idx++)
+  {
+    if ((strcmp(argv[idx], "-n") == 0) && ((idx + 1) < argc))
+    {
+      runs = (uint32_t)strtoul(argv[++idx], NULL, 0);
+    }
+    else if ((strcmp(argv[idx], "-d") == 0) && ((idx + 1) < argc))
+    {
+      which = argv[++idx];
+    }
+    else if ((strcmp(argv[idx], "-p") == 0) && ((idx + 1) < argc))
+    {
+      cfg.PassTime = (uint32_t)USBH_SIM_US(strtoul(argv[++idx], NULL, 0));
+    }
+    else if ((strcmp(argv[idx], "-j") == 0) && ((idx + 1) < argc))
+    {
+      Rng = strtoull(argv[++idx], NULL, 0) | 1U;
+      jitter = 1;
+    }
+    else if (strcmp(argv[idx], "-r") == 0)
+    {
+      raw = 1;
+    }
+    else if (strcmp(argv[idx], "-c") == 0)
+    {
+      cache = 1;
+    }
+    else
+    {
+      fprintf(stderr, "usage: %s [-n runs] [-d keyboard|mouse|cdc|all] [-p pass_us] [-j seed] [-r] [-c]\n",
+              argv[0]);
+      return 2;
+    }
+  }
+
+  USBH_SIM_KeyboardInit(&Keyboard);
+  USBH_SIM_MouseInit(&Mouse);
+  USBH_SIM_CdcInit(&Serial);
+
+  USBH_SIM_Configure(&cfg);
+  (void)USBH_Init(&hUsbHost, UserProcess, 0U);
+  (void)USBH_RegisterClass(&hUsbHost, USBH_HID_CLASS);
+  (void)USBH_RegisterClass(&hUsbHost, USBH_CDC_CLASS);
+  (void)USBH_Start(&hUsbHost);
+
+  if (raw != 0)
+  {
+    printf("device,run,total_us");
+    for (slot = 0U; slot < BENCH_NUM_SLOTS; slot++)
+    {
+      printf(",%s_us", BENCH_SlotName(slot));
+    }
+    printf("\n");
+  }
+  else
+  {
+    printf("device,state,runs,mean_us,min_us,max_us,delay_mean_us,passes_mean\n");
+  }
+
+  if ((strcmp(which, "all") == 0) || (strcmp(which, "keyboard") == 0))
+  {
+    status |= BENCH_Device("keyboard", &Keyboard.Dev, runs, cfg.PassTime, jitter, raw, cache);
+  }
+  if ((strcmp(which, "all") == 0) || (strcmp(which, "mouse") == 0))
+  {
+    status |= BENCH_Device("mouse", &Mouse.Dev, runs, cfg.PassTime, jitter, raw, cache);
+  }
+  if ((strcmp(which, "all") == 0) || (strcmp(which, "cdc") == 0))
+  {
+    status |= BENCH_Device("cdc", &Serial.Dev, runs, cfg.PassTime, jitter, raw, cache);
+  }
+
+  return (status == 0) ? 0 : 1;
+}
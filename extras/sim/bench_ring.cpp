@@ -0,0 +1,176 @@
+/**
+  ******************************************************************************
+  * @file    bench_ring.cpp
+  * @brief   HostSerial receive ring benchmark on the build host.
+  *
+  *          A producer thread stores HOST_SERIAL_RX_CHUNK_SIZE byte chunks,
+  *          like USBH_CDC_ReceiveCallback, while the main thread reads them
+  *          back one byte at a time (HostSerial::read()) or in 64 byte
+  *          blocks (HostSerial::readBytes()). Both threads spin on a full or
+  *          empty ring, so every access is contended. Two rings are
+  *          compared:
+  *            - spsc: SpscRing, acquire/release indices and no lock
+  *            - mutex: the same ring with every access under a std::mutex,
+  *              as HostSerial did with its rtos::Mutex
+  *          The byte sequence is checked on the consumer side. Results are
+  *          printed as CSV.
+  *
+  *          usage: bench_ring [-n MiB] [-r spsc|mutex|all]
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include "SpscRing.h"
+
+#define BENCH_RING_SIZE        1024U
+#define BENCH_CHUNK_SIZE       256U
+#define BENCH_BLOCK_SIZE       64U
+
+// The reference: one lock around each access of the same ring
+template <size_t N>
+class MutexRing
+{
+  public:
+    size_t write(const uint8_t* data, size_t len) {
+        std::lock_guard<std::mutex> lock(_mut);
+        return _ring.write(data, len);
+    }
+
+    size_t read(uint8_t* data, size_t len) {
+        std::lock_guard<std::mutex> lock(_mut);
+        return _ring.read(data, len);
+    }
+
+  private:
+    std::mutex _mut;
+    SpscRing<N> _ring;
+};
+
+struct BenchResult
+{
+    double Seconds;
+    uint64_t ProducerWaits;
+    uint64_t ConsumerWaits;
+    uint64_t Errors;
+};
+
+template <class Ring>
+static BenchResult BenchRun(Ring& ring, uint64_t total, size_t block)
+{
+    BenchResult res = {};
+    uint64_t producer_waits = 0;
+    uint8_t buf[BENCH_BLOCK_SIZE];
+    uint8_t expected = 0;
+    uint64_t received = 0;
+
+    auto start = std::chrono::steady_clock::now();
+
+    std::thread producer([&ring, total, &producer_waits]() {
+        uint8_t chunk[BENCH_CHUNK_SIZE];
+        uint8_t next = 0;
+        uint64_t sent = 0;
+
+        while (sent < total) {
+            size_t len = BENCH_CHUNK_SIZE;
+            if (len > total - sent) {
+                len = (size_t)(total - sent);
+            }
+            for (size_t i = 0; i < len; i++) {
+                chunk[i] = next++;
+            }
+            size_t done = 0;
+            while (done < len) {
+                size_t n = ring.write(&chunk[done], len - done);
+                if (n == 0) {
+                    producer_waits++;
+                    std::this_thread::yield();
+                }
+                done += n;
+            }
+            sent += len;
+        }
+    });
+
+    while (received < total) {
+        size_t n = ring.read(buf, block);
+        if (n == 0) {
+            res.ConsumerWaits++;
+            std::this_thread::yield();
+            continue;
+        }
+        for (size_t i = 0; i < n; i++) {
+            if (buf[i] != expected) {
+                res.Errors++;
+                expected = buf[i];
+            }
+            expected++;
+        }
+        received += n;
+    }
+
+    producer.join();
+    res.Seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    res.ProducerWaits = producer_waits;
+    return res;
+}
+
+template <class Ring>
+static int BenchRing(const char* name, uint64_t total)
+{
+    static const struct { const char* Name; size_t Block; } modes[] = {
+        { "byte", 1 }, { "block", BENCH_BLOCK_SIZE },
+    };
+    int status = 0;
+
+    for (const auto& mode : modes) {
+        Ring* ring = new Ring();
+        BenchResult res = BenchRun(*ring, total, mode.Block);
+        delete ring;
+
+        printf("%s,%s,%llu,%.3f,%.1f,%.2f,%llu,%llu\n", name, mode.Name,
+               (unsigned long long)total, res.Seconds, (double)total / res.Seconds / 1e6,
+               res.Seconds * 1e9 / (double)total, (unsigned long long)res.ProducerWaits,
+               (unsigned long long)res.ConsumerWaits);
+        if (res.Errors != 0) {
+            fprintf(stderr, "%s,%s: %llu bytes out of sequence\n", name, mode.Name,
+                    (unsigned long long)res.Errors);
+            status = 1;
+        }
+    }
+    return status;
+}
+
+int main(int argc, char** argv)
+{
+    const char* which = "all";
+    uint64_t total = 64ULL << 20;
+    int status = 0;
+
+    for (int idx = 1; idx < argc; idx++) {
+        if ((strcmp(argv[idx], "-n") == 0) && ((idx + 1) < argc)) {
+            total = strtoull(argv[++idx], NULL, 0) << 20;
+        } else if ((strcmp(argv[idx], "-r") == 0) && ((idx + 1) < argc)) {
+            which = argv[++idx];
+        } else {
+            fprintf(stderr, "usage: %s [-n MiB] [-r spsc|mutex|all]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    printf("ring,read,bytes,seconds,MB_s,ns_per_byte,producer_waits,consumer_waits\n");
+
+    if ((strcmp(which, "all") == 0) || (strcmp(which, "spsc") == 0)) {
+        status |= BenchRing<SpscRing<BENCH_RING_SIZE>>("spsc", total);
+    }
+    if ((strcmp(which, "all") == 0) || (strcmp(which, "mutex") == 0)) {
+        status |= BenchRing<MutexRing<BENCH_RING_SIZE>>("mutex", total);
+    }
+
+    return status;
+}
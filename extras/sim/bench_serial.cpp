@@ -0,0 +1,278 @@
+/**
+  ******************************************************************************
+  * @file    bench_serial.cpp
+  * @brief   HostSerial throughput and latency benchmark on the simulated
+  *          controller.
+  *
+  *          The Arduino wrapper (USBHostGiga.cpp) is built unchanged against
+  *          sim_arduino.cpp and opens the CDC-ACM loopback with begin(), then
+  *          a sketch loop is timed per chunk size, as bench_cdc times the
+  *          class underneath it:
+  *            - tx: write() then flush(), the device consumes everything
+  *            - stream: write() alone, the TX ring absorbs what the bus
+  *              cannot take yet; flush() once at the end
+  *            - rx: readBytes() of a whole chunk, the device always has data
+  *            - echo: the chunk is written and read back through the
+  *              loopback, reading while the TX ring is full
+  *          Latency is the virtual time spent in those calls per chunk, so
+  *          it is zero when the rings absorb the chunk. The CPU time is the
+  *          host process time of the run (simulator included) divided by the
+  *          bytes moved. Results are printed as CSV with the columns of
+  *          bench_cdc. Received data is checked against the sequence sent.
+  *
+  *          usage: bench_serial [-d tx|stream|rx|echo|all] [-s chunk] [-t ms]
+  *                              [-p pass_us]
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <algorithm>
+#include <vector>
+#include "USBHostGiga.h"
+#include "sim_arduino.h"
+#include "usbh_sim_dev.h"
+
+#define BENCH_MAX_CHUNK        16384U
+
+enum BenchDirection
+{
+    BENCH_TX = 0,
+    BENCH_STREAM,
+    BENCH_RX,
+    BENCH_ECHO,
+    BENCH_IDLE,
+};
+
+static const char* const DirectionName[] = { "tx", "stream", "rx", "echo" };
+static const size_t SweepChunks[] = { 1, 4, 16, 64, 256, 1024, 4096 };
+
+static USBH_SIM_CdcDevTypeDef Device;
+static HostSerial SerialUsb;
+
+static uint8_t TxBuf[BENCH_MAX_CHUNK];
+static uint8_t RxBuf[BENCH_MAX_CHUNK];
+static BenchDirection Direction = BENCH_IDLE;
+static uint8_t Source;           // next byte sent, by the sketch or the device
+static uint8_t Expected;         // next byte the sketch should receive
+static uint64_t Errors;
+static std::vector<uint64_t> Latency;
+
+// The device side, before each USBH_Process() pass: drain what the host
+// sent, or keep data ready for it
+static void BenchDevice(void)
+{
+    if (Direction == BENCH_RX) {
+        while ((Device.Head - Device.Tail) < Device.Capacity) {
+            Device.Fifo[Device.Head % USBH_SIM_CDC_FIFO_SIZE] = Source++;
+            Device.Head++;
+        }
+    } else if (Direction != BENCH_ECHO) {
+        Device.Tail = Device.Head;
+    }
+}
+
+static void BenchCheck(const uint8_t* data, size_t length)
+{
+    for (size_t i = 0; i < length; i++) {
+        if (data[i] != Expected) {
+            Errors++;
+            Expected = data[i];
+        }
+        Expected++;
+    }
+}
+
+static void BenchFill(size_t chunk)
+{
+    for (size_t i = 0; i < chunk; i++) {
+        TxBuf[i] = Source++;
+    }
+}
+
+// Write and read back one chunk, as an echo sketch would
+static size_t BenchEcho(size_t chunk)
+{
+    size_t sent = 0;
+    size_t received = 0;
+
+    BenchFill(chunk);
+    while (received < chunk) {
+        if (sent < chunk) {
+            size_t len = std::min((size_t)SerialUsb.availableForWrite(), chunk - sent);
+            sent += SerialUsb.write(&TxBuf[sent], len);
+        }
+        // Blocks for one byte at least, which is when the USB side runs
+        size_t len = std::max((size_t)SerialUsb.available(), (size_t)1);
+        len = std::min(len, chunk - received);
+        size_t n = SerialUsb.readBytes(&RxBuf[received], len);
+        if (n == 0) {
+            break;
+        }
+        BenchCheck(&RxBuf[received], n);
+        received += n;
+    }
+    return received;
+}
+
+static double BenchCpuTime(void)
+{
+    struct timespec ts;
+
+    (void)clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+    return ((double)ts.tv_sec * 1e9) + (double)ts.tv_nsec;
+}
+
+static double BenchPercentile(unsigned percent)
+{
+    if (Latency.empty()) {
+        return 0.0;
+    }
+    size_t idx = ((Latency.size() - 1) * percent + 50) / 100;
+    return (double)Latency[idx] / 1e3;
+}
+
+// Discards whatever is still buffered on either side of the wrapper
+static void BenchDrain(void)
+{
+    const uint8_t* data;
+
+    Direction = BENCH_IDLE;
+    SerialUsb.flush();
+    for (int i = 0; i < 10; i++) {
+        delay(1);
+        size_t n;
+        while ((n = SerialUsb.peekSpan(&data)) != 0) {
+            SerialUsb.consume(n);
+        }
+    }
+    Device.Tail = Device.Head;
+}
+
+static int BenchRun(BenchDirection dir, size_t chunk, uint32_t time_ms)
+{
+    USBH_SIM_HostTypeDef* phc = USBH_SIM_GetHost();
+    uint64_t start = USBH_SIM_Now();
+    uint64_t end = start + USBH_SIM_MS(time_ms);
+    uint64_t urbs = phc->Stats.Urbs;
+    uint64_t passes = phc->Stats.Passes;
+    uint64_t bus = phc->Stats.BusTime;
+    double cpu = BenchCpuTime();
+    uint64_t bytes = 0;
+    int status = 0;
+
+    Direction = dir;
+    Expected = Source;
+    Latency.clear();
+
+    while (USBH_SIM_Now() < end) {
+        uint64_t t0 = USBH_SIM_Now();
+        size_t n;
+
+        if (dir == BENCH_TX || dir == BENCH_STREAM) {
+            BenchFill(chunk);
+            n = SerialUsb.write(TxBuf, chunk);
+            if (dir == BENCH_TX) {
+                SerialUsb.flush();
+            }
+        } else if (dir == BENCH_RX) {
+            n = SerialUsb.readBytes(RxBuf, chunk);
+            BenchCheck(RxBuf, n);
+        } else {
+            n = BenchEcho(chunk);
+        }
+
+        Latency.push_back(USBH_SIM_Now() - t0);
+        bytes += n;
+        if (n != chunk) {
+            fprintf(stderr, "%s,%u: %u of %u bytes moved\n", DirectionName[dir], (unsigned)chunk,
+                    (unsigned)n, (unsigned)chunk);
+            status = -1;
+            break;
+        }
+    }
+
+    if (dir == BENCH_STREAM) {
+        SerialUsb.flush();
+    }
+    end = USBH_SIM_Now();
+    cpu = BenchCpuTime() - cpu;
+    double seconds = (double)(end - start) / 1e9;
+    std::sort(Latency.begin(), Latency.end());
+
+    printf("%s,%u,%llu,%.1f,%.1f,%u,%.1f,%.1f,%.1f,%.1f,%.1f,%llu,%llu,%.1f\n",
+           DirectionName[dir], (unsigned)chunk, (unsigned long long)bytes, seconds * 1e3,
+           (double)bytes / seconds / 1e3, (unsigned)Latency.size(), BenchPercentile(50),
+           BenchPercentile(90), BenchPercentile(99), BenchPercentile(100),
+           (bytes != 0) ? (cpu / (double)bytes) : 0.0,
+           (unsigned long long)(phc->Stats.Urbs - urbs),
+           (unsigned long long)(phc->Stats.Passes - passes),
+           (double)(phc->Stats.BusTime - bus) * 100.0 / (double)(end - start));
+
+    BenchDrain();
+    return (bytes == 0) ? -1 : status;
+}
+
+int main(int argc, char** argv)
+{
+    USBH_SIM_ConfigTypeDef cfg;
+    const char* which = "all";
+    uint32_t time_ms = 200;
+    size_t chunk = 0;
+    int status = 0;
+
+    USBH_SIM_GetDefaultConfig(&cfg);
+
+    for (int idx = 1; idx < argc; idx++) {
+        if ((strcmp(argv[idx], "-d") == 0) && ((idx + 1) < argc)) {
+            which = argv[++idx];
+        } else if ((strcmp(argv[idx], "-s") == 0) && ((idx + 1) < argc)) {
+            chunk = strtoul(argv[++idx], NULL, 0);
+            if ((chunk == 0) || (chunk > BENCH_MAX_CHUNK)) {
+                fprintf(stderr, "chunk must be 1 to %u bytes\n", (unsigned)BENCH_MAX_CHUNK);
+                return 2;
+            }
+        } else if ((strcmp(argv[idx], "-t") == 0) && ((idx + 1) < argc)) {
+            time_ms = (uint32_t)strtoul(argv[++idx], NULL, 0);
+        } else if ((strcmp(argv[idx], "-p") == 0) && ((idx + 1) < argc)) {
+            cfg.PassTime = (uint32_t)USBH_SIM_US(strtoul(argv[++idx], NULL, 0));
+        } else {
+            fprintf(stderr, "usage: %s [-d tx|stream|rx|echo|all] [-s chunk] [-t ms] [-p pass_us]\n",
+                    argv[0]);
+            return 2;
+        }
+    }
+
+    USBH_SIM_CdcInit(&Device);
+    USBH_SIM_Configure(&cfg);
+    USBH_SIM_ArduinoSetup(&Device.Dev, BenchDevice);
+
+    // Polls the host until the loopback is running its class
+    SerialUsb.begin(115200, 0);
+
+    printf("direction,chunk,bytes,time_ms,kB_s,transfers,lat_p50_us,lat_p90_us,lat_p99_us,"
+           "lat_max_us,cpu_ns_per_byte,urbs,passes,bus_pct\n");
+
+    for (int dir = BENCH_TX; dir <= BENCH_ECHO; dir++) {
+        if ((strcmp(which, "all") != 0) && (strcmp(which, DirectionName[dir]) != 0)) {
+            continue;
+        }
+        if (chunk != 0) {
+            status |= BenchRun((BenchDirection)dir, chunk, time_ms);
+        } else {
+            for (size_t size : SweepChunks) {
+                status |= BenchRun((BenchDirection)dir, size, time_ms);
+            }
+        }
+    }
+
+    if (Errors != 0) {
+        fprintf(stderr, "%llu bytes received out of sequence\n", (unsigned long long)Errors);
+        status = -1;
+    }
+
+    return (status == 0) ? 0 : 1;
+}
@@ -0,0 +1,74 @@
+/**
+  ******************************************************************************
+  * @file    Arduino.h
+  * @brief   Host-side stand-in for the Arduino core header, used only by the
+  *          USB host simulator build (extras/sim) to compile USBHostGiga.cpp.
+  *          delay() and millis() run on the simulator's virtual time, see
+  *          sim_arduino.cpp.
+  ******************************************************************************
+  */
+
+#ifndef ARDUINO_SIM_H
+#define ARDUINO_SIM_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+void delay(unsigned long ms);
+unsigned long millis(void);
+
+namespace arduino {
+
+class Print
+{
+  public:
+    virtual ~Print() {}
+    virtual size_t write(uint8_t c) = 0;
+    virtual size_t write(const uint8_t* buffer, size_t size) {
+        size_t n = 0;
+        while (size-- != 0) {
+            n += write(*buffer++);
+        }
+        return n;
+    }
+    size_t write(const char* str) {
+        return write((const uint8_t*)str, strlen(str));
+    }
+    size_t write(const char* buffer, size_t size) {
+        return write((const uint8_t*)buffer, size);
+    }
+    virtual int availableForWrite() {
+        return 0;
+    }
+    virtual void flush() {}
+};
+
+class Stream : public Print
+{
+  public:
+    virtual int available() = 0;
+    virtual int read() = 0;
+    virtual int peek() = 0;
+    void setTimeout(unsigned long timeout) {
+        _timeout = timeout;
+    }
+
+  protected:
+    unsigned long _timeout = 1000;
+};
+
+class HardwareSerial : public Stream
+{
+  public:
+    virtual void begin(unsigned long baudrate) = 0;
+    virtual void begin(unsigned long baudrate, uint16_t config) = 0;
+    virtual void end() = 0;
+    virtual operator bool() = 0;
+};
+
+}
+
+using namespace arduino;
+
+#endif /* ARDUINO_SIM_H */
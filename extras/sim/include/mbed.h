@@ -0,0 +1,61 @@
+/**
+  ******************************************************************************
+  * @file    mbed.h
+  * @brief   Host-side stand-in for the Mbed OS header, used only by the USB
+  *          host simulator build (extras/sim) to compile USBHostGiga.cpp.
+  *          The simulator runs the stack and the sketch on one thread:
+  *          waiting on an EventFlags polls the host until a flag is set or
+  *          the virtual timeout expires, see sim_arduino.cpp.
+  ******************************************************************************
+  */
+
+#ifndef MBED_SIM_H
+#define MBED_SIM_H
+
+#include <stdint.h>
+#include <chrono>
+#include <mutex>
+
+namespace rtos {
+
+class Mutex
+{
+  public:
+    void lock() {
+        _mut.lock();
+    }
+    void unlock() {
+        _mut.unlock();
+    }
+    bool trylock() {
+        return _mut.try_lock();
+    }
+
+  private:
+    std::mutex _mut;
+};
+
+class EventFlags
+{
+  public:
+    uint32_t set(uint32_t flags) {
+        _flags |= flags;
+        return _flags;
+    }
+    uint32_t clear(uint32_t flags = 0x7FFFFFFFU) {
+        uint32_t ret = _flags;
+        _flags &= ~flags;
+        return ret;
+    }
+    uint32_t get() const {
+        return _flags;
+    }
+    uint32_t wait_any_for(uint32_t flags, std::chrono::milliseconds rel_time, bool clear = true);
+
+  private:
+    uint32_t _flags = 0;
+};
+
+}
+
+#endif /* MBED_SIM_H */
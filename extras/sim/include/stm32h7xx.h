@@ -0,0 +1,24 @@
+/**
+  ******************************************************************************
+  * @file    stm32h7xx.h
+  * @brief   Host-side stand-in for the CMSIS device header, used only by the
+  *          USB host simulator build (extras/sim). It provides the handful of
+  *          CMSIS/HAL definitions the portable USBH sources rely on.
+  ******************************************************************************
+  */
+
+#ifndef STM32H7XX_SIM_H
+#define STM32H7XX_SIM_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifndef __IO
+#define __IO    volatile
+#endif /* __IO */
+
+#ifndef UNUSED
+#define UNUSED(X) (void)X
+#endif /* UNUSED */
+
+#endif /* STM32H7XX_SIM_H */
@@ -0,0 +1,22 @@
+/**
+  ******************************************************************************
+  * @file    stm32h7xx_hal.h
+  * @brief   Host-side stand-in for the HAL header, used only by the USB host
+  *          simulator build (extras/sim).
+  ******************************************************************************
+  */
+
+#ifndef STM32H7XX_HAL_SIM_H
+#define STM32H7XX_HAL_SIM_H
+
+#include "stm32h7xx.h"
+
+typedef enum
+{
+  HAL_OK       = 0x00U,
+  HAL_ERROR    = 0x01U,
+  HAL_BUSY     = 0x02U,
+  HAL_TIMEOUT  = 0x03U
+} HAL_StatusTypeDef;
+
+#endif /* STM32H7XX_HAL_SIM_H */
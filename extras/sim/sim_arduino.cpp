@@ -0,0 +1,103 @@
+/**
+  ******************************************************************************
+  * @file    sim_arduino.cpp
+  * @brief   Replaces usb_host.c and the Arduino and Mbed OS runtime for the
+  *          wrapper (USBHostGiga.cpp) on the simulated host controller.
+  *
+  *          There is no USBH thread: whenever the sketch blocks, in delay()
+  *          or on an EventFlags, the host is polled in its place, so the
+  *          class callbacks run inside the sketch's wait as they would run
+  *          alongside it on the board. millis() is virtual time.
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "Arduino.h"
+#include "mbed.h"
+#include "sim_arduino.h"
+#include "usb_host.h"
+#include "usbh_hid.h"
+#include "usbh_cdc.h"
+
+// osFlagsErrorTimeout
+#define SIM_FLAGS_TIMEOUT 0xFFFFFFFEU
+
+USBH_HandleTypeDef hUsbHostHS;
+
+static USBH_SIM_DeviceTypeDef* _device = nullptr;
+static void (*_hook)(void) = nullptr;
+static bool _begun = false;
+
+extern "C" void Error_Handler(void);
+
+static void USBH_UserProcess(USBH_HandleTypeDef* phost, uint8_t id)
+{
+    if (id == HOST_USER_DISCONNECTION) {
+        USBH_UserDisconnection(phost);
+    }
+}
+
+void USBH_SIM_ArduinoSetup(USBH_SIM_DeviceTypeDef* pdev, void (*hook)(void))
+{
+    _device = pdev;
+    _hook = hook;
+}
+
+void USBH_SIM_ArduinoPoll(void)
+{
+    if (_hook != nullptr) {
+        _hook();
+    }
+    USBH_SIM_Poll(&hUsbHostHS);
+}
+
+extern "C" void MX_USB_HOST_Init(void)
+{
+    if (_begun) {
+        return;
+    }
+    if (USBH_Init(&hUsbHostHS, USBH_UserProcess, 0U) != USBH_OK ||
+        USBH_RegisterClass(&hUsbHostHS, USBH_HID_CLASS) != USBH_OK ||
+        USBH_RegisterClass(&hUsbHostHS, USBH_CDC_CLASS) != USBH_OK) {
+        Error_Handler();
+        return;
+    }
+    if (_device != nullptr) {
+        USBH_SIM_Attach(&hUsbHostHS, _device);
+    }
+    (void)USBH_Start(&hUsbHostHS);
+    _begun = true;
+}
+
+void delay(unsigned long ms)
+{
+    uint64_t end = USBH_SIM_Now() + USBH_SIM_MS(ms);
+
+    while (USBH_SIM_Now() < end) {
+        USBH_SIM_ArduinoPoll();
+    }
+}
+
+unsigned long millis(void)
+{
+    return (unsigned long)(USBH_SIM_Now() / USBH_SIM_MS(1U));
+}
+
+uint32_t rtos::EventFlags::wait_any_for(uint32_t flags, std::chrono::milliseconds rel_time, bool clear)
+{
+    uint64_t end = USBH_SIM_Now() + USBH_SIM_MS(rel_time.count());
+
+    for (;;) {
+        uint32_t ret = _flags;
+        if ((ret & flags) != 0) {
+            if (clear) {
+                _flags &= ~flags;
+            }
+            return ret;
+        }
+        if (USBH_SIM_Now() >= end) {
+            return SIM_FLAGS_TIMEOUT;
+        }
+        USBH_SIM_ArduinoPoll();
+    }
+}
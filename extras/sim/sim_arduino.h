@@ -0,0 +1,26 @@
+/**
+  ******************************************************************************
+  * @file    sim_arduino.h
+  * @brief   Header file for sim_arduino.cpp: runs the Arduino wrapper
+  *          (USBHostGiga.cpp) on the simulated host controller.
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __SIM_ARDUINO_H
+#define __SIM_ARDUINO_H
+
+/* Includes ------------------------------------------------------------------*/
+#include "usbh_sim.h"
+
+/* The handle MX_USB_HOST_Init() starts, as in usb_host.c */
+extern "C" USBH_HandleTypeDef hUsbHostHS;
+
+/* Device MX_USB_HOST_Init() attaches to the root port, and a hook run before
+   each USBH_Process() pass to play the device side */
+void USBH_SIM_ArduinoSetup(USBH_SIM_DeviceTypeDef *pdev, void (*hook)(void));
+
+/* One pass of the hook and of USBH_Process(), as the USBH thread would run */
+void USBH_SIM_ArduinoPoll(void);
+
+#endif /* __SIM_ARDUINO_H */
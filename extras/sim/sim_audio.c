@@ -0,0 +1,180 @@
+/**
+  ******************************************************************************
+  * @file    sim_audio.c
+  * @brief   A UAC1 microphone on the root port: the audio class selects the
+  *          streaming alternate setting at 48 kHz and the application reads
+  *          the PCM ring every few milliseconds. Checks that two seconds of
+  *          stereo 16-bit audio arrive without a missing or repeated sample,
+  *          then that a reader falling behind is reported as ring overruns.
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdio.h>
+#include "usbh_sim_dev.h"
+#include "usbh_audio.h"
+
+#define SIM_RATE          48000U
+#define SIM_STREAM_TIME   2000U     /* ms */
+#define SIM_READ_PERIOD   4U        /* ms between two reads */
+#define SIM_STALL_TIME    40U       /* ms without reading, more than the ring holds */
+#define SIM_TIMEOUT       USBH_SIM_MS(5000U)
+
+static USBH_HandleTypeDef hUsbHost;
+static USBH_SIM_AudioDevTypeDef Microphone;
+static uint8_t ClassActive;
+
+/* Continuity of the samples read: the left channel counts them */
+static uint8_t Started;
+static uint16_t Expected;
+static uint64_t SamplesRead;
+static uint64_t SamplesLost;
+static uint32_t Gaps;
+static uint32_t BadSamples;
+
+static void UserProcess(USBH_HandleTypeDef *phost, uint8_t id)
+{
+  UNUSED(phost);
+
+  if (id == HOST_USER_CLASS_ACTIVE)
+  {
+    ClassActive = 1U;
+  }
+}
+
+static void Check(const uint8_t *pbuf, uint32_t length)
+{
+  uint32_t pos;
+  uint16_t left;
+  uint16_t right;
+
+  for (pos = 0U; (pos + 4U) <= length; pos += 4U)
+  {
+    left = (uint16_t)(pbuf[pos] | (pbuf[pos + 1U] << 8));
+    right = (uint16_t)(pbuf[pos + 2U] | (pbuf[pos + 3U] << 8));
+
+    if ((uint16_t)(left ^ right) != 0xFFFFU)
+    {
+      BadSamples++;
+    }
+
+    if ((Started != 0U) && (left != Expected))
+    {
+      Gaps++;
+      SamplesLost += (uint16_t)(left - Expected);
+    }
+
+    Started = 1U;
+    Expected = (uint16_t)(left + 1U);
+    SamplesRead++;
+  }
+}
+
+static void Stream(uint32_t time, uint32_t period)
+{
+  static uint8_t buf[USBH_AUDIO_RING_SIZE];
+  uint64_t end = USBH_SIM_Now() + USBH_SIM_MS(time);
+  uint64_t next = USBH_SIM_Now() + USBH_SIM_MS(period);
+
+  while (USBH_SIM_Now() < end)
+  {
+    USBH_SIM_Poll(&hUsbHost);
+
+    if (USBH_SIM_Now() >= next)
+    {
+      next += USBH_SIM_MS(period);
+      Check(buf, USBH_AUDIO_Read(&hUsbHost, buf, sizeof(buf)));
+    }
+  }
+
+  /* A packet the device already sent goes to the ring */
+  (void)USBH_Process(&hUsbHost);
+}
+
+int main(void)
+{
+  const AUDIO_StatsTypeDef *pstats;
+  AUDIO_FormatTypeDef format;
+  uint64_t deadline;
+  uint64_t sent;
+  uint32_t overruns;
+  int failed = 0;
+
+  USBH_SIM_MicrophoneInit(&Microphone);
+
+  (void)USBH_Init(&hUsbHost, UserProcess, 0U);
+  (void)USBH_RegisterClass(&hUsbHost, USBH_AUDIO_CLASS);
+  USBH_SIM_Attach(&hUsbHost, &Microphone.Dev);
+  (void)USBH_Start(&hUsbHost);
+
+  deadline = USBH_SIM_Now() + SIM_TIMEOUT;
+  while ((ClassActive == 0U) && (USBH_SIM_Now() < deadline))
+  {
+    USBH_SIM_Poll(&hUsbHost);
+  }
+
+  if ((ClassActive == 0U) || (USBH_AUDIO_GetFormat(&hUsbHost, &format) != USBH_OK))
+  {
+    printf("enumeration did not complete (gState %d, EnumState %d)\n",
+           (int)hUsbHost.gState, (int)hUsbHost.EnumState);
+    return 1;
+  }
+
+  printf("device    : %04X:%04X, address %u\n",
+         hUsbHost.device.DevDesc.idVendor, hUsbHost.device.DevDesc.idProduct,
+         hUsbHost.device.address);
+  printf("format    : %u Hz, %u channels, %u bits, device set to %u Hz\n",
+         (unsigned)format.Frequency, format.Channels, format.BitResolution,
+         (unsigned)Microphone.Frequency);
+
+  if ((format.Frequency != SIM_RATE) || (Microphone.Frequency != SIM_RATE))
+  {
+    failed = 1;
+  }
+
+  /* Reading every few milliseconds keeps up with the stream */
+  Stream(SIM_STREAM_TIME, SIM_READ_PERIOD);
+  pstats = USBH_AUDIO_GetStats(&hUsbHost);
+  sent = Microphone.Samples;
+
+  printf("stream    : %llu samples read of %llu sent in %u ms, %u gaps, %u bad\n",
+         (unsigned long long)SamplesRead, (unsigned long long)sent,
+         (unsigned)SIM_STREAM_TIME, (unsigned)Gaps, (unsigned)BadSamples);
+  printf("packets   : %u, %u empty, %u dropped, %u overruns\n",
+         (unsigned)pstats->Packets, (unsigned)pstats->Empty, (unsigned)pstats->Dropped,
+         (unsigned)pstats->Overruns);
+  printf("ring      : %u of %u bytes at most (%.1f ms)\n",
+         (unsigned)pstats->MaxFill, (unsigned)USBH_AUDIO_RING_SIZE,
+         (double)pstats->MaxFill * 1000.0 / (SIM_RATE * 4.0));
+  printf("schedule  : %u transfers, %u skipped, %u frames of lag at most\n",
+         (unsigned)hUsbHost.pPort->PeriodicStats.Issued, (unsigned)hUsbHost.pPort->PeriodicStats.Skipped,
+         (unsigned)hUsbHost.pPort->PeriodicStats.MaxLag);
+
+  /* The samples not read yet are still in the ring */
+  if ((Gaps != 0U) || (BadSamples != 0U) || (pstats->Dropped != 0U) ||
+      (pstats->Overruns != 0U) || ((SamplesRead + (USBH_AUDIO_GetFill(&hUsbHost) / 4U)) != sent) ||
+      (SamplesRead < ((SIM_RATE / 1000U) * (SIM_STREAM_TIME - 10U))))
+  {
+    failed = 1;
+  }
+
+  /* A reader falling behind loses whole packets, counted as overruns */
+  overruns = pstats->Overruns;
+  Stream(SIM_STALL_TIME, SIM_STALL_TIME);
+  Stream(100U, SIM_READ_PERIOD);
+
+  printf("stalled   : %u ms without reading, %u overruns, %llu samples lost in %u gaps\n",
+         (unsigned)SIM_STALL_TIME, (unsigned)(pstats->Overruns - overruns),
+         (unsigned long long)SamplesLost, (unsigned)Gaps);
+
+  if ((pstats->Overruns == overruns) || (Gaps == 0U) || (BadSamples != 0U) ||
+      (pstats->Dropped != 0U) ||
+      ((SamplesRead + SamplesLost + (USBH_AUDIO_GetFill(&hUsbHost) / 4U)) != Microphone.Samples))
+  {
+    failed = 1;
+  }
+
+  printf("%s\n", (failed == 0) ? "PASS" : "FAIL");
+
+  return failed;
+}
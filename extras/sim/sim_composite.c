@@ -0,0 +1,260 @@
+/**
+  ******************************************************************************
+  * @file    sim_composite.c
+  * @brief   A composite terminal on the host port: a CDC-ACM serial function
+  *          and a boot keyboard behind one address. Checks that both classes
+  *          start, each on its own interface, that the serial echo runs
+  *          at the same rate whether the keyboard is typing or not, and
+  *          that the product string reads back as UTF-8.
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdio.h>
+#include <string.h>
+#include "usbh_sim_dev.h"
+#include "usbh_hid.h"
+#include "usbh_cdc.h"
+
+#define SIM_KEYBOARD_TEXT "Hello from the terminal\n"
+#define SIM_PRODUCT_UTF8  "Virtual Terminal \xE2\x80\x93 \xC2\xB5" "C"
+#define SIM_ECHO_SIZE     2048U
+#define SIM_ECHO_CHUNK    256U
+#define SIM_ECHO_TIME     USBH_SIM_MS(500U)
+#define SIM_TIMEOUT       USBH_SIM_MS(10000U)
+
+/* Keyboard traffic may cost the serial function some bus time, not more */
+#define SIM_MAX_SLOWDOWN  1.05
+
+static USBH_HandleTypeDef hUsbHost;
+static USBH_SIM_CompositeDevTypeDef Terminal;
+
+static uint32_t Active;
+static char Typed[64];
+static uint32_t TypedLen;
+static uint8_t TxBuf[SIM_ECHO_SIZE];
+static uint8_t RxBuf[SIM_ECHO_SIZE];
+static uint32_t TxDone;
+static uint32_t RxDone;
+static uint32_t RxLen;
+static char Product[64];
+static USBH_StatusTypeDef ProductStatus = USBH_BUSY;
+
+static void UserProcess(USBH_HandleTypeDef *phost, uint8_t id)
+{
+  UNUSED(phost);
+
+  if (id == HOST_USER_CLASS_ACTIVE)
+  {
+    Active++;
+  }
+}
+
+void USBH_HID_EventCallback(USBH_HandleTypeDef *phost)
+{
+  HID_KEYBD_Info_TypeDef *info;
+  uint8_t c;
+
+  info = USBH_HID_GetKeybdInfo(phost);
+  if (info == NULL)
+  {
+    return;
+  }
+
+  c = USBH_HID_GetASCIICode(info);
+  if ((c != 0U) && (TypedLen < (sizeof(Typed) - 1U)))
+  {
+    Typed[TypedLen] = (char)c;
+    TypedLen++;
+  }
+}
+
+void USBH_StringCallback(USBH_HandleTypeDef *phost, uint8_t string_index,
+                         USBH_StatusTypeDef status)
+{
+  UNUSED(phost);
+  UNUSED(string_index);
+
+  ProductStatus = status;
+}
+
+void USBH_CDC_TransmitCallback(USBH_HandleTypeDef *phost)
+{
+  UNUSED(phost);
+
+  TxDone = 1U;
+}
+
+void USBH_CDC_ReceiveCallback(USBH_HandleTypeDef *phost)
+{
+  RxLen += USBH_CDC_GetLastReceivedDataSize(phost);
+  RxDone = 1U;
+}
+
+/* Send SIM_ECHO_SIZE bytes through the loopback, return the virtual time
+   until the last byte came back, 0 on timeout or data mismatch */
+static uint64_t Echo(USBH_HandleTypeDef *pcdc)
+{
+  uint64_t start = USBH_SIM_Now();
+  uint32_t sent = SIM_ECHO_CHUNK;
+  uint32_t idx;
+
+  for (idx = 0U; idx < SIM_ECHO_SIZE; idx++)
+  {
+    TxBuf[idx] = (uint8_t)(idx * 7U);
+  }
+  (void)memset(RxBuf, 0, sizeof(RxBuf));
+  TxDone = 0U;
+  RxDone = 0U;
+  RxLen = 0U;
+
+  (void)USBH_CDC_Transmit(pcdc, TxBuf, SIM_ECHO_CHUNK);
+  (void)USBH_CDC_Receive(pcdc, RxBuf, SIM_ECHO_CHUNK);
+
+  while ((RxLen < SIM_ECHO_SIZE) && ((USBH_SIM_Now() - start) < SIM_TIMEOUT))
+  {
+    USBH_SIM_Poll(&hUsbHost);
+
+    if ((TxDone != 0U) && (sent < SIM_ECHO_SIZE))
+    {
+      TxDone = 0U;
+      (void)USBH_CDC_Transmit(pcdc, &TxBuf[sent], SIM_ECHO_CHUNK);
+      sent += SIM_ECHO_CHUNK;
+    }
+
+    if ((RxDone != 0U) && (RxLen < SIM_ECHO_SIZE))
+    {
+      RxDone = 0U;
+      (void)USBH_CDC_Receive(pcdc, &RxBuf[RxLen], SIM_ECHO_SIZE - RxLen);
+    }
+  }
+
+  if ((RxLen != SIM_ECHO_SIZE) || (memcmp(TxBuf, RxBuf, SIM_ECHO_SIZE) != 0))
+  {
+    return 0U;
+  }
+
+  return USBH_SIM_Now() - start;
+}
+
+/* Echo rounds until the keyboard queue is drained and at least
+   SIM_ECHO_TIME has passed, return the echo rate in bytes per ms */
+static double EchoRate(void)
+{
+  USBH_HandleTypeDef *pcdc = USBH_FindDevice(&hUsbHost, USB_CDC_CLASS, 0U);
+  uint64_t start = USBH_SIM_Now();
+  uint64_t busy = 0U;
+  uint64_t bytes = 0U;
+  uint64_t time;
+
+  while ((pcdc != NULL) && (((USBH_SIM_Now() - start) < SIM_ECHO_TIME) ||
+                            (USBH_SIM_HidPending(&Terminal.Kbd) != 0U)))
+  {
+    time = Echo(pcdc);
+    if (time == 0U)
+    {
+      return 0.0;
+    }
+    busy += time;
+    bytes += SIM_ECHO_SIZE;
+  }
+
+  return (busy != 0U) ? ((double)bytes * 1e6 / (double)busy) : 0.0;
+}
+
+int main(void)
+{
+  USBH_HandleTypeDef *pcdc;
+  USBH_HandleTypeDef *pkbd;
+  uint64_t deadline;
+  double alone;
+  double shared;
+  int failed = 0;
+
+  USBH_SIM_CompositeInit(&Terminal);
+
+  (void)USBH_Init(&hUsbHost, UserProcess, 0U);
+  (void)USBH_RegisterClass(&hUsbHost, USBH_HID_CLASS);
+  (void)USBH_RegisterClass(&hUsbHost, USBH_CDC_CLASS);
+  USBH_SIM_Attach(&hUsbHost, &Terminal.Dev);
+  (void)USBH_Start(&hUsbHost);
+
+  deadline = USBH_SIM_Now() + SIM_TIMEOUT;
+  while ((Active < 2U) && (USBH_SIM_Now() < deadline))
+  {
+    USBH_SIM_Poll(&hUsbHost);
+  }
+
+  pcdc = USBH_FindDevice(&hUsbHost, USB_CDC_CLASS, 0U);
+  pkbd = USBH_FindDevice(&hUsbHost, USB_HID_CLASS, 0U);
+  if ((pcdc == NULL) || (pkbd == NULL) || (pcdc == pkbd))
+  {
+    printf("only %u of 2 functions started\n", (unsigned)Active);
+    return 1;
+  }
+
+  printf("functions : %s on interface %u, %s on interface %u, address %u\n",
+         pcdc->pActiveClass->Name, USBH_CURRENT_ITF_NUMBER(pcdc),
+         pkbd->pActiveClass->Name, USBH_CURRENT_ITF_NUMBER(pkbd), pkbd->device.address);
+
+  if ((pcdc->device.address != pkbd->device.address) ||
+      (USBH_HID_GetDeviceType(pkbd) != HID_KEYBOARD))
+  {
+    failed = 1;
+  }
+
+  /* Product string, read from the device or from the descriptor cache */
+  if (USBH_GetString(pkbd, pkbd->device.DevDesc.iProduct, Product, sizeof(Product)) == USBH_OK)
+  {
+    ProductStatus = USBH_OK;
+  }
+  deadline = USBH_SIM_Now() + SIM_TIMEOUT;
+  while ((ProductStatus == USBH_BUSY) && (USBH_SIM_Now() < deadline))
+  {
+    USBH_SIM_Poll(&hUsbHost);
+  }
+
+  printf("product   : %s\n", Product);
+
+  if ((ProductStatus != USBH_OK) || (strcmp(Product, SIM_PRODUCT_UTF8) != 0))
+  {
+    failed = 1;
+  }
+
+  /* Serial echo alone, then while the keyboard types */
+  alone = EchoRate();
+
+  (void)USBH_SIM_KeyboardType(&Terminal.Kbd, SIM_KEYBOARD_TEXT);
+  shared = EchoRate();
+
+  USBH_SIM_Advance(&hUsbHost, USBH_SIM_MS(50U));
+  (void)USBH_Process(&hUsbHost);
+
+  printf("echo      : %.1f bytes/ms alone, %.1f bytes/ms while typing\n", alone, shared);
+  printf("keyboard  : %s", Typed);
+
+  if ((alone == 0.0) || (shared == 0.0) || ((shared * SIM_MAX_SLOWDOWN) < alone) ||
+      (strcmp(Typed, SIM_KEYBOARD_TEXT) != 0))
+  {
+    failed = 1;
+  }
+
+  /* Unplug: both functions stop */
+  USBH_SIM_Detach(&hUsbHost);
+  USBH_SIM_Advance(&hUsbHost, USBH_SIM_MS(10U));
+  (void)USBH_Process(&hUsbHost);
+
+  printf("unplugged : %u CDC, %u HID functions left\n",
+         (USBH_FindDevice(&hUsbHost, USB_CDC_CLASS, 0U) != NULL) ? 1U : 0U,
+         (USBH_FindDevice(&hUsbHost, USB_HID_CLASS, 0U) != NULL) ? 1U : 0U);
+
+  if ((USBH_FindDevice(&hUsbHost, USB_CDC_CLASS, 0U) != NULL) ||
+      (USBH_FindDevice(&hUsbHost, USB_HID_CLASS, 0U) != NULL))
+  {
+    failed = 1;
+  }
+
+  printf("%s\n", (failed == 0) ? "PASS" : "FAIL");
+
+  return failed;
+}
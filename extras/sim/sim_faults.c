@@ -0,0 +1,202 @@
+/**
+  ******************************************************************************
+  * @file    sim_faults.c
+  * @brief   Control transfer recovery on the simulated controller: transaction
+  *          errors on the SETUP stage, a device that NAKs the data stage for
+  *          a while, then one that never answers. Checks that each request
+  *          ends, within the time the retry settings allow, and prints the
+  *          retry and timeout counters.
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdio.h>
+#include "usbh_sim_dev.h"
+#include "usbh_hid.h"
+
+#define SIM_TIMEOUT       USBH_SIM_MS(10000U)
+#define SIM_SETTLE_TIME   USBH_SIM_MS(50U)
+
+/* The device stops NAKing this long after the request started */
+#define SIM_NAK_TIME      USBH_SIM_MS(600U)
+
+static USBH_HandleTypeDef hUsbHost;
+static USBH_SIM_HidDevTypeDef Keyboard;
+static uint32_t Active;
+static uint32_t Unrecovered;
+static uint64_t UnrecoveredAt;
+static USBH_StatusTypeDef ReqStatus;
+static uint64_t ReqDoneAt;
+static uint8_t Config;
+
+static void UserProcess(USBH_HandleTypeDef *phost, uint8_t id)
+{
+  UNUSED(phost);
+
+  if (id == HOST_USER_CLASS_ACTIVE)
+  {
+    Active++;
+  }
+  else if (id == HOST_USER_UNRECOVERED_ERROR)
+  {
+    Unrecovered++;
+    UnrecoveredAt = USBH_SIM_Now();
+  }
+  else
+  {
+    /* .. */
+  }
+}
+
+static void ReqDone(USBH_HandleTypeDef *phost, USBH_StatusTypeDef status, void *pContext)
+{
+  UNUSED(phost);
+  UNUSED(pContext);
+
+  ReqStatus = status;
+  ReqDoneAt = USBH_SIM_Now();
+}
+
+/* Frames a request takes at most before it is given up: every attempt
+   times out and every retry waits its full delay */
+static uint32_t WorstCase(void)
+{
+  uint32_t frames = (USBH_MAX_ERROR_COUNT + 1U) * USBH_CTL_TIMEOUT;
+  uint32_t delay = USBH_CTL_RETRY_DELAY;
+  uint32_t idx;
+
+  for (idx = 0U; idx < USBH_MAX_ERROR_COUNT; idx++)
+  {
+    frames += (delay < USBH_CTL_RETRY_DELAY_MAX) ? delay : USBH_CTL_RETRY_DELAY_MAX;
+    delay <<= 1;
+  }
+
+  return frames;
+}
+
+/* GET_CONFIGURATION through the control queue. The device faults are
+   cleared clear_after into the request, return the time it took */
+static uint64_t Request(const char *name, uint64_t clear_after)
+{
+  USB_Setup_TypeDef setup = {0};
+  USBH_CtlStatsTypeDef before = hUsbHost.CtlStats;
+  uint64_t start = USBH_SIM_Now();
+  uint64_t deadline = start + SIM_TIMEOUT;
+
+  setup.b.bmRequestType = USB_D2H | USB_REQ_RECIPIENT_DEVICE | USB_REQ_TYPE_STANDARD;
+  setup.b.bRequest = USB_REQ_GET_CONFIGURATION;
+  setup.b.wLength.w = 1U;
+
+  Config = 0U;
+  ReqStatus = USBH_BUSY;
+  (void)USBH_CtlSubmit(&hUsbHost, &setup, &Config, ReqDone, NULL);
+
+  while ((ReqStatus == USBH_BUSY) && (USBH_SIM_Now() < deadline))
+  {
+    USBH_SIM_Poll(&hUsbHost);
+
+    if ((USBH_SIM_Now() - start) >= clear_after)
+    {
+      USBH_SIM_ClearFaults(&Keyboard.Dev);
+    }
+  }
+
+  printf("%-9s : status %d after %.1f ms, %lu retries, %lu timeouts, %lu aborts\n",
+         name, (int)ReqStatus, (double)(ReqDoneAt - start) / 1e6,
+         (unsigned long)(hUsbHost.CtlStats.Retries - before.Retries),
+         (unsigned long)(hUsbHost.CtlStats.Timeouts - before.Timeouts),
+         (unsigned long)(hUsbHost.CtlStats.Aborts - before.Aborts));
+
+  return ReqDoneAt - start;
+}
+
+/* Wait for the class to start and run its own first requests */
+static void WaitActive(uint32_t count)
+{
+  uint64_t deadline = USBH_SIM_Now() + SIM_TIMEOUT;
+
+  while ((Active < count) && (USBH_SIM_Now() < deadline))
+  {
+    USBH_SIM_Poll(&hUsbHost);
+  }
+
+  deadline = USBH_SIM_Now() + SIM_SETTLE_TIME;
+  while (USBH_SIM_Now() < deadline)
+  {
+    USBH_SIM_Poll(&hUsbHost);
+  }
+}
+
+int main(void)
+{
+  uint64_t bound = USBH_SIM_MS(WorstCase());
+  uint64_t start;
+  uint64_t time;
+  int failed = 0;
+
+  USBH_SIM_KeyboardInit(&Keyboard);
+
+  (void)USBH_Init(&hUsbHost, UserProcess, 0U);
+  (void)USBH_RegisterClass(&hUsbHost, USBH_HID_CLASS);
+  USBH_SIM_Attach(&hUsbHost, &Keyboard.Dev);
+  (void)USBH_Start(&hUsbHost);
+
+  WaitActive(1U);
+  if (Active != 1U)
+  {
+    printf("keyboard not started\n");
+    return 1;
+  }
+
+  printf("settings  : %u frames per attempt, %u retries, worst case %.1f ms\n",
+         (unsigned)USBH_CTL_TIMEOUT, (unsigned)USBH_MAX_ERROR_COUNT, (double)bound / 1e6);
+
+  /* Transaction errors on the SETUP stage, fewer than the retries */
+  (void)USBH_SIM_InjectFault(&Keyboard.Dev, 0x00U, USBH_SIM_TOKEN_SETUP, USBH_SIM_ERROR,
+                             0U, USBH_MAX_ERROR_COUNT);
+  time = Request("errors", USBH_SIM_NEVER);
+  if ((ReqStatus != USBH_OK) || (Config != 1U) || (time > bound))
+  {
+    failed = 1;
+  }
+
+  /* The data stage is NAKed past the first deadline, a retry gets it */
+  (void)USBH_SIM_InjectFault(&Keyboard.Dev, 0x80U, USBH_SIM_TOKEN_IN, USBH_SIM_NAK,
+                             0U, USBH_SIM_FOREVER);
+  time = Request("nak", SIM_NAK_TIME);
+  if ((ReqStatus != USBH_OK) || (Config != 1U) || (time > bound))
+  {
+    failed = 1;
+  }
+
+  /* No answer at all: the request is given up and the device reset */
+  (void)USBH_SIM_InjectFault(&Keyboard.Dev, 0x80U, USBH_SIM_TOKEN_IN, USBH_SIM_NAK,
+                             0U, USBH_SIM_FOREVER);
+  start = USBH_SIM_Now();
+  (void)Request("no answer", USBH_SIM_NEVER);
+  USBH_SIM_ClearFaults(&Keyboard.Dev);
+  if ((ReqStatus != USBH_TIMEOUT) || (Unrecovered != 1U) ||
+      ((UnrecoveredAt - start) > (bound + USBH_SIM_MS(1U))))
+  {
+    failed = 1;
+  }
+
+  /* The device answers again once reset */
+  WaitActive(2U);
+  printf("recovered : %s, given up after %.1f ms, class active again after %.1f ms\n",
+         (Active == 2U) ? "yes" : "no", (double)(UnrecoveredAt - start) / 1e6,
+         (double)(USBH_SIM_Now() - start - SIM_SETTLE_TIME) / 1e6);
+  if (Active != 2U)
+  {
+    failed = 1;
+  }
+
+  printf("counters  : %lu requests, %lu retries, %lu timeouts, %lu aborts, max %lu frames\n",
+         (unsigned long)hUsbHost.CtlStats.Requests, (unsigned long)hUsbHost.CtlStats.Retries,
+         (unsigned long)hUsbHost.CtlStats.Timeouts, (unsigned long)hUsbHost.CtlStats.Aborts,
+         (unsigned long)hUsbHost.CtlStats.MaxTime);
+
+  printf("%s\n", (failed == 0) ? "PASS" : "FAIL");
+
+  return failed;
+}
@@ -0,0 +1,389 @@
+/**
+  ******************************************************************************
+  * @file    sim_hub.c
+  * @brief   Several devices on the single host port through a hub: a
+  *          keyboard, a barcode scanner (a second keyboard), a USB-serial
+  *          adapter and mice. Checks that they all enumerate, that both
+  *          keyboards type at the same time, that the serial adapter echoes,
+  *          that control requests queued to every device meanwhile complete,
+  *          and that unplugging one device leaves the others running.
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdio.h>
+#include <string.h>
+#include "usbh_sim_dev.h"
+#include "usbh_hub.h"
+#include "usbh_hid.h"
+#include "usbh_cdc.h"
+
+#define SIM_HUB_PORTS     7U
+#define SIM_PORT_KEYBOARD 1U
+#define SIM_PORT_SCANNER  2U
+#define SIM_PORT_SERIAL   3U
+#define SIM_PORT_MOUSE    4U
+
+/* The root EP0 and the bulk endpoints of the serial adapter hold 4 host
+   channels, the interrupt endpoints borrow the others for each transfer */
+#define SIM_NUM_MICE      3U
+#define SIM_NUM_DEVICES   (3U + SIM_NUM_MICE)
+
+#define SIM_KEYBOARD_TEXT "The quick brown fox\n"
+#define SIM_SCANNER_TEXT  "4006381333931\n"
+#define SIM_SERIAL_TEXT   "AT+GMR\r\n"
+#define SIM_MOUSE_REPORTS 10U
+#define SIM_TIMEOUT       USBH_SIM_MS(10000U)
+#define SIM_CHANNEL_MASK  ((1UL << USBH_MAX_PIPES_NBR) - 1U)
+
+static USBH_HandleTypeDef hUsbHost;
+static USBH_SIM_HubDevTypeDef Hub;
+static USBH_SIM_HidDevTypeDef Keyboard;
+static USBH_SIM_HidDevTypeDef Scanner;
+static USBH_SIM_CdcDevTypeDef Serial;
+static USBH_SIM_HidDevTypeDef Mice[SIM_NUM_MICE];
+
+static uint32_t Active;
+static uint32_t Disconnected;
+static char Typed[SIM_HUB_PORTS + 1U][64];
+static uint32_t TypedLen[SIM_HUB_PORTS + 1U];
+static uint32_t MouseReports[SIM_HUB_PORTS + 1U];
+static uint8_t SerialRx[64];
+static uint32_t SerialRxLen;
+static uint8_t CtlConfig[SIM_HUB_PORTS + 1U];
+static uint8_t CtlString[64];
+static uint32_t CtlDone[USBH_TIMEOUT + 1U];
+
+static void UserProcess(USBH_HandleTypeDef *phost, uint8_t id)
+{
+  /* Only the devices behind the hub are counted */
+  if (phost->pParent == NULL)
+  {
+    return;
+  }
+
+  if (id == HOST_USER_CLASS_ACTIVE)
+  {
+    Active++;
+  }
+  else if (id == HOST_USER_DISCONNECTION)
+  {
+    Disconnected++;
+  }
+}
+
+void USBH_HID_EventCallback(USBH_HandleTypeDef *phost)
+{
+  HID_KEYBD_Info_TypeDef *info;
+  uint8_t port = phost->HubPort;
+  uint8_t c;
+
+  if (USBH_HID_GetDeviceType(phost) == HID_MOUSE)
+  {
+    if (USBH_HID_GetMouseInfo(phost) != NULL)
+    {
+      MouseReports[port]++;
+    }
+    return;
+  }
+
+  info = USBH_HID_GetKeybdInfo(phost);
+  if (info == NULL)
+  {
+    return;
+  }
+
+  c = USBH_HID_GetASCIICode(info);
+  if ((c != 0U) && (TypedLen[port] < (sizeof(Typed[port]) - 1U)))
+  {
+    Typed[port][TypedLen[port]] = (char)c;
+    TypedLen[port]++;
+  }
+}
+
+void USBH_CDC_ReceiveCallback(USBH_HandleTypeDef *phost)
+{
+  SerialRxLen += USBH_CDC_GetLastReceivedDataSize(phost);
+}
+
+static uint32_t CountDevices(uint8_t class_code)
+{
+  uint32_t count = 0U;
+
+  while (USBH_FindDevice(&hUsbHost, class_code, (uint8_t)count) != NULL)
+  {
+    count++;
+  }
+
+  return count;
+}
+
+static uint32_t CountPipes(uint32_t map)
+{
+  uint32_t count = 0U;
+
+  while (map != 0U)
+  {
+    map &= map - 1U;
+    count++;
+  }
+
+  return count;
+}
+
+static uint8_t RunUntil(uint32_t *counter, uint32_t value)
+{
+  uint64_t deadline = USBH_SIM_Now() + SIM_TIMEOUT;
+
+  while ((*counter < value) && (USBH_SIM_Now() < deadline))
+  {
+    USBH_SIM_Poll(&hUsbHost);
+  }
+
+  return (*counter >= value) ? 1U : 0U;
+}
+
+/* Completion of the requests queued while the devices run */
+static void CtlCallback(USBH_HandleTypeDef *phost, USBH_StatusTypeDef status, void *pContext)
+{
+  UNUSED(phost);
+  UNUSED(pContext);
+
+  CtlDone[status]++;
+}
+
+/* GET_CONFIGURATION to the hub and to every device behind it, and a string
+   descriptor the keyboard does not have, all queued at once */
+static uint32_t SubmitRequests(void)
+{
+  USB_Setup_TypeDef setup;
+  USBH_HandleTypeDef *pdev;
+  uint32_t count = 0U;
+  uint32_t port;
+
+  setup.b.bmRequestType = USB_D2H | USB_REQ_RECIPIENT_DEVICE | USB_REQ_TYPE_STANDARD;
+  setup.b.bRequest = USB_REQ_GET_CONFIGURATION;
+  setup.b.wValue.w = 0U;
+  setup.b.wIndex.w = 0U;
+  setup.b.wLength.w = 1U;
+
+  for (port = 0U; port <= SIM_HUB_PORTS; port++)
+  {
+    pdev = (port == 0U) ? &hUsbHost : USBH_HUB_GetPortDevice(&hUsbHost, (uint8_t)port);
+    if ((pdev != NULL) &&
+        (USBH_CtlSubmit(pdev, &setup, &CtlConfig[port], CtlCallback, NULL) == USBH_OK))
+    {
+      count++;
+    }
+  }
+
+  setup.b.bRequest = USB_REQ_GET_DESCRIPTOR;
+  setup.b.wValue.w = USB_DESC_STRING | 0x7FU;
+  setup.b.wIndex.w = 0x0409U;
+  setup.b.wLength.w = sizeof(CtlString);
+  pdev = USBH_HUB_GetPortDevice(&hUsbHost, SIM_PORT_KEYBOARD);
+  if ((pdev != NULL) && (USBH_CtlSubmit(pdev, &setup, CtlString, CtlCallback, NULL) == USBH_OK))
+  {
+    count++;
+  }
+
+  return count;
+}
+
+int main(void)
+{
+  USBH_HandleTypeDef *pdev;
+  uint8_t report[4] = { 0x00U, 0x01U, 0xFFU, 0x00U };
+  uint64_t start;
+  uint64_t deadline;
+  uint32_t pipes;
+  uint32_t queued;
+  uint32_t idx;
+  uint32_t port;
+  int failed = 0;
+
+  USBH_SIM_HubInit(&Hub, SIM_HUB_PORTS);
+  USBH_SIM_KeyboardInit(&Keyboard);
+  USBH_SIM_KeyboardInit(&Scanner);
+  USBH_SIM_CdcInit(&Serial);
+  (void)USBH_SIM_HubAttach(&Hub, SIM_PORT_KEYBOARD, &Keyboard.Dev);
+  (void)USBH_SIM_HubAttach(&Hub, SIM_PORT_SCANNER, &Scanner.Dev);
+  (void)USBH_SIM_HubAttach(&Hub, SIM_PORT_SERIAL, &Serial.Dev);
+  for (idx = 0U; idx < SIM_NUM_MICE; idx++)
+  {
+    USBH_SIM_MouseInit(&Mice[idx]);
+    (void)USBH_SIM_HubAttach(&Hub, (uint8_t)(SIM_PORT_MOUSE + idx), &Mice[idx].Dev);
+  }
+
+  (void)USBH_Init(&hUsbHost, UserProcess, 0U);
+  (void)USBH_RegisterClass(&hUsbHost, USBH_HUB_CLASS);
+  (void)USBH_RegisterClass(&hUsbHost, USBH_HID_CLASS);
+  (void)USBH_RegisterClass(&hUsbHost, USBH_CDC_CLASS);
+  USBH_SIM_Attach(&hUsbHost, &Hub.Dev);
+  (void)USBH_Start(&hUsbHost);
+
+  /* Enumeration of the hub and of every device behind it */
+  start = USBH_SIM_Now();
+  if (RunUntil(&Active, SIM_NUM_DEVICES) == 0U)
+  {
+    printf("only %u of %u devices enumerated\n", (unsigned)Active, (unsigned)SIM_NUM_DEVICES);
+    return 1;
+  }
+  printf("enumerated: %u devices behind the hub in %.3f ms of virtual time\n",
+         (unsigned)Active, (double)(USBH_SIM_Now() - start) / 1e6);
+
+  for (port = 1U; port <= SIM_HUB_PORTS; port++)
+  {
+    pdev = USBH_HUB_GetPortDevice(&hUsbHost, (uint8_t)port);
+    if (pdev != NULL)
+    {
+      printf("  port %u : %-4s %04X:%04X address %u, %s speed\n", (unsigned)port,
+             pdev->pActiveClass->Name, pdev->device.DevDesc.idVendor,
+             pdev->device.DevDesc.idProduct, pdev->device.address,
+             (pdev->device.speed == (uint8_t)USBH_SPEED_LOW) ? "low" : "full");
+    }
+  }
+  pipes = CountPipes(hUsbHost.pPort->PipeMap);
+  printf("  %u pipes, %u of them on a host channel of their own, %u frame timers in use\n",
+         (unsigned)pipes, (unsigned)CountPipes(hUsbHost.pPort->PipeMap & SIM_CHANNEL_MASK),
+         (unsigned)hUsbHost.pPort->TimerCount);
+
+  /* Both keyboards type while the mice move and the serial adapter echoes */
+  (void)USBH_SIM_KeyboardType(&Keyboard, SIM_KEYBOARD_TEXT);
+  (void)USBH_SIM_KeyboardType(&Scanner, SIM_SCANNER_TEXT);
+  for (idx = 0U; idx < SIM_NUM_MICE; idx++)
+  {
+    for (port = 0U; port < SIM_MOUSE_REPORTS; port++)
+    {
+      (void)USBH_SIM_HidPushReport(&Mice[idx], report, sizeof(report));
+    }
+  }
+
+  pdev = USBH_FindDevice(&hUsbHost, USB_CDC_CLASS, 0U);
+  if (pdev == NULL)
+  {
+    printf("serial adapter not found\n");
+    return 1;
+  }
+  queued = SubmitRequests();
+  (void)USBH_CDC_Transmit(pdev, (uint8_t *)SIM_SERIAL_TEXT, sizeof(SIM_SERIAL_TEXT) - 1U);
+
+  start = USBH_SIM_Now();
+  deadline = start + SIM_TIMEOUT;
+  while (((USBH_SIM_HidPending(&Keyboard) != 0U) || (USBH_SIM_HidPending(&Scanner) != 0U)) &&
+         (USBH_SIM_Now() < deadline))
+  {
+    USBH_SIM_Poll(&hUsbHost);
+  }
+  (void)USBH_CDC_Receive(pdev, SerialRx, sizeof(SerialRx));
+
+  /* Keep the host running while the echo comes back, the interrupt
+     endpoints stay polled */
+  deadline = USBH_SIM_Now() + USBH_SIM_MS(50U);
+  while (USBH_SIM_Now() < deadline)
+  {
+    USBH_SIM_Poll(&hUsbHost);
+  }
+
+  printf("keyboard  : %s", Typed[SIM_PORT_KEYBOARD]);
+  printf("scanner   : %s", Typed[SIM_PORT_SCANNER]);
+  printf("           %.3f ms to drain both keyboards\n", (double)(USBH_SIM_Now() - start) / 1e6);
+  printf("serial    : %u of %u bytes echoed\n", (unsigned)SerialRxLen,
+         (unsigned)(sizeof(SIM_SERIAL_TEXT) - 1U));
+  printf("control   : %u requests queued, %u done, %u stalled\n", (unsigned)queued,
+         (unsigned)CtlDone[USBH_OK], (unsigned)CtlDone[USBH_NOT_SUPPORTED]);
+  printf("schedule  : %lu polls, %lu skipped, max lag %lu frames, peak %lu of %u byte times, "
+         "%lu rejected\n",
+         (unsigned long)hUsbHost.pPort->PeriodicStats.Issued, (unsigned long)hUsbHost.pPort->PeriodicStats.Skipped,
+         (unsigned long)hUsbHost.pPort->PeriodicStats.MaxLag, (unsigned long)hUsbHost.pPort->PeriodicStats.PeakLoad,
+         (unsigned)USBH_PERIODIC_BUDGET, (unsigned long)hUsbHost.pPort->PeriodicStats.Rejected);
+  if (hUsbHost.pPort->PeriodicStats.Rejected != 0U)
+  {
+    failed = 1;
+  }
+#if (USBH_MAX_VPIPES_NBR > 0U)
+  printf("channels  : %lu transfers on %u host channels, %lu channel switches, %lu waited, "
+         "max jitter %lu frames, %lu late\n",
+         (unsigned long)hUsbHost.pPort->VPipeStats.Transfers, (unsigned)USBH_MAX_PIPES_NBR,
+         (unsigned long)hUsbHost.pPort->VPipeStats.Switches, (unsigned long)hUsbHost.pPort->VPipeStats.Waits,
+         (unsigned long)hUsbHost.pPort->VPipeStats.MaxJitter, (unsigned long)hUsbHost.pPort->VPipeStats.Late);
+  if (hUsbHost.pPort->VPipeStats.Late != 0U)
+  {
+    failed = 1;
+  }
+#endif /* (USBH_MAX_VPIPES_NBR > 0U) */
+
+  if ((queued != (SIM_NUM_DEVICES + 2U)) || (CtlDone[USBH_OK] != (SIM_NUM_DEVICES + 1U)) ||
+      (CtlDone[USBH_NOT_SUPPORTED] != 1U))
+  {
+    failed = 1;
+  }
+  port = 0U;
+  for (idx = 0U; idx <= SIM_HUB_PORTS; idx++)
+  {
+    port += (CtlConfig[idx] == 1U) ? 1U : 0U;
+  }
+  if (port != (SIM_NUM_DEVICES + 1U))
+  {
+    failed = 1;
+  }
+
+  if ((strcmp(Typed[SIM_PORT_KEYBOARD], SIM_KEYBOARD_TEXT) != 0) ||
+      (strcmp(Typed[SIM_PORT_SCANNER], SIM_SCANNER_TEXT) != 0) ||
+      (SerialRxLen != (sizeof(SIM_SERIAL_TEXT) - 1U)) ||
+      (memcmp(SerialRx, SIM_SERIAL_TEXT, SerialRxLen) != 0))
+  {
+    failed = 1;
+  }
+
+  for (idx = 0U; idx < SIM_NUM_MICE; idx++)
+  {
+    port = SIM_PORT_MOUSE + idx;
+    printf("mouse %u   : %u of %u reports\n", (unsigned)port, (unsigned)MouseReports[port],
+           (unsigned)SIM_MOUSE_REPORTS);
+    if (MouseReports[port] != SIM_MOUSE_REPORTS)
+    {
+      failed = 1;
+    }
+  }
+
+  /* Unplug the keyboard: the others keep running, its resources return */
+  (void)USBH_SIM_HubDetach(&Hub, SIM_PORT_KEYBOARD);
+  (void)RunUntil(&Disconnected, 1U);
+  TypedLen[SIM_PORT_SCANNER] = 0U;
+  (void)memset(Typed[SIM_PORT_SCANNER], 0, sizeof(Typed[SIM_PORT_SCANNER]));
+  (void)USBH_SIM_KeyboardType(&Scanner, SIM_SCANNER_TEXT);
+
+  deadline = USBH_SIM_Now() + SIM_TIMEOUT;
+  while ((USBH_SIM_HidPending(&Scanner) != 0U) && (USBH_SIM_Now() < deadline))
+  {
+    USBH_SIM_Poll(&hUsbHost);
+  }
+  USBH_SIM_Advance(&hUsbHost, USBH_SIM_MS(50U));
+  (void)USBH_Process(&hUsbHost);
+
+  printf("unplugged : keyboard, %u HID devices left, %u pipes in use\n",
+         (unsigned)CountDevices(USB_HID_CLASS), (unsigned)CountPipes(hUsbHost.pPort->PipeMap));
+  printf("scanner   : %s", Typed[SIM_PORT_SCANNER]);
+
+  if ((Disconnected != 1U) || (CountDevices(USB_HID_CLASS) != (1U + SIM_NUM_MICE)) ||
+      (CountPipes(hUsbHost.pPort->PipeMap) != (pipes - 1U)) ||
+      (strcmp(Typed[SIM_PORT_SCANNER], SIM_SCANNER_TEXT) != 0))
+  {
+    failed = 1;
+  }
+
+  /* Plug it back in */
+  (void)USBH_SIM_HubAttach(&Hub, SIM_PORT_KEYBOARD, &Keyboard.Dev);
+  if (RunUntil(&Active, SIM_NUM_DEVICES + 1U) == 0U)
+  {
+    failed = 1;
+  }
+  printf("replugged : keyboard at address %u\n",
+         (USBH_HUB_GetPortDevice(&hUsbHost, SIM_PORT_KEYBOARD) != NULL) ?
+         USBH_HUB_GetPortDevice(&hUsbHost, SIM_PORT_KEYBOARD)->device.address : 0U);
+
+  printf("%s\n", (failed == 0) ? "PASS" : "FAIL");
+
+  return failed;
+}
@@ -0,0 +1,109 @@
+/**
+  ******************************************************************************
+  * @file    sim_keyboard.c
+  * @brief   Host stack smoke test on the simulated controller: enumerate a
+  *          virtual boot keyboard, type a line on it and print what the HID
+  *          class decodes.
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdio.h>
+#include "usbh_sim_dev.h"
+#include "usbh_hid.h"
+
+#define SIM_TEXT          "Hello, USBHostGiga!\n"
+#define SIM_TIMEOUT       USBH_SIM_MS(5000U)
+
+static USBH_HandleTypeDef hUsbHost;
+static USBH_SIM_HidDevTypeDef Keyboard;
+static uint8_t ClassActive;
+static char Typed[64];
+static uint32_t TypedLen;
+
+static void UserProcess(USBH_HandleTypeDef *phost, uint8_t id)
+{
+  UNUSED(phost);
+
+  if (id == HOST_USER_CLASS_ACTIVE)
+  {
+    ClassActive = 1U;
+  }
+}
+
+void USBH_HID_EventCallback(USBH_HandleTypeDef *phost)
+{
+  HID_KEYBD_Info_TypeDef *info;
+  uint8_t c;
+
+  if (USBH_HID_GetDeviceType(phost) != HID_KEYBOARD)
+  {
+    return;
+  }
+
+  info = USBH_HID_GetKeybdInfo(phost);
+  if (info == NULL)
+  {
+    return;
+  }
+
+  c = USBH_HID_GetASCIICode(info);
+  if ((c != 0U) && (TypedLen < (sizeof(Typed) - 1U)))
+  {
+    Typed[TypedLen] = (char)c;
+    TypedLen++;
+  }
+}
+
+int main(void)
+{
+  USBH_SIM_StatsTypeDef *pstats = &USBH_SIM_GetHost()->Stats;
+  uint64_t active_at;
+  uint64_t deadline;
+
+  USBH_SIM_KeyboardInit(&Keyboard);
+
+  (void)USBH_Init(&hUsbHost, UserProcess, 0U);
+  (void)USBH_RegisterClass(&hUsbHost, USBH_HID_CLASS);
+  USBH_SIM_Attach(&hUsbHost, &Keyboard.Dev);
+  (void)USBH_Start(&hUsbHost);
+
+  deadline = USBH_SIM_Now() + SIM_TIMEOUT;
+  while ((ClassActive == 0U) && (USBH_SIM_Now() < deadline))
+  {
+    USBH_SIM_Poll(&hUsbHost);
+  }
+
+  if (ClassActive == 0U)
+  {
+    printf("enumeration did not complete (gState %d, EnumState %d)\n",
+           (int)hUsbHost.gState, (int)hUsbHost.EnumState);
+    return 1;
+  }
+  active_at = USBH_SIM_Now();
+
+  printf("device   : %04X:%04X, address %u\n",
+         hUsbHost.device.DevDesc.idVendor, hUsbHost.device.DevDesc.idProduct,
+         hUsbHost.device.address);
+  printf("attached : class active after %.3f ms of virtual time\n",
+         (double)active_at / 1e6);
+  printf("           %llu blocking delays totalling %.3f ms, %llu transactions\n",
+         (unsigned long long)pstats->DelayCalls, (double)pstats->DelayTime / 1e6,
+         (unsigned long long)pstats->Transactions);
+
+  (void)USBH_SIM_KeyboardType(&Keyboard, SIM_TEXT);
+
+  deadline = USBH_SIM_Now() + SIM_TIMEOUT;
+  while ((USBH_SIM_HidPending(&Keyboard) != 0U) && (USBH_SIM_Now() < deadline))
+  {
+    USBH_SIM_Poll(&hUsbHost);
+  }
+  USBH_SIM_Advance(&hUsbHost, USBH_SIM_MS(50U));
+  (void)USBH_Process(&hUsbHost);
+
+  printf("typed    : %s", Typed);
+  printf("           %.3f ms to drain %u characters\n",
+         (double)(USBH_SIM_Now() - active_at) / 1e6, (unsigned)(sizeof(SIM_TEXT) - 1U));
+
+  return (TypedLen == (sizeof(SIM_TEXT) - 1U)) ? 0 : 1;
+}
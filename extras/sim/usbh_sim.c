@@ -0,0 +1,1263 @@
+/**
+  ******************************************************************************
+  * @file    usbh_sim.c
+  * @brief   Simulated host controller: implements the USBH_LL_* low level
+  *          driver interface against virtual devices so that the USB host
+  *          library runs, unchanged, on a development machine.
+  ******************************************************************************
+  * @attention
+  *
+  *  @verbatim
+  *
+  *          ===================================================================
+  *                           Simulated Host Controller
+  *          ===================================================================
+  *           The model follows the behaviour the library sees from the H7
+  *           OTG HAL through usbh_conf.c:
+  *             - one root port; connect/port-enable are reported through
+  *               USBH_LL_Connect()/USBH_LL_PortEnabled()
+  *             - SOF every 1 ms once the port is enabled, reported through
+  *               USBH_LL_IncTimer()
+  *             - bulk/control IN NAKs are retried by the "hardware" and stay
+  *               invisible to the library; OUT and interrupt NAKs complete
+  *               the URB with USBH_URB_NOTREADY
+  *             - multi-packet URBs complete on a short packet or when the
+  *               requested length has been moved
+  *             - periodic transactions are issued at the next frame start
+  *             - port reset and VBUS switching block like the HAL does
+  *           Bus time is charged per packet at the device speed so that
+  *           throughput and latency figures are meaningful.
+  *
+  *  @endverbatim
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "usbh_sim.h"
+
+/** @addtogroup USBH_SIM
+  * @{
+  */
+
+/** @defgroup USBH_SIM_Private_Defines
+  * @{
+  */
+/* Sync, PID, CRC, EOP, handshake and inter-packet gaps, in bytes */
+#define USBH_SIM_PACKET_OVERHEAD                 20U
+/* Offset of periodic transactions after the SOF packet */
+#define USBH_SIM_SOF_TIME                        USBH_SIM_US(5U)
+/* Time after which an unanswered transaction is reported as an error */
+#define USBH_SIM_TIMEOUT_TIME                    USBH_SIM_US(20U)
+/**
+  * @}
+  */
+
+/** @defgroup USBH_SIM_Private_Variables
+  * @{
+  */
+static USBH_SIM_HostTypeDef USBH_SIM_Host;
+static uint8_t USBH_SIM_Configured = 0U;
+/**
+  * @}
+  */
+
+/** @defgroup USBH_SIM_Private_Functions
+  * @{
+  */
+static uint64_t USBH_SIM_PacketTime(uint8_t speed, uint32_t bytes);
+static USBH_SIM_DeviceTypeDef *USBH_SIM_FindDevice(USBH_SIM_HostTypeDef *phc, uint8_t address);
+static uint8_t USBH_SIM_CheckFault(USBH_SIM_DeviceTypeDef *pdev, uint8_t ep_addr,
+                                   uint8_t token, USBH_SIM_RespTypeDef *resp);
+static USBH_SIM_RespTypeDef USBH_SIM_StdSetup(USBH_SIM_DeviceTypeDef *pdev,
+                                              const USB_Setup_TypeDef *setup,
+                                              uint8_t *data, uint16_t *length);
+static USBH_SIM_RespTypeDef USBH_SIM_CtlSetup(USBH_SIM_HostTypeDef *phc,
+                                              USBH_SIM_DeviceTypeDef *pdev,
+                                              const uint8_t *pbuff);
+static USBH_SIM_RespTypeDef USBH_SIM_CtlIn(USBH_SIM_HostTypeDef *phc,
+                                           USBH_SIM_DeviceTypeDef *pdev,
+                                           uint8_t *buff, uint16_t *length);
+static USBH_SIM_RespTypeDef USBH_SIM_CtlOut(USBH_SIM_DeviceTypeDef *pdev,
+                                            const uint8_t *buff, uint16_t length);
+static void USBH_SIM_Transact(USBH_SIM_HostTypeDef *phc, uint8_t pipe);
+static void USBH_SIM_Complete(USBH_SIM_HostTypeDef *phc, uint8_t pipe,
+                              USBH_URBStateTypeDef state);
+
+
+/**
+  * @brief  USBH_SIM_GetDefaultConfig
+  *         Fill a timing model with the values the H7 HAL exhibits.
+  * @param  pcfg: configuration to fill
+  * @retval None
+  */
+void USBH_SIM_GetDefaultConfig(USBH_SIM_ConfigTypeDef *pcfg)
+{
+  pcfg->PassTime = (uint32_t)USBH_SIM_US(5U);
+  pcfg->ResetTime = 100U;
+  pcfg->ResetRecovery = 10U;
+  pcfg->VbusDelay = 200U;
+  pcfg->AttachTime = (uint32_t)USBH_SIM_MS(5U);
+  pcfg->NakRetry = (uint32_t)USBH_SIM_US(100U);
+}
+
+
+/**
+  * @brief  USBH_SIM_Configure
+  *         Select the timing model. Must be called before USBH_Init().
+  * @param  pcfg: timing model
+  * @retval None
+  */
+void USBH_SIM_Configure(const USBH_SIM_ConfigTypeDef *pcfg)
+{
+  USBH_SIM_Host.Config = *pcfg;
+  USBH_SIM_Configured = 1U;
+}
+
+
+/**
+  * @brief  USBH_SIM_GetHost
+  *         Return the virtual host controller.
+  * @retval Host controller
+  */
+USBH_SIM_HostTypeDef *USBH_SIM_GetHost(void)
+{
+  return &USBH_SIM_Host;
+}
+
+
+/**
+  * @brief  USBH_SIM_Now
+  *         Return the virtual time in ns.
+  * @retval Time
+  */
+uint64_t USBH_SIM_Now(void)
+{
+  return USBH_SIM_Host.Now;
+}
+
+
+/**
+  * @brief  USBH_SIM_Attach
+  *         Plug a virtual device into the root port.
+  * @param  phost: Host handle
+  * @param  pdev: Virtual device
+  * @retval None
+  */
+void USBH_SIM_Attach(USBH_HandleTypeDef *phost, USBH_SIM_DeviceTypeDef *pdev)
+{
+  USBH_SIM_HostTypeDef *phc = (USBH_SIM_HostTypeDef *)phost->pData;
+
+  USBH_SIM_ResetDevice(pdev);
+  phc->pPortDev = pdev;
+
+  if ((phc->Running != 0U) && (phc->Vbus != 0U))
+  {
+    phc->ConnectAt = phc->Now + phc->Config.AttachTime;
+  }
+}
+
+
+/**
+  * @brief  USBH_SIM_Detach
+  *         Unplug the device from the root port.
+  * @param  phost: Host handle
+  * @retval None
+  */
+void USBH_SIM_Detach(USBH_HandleTypeDef *phost)
+{
+  USBH_SIM_HostTypeDef *phc = (USBH_SIM_HostTypeDef *)phost->pData;
+
+  phc->pPortDev = NULL;
+  phc->ConnectAt = USBH_SIM_NEVER;
+  phc->EnableAt = USBH_SIM_NEVER;
+  phc->PortEnabled = 0U;
+
+  if (phc->Connected != 0U)
+  {
+    phc->Connected = 0U;
+    (void)USBH_LL_Disconnect(phost);
+  }
+}
+
+
+/**
+  * @brief  USBH_SIM_Advance
+  *         Move virtual time forward, delivering port events, SOFs and
+  *         transaction results in chronological order.
+  * @param  phost: Host handle
+  * @param  time: Duration in ns
+  * @retval None
+  */
+void USBH_SIM_Advance(USBH_HandleTypeDef *phost, uint64_t time)
+{
+  USBH_SIM_HostTypeDef *phc = (USBH_SIM_HostTypeDef *)phost->pData;
+  uint64_t target = phc->Now + time;
+  uint64_t next;
+  uint8_t pipe;
+
+  for (;;)
+  {
+    next = target;
+
+    if ((phc->PortEnabled != 0U) && (phc->NextSof < next))
+    {
+      next = phc->NextSof;
+    }
+    if (phc->ConnectAt < next)
+    {
+      next = phc->ConnectAt;
+    }
+    if (phc->EnableAt < next)
+    {
+      next = phc->EnableAt;
+    }
+    for (pipe = 0U; pipe < USBH_SIM_MAX_CHANNELS; pipe++)
+    {
+      if ((phc->Channels[pipe].Busy != 0U) && (phc->Channels[pipe].Due < next))
+      {
+        next = phc->Channels[pipe].Due;
+      }
+    }
+
+    if (next > phc->Now)
+    {
+      phc->Now = next;
+    }
+
+    if (phc->Now >= phc->ConnectAt)
+    {
+      phc->ConnectAt = USBH_SIM_NEVER;
+      if ((phc->pPortDev != NULL) && (phc->Running != 0U) && (phc->Vbus != 0U))
+      {
+        phc->Connected = 1U;
+        (void)USBH_LL_Connect(phost);
+      }
+    }
+
+    if (phc->Now >= phc->EnableAt)
+    {
+      phc->EnableAt = USBH_SIM_NEVER;
+      if ((phc->Connected != 0U) && (phc->pPortDev != NULL))
+      {
+        phc->PortEnabled = 1U;
+        phc->NextSof = phc->Now + USBH_SIM_FRAME_TIME;
+        USBH_LL_PortEnabled(phost);
+      }
+    }
+
+    if ((phc->PortEnabled != 0U) && (phc->Now >= phc->NextSof))
+    {
+      phc->NextSof += USBH_SIM_FRAME_TIME;
+      phc->Frame++;
+      phc->Stats.Frames++;
+      USBH_LL_IncTimer(phost);
+    }
+
+    for (pipe = 0U; pipe < USBH_SIM_MAX_CHANNELS; pipe++)
+    {
+      if ((phc->Channels[pipe].Busy != 0U) && (phc->Channels[pipe].Due <= phc->Now))
+      {
+        USBH_SIM_Transact(phc, pipe);
+      }
+    }
+
+    if (phc->Now >= target)
+    {
+      break;
+    }
+  }
+}
+
+
+/**
+  * @brief  USBH_SIM_Poll
+  *         One iteration of a bare-metal main loop: run the host state
+  *         machine once and charge the configured pass time.
+  * @param  phost: Host handle
+  * @retval None
+  */
+void USBH_SIM_Poll(USBH_HandleTypeDef *phost)
+{
+  USBH_SIM_HostTypeDef *phc = (USBH_SIM_HostTypeDef *)phost->pData;
+
+  (void)USBH_Process(phost);
+  phc->Stats.Passes++;
+  USBH_SIM_Advance(phost, phc->Config.PassTime);
+}
+
+
+/**
+  * @brief  USBH_SIM_ResetDevice
+  *         Put a virtual device back in the default state (bus reset).
+  * @param  pdev: Virtual device
+  * @retval None
+  */
+void USBH_SIM_ResetDevice(USBH_SIM_DeviceTypeDef *pdev)
+{
+  pdev->Address = 0U;
+  pdev->PendingAddress = 0U;
+  pdev->Configuration = 0U;
+  pdev->HaltMask = 0U;
+  pdev->CtlStage = USBH_SIM_CTL_IDLE;
+  pdev->CtlLen = 0U;
+  pdev->CtlPos = 0U;
+  pdev->Stats.Resets++;
+
+  if ((pdev->pOps != NULL) && (pdev->pOps->Reset != NULL))
+  {
+    pdev->pOps->Reset(pdev);
+  }
+}
+
+
+/**
+  * @brief  USBH_SIM_InjectFault
+  *         Script a fault on an endpoint of a virtual device.
+  * @param  pdev: Virtual device
+  * @param  ep_addr: Endpoint address (0x00 / 0x80 for the control endpoint)
+  * @param  tokens: USBH_SIM_TOKEN_xxx mask the fault applies to
+  * @param  resp: Handshake to return (NAK, STALL or ERROR)
+  * @param  skip: Matching transactions to let through first
+  * @param  count: Number of faulted transactions, or USBH_SIM_FOREVER
+  * @retval USBH Status
+  */
+USBH_StatusTypeDef USBH_SIM_InjectFault(USBH_SIM_DeviceTypeDef *pdev, uint8_t ep_addr,
+                                        uint8_t tokens, USBH_SIM_RespTypeDef resp,
+                                        uint32_t skip, uint32_t count)
+{
+  uint32_t idx;
+
+  for (idx = 0U; idx < USBH_SIM_MAX_FAULTS; idx++)
+  {
+    if (pdev->Faults[idx].Count == 0U)
+    {
+      pdev->Faults[idx].ep_addr = ep_addr;
+      pdev->Faults[idx].tokens = tokens;
+      pdev->Faults[idx].Resp = resp;
+      pdev->Faults[idx].Skip = skip;
+      pdev->Faults[idx].Count = count;
+      return USBH_OK;
+    }
+  }
+
+  return USBH_FAIL;
+}
+
+
+/**
+  * @brief  USBH_SIM_ClearFaults
+  *         Remove every scripted fault of a virtual device.
+  * @param  pdev: Virtual device
+  * @retval None
+  */
+void USBH_SIM_ClearFaults(USBH_SIM_DeviceTypeDef *pdev)
+{
+  (void)memset(pdev->Faults, 0, sizeof(pdev->Faults));
+}
+
+
+/**
+  * @brief  USBH_SIM_PacketTime
+  *         Bus time taken by one transaction carrying bytes of payload.
+  * @param  speed: Device speed
+  * @param  bytes: Payload size
+  * @retval Time in ns
+  */
+static uint64_t USBH_SIM_PacketTime(uint8_t speed, uint32_t bytes)
+{
+  uint64_t bits = ((uint64_t)bytes + USBH_SIM_PACKET_OVERHEAD) * 8U;
+
+  if (speed == (uint8_t)USBH_SPEED_LOW)
+  {
+    return (bits * 2000U) / 3U;  /* 1.5 Mbit/s */
+  }
+
+  return (bits * 1000U) / 12U;   /* 12 Mbit/s */
+}
+
+
+/**
+  * @brief  USBH_SIM_FindDevice
+  *         Return the device answering at a bus address, on the port or
+  *         behind a hub attached to it.
+  * @param  phc: Host controller
+  * @param  address: Device address
+  * @retval Device or NULL when nobody answers
+  */
+static USBH_SIM_DeviceTypeDef *USBH_SIM_FindDevice(USBH_SIM_HostTypeDef *phc, uint8_t address)
+{
+  USBH_SIM_DeviceTypeDef *pdev = phc->pPortDev;
+
+  if ((pdev == NULL) || (phc->PortEnabled == 0U))
+  {
+    return NULL;
+  }
+
+  if (pdev->Address == address)
+  {
+    return pdev;
+  }
+
+  if ((pdev->pOps != NULL) && (pdev->pOps->Route != NULL))
+  {
+    return pdev->pOps->Route(pdev, address);
+  }
+
+  return NULL;
+}
+
+
+/**
+  * @brief  USBH_SIM_CheckFault
+  *         Apply the scripted faults to a transaction.
+  * @param  pdev: Virtual device
+  * @param  ep_addr: Endpoint address
+  * @param  token: USBH_SIM_TOKEN_xxx
+  * @param  resp: Handshake to use when a fault fires
+  * @retval 1 when a fault fires
+  */
+static uint8_t USBH_SIM_CheckFault(USBH_SIM_DeviceTypeDef *pdev, uint8_t ep_addr,
+                                   uint8_t token, USBH_SIM_RespTypeDef *resp)
+{
+  USBH_SIM_FaultTypeDef *pf;
+  uint32_t idx;
+
+  for (idx = 0U; idx < USBH_SIM_MAX_FAULTS; idx++)
+  {
+    pf = &pdev->Faults[idx];
+
+    if ((pf->Count != 0U) && (pf->ep_addr == ep_addr) && ((pf->tokens & token) != 0U))
+    {
+      if (pf->Skip != 0U)
+      {
+        pf->Skip--;
+        continue;
+      }
+      if (pf->Count != USBH_SIM_FOREVER)
+      {
+        pf->Count--;
+      }
+      *resp = pf->Resp;
+      return 1U;
+    }
+  }
+
+  return 0U;
+}
+
+
+/**
+  * @brief  USBH_SIM_StdSetup
+  *         Answer the standard requests every device shares.
+  * @param  pdev: Virtual device
+  * @param  setup: Setup packet
+  * @param  data: Data stage buffer
+  * @param  length: In: buffer size / OUT data size, out: IN data size
+  * @retval Handshake
+  */
+static USBH_SIM_RespTypeDef USBH_SIM_StdSetup(USBH_SIM_DeviceTypeDef *pdev,
+                                              const USB_Setup_TypeDef *setup,
+                                              uint8_t *data, uint16_t *length)
+{
+  uint8_t type = setup->b.bmRequestType & (USB_REQ_DIR_MASK | 0x7FU);
+  uint8_t desc_type = (uint8_t)(setup->b.wValue.w >> 8);
+  uint8_t desc_idx = (uint8_t)(setup->b.wValue.w & 0xFFU);
+  const uint8_t *pdesc = NULL;
+  uint16_t len = 0U;
+  uint8_t ep;
+
+  if ((setup->b.bmRequestType & 0x60U) != USB_REQ_TYPE_STANDARD)
+  {
+    goto forward;
+  }
+
+  switch (setup->b.bRequest)
+  {
+    case USB_REQ_GET_DESCRIPTOR:
+      if (type != (USB_D2H | USB_REQ_RECIPIENT_DEVICE))
+      {
+        goto forward;
+      }
+      if (desc_type == USB_DESC_TYPE_DEVICE)
+      {
+        pdesc = pdev->pDevDesc;
+        len = pdesc[0];
+      }
+      else if (desc_type == USB_DESC_TYPE_CONFIGURATION)
+      {
+        pdesc = pdev->pCfgDesc;
+        len = LE16(&pdesc[2]);
+      }
+      else if ((desc_type == USB_DESC_TYPE_STRING) && (desc_idx < pdev->NumStrDesc))
+      {
+        pdesc = pdev->pStrDesc[desc_idx];
+        len = pdesc[0];
+      }
+      else
+      {
+        return USBH_SIM_STALL;
+      }
+      if (len > *length)
+      {
+        len = *length;
+      }
+      (void)memcpy(data, pdesc, len);
+      *length = len;
+      return USBH_SIM_ACK;
+
+    case USB_REQ_SET_ADDRESS:
+      pdev->PendingAddress = (uint8_t)(setup->b.wValue.w & 0x7FU);
+      return USBH_SIM_ACK;
+
+    case USB_REQ_SET_CONFIGURATION:
+      pdev->Configuration = (uint8_t)setup->b.wValue.w;
+      pdev->HaltMask = 0U;
+      return USBH_SIM_ACK;
+
+    case USB_REQ_GET_CONFIGURATION:
+      data[0] = pdev->Configuration;
+      *length = 1U;
+      return USBH_SIM_ACK;
+
+    case USB_REQ_GET_STATUS:
+      data[0] = 0U;
+      data[1] = 0U;
+      *length = 2U;
+      return USBH_SIM_ACK;
+
+    case USB_REQ_SET_FEATURE:
+    case USB_REQ_CLEAR_FEATURE:
+      if ((setup->b.bmRequestType & 0x1FU) == USB_REQ_RECIPIENT_ENDPOINT)
+      {
+        ep = (uint8_t)setup->b.wIndex.w;
+        if (setup->b.bRequest == USB_REQ_SET_FEATURE)
+        {
+          pdev->HaltMask |= (1UL << ((ep & 0x0FU) + (((ep & 0x80U) != 0U) ? 16U : 0U)));
+        }
+        else
+        {
+          pdev->HaltMask &= ~(1UL << ((ep & 0x0FU) + (((ep & 0x80U) != 0U) ? 16U : 0U)));
+        }
+        return USBH_SIM_ACK;
+      }
+      if ((setup->b.bmRequestType & 0x1FU) == USB_REQ_RECIPIENT_DEVICE)
+      {
+        return USBH_SIM_ACK;
+      }
+      goto forward;
+
+    default:
+      break;
+  }
+
+forward:
+  if ((pdev->pOps != NULL) && (pdev->pOps->Setup != NULL))
+  {
+    return pdev->pOps->Setup(pdev, setup, data, length);
+  }
+
+  return USBH_SIM_STALL;
+}
+
+
+/**
+  * @brief  USBH_SIM_CtlSetup
+  *         SETUP stage of a control transfer.
+  * @param  phc: Host controller
+  * @param  pdev: Virtual device
+  * @param  pbuff: 8-byte setup packet
+  * @retval Handshake
+  */
+static USBH_SIM_RespTypeDef USBH_SIM_CtlSetup(USBH_SIM_HostTypeDef *phc,
+                                              USBH_SIM_DeviceTypeDef *pdev,
+                                              const uint8_t *pbuff)
+{
+  uint16_t len;
+
+  (void)memcpy(&pdev->Setup, pbuff, USB_LEN_SETUP_PKT);
+  pdev->Stats.Setups++;
+  pdev->CtlPos = 0U;
+  pdev->CtlLen = 0U;
+  pdev->CtlResp = USBH_SIM_ACK;
+  pdev->CtlReady = phc->Now + pdev->CtlLatency;
+
+  if ((pdev->Setup.b.bmRequestType & USB_REQ_DIR_MASK) == USB_D2H)
+  {
+    len = pdev->Setup.b.wLength.w;
+    if (len > USBH_SIM_CTL_BUFFER_SIZE)
+    {
+      len = USBH_SIM_CTL_BUFFER_SIZE;
+    }
+    pdev->CtlResp = USBH_SIM_StdSetup(pdev, &pdev->Setup, pdev->CtlBuf, &len);
+    pdev->CtlLen = len;
+    pdev->CtlStage = USBH_SIM_CTL_DATA_IN;
+  }
+  else if (pdev->Setup.b.wLength.w != 0U)
+  {
+    pdev->CtlStage = USBH_SIM_CTL_DATA_OUT;
+  }
+  else
+  {
+    pdev->CtlStage = USBH_SIM_CTL_STATUS_IN;
+  }
+
+  return USBH_SIM_ACK;
+}
+
+
+/**
+  * @brief  USBH_SIM_CtlIn
+  *         IN packet on the control endpoint (data or status stage).
+  * @param  phc: Host controller
+  * @param  pdev: Virtual device
+  * @param  buff: Packet buffer
+  * @param  length: In: max packet size, out: packet size
+  * @retval Handshake
+  */
+static USBH_SIM_RespTypeDef USBH_SIM_CtlIn(USBH_SIM_HostTypeDef *phc,
+                                           USBH_SIM_DeviceTypeDef *pdev,
+                                           uint8_t *buff, uint16_t *length)
+{
+  USBH_SIM_RespTypeDef resp;
+  uint16_t len;
+
+  if (phc->Now < pdev->CtlReady)
+  {
+    return USBH_SIM_NAK;
+  }
+
+  switch (pdev->CtlStage)
+  {
+    case USBH_SIM_CTL_DATA_IN:
+      if (pdev->CtlResp != USBH_SIM_ACK)
+      {
+        return pdev->CtlResp;
+      }
+      len = pdev->CtlLen - pdev->CtlPos;
+      if (len > *length)
+      {
+        len = *length;
+      }
+      (void)memcpy(buff, &pdev->CtlBuf[pdev->CtlPos], len);
+      pdev->CtlPos += len;
+      *length = len;
+      return USBH_SIM_ACK;
+
+    case USBH_SIM_CTL_STATUS_IN:
+      len = pdev->CtlLen;
+      resp = USBH_SIM_StdSetup(pdev, &pdev->Setup, pdev->CtlBuf, &len);
+      pdev->CtlStage = USBH_SIM_CTL_IDLE;
+      if ((resp == USBH_SIM_ACK) && (pdev->Setup.b.bRequest == USB_REQ_SET_ADDRESS) &&
+          ((pdev->Setup.b.bmRequestType & 0x60U) == USB_REQ_TYPE_STANDARD))
+      {
+        pdev->Address = pdev->PendingAddress;
+      }
+      *length = 0U;
+      return resp;
+
+    default:
+      return USBH_SIM_STALL;
+  }
+}
+
+
+/**
+  * @brief  USBH_SIM_CtlOut
+  *         OUT packet on the control endpoint (data or status stage).
+  * @param  pdev: Virtual device
+  * @param  buff: Packet data
+  * @param  length: Packet size
+  * @retval Handshake
+  */
+static USBH_SIM_RespTypeDef USBH_SIM_CtlOut(USBH_SIM_DeviceTypeDef *pdev,
+                                            const uint8_t *buff, uint16_t length)
+{
+  if (pdev->CtlStage == USBH_SIM_CTL_DATA_OUT)
+  {
+    if ((uint32_t)pdev->CtlLen + length > USBH_SIM_CTL_BUFFER_SIZE)
+    {
+      return USBH_SIM_STALL;
+    }
+    (void)memcpy(&pdev->CtlBuf[pdev->CtlLen], buff, length);
+    pdev->CtlLen += length;
+    if (pdev->CtlLen >= pdev->Setup.b.wLength.w)
+    {
+      pdev->CtlStage = USBH_SIM_CTL_STATUS_IN;
+    }
+    return USBH_SIM_ACK;
+  }
+
+  /* Status stage of an IN transfer, possibly ending the data stage early */
+  pdev->CtlStage = USBH_SIM_CTL_IDLE;
+  return USBH_SIM_ACK;
+}
+
+
+/**
+  * @brief  USBH_SIM_Transact
+  *         Run the transactions of the URB pending on a channel.
+  * @param  phc: Host controller
+  * @param  pipe: Channel
+  * @retval None
+  */
+static void USBH_SIM_Transact(USBH_SIM_HostTypeDef *phc, uint8_t pipe)
+{
+  USBH_SIM_ChannelTypeDef *pch = &phc->Channels[pipe];
+  USBH_SIM_DeviceTypeDef *pdev;
+  USBH_SIM_RespTypeDef resp;
+  uint8_t token;
+  uint8_t halt_bit;
+  uint16_t len;
+  uint16_t chunk;
+
+  if (phc->BusFree > phc->Now)
+  {
+    pch->Due = phc->BusFree;
+    return;
+  }
+
+  pdev = USBH_SIM_FindDevice(phc, pch->DevAddr);
+  if (pdev == NULL)
+  {
+    /* Nobody answers: the HAL reports a transaction error */
+    phc->BusFree = phc->Now + USBH_SIM_TIMEOUT_TIME;
+    USBH_SIM_Complete(phc, pipe, USBH_URB_ERROR);
+    return;
+  }
+
+  if (pch->Token == 0U)
+  {
+    token = USBH_SIM_TOKEN_SETUP;
+  }
+  else
+  {
+    token = (pch->Direction != 0U) ? USBH_SIM_TOKEN_IN : USBH_SIM_TOKEN_OUT;
+  }
+  halt_bit = (uint8_t)((pch->EpAddr & 0x0FU) + ((token == USBH_SIM_TOKEN_IN) ? 16U : 0U));
+
+  for (;;)
+  {
+    phc->Stats.Transactions++;
+
+    if (token == USBH_SIM_TOKEN_IN)
+    {
+      chunk = pch->Length - (uint16_t)pch->XferCount;
+      if (chunk > pch->Mps)
+      {
+        chunk = pch->Mps;
+      }
+      len = chunk;
+
+      if (USBH_SIM_CheckFault(pdev, pch->EpAddr | 0x80U, token, &resp) != 0U)
+      {
+        len = 0U;
+      }
+      else if (pch->EpType == USB_EP_TYPE_CTRL)
+      {
+        resp = USBH_SIM_CtlIn(phc, pdev, pch->pBuff + pch->XferCount, &len);
+      }
+      else if ((pdev->HaltMask & (1UL << halt_bit)) != 0U)
+      {
+        resp = USBH_SIM_STALL;
+      }
+      else if ((pdev->pOps != NULL) && (pdev->pOps->DataIn != NULL))
+      {
+        resp = pdev->pOps->DataIn(pdev, pch->EpAddr | 0x80U, pch->pBuff + pch->XferCount, &len);
+      }
+      else
+      {
+        resp = USBH_SIM_NAK;
+      }
+    }
+    else
+    {
+      chunk = pch->Length - (uint16_t)pch->XferCount;
+      if (chunk > pch->Mps)
+      {
+        chunk = pch->Mps;
+      }
+      len = chunk;
+
+      if (USBH_SIM_CheckFault(pdev, pch->EpAddr & 0x7FU, token, &resp) != 0U)
+      {
+        /* fault applied */
+      }
+      else if (token == USBH_SIM_TOKEN_SETUP)
+      {
+        resp = USBH_SIM_CtlSetup(phc, pdev, pch->pBuff);
+      }
+      else if (pch->EpType == USB_EP_TYPE_CTRL)
+      {
+        resp = USBH_SIM_CtlOut(pdev, pch->pBuff + pch->XferCount, len);
+      }
+      else if ((pdev->HaltMask & (1UL << halt_bit)) != 0U)
+      {
+        resp = USBH_SIM_STALL;
+      }
+      else if ((pdev->pOps != NULL) && (pdev->pOps->DataOut != NULL))
+      {
+        resp = pdev->pOps->DataOut(pdev, pch->EpAddr & 0x7FU, pch->pBuff + pch->XferCount, len);
+      }
+      else
+      {
+        resp = USBH_SIM_NAK;
+      }
+    }
+
+    phc->BusFree = phc->Now + USBH_SIM_PacketTime(pch->Speed, (resp == USBH_SIM_ACK) ? len : 0U);
+    phc->Stats.BusTime += phc->BusFree - phc->Now;
+    phc->Now = phc->BusFree;
+
+    if (resp == USBH_SIM_NAK)
+    {
+      pdev->Stats.Naks++;
+      phc->Stats.Naks++;
+
+      if (pch->EpType == USB_EP_TYPE_ISOC)
+      {
+        /* No handshake on isochronous endpoints: an empty frame */
+        USBH_SIM_Complete(phc, pipe, USBH_URB_DONE);
+      }
+      else if ((token == USBH_SIM_TOKEN_IN) && (pch->EpType != USB_EP_TYPE_INTR))
+      {
+        /* The channel re-arms by itself on bulk/control IN */
+        pch->Due = phc->Now + phc->Config.NakRetry;
+      }
+      else
+      {
+        USBH_SIM_Complete(phc, pipe, USBH_URB_NOTREADY);
+      }
+      return;
+    }
+
+    if (resp == USBH_SIM_STALL)
+    {
+      pdev->Stats.Stalls++;
+      USBH_SIM_Complete(phc, pipe, USBH_URB_STALL);
+      return;
+    }
+
+    if (resp == USBH_SIM_ERROR)
+    {
+      pdev->Stats.Errors++;
+      USBH_SIM_Complete(phc, pipe, USBH_URB_ERROR);
+      return;
+    }
+
+    /* ACK */
+    pch->XferCount += len;
+    if (token == USBH_SIM_TOKEN_IN)
+    {
+      pdev->Stats.BytesIn += len;
+      pch->ToggleIn ^= 1U;
+    }
+    else
+    {
+      pdev->Stats.BytesOut += len;
+      pch->ToggleOut ^= 1U;
+    }
+
+    if ((token == USBH_SIM_TOKEN_SETUP) || (len < pch->Mps) ||
+        (pch->XferCount >= pch->Length) || (pch->EpType == USB_EP_TYPE_ISOC))
+    {
+      USBH_SIM_Complete(phc, pipe, USBH_URB_DONE);
+      return;
+    }
+  }
+}
+
+
+/**
+  * @brief  USBH_SIM_Complete
+  *         Publish the final state of a URB, like the HCD channel interrupt.
+  * @param  phc: Host controller
+  * @param  pipe: Channel
+  * @param  state: URB state
+  * @retval None
+  */
+static void USBH_SIM_Complete(USBH_SIM_HostTypeDef *phc, uint8_t pipe,
+                              USBH_URBStateTypeDef state)
+{
+  phc->Channels[pipe].Busy = 0U;
+  phc->Channels[pipe].UrbState = state;
+
+  (void)USBH_LL_NotifyURBChange(phc->phost, pipe, state);
+}
+/**
+  * @}
+  */
+
+
+/** @defgroup USBH_SIM_LL_Functions
+  * @brief Low level driver interface implemented on the virtual controller.
+  * @{
+  */
+
+/**
+  * @brief  Initialize the low level portion of the host driver.
+  * @param  phost: Host handle
+  * @retval USBH status
+  */
+USBH_StatusTypeDef USBH_LL_Init(USBH_HandleTypeDef *phost)
+{
+  USBH_SIM_HostTypeDef *phc = &USBH_SIM_Host;
+  USBH_SIM_ConfigTypeDef cfg;
+
+  if (USBH_SIM_Configured != 0U)
+  {
+    cfg = phc->Config;
+  }
+  else
+  {
+    USBH_SIM_GetDefaultConfig(&cfg);
+  }
+
+  (void)memset(phc, 0, sizeof(USBH_SIM_HostTypeDef));
+  phc->Config = cfg;
+  phc->phost = phost;
+  phc->ConnectAt = USBH_SIM_NEVER;
+  phc->EnableAt = USBH_SIM_NEVER;
+  phost->pData = phc;
+
+  USBH_LL_SetTimer(phost, phc->Frame);
+
+  return USBH_OK;
+}
+
+/**
+  * @brief  De-Initialize the low level portion of the host driver.
+  * @param  phost: Host handle
+  * @retval USBH status
+  */
+USBH_StatusTypeDef USBH_LL_DeInit(USBH_HandleTypeDef *phost)
+{
+  USBH_SIM_HostTypeDef *phc = (USBH_SIM_HostTypeDef *)phost->pData;
+
+  phc->Running = 0U;
+  return USBH_OK;
+}
+
+/**
+  * @brief  Start the low level portion of the host driver.
+  * @param  phost: Host handle
+  * @retval USBH status
+  */
+USBH_StatusTypeDef USBH_LL_Start(USBH_HandleTypeDef *phost)
+{
+  USBH_SIM_HostTypeDef *phc = (USBH_SIM_HostTypeDef *)phost->pData;
+
+  phc->Running = 1U;
+
+  /* A device still plugged in is detected again */
+  if ((phc->pPortDev != NULL) && (phc->Vbus != 0U) && (phc->Connected == 0U))
+  {
+    phc->ConnectAt = phc->Now + phc->Config.AttachTime;
+  }
+
+  return USBH_OK;
+}
+
+/**
+  * @brief  Stop the low level portion of the host driver.
+  * @param  phost: Host handle
+  * @retval USBH status
+  */
+USBH_StatusTypeDef USBH_LL_Stop(USBH_HandleTypeDef *phost)
+{
+  USBH_SIM_HostTypeDef *phc = (USBH_SIM_HostTypeDef *)phost->pData;
+  uint8_t pipe;
+
+  phc->Running = 0U;
+  phc->Connected = 0U;
+  phc->PortEnabled = 0U;
+  phc->ConnectAt = USBH_SIM_NEVER;
+  phc->EnableAt = USBH_SIM_NEVER;
+
+  for (pipe = 0U; pipe < USBH_SIM_MAX_CHANNELS; pipe++)
+  {
+    phc->Channels[pipe].Busy = 0U;
+  }
+
+  return USBH_OK;
+}
+
+/**
+  * @brief  Return the USB host speed from the low level driver.
+  * @param  phost: Host handle
+  * @retval USBH speeds
+  */
+USBH_SpeedTypeDef USBH_LL_GetSpeed(USBH_HandleTypeDef *phost)
+{
+  USBH_SIM_HostTypeDef *phc = (USBH_SIM_HostTypeDef *)phost->pData;
+
+  if (phc->pPortDev == NULL)
+  {
+    return USBH_SPEED_FULL;
+  }
+
+  return (USBH_SpeedTypeDef)phc->pPortDev->Speed;
+}
+
+/**
+  * @brief  Reset the Host port of the low level driver.
+  *         Blocks like USB_ResetPort() in the HAL.
+  * @param  phost: Host handle
+  * @retval USBH status
+  */
+USBH_StatusTypeDef USBH_LL_ResetPort(USBH_HandleTypeDef *phost)
+{
+  USBH_SIM_HostTypeDef *phc = (USBH_SIM_HostTypeDef *)phost->pData;
+
+  phc->PortEnabled = 0U;
+  phc->Stats.DelayCalls++;
+  phc->Stats.DelayTime += USBH_SIM_MS(phc->Config.ResetTime + phc->Config.ResetRecovery);
+
+  USBH_SIM_Advance(phost, USBH_SIM_MS(phc->Config.ResetTime));
+
+  if (phc->pPortDev != NULL)
+  {
+    USBH_SIM_ResetDevice(phc->pPortDev);
+    phc->EnableAt = phc->Now + USBH_SIM_US(10U);
+  }
+
+  USBH_SIM_Advance(phost, USBH_SIM_MS(phc->Config.ResetRecovery));
+
+  return USBH_OK;
+}
+
+/**
+  * @brief  Return the last transferred packet size.
+  * @param  phost: Host handle
+  * @param  pipe: Pipe index
+  * @retval Packet size
+  */
+uint32_t USBH_LL_GetLastXferSize(USBH_HandleTypeDef *phost, uint8_t pipe)
+{
+  USBH_SIM_HostTypeDef *phc = (USBH_SIM_HostTypeDef *)phost->pData;
+
+  return phc->Channels[pipe].XferCount;
+}
+
+/**
+  * @brief  Open a pipe of the low level driver.
+  * @param  phost: Host handle
+  * @param  pipe_num: Pipe index
+  * @param  epnum: Endpoint number
+  * @param  dev_address: Device USB address
+  * @param  speed: Device Speed
+  * @param  ep_type: Endpoint type
+  * @param  mps: Endpoint max packet size
+  * @retval USBH status
+  */
+USBH_StatusTypeDef USBH_LL_OpenPipe(USBH_HandleTypeDef *phost, uint8_t pipe_num, uint8_t epnum,
+                                    uint8_t dev_address, uint8_t speed, uint8_t ep_type, uint16_t mps)
+{
+  USBH_SIM_HostTypeDef *phc = (USBH_SIM_HostTypeDef *)phost->pData;
+  USBH_SIM_ChannelTypeDef *pch;
+
+  if (pipe_num >= USBH_SIM_MAX_CHANNELS)
+  {
+    return USBH_FAIL;
+  }
+
+  pch = &phc->Channels[pipe_num];
+  pch->Open = 1U;
+  pch->Busy = 0U;
+  pch->EpAddr = epnum;
+  pch->DevAddr = dev_address;
+  pch->Speed = speed;
+  pch->EpType = ep_type;
+  pch->Mps = (mps != 0U) ? mps : 8U;
+
+  return USBH_OK;
+}
+
+/**
+  * @brief  Close a pipe of the low level driver.
+  * @param  phost: Host handle
+  * @param  pipe: Pipe index
+  * @retval USBH status
+  */
+USBH_StatusTypeDef USBH_LL_ClosePipe(USBH_HandleTypeDef *phost, uint8_t pipe)
+{
+  USBH_SIM_HostTypeDef *phc = (USBH_SIM_HostTypeDef *)phost->pData;
+
+  if (pipe >= USBH_SIM_MAX_CHANNELS)
+  {
+    return USBH_FAIL;
+  }
+
+  phc->Channels[pipe].Busy = 0U;
+
+  return USBH_OK;
+}
+
+/**
+  * @brief  Submit a new URB to the low level driver.
+  * @param  phost: Host handle
+  * @param  pipe: Pipe index
+  * @param  direction : 0 output, 1 input
+  * @param  ep_type : Endpoint Type
+  * @param  token : 0 PID_SETUP, 1 PID_DATA
+  * @param  pbuff : pointer to URB data
+  * @param  length : Length of URB data
+  * @param  do_ping : activate do ping protocol (for high speed only)
+  * @retval Status
+  */
+USBH_StatusTypeDef USBH_LL_SubmitURB(USBH_HandleTypeDef *phost, uint8_t pipe, uint8_t direction,
+                                     uint8_t ep_type, uint8_t token, uint8_t *pbuff, uint16_t length,
+                                     uint8_t do_ping)
+{
+  USBH_SIM_HostTypeDef *phc = (USBH_SIM_HostTypeDef *)phost->pData;
+  USBH_SIM_ChannelTypeDef *pch;
+
+  UNUSED(do_ping);
+
+  if (pipe >= USBH_SIM_MAX_CHANNELS)
+  {
+    return USBH_FAIL;
+  }
+
+  pch = &phc->Channels[pipe];
+  pch->Direction = direction;
+  pch->EpType = ep_type;
+  pch->Token = token;
+  pch->pBuff = pbuff;
+  pch->Length = length;
+  pch->XferCount = 0U;
+  pch->UrbState = USBH_URB_IDLE;
+  pch->Busy = 1U;
+  phc->Stats.Urbs++;
+
+  if ((ep_type == USB_EP_TYPE_INTR) || (ep_type == USB_EP_TYPE_ISOC))
+  {
+    pch->Due = phc->NextSof + USBH_SIM_SOF_TIME;
+  }
+  else
+  {
+    pch->Due = phc->Now;
+  }
+
+  return USBH_OK;
+}
+
+/**
+  * @brief  Get a URB state from the low level driver.
+  * @param  phost: Host handle
+  * @param  pipe: Pipe index
+  * @retval URB state
+  */
+USBH_URBStateTypeDef USBH_LL_GetURBState(USBH_HandleTypeDef *phost, uint8_t pipe)
+{
+  USBH_SIM_HostTypeDef *phc = (USBH_SIM_HostTypeDef *)phost->pData;
+
+  return phc->Channels[pipe].UrbState;
+}
+
+/**
+  * @brief  Drive VBUS. Blocks like usbh_conf.c does.
+  * @param  phost: Host handle
+  * @param  state : VBUS state
+  * @retval Status
+  */
+USBH_StatusTypeDef USBH_LL_DriverVBUS(USBH_HandleTypeDef *phost, uint8_t state)
+{
+  USBH_SIM_HostTypeDef *phc = (USBH_SIM_HostTypeDef *)phost->pData;
+
+  phc->Vbus = state;
+
+  if ((state != 0U) && (phc->pPortDev != NULL) && (phc->Running != 0U) &&
+      (phc->Connected == 0U))
+  {
+    phc->ConnectAt = phc->Now + phc->Config.AttachTime;
+  }
+
+#if (USBH_FAST_ATTACH == 0U)
+  if (phc->Config.VbusDelay != 0U)
+  {
+    phc->Stats.DelayCalls++;
+    phc->Stats.DelayTime += USBH_SIM_MS(phc->Config.VbusDelay);
+    USBH_SIM_Advance(phost, USBH_SIM_MS(phc->Config.VbusDelay));
+  }
+#endif
+
+  return USBH_OK;
+}
+
+/**
+  * @brief  Set toggle for a pipe.
+  * @param  phost: Host handle
+  * @param  pipe: Pipe index
+  * @param  toggle: toggle (0/1)
+  * @retval Status
+  */
+USBH_StatusTypeDef USBH_LL_SetToggle(USBH_HandleTypeDef *phost, uint8_t pipe, uint8_t toggle)
+{
+  USBH_SIM_HostTypeDef *phc = (USBH_SIM_HostTypeDef *)phost->pData;
+
+  if ((phc->Channels[pipe].EpAddr & 0x80U) != 0U)
+  {
+    phc->Channels[pipe].ToggleIn = toggle;
+  }
+  else
+  {
+    phc->Channels[pipe].ToggleOut = toggle;
+  }
+
+  return USBH_OK;
+}
+
+/**
+  * @brief  Return the current toggle of a pipe.
+  * @param  phost: Host handle
+  * @param  pipe: Pipe index
+  * @retval toggle (0/1)
+  */
+uint8_t USBH_LL_GetToggle(USBH_HandleTypeDef *phost, uint8_t pipe)
+{
+  USBH_SIM_HostTypeDef *phc = (USBH_SIM_HostTypeDef *)phost->pData;
+
+  if ((phc->Channels[pipe].EpAddr & 0x80U) != 0U)
+  {
+    return phc->Channels[pipe].ToggleIn;
+  }
+
+  return phc->Channels[pipe].ToggleOut;
+}
+
+/**
+  * @brief  Delay routine for the USB Host Library: advances virtual time.
+  * @param  Delay: Delay in ms
+  * @retval None
+  */
+void USBH_Delay(uint32_t Delay)
+{
+  USBH_SIM_HostTypeDef *phc = &USBH_SIM_Host;
+
+  phc->Stats.DelayCalls++;
+  phc->Stats.DelayTime += USBH_SIM_MS(Delay);
+
+  if (phc->phost != NULL)
+  {
+    USBH_SIM_Advance(phc->phost, USBH_SIM_MS(Delay));
+  }
+}
+
+#if (USBH_FAST_ATTACH == 1U)
+/**
+  * @brief  Time base for the non-blocking waits of the fast attach mode
+  * @retval Virtual time in ms
+  */
+uint32_t USBH_GetTick(void)
+{
+  return (uint32_t)(USBH_SIM_Host.Now / USBH_SIM_MS(1U));
+}
+#endif
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
@@ -0,0 +1,258 @@
+/**
+  ******************************************************************************
+  * @file    usbh_sim.h
+  * @brief   Header file for usbh_sim.c, the simulated host controller used to
+  *          run the USB host library on a development machine.
+  ******************************************************************************
+  * @attention
+  *
+  * The simulator replaces usbh_conf.c: it implements the USBH_LL_* surface
+  * on top of a virtual port, a set of virtual host channels and scriptable
+  * virtual devices. Time is virtual: it only moves when the application calls
+  * USBH_SIM_Advance()/USBH_SIM_Poll() or when the library calls USBH_Delay().
+  * Every SOF crossed on the way is delivered through USBH_LL_IncTimer(),
+  * exactly as HAL_HCD_SOF_Callback() does on the target.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __USBH_SIM_H
+#define __USBH_SIM_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "usbh_core.h"
+
+/** @addtogroup USBH_SIM
+  * @{
+  */
+
+/** @defgroup USBH_SIM_Exported_Defines
+  * @{
+  */
+#define USBH_SIM_MAX_CHANNELS                    16U
+#define USBH_SIM_MAX_FAULTS                      8U
+#define USBH_SIM_CTL_BUFFER_SIZE                 1024U
+
+/* Virtual time unit helpers: the simulator clock counts nanoseconds */
+#define USBH_SIM_US(x)                           ((uint64_t)(x) * 1000U)
+#define USBH_SIM_MS(x)                           ((uint64_t)(x) * 1000000U)
+#define USBH_SIM_FRAME_TIME                      USBH_SIM_MS(1U)
+#define USBH_SIM_NEVER                           0xFFFFFFFFFFFFFFFFU
+
+/* Fault injection repeat count meaning "until cleared" */
+#define USBH_SIM_FOREVER                         0xFFFFFFFFU
+
+/* Token filter used by the fault injector */
+#define USBH_SIM_TOKEN_SETUP                     0x01U
+#define USBH_SIM_TOKEN_IN                        0x02U
+#define USBH_SIM_TOKEN_OUT                       0x04U
+#define USBH_SIM_TOKEN_ANY                       0x07U
+/**
+  * @}
+  */
+
+/** @defgroup USBH_SIM_Exported_Types
+  * @{
+  */
+
+/* Handshake returned by a virtual device for one transaction */
+typedef enum
+{
+  USBH_SIM_ACK = 0U,
+  USBH_SIM_NAK,
+  USBH_SIM_STALL,
+  USBH_SIM_ERROR,
+} USBH_SIM_RespTypeDef;
+
+/* Control transfer stage tracked by the virtual device */
+typedef enum
+{
+  USBH_SIM_CTL_IDLE = 0U,
+  USBH_SIM_CTL_DATA_IN,
+  USBH_SIM_CTL_DATA_OUT,
+  USBH_SIM_CTL_STATUS_IN,
+  USBH_SIM_CTL_STATUS_OUT,
+} USBH_SIM_CtlStageTypeDef;
+
+struct _USBH_SIM_Device;
+
+/* Endpoint responders of a virtual device. Standard device requests
+   (descriptors, address, configuration, features) are answered by the
+   simulator itself; everything else is forwarded to Setup. */
+typedef struct
+{
+  /* Class/vendor request. For device-to-host requests fill data (at most
+     *length bytes) and update *length; for host-to-device requests data
+     holds the *length bytes received during the data stage. */
+  USBH_SIM_RespTypeDef(*Setup)(struct _USBH_SIM_Device *pdev,
+                               const USB_Setup_TypeDef *setup,
+                               uint8_t *data, uint16_t *length);
+  /* One IN packet: fill at most *length bytes (the max packet size) */
+  USBH_SIM_RespTypeDef(*DataIn)(struct _USBH_SIM_Device *pdev, uint8_t ep_addr,
+                                uint8_t *buff, uint16_t *length);
+  /* One OUT packet */
+  USBH_SIM_RespTypeDef(*DataOut)(struct _USBH_SIM_Device *pdev, uint8_t ep_addr,
+                                 const uint8_t *buff, uint16_t length);
+  /* Bus reset or attach */
+  void (*Reset)(struct _USBH_SIM_Device *pdev);
+  /* Hub only: downstream device answering at address, NULL when none */
+  struct _USBH_SIM_Device *(*Route)(struct _USBH_SIM_Device *pdev, uint8_t address);
+} USBH_SIM_DevOpsTypeDef;
+
+/* Scripted fault: after Skip matching transactions, answer the next Count
+   ones with Resp instead of calling the responder */
+typedef struct
+{
+  uint8_t               ep_addr;
+  uint8_t               tokens;
+  USBH_SIM_RespTypeDef  Resp;
+  uint32_t              Skip;
+  uint32_t              Count;
+} USBH_SIM_FaultTypeDef;
+
+typedef struct
+{
+  uint32_t              Setups;
+  uint32_t              Naks;
+  uint32_t              Stalls;
+  uint32_t              Errors;
+  uint32_t              Resets;
+  uint64_t              BytesIn;
+  uint64_t              BytesOut;
+} USBH_SIM_DevStatsTypeDef;
+
+/* Virtual device */
+typedef struct _USBH_SIM_Device
+{
+  const char                    *Name;
+  uint8_t                        Speed;        /* USBH_SPEED_FULL or USBH_SPEED_LOW */
+  const uint8_t                 *pDevDesc;
+  const uint8_t                 *pCfgDesc;
+  const uint8_t *const          *pStrDesc;     /* [0] is the LANGID table */
+  uint8_t                        NumStrDesc;
+  const USBH_SIM_DevOpsTypeDef  *pOps;
+  uint32_t                       CtlLatency;   /* ns from SETUP to data/status ready */
+  void                          *pUser;
+
+  /* run-time state, owned by the simulator */
+  uint8_t                        Address;
+  uint8_t                        PendingAddress;
+  uint8_t                        Configuration;
+  uint32_t                       HaltMask;     /* bit (ep & 0xF) + 16 * dir */
+  USB_Setup_TypeDef              Setup;
+  USBH_SIM_CtlStageTypeDef       CtlStage;
+  USBH_SIM_RespTypeDef           CtlResp;
+  uint64_t                       CtlReady;
+  uint16_t                       CtlLen;
+  uint16_t                       CtlPos;
+  uint8_t                        CtlBuf[USBH_SIM_CTL_BUFFER_SIZE];
+  USBH_SIM_FaultTypeDef          Faults[USBH_SIM_MAX_FAULTS];
+  USBH_SIM_DevStatsTypeDef       Stats;
+} USBH_SIM_DeviceTypeDef;
+
+/* Virtual host channel (HAL_HCD "hc") */
+typedef struct
+{
+  uint8_t               Open;
+  uint8_t               EpAddr;
+  uint8_t               DevAddr;
+  uint8_t               Speed;
+  uint8_t               EpType;
+  uint16_t              Mps;
+  uint8_t               ToggleIn;
+  uint8_t               ToggleOut;
+
+  /* current URB */
+  uint8_t               Busy;
+  uint8_t               Direction;
+  uint8_t               Token;
+  uint8_t              *pBuff;
+  uint16_t              Length;
+  uint32_t              XferCount;
+  uint64_t              Due;
+  USBH_URBStateTypeDef  UrbState;
+} USBH_SIM_ChannelTypeDef;
+
+/* Timing model. Defaults mirror what usbh_conf.c and the H7 HAL do. */
+typedef struct
+{
+  uint32_t              PassTime;      /* ns charged by USBH_SIM_Poll() per USBH_Process() pass */
+  uint32_t              ResetTime;     /* ms the HAL keeps the port in reset (blocking) */
+  uint32_t              ResetRecovery; /* ms the HAL waits after releasing reset (blocking) */
+  uint32_t              VbusDelay;     /* ms USBH_LL_DriverVBUS() blocks, unless USBH_FAST_ATTACH */
+  uint32_t              AttachTime;    /* ns between VBUS/attach and the connect interrupt */
+  uint32_t              NakRetry;      /* ns between retries of a NAKed bulk/control IN */
+} USBH_SIM_ConfigTypeDef;
+
+typedef struct
+{
+  uint64_t              Frames;
+  uint64_t              Urbs;
+  uint64_t              Transactions;
+  uint64_t              Naks;
+  uint64_t              BusTime;       /* ns the bus carried traffic */
+  uint64_t              DelayCalls;    /* blocking USBH_Delay()/HAL_Delay() calls */
+  uint64_t              DelayTime;     /* ns spent in them */
+  uint64_t              Passes;
+} USBH_SIM_StatsTypeDef;
+
+/* Virtual host controller */
+typedef struct
+{
+  USBH_HandleTypeDef            *phost;
+  USBH_SIM_ConfigTypeDef         Config;
+  uint64_t                       Now;
+  uint64_t                       NextSof;
+  uint64_t                       BusFree;
+  uint64_t                       ConnectAt;
+  uint64_t                       EnableAt;
+  uint32_t                       Frame;
+  uint8_t                        Running;
+  uint8_t                        Vbus;
+  uint8_t                        Connected;
+  uint8_t                        PortEnabled;
+  USBH_SIM_DeviceTypeDef        *pPortDev;
+  USBH_SIM_ChannelTypeDef        Channels[USBH_SIM_MAX_CHANNELS];
+  USBH_SIM_StatsTypeDef          Stats;
+} USBH_SIM_HostTypeDef;
+/**
+  * @}
+  */
+
+/** @defgroup USBH_SIM_Exported_FunctionsPrototype
+  * @{
+  */
+void                  USBH_SIM_GetDefaultConfig(USBH_SIM_ConfigTypeDef *pcfg);
+void                  USBH_SIM_Configure(const USBH_SIM_ConfigTypeDef *pcfg);
+USBH_SIM_HostTypeDef *USBH_SIM_GetHost(void);
+uint64_t              USBH_SIM_Now(void);
+
+void USBH_SIM_Attach(USBH_HandleTypeDef *phost, USBH_SIM_DeviceTypeDef *pdev);
+void USBH_SIM_Detach(USBH_HandleTypeDef *phost);
+
+void USBH_SIM_Advance(USBH_HandleTypeDef *phost, uint64_t time);
+void USBH_SIM_Poll(USBH_HandleTypeDef *phost);
+
+void USBH_SIM_ResetDevice(USBH_SIM_DeviceTypeDef *pdev);
+USBH_StatusTypeDef USBH_SIM_InjectFault(USBH_SIM_DeviceTypeDef *pdev, uint8_t ep_addr,
+                                        uint8_t tokens, USBH_SIM_RespTypeDef resp,
+                                        uint32_t skip, uint32_t count);
+void USBH_SIM_ClearFaults(USBH_SIM_DeviceTypeDef *pdev);
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __USBH_SIM_H */
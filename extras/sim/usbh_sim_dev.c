@@ -0,0 +1,1401 @@
+/**
+  ******************************************************************************
+  * @file    usbh_sim_dev.c
+  * @brief   Ready-made virtual devices for the simulated host controller:
+  *          a low speed boot keyboard, a low speed boot mouse, a full
+  *          speed CDC-ACM device echoing its bulk OUT data on bulk IN, a
+  *          full speed hub, a composite device combining the CDC-ACM
+  *          device with a keyboard and a full speed UAC1 microphone.
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "usbh_sim_dev.h"
+
+/** @addtogroup USBH_SIM
+  * @{
+  */
+
+/** @defgroup USBH_SIM_DEV_Private_Defines
+  * @{
+  */
+#define SIM_HID_REQ_GET_REPORT                   0x01U
+#define SIM_HID_REQ_SET_REPORT                   0x09U
+#define SIM_HID_REQ_SET_IDLE                     0x0AU
+#define SIM_HID_REQ_SET_PROTOCOL                 0x0BU
+#define SIM_HID_DESC_TYPE_REPORT                 0x22U
+
+#define SIM_CDC_REQ_SET_LINE_CODING              0x20U
+#define SIM_CDC_REQ_GET_LINE_CODING              0x21U
+#define SIM_CDC_REQ_SET_CONTROL_LINE_STATE       0x22U
+
+#define SIM_HUB_DESC_TYPE                        0x29U
+#define SIM_HUB_FEATURE_PORT_RESET               4U
+#define SIM_HUB_FEATURE_PORT_POWER               8U
+#define SIM_HUB_FEATURE_C_PORT_CONNECTION        16U
+#define SIM_HUB_PORT_CONNECTION                  0x0001U
+#define SIM_HUB_PORT_ENABLE                      0x0002U
+#define SIM_HUB_PORT_RESET                       0x0010U
+#define SIM_HUB_PORT_POWER                       0x0100U
+#define SIM_HUB_PORT_LOW_SPEED                   0x0200U
+#define SIM_HUB_RESET_TIME                       USBH_SIM_MS(15U)
+
+#define SIM_KEY_MOD_LSHIFT                       0x02U
+
+#define SIM_COMPOSITE_KBD_INTERFACE              2U
+#define SIM_COMPOSITE_KBD_EP                     0x84U
+
+#define SIM_AUDIO_REQ_SET_CUR                    0x01U
+#define SIM_AUDIO_REQ_GET_CUR                    0x81U
+#define SIM_AUDIO_SAMPLING_FREQ_CONTROL          0x01U
+#define SIM_AUDIO_STREAMING_INTERFACE            1U
+#define SIM_AUDIO_EP                             0x81U
+#define SIM_AUDIO_FRAME_SIZE                     4U     /* Stereo 16-bit */
+/**
+  * @}
+  */
+
+/** @defgroup USBH_SIM_DEV_Private_Variables
+  * @{
+  */
+static const uint8_t SIM_LangIdDesc[] = { 0x04U, 0x03U, 0x09U, 0x04U };
+
+static const uint8_t SIM_MfcDesc[] =
+{
+  0x18U, 0x03U, 'U', 0U, 'S', 0U, 'B', 0U, 'H', 0U, 'o', 0U, 's', 0U, 't', 0U,
+  'G', 0U, 'i', 0U, 'g', 0U, 'a', 0U
+};
+
+static const uint8_t SIM_KbdProductDesc[] =
+{
+  0x22U, 0x03U, 'V', 0U, 'i', 0U, 'r', 0U, 't', 0U, 'u', 0U, 'a', 0U, 'l', 0U,
+  ' ', 0U, 'K', 0U, 'e', 0U, 'y', 0U, 'b', 0U, 'o', 0U, 'a', 0U, 'r', 0U, 'd', 0U
+};
+
+static const uint8_t SIM_MouseProductDesc[] =
+{
+  0x1CU, 0x03U, 'V', 0U, 'i', 0U, 'r', 0U, 't', 0U, 'u', 0U, 'a', 0U, 'l', 0U,
+  ' ', 0U, 'M', 0U, 'o', 0U, 'u', 0U, 's', 0U, 'e', 0U
+};
+
+static const uint8_t SIM_CdcProductDesc[] =
+{
+  0x1AU, 0x03U, 'V', 0U, 'i', 0U, 'r', 0U, 't', 0U, 'u', 0U, 'a', 0U, 'l', 0U,
+  ' ', 0U, 'U', 0U, 'A', 0U, 'R', 0U, 'T', 0U
+};
+
+static const uint8_t SIM_SerialDesc[] =
+{
+  0x12U, 0x03U, '0', 0U, '0', 0U, '0', 0U, '0', 0U, '0', 0U, '0', 0U, '0', 0U,
+  '1', 0U
+};
+
+static const uint8_t SIM_HubProductDesc[] =
+{
+  0x18U, 0x03U, 'V', 0U, 'i', 0U, 'r', 0U, 't', 0U, 'u', 0U, 'a', 0U, 'l', 0U,
+  ' ', 0U, 'H', 0U, 'u', 0U, 'b', 0U
+};
+
+/* "Virtual Terminal \u2013 \u00B5C", not plain ASCII */
+static const uint8_t SIM_CompositeProductDesc[] =
+{
+  0x2CU, 0x03U, 'V', 0U, 'i', 0U, 'r', 0U, 't', 0U, 'u', 0U, 'a', 0U, 'l', 0U,
+  ' ', 0U, 'T', 0U, 'e', 0U, 'r', 0U, 'm', 0U, 'i', 0U, 'n', 0U, 'a', 0U, 'l', 0U,
+  ' ', 0U, 0x13U, 0x20U, ' ', 0U, 0xB5U, 0x00U, 'C', 0U
+};
+
+static const uint8_t SIM_MicProductDesc[] =
+{
+  0x26U, 0x03U, 'V', 0U, 'i', 0U, 'r', 0U, 't', 0U, 'u', 0U, 'a', 0U, 'l', 0U,
+  ' ', 0U, 'M', 0U, 'i', 0U, 'c', 0U, 'r', 0U, 'o', 0U, 'p', 0U, 'h', 0U, 'o', 0U,
+  'n', 0U, 'e', 0U
+};
+
+static const uint8_t *const SIM_KbdStrings[] =
+{
+  SIM_LangIdDesc, SIM_MfcDesc, SIM_KbdProductDesc, SIM_SerialDesc
+};
+
+static const uint8_t *const SIM_MouseStrings[] =
+{
+  SIM_LangIdDesc, SIM_MfcDesc, SIM_MouseProductDesc, SIM_SerialDesc
+};
+
+static const uint8_t *const SIM_CdcStrings[] =
+{
+  SIM_LangIdDesc, SIM_MfcDesc, SIM_CdcProductDesc, SIM_SerialDesc
+};
+
+static const uint8_t *const SIM_HubStrings[] =
+{
+  SIM_LangIdDesc, SIM_MfcDesc, SIM_HubProductDesc, SIM_SerialDesc
+};
+
+static const uint8_t *const SIM_CompositeStrings[] =
+{
+  SIM_LangIdDesc, SIM_MfcDesc, SIM_CompositeProductDesc, SIM_SerialDesc
+};
+
+static const uint8_t *const SIM_MicStrings[] =
+{
+  SIM_LangIdDesc, SIM_MfcDesc, SIM_MicProductDesc, SIM_SerialDesc
+};
+
+static const uint8_t SIM_KbdDevDesc[] =
+{
+  0x12U, 0x01U, 0x10U, 0x01U, 0x00U, 0x00U, 0x00U, 0x08U,
+  0x09U, 0x12U, 0x01U, 0x00U, 0x00U, 0x01U, 0x01U, 0x02U, 0x03U, 0x01U
+};
+
+static const uint8_t SIM_KbdReportDesc[] =
+{
+  0x05U, 0x01U, 0x09U, 0x06U, 0xA1U, 0x01U, 0x05U, 0x07U, 0x19U, 0xE0U, 0x29U, 0xE7U,
+  0x15U, 0x00U, 0x25U, 0x01U, 0x75U, 0x01U, 0x95U, 0x08U, 0x81U, 0x02U, 0x95U, 0x01U,
+  0x75U, 0x08U, 0x81U, 0x01U, 0x95U, 0x05U, 0x75U, 0x01U, 0x05U, 0x08U, 0x19U, 0x01U,
+  0x29U, 0x05U, 0x91U, 0x02U, 0x95U, 0x01U, 0x75U, 0x03U, 0x91U, 0x01U, 0x95U, 0x06U,
+  0x75U, 0x08U, 0x15U, 0x00U, 0x25U, 0x65U, 0x05U, 0x07U, 0x19U, 0x00U, 0x29U, 0x65U,
+  0x81U, 0x00U, 0xC0U
+};
+
+static const uint8_t SIM_KbdCfgDesc[] =
+{
+  /* Configuration */
+  0x09U, 0x02U, 0x22U, 0x00U, 0x01U, 0x01U, 0x00U, 0xA0U, 0x32U,
+  /* Interface 0: HID, boot, keyboard */
+  0x09U, 0x04U, 0x00U, 0x00U, 0x01U, 0x03U, 0x01U, 0x01U, 0x00U,
+  /* HID */
+  0x09U, 0x21U, 0x11U, 0x01U, 0x00U, 0x01U, 0x22U, sizeof(SIM_KbdReportDesc), 0x00U,
+  /* Endpoint 1 IN, interrupt, 8 bytes, 10 ms */
+  0x07U, 0x05U, 0x81U, 0x03U, 0x08U, 0x00U, 0x0AU
+};
+
+static const uint8_t SIM_MouseDevDesc[] =
+{
+  0x12U, 0x01U, 0x10U, 0x01U, 0x00U, 0x00U, 0x00U, 0x08U,
+  0x09U, 0x12U, 0x02U, 0x00U, 0x00U, 0x01U, 0x01U, 0x02U, 0x03U, 0x01U
+};
+
+static const uint8_t SIM_MouseReportDesc[] =
+{
+  0x05U, 0x01U, 0x09U, 0x02U, 0xA1U, 0x01U, 0x09U, 0x01U, 0xA1U, 0x00U, 0x05U, 0x09U,
+  0x19U, 0x01U, 0x29U, 0x03U, 0x15U, 0x00U, 0x25U, 0x01U, 0x95U, 0x03U, 0x75U, 0x01U,
+  0x81U, 0x02U, 0x95U, 0x01U, 0x75U, 0x05U, 0x81U, 0x01U, 0x05U, 0x01U, 0x09U, 0x30U,
+  0x09U, 0x31U, 0x15U, 0x81U, 0x25U, 0x7FU, 0x75U, 0x08U, 0x95U, 0x02U, 0x81U, 0x06U,
+  0xC0U, 0xC0U
+};
+
+static const uint8_t SIM_MouseCfgDesc[] =
+{
+  /* Configuration */
+  0x09U, 0x02U, 0x22U, 0x00U, 0x01U, 0x01U, 0x00U, 0xA0U, 0x32U,
+  /* Interface 0: HID, boot, mouse */
+  0x09U, 0x04U, 0x00U, 0x00U, 0x01U, 0x03U, 0x01U, 0x02U, 0x00U,
+  /* HID */
+  0x09U, 0x21U, 0x11U, 0x01U, 0x00U, 0x01U, 0x22U, sizeof(SIM_MouseReportDesc), 0x00U,
+  /* Endpoint 1 IN, interrupt, 4 bytes, 10 ms */
+  0x07U, 0x05U, 0x81U, 0x03U, 0x04U, 0x00U, 0x0AU
+};
+
+static const uint8_t SIM_CdcDevDesc[] =
+{
+  0x12U, 0x01U, 0x00U, 0x02U, 0x02U, 0x00U, 0x00U, 0x40U,
+  0x09U, 0x12U, 0x03U, 0x00U, 0x00U, 0x01U, 0x01U, 0x02U, 0x03U, 0x01U
+};
+
+static const uint8_t SIM_CdcCfgDesc[] =
+{
+  /* Configuration */
+  0x09U, 0x02U, 0x43U, 0x00U, 0x02U, 0x01U, 0x00U, 0xC0U, 0x32U,
+  /* Interface 0: CDC, ACM, AT commands */
+  0x09U, 0x04U, 0x00U, 0x00U, 0x01U, 0x02U, 0x02U, 0x01U, 0x00U,
+  /* Header, call management, ACM and union functional descriptors */
+  0x05U, 0x24U, 0x00U, 0x10U, 0x01U,
+  0x05U, 0x24U, 0x01U, 0x00U, 0x01U,
+  0x04U, 0x24U, 0x02U, 0x02U,
+  0x05U, 0x24U, 0x06U, 0x00U, 0x01U,
+  /* Endpoint 3 IN, interrupt, 8 bytes, 16 ms */
+  0x07U, 0x05U, 0x83U, 0x03U, 0x08U, 0x00U, 0x10U,
+  /* Interface 1: CDC data */
+  0x09U, 0x04U, 0x01U, 0x00U, 0x02U, 0x0AU, 0x00U, 0x00U, 0x00U,
+  /* Endpoint 1 OUT, bulk, 64 bytes */
+  0x07U, 0x05U, 0x01U, 0x02U, 0x40U, 0x00U, 0x00U,
+  /* Endpoint 2 IN, bulk, 64 bytes */
+  0x07U, 0x05U, 0x82U, 0x02U, 0x40U, 0x00U, 0x00U
+};
+
+static const uint8_t SIM_HubDevDesc[] =
+{
+  0x12U, 0x01U, 0x10U, 0x01U, 0x09U, 0x00U, 0x00U, 0x40U,
+  0x09U, 0x12U, 0x04U, 0x00U, 0x00U, 0x01U, 0x01U, 0x02U, 0x03U, 0x01U
+};
+
+static const uint8_t SIM_HubCfgDesc[] =
+{
+  /* Configuration */
+  0x09U, 0x02U, 0x19U, 0x00U, 0x01U, 0x01U, 0x00U, 0xE0U, 0x32U,
+  /* Interface 0: hub */
+  0x09U, 0x04U, 0x00U, 0x00U, 0x01U, 0x09U, 0x00U, 0x00U, 0x00U,
+  /* Endpoint 1 IN, interrupt, 1 byte, 12 ms */
+  0x07U, 0x05U, 0x81U, 0x03U, 0x01U, 0x00U, 0x0CU
+};
+
+static const uint8_t SIM_CompositeDevDesc[] =
+{
+  0x12U, 0x01U, 0x00U, 0x02U, 0xEFU, 0x02U, 0x01U, 0x40U,
+  0x09U, 0x12U, 0x05U, 0x00U, 0x00U, 0x01U, 0x01U, 0x02U, 0x03U, 0x01U
+};
+
+static const uint8_t SIM_CompositeCfgDesc[] =
+{
+  /* Configuration */
+  0x09U, 0x02U, 0x64U, 0x00U, 0x03U, 0x01U, 0x00U, 0xA0U, 0x32U,
+  /* Interface association: interfaces 0 and 1, CDC ACM */
+  0x08U, 0x0BU, 0x00U, 0x02U, 0x02U, 0x02U, 0x01U, 0x00U,
+  /* Interface 0: CDC, ACM, AT commands */
+  0x09U, 0x04U, 0x00U, 0x00U, 0x01U, 0x02U, 0x02U, 0x01U, 0x00U,
+  /* Header, call management, ACM and union functional descriptors */
+  0x05U, 0x24U, 0x00U, 0x10U, 0x01U,
+  0x05U, 0x24U, 0x01U, 0x00U, 0x01U,
+  0x04U, 0x24U, 0x02U, 0x02U,
+  0x05U, 0x24U, 0x06U, 0x00U, 0x01U,
+  /* Endpoint 3 IN, interrupt, 8 bytes, 16 ms */
+  0x07U, 0x05U, 0x83U, 0x03U, 0x08U, 0x00U, 0x10U,
+  /* Interface 1: CDC data */
+  0x09U, 0x04U, 0x01U, 0x00U, 0x02U, 0x0AU, 0x00U, 0x00U, 0x00U,
+  /* Endpoint 1 OUT, bulk, 64 bytes */
+  0x07U, 0x05U, 0x01U, 0x02U, 0x40U, 0x00U, 0x00U,
+  /* Endpoint 2 IN, bulk, 64 bytes */
+  0x07U, 0x05U, 0x82U, 0x02U, 0x40U, 0x00U, 0x00U,
+  /* Interface 2: HID, boot, keyboard */
+  0x09U, 0x04U, 0x02U, 0x00U, 0x01U, 0x03U, 0x01U, 0x01U, 0x00U,
+  /* HID */
+  0x09U, 0x21U, 0x11U, 0x01U, 0x00U, 0x01U, 0x22U, sizeof(SIM_KbdReportDesc), 0x00U,
+  /* Endpoint 4 IN, interrupt, 8 bytes, 10 ms */
+  0x07U, 0x05U, 0x84U, 0x03U, 0x08U, 0x00U, 0x0AU
+};
+
+static const uint8_t SIM_MicDevDesc[] =
+{
+  0x12U, 0x01U, 0x10U, 0x01U, 0x00U, 0x00U, 0x00U, 0x40U,
+  0x09U, 0x12U, 0x06U, 0x00U, 0x00U, 0x01U, 0x01U, 0x02U, 0x03U, 0x01U
+};
+
+static const uint8_t SIM_MicCfgDesc[] =
+{
+  /* Configuration */
+  0x09U, 0x02U, 0x67U, 0x00U, 0x02U, 0x01U, 0x00U, 0x80U, 0x32U,
+  /* Interface 0: audio control */
+  0x09U, 0x04U, 0x00U, 0x00U, 0x00U, 0x01U, 0x01U, 0x00U, 0x00U,
+  /* Header, UAC 1.0, interface 1 in the collection */
+  0x09U, 0x24U, 0x01U, 0x00U, 0x01U, 0x1EU, 0x00U, 0x01U, 0x01U,
+  /* Input terminal 1: microphone, stereo */
+  0x0CU, 0x24U, 0x02U, 0x01U, 0x01U, 0x02U, 0x00U, 0x02U, 0x03U, 0x00U, 0x00U, 0x00U,
+  /* Output terminal 2: USB streaming, from terminal 1 */
+  0x09U, 0x24U, 0x03U, 0x02U, 0x01U, 0x01U, 0x00U, 0x01U, 0x00U,
+  /* Interface 1 alternate 0: audio streaming, no bandwidth */
+  0x09U, 0x04U, 0x01U, 0x00U, 0x00U, 0x01U, 0x02U, 0x00U, 0x00U,
+  /* Interface 1 alternate 1: audio streaming */
+  0x09U, 0x04U, 0x01U, 0x01U, 0x01U, 0x01U, 0x02U, 0x00U, 0x00U,
+  /* General: terminal 2, PCM */
+  0x07U, 0x24U, 0x01U, 0x02U, 0x01U, 0x01U, 0x00U,
+  /* Format type I: 2 channels, 2 bytes, 16 bits, 44100 and 48000 Hz */
+  0x0EU, 0x24U, 0x02U, 0x01U, 0x02U, 0x02U, 0x10U, 0x02U,
+  0x44U, 0xACU, 0x00U, 0x80U, 0xBBU, 0x00U,
+  /* Endpoint 1 IN, isochronous asynchronous, 196 bytes, 1 ms */
+  0x09U, 0x05U, 0x81U, 0x05U, 0xC4U, 0x00U, 0x01U, 0x00U, 0x00U,
+  /* General: sampling frequency control */
+  0x07U, 0x25U, 0x01U, 0x01U, 0x00U, 0x00U, 0x00U
+};
+/**
+  * @}
+  */
+
+/** @defgroup USBH_SIM_DEV_Private_Functions
+  * @{
+  */
+static USBH_SIM_RespTypeDef SIM_HidSetup(USBH_SIM_DeviceTypeDef *pdev,
+                                         const USB_Setup_TypeDef *setup,
+                                         uint8_t *data, uint16_t *length);
+static USBH_SIM_RespTypeDef SIM_HidDataIn(USBH_SIM_DeviceTypeDef *pdev, uint8_t ep_addr,
+                                          uint8_t *buff, uint16_t *length);
+static void SIM_HidReset(USBH_SIM_DeviceTypeDef *pdev);
+static USBH_SIM_RespTypeDef SIM_CdcSetup(USBH_SIM_DeviceTypeDef *pdev,
+                                         const USB_Setup_TypeDef *setup,
+                                         uint8_t *data, uint16_t *length);
+static USBH_SIM_RespTypeDef SIM_CdcDataIn(USBH_SIM_DeviceTypeDef *pdev, uint8_t ep_addr,
+                                          uint8_t *buff, uint16_t *length);
+static USBH_SIM_RespTypeDef SIM_CdcDataOut(USBH_SIM_DeviceTypeDef *pdev, uint8_t ep_addr,
+                                           const uint8_t *buff, uint16_t length);
+static void SIM_CdcReset(USBH_SIM_DeviceTypeDef *pdev);
+static USBH_SIM_RespTypeDef SIM_HubSetup(USBH_SIM_DeviceTypeDef *pdev,
+                                         const USB_Setup_TypeDef *setup,
+                                         uint8_t *data, uint16_t *length);
+static USBH_SIM_RespTypeDef SIM_HubDataIn(USBH_SIM_DeviceTypeDef *pdev, uint8_t ep_addr,
+                                          uint8_t *buff, uint16_t *length);
+static void SIM_HubReset(USBH_SIM_DeviceTypeDef *pdev);
+static USBH_SIM_DeviceTypeDef *SIM_HubRoute(USBH_SIM_DeviceTypeDef *pdev, uint8_t address);
+static void SIM_HubUpdate(USBH_SIM_HubDevTypeDef *phub);
+static USBH_SIM_RespTypeDef SIM_CompositeSetup(USBH_SIM_DeviceTypeDef *pdev,
+                                               const USB_Setup_TypeDef *setup,
+                                               uint8_t *data, uint16_t *length);
+static USBH_SIM_RespTypeDef SIM_CompositeDataIn(USBH_SIM_DeviceTypeDef *pdev, uint8_t ep_addr,
+                                                uint8_t *buff, uint16_t *length);
+static USBH_SIM_RespTypeDef SIM_CompositeDataOut(USBH_SIM_DeviceTypeDef *pdev, uint8_t ep_addr,
+                                                 const uint8_t *buff, uint16_t length);
+static void SIM_CompositeReset(USBH_SIM_DeviceTypeDef *pdev);
+static USBH_SIM_RespTypeDef SIM_MicSetup(USBH_SIM_DeviceTypeDef *pdev,
+                                         const USB_Setup_TypeDef *setup,
+                                         uint8_t *data, uint16_t *length);
+static USBH_SIM_RespTypeDef SIM_MicDataIn(USBH_SIM_DeviceTypeDef *pdev, uint8_t ep_addr,
+                                          uint8_t *buff, uint16_t *length);
+static void SIM_MicReset(USBH_SIM_DeviceTypeDef *pdev);
+static uint8_t SIM_KeyUsage(char c, uint8_t *modifier);
+
+static const USBH_SIM_DevOpsTypeDef SIM_HidOps =
+{
+  SIM_HidSetup,
+  SIM_HidDataIn,
+  NULL,
+  SIM_HidReset,
+  NULL,
+};
+
+static const USBH_SIM_DevOpsTypeDef SIM_CdcOps =
+{
+  SIM_CdcSetup,
+  SIM_CdcDataIn,
+  SIM_CdcDataOut,
+  SIM_CdcReset,
+  NULL,
+};
+
+static const USBH_SIM_DevOpsTypeDef SIM_HubOps =
+{
+  SIM_HubSetup,
+  SIM_HubDataIn,
+  NULL,
+  SIM_HubReset,
+  SIM_HubRoute,
+};
+
+static const USBH_SIM_DevOpsTypeDef SIM_CompositeOps =
+{
+  SIM_CompositeSetup,
+  SIM_CompositeDataIn,
+  SIM_CompositeDataOut,
+  SIM_CompositeReset,
+  NULL,
+};
+
+static const USBH_SIM_DevOpsTypeDef SIM_MicOps =
+{
+  SIM_MicSetup,
+  SIM_MicDataIn,
+  NULL,
+  SIM_MicReset,
+  NULL,
+};
+
+
+/**
+  * @brief  USBH_SIM_KeyboardInit
+  *         Build a low speed boot keyboard.
+  * @param  pkbd: Device storage
+  * @retval None
+  */
+void USBH_SIM_KeyboardInit(USBH_SIM_HidDevTypeDef *pkbd)
+{
+  (void)memset(pkbd, 0, sizeof(USBH_SIM_HidDevTypeDef));
+  pkbd->Dev.Name = "keyboard";
+  pkbd->Dev.Speed = (uint8_t)USBH_SPEED_LOW;
+  pkbd->Dev.pDevDesc = SIM_KbdDevDesc;
+  pkbd->Dev.pCfgDesc = SIM_KbdCfgDesc;
+  pkbd->Dev.pStrDesc = SIM_KbdStrings;
+  pkbd->Dev.NumStrDesc = (uint8_t)(sizeof(SIM_KbdStrings) / sizeof(SIM_KbdStrings[0]));
+  pkbd->Dev.pOps = &SIM_HidOps;
+  pkbd->Dev.CtlLatency = (uint32_t)USBH_SIM_US(200U);
+  pkbd->Dev.pUser = pkbd;
+  pkbd->ReportSize = 8U;
+}
+
+
+/**
+  * @brief  USBH_SIM_MouseInit
+  *         Build a low speed boot mouse.
+  * @param  pmouse: Device storage
+  * @retval None
+  */
+void USBH_SIM_MouseInit(USBH_SIM_HidDevTypeDef *pmouse)
+{
+  (void)memset(pmouse, 0, sizeof(USBH_SIM_HidDevTypeDef));
+  pmouse->Dev.Name = "mouse";
+  pmouse->Dev.Speed = (uint8_t)USBH_SPEED_LOW;
+  pmouse->Dev.pDevDesc = SIM_MouseDevDesc;
+  pmouse->Dev.pCfgDesc = SIM_MouseCfgDesc;
+  pmouse->Dev.pStrDesc = SIM_MouseStrings;
+  pmouse->Dev.NumStrDesc = (uint8_t)(sizeof(SIM_MouseStrings) / sizeof(SIM_MouseStrings[0]));
+  pmouse->Dev.pOps = &SIM_HidOps;
+  pmouse->Dev.CtlLatency = (uint32_t)USBH_SIM_US(200U);
+  pmouse->Dev.pUser = pmouse;
+  pmouse->ReportSize = 4U;
+}
+
+
+/**
+  * @brief  USBH_SIM_CdcInit
+  *         Build a full speed CDC-ACM loopback device.
+  * @param  pcdc: Device storage
+  * @retval None
+  */
+void USBH_SIM_CdcInit(USBH_SIM_CdcDevTypeDef *pcdc)
+{
+  (void)memset(pcdc, 0, sizeof(USBH_SIM_CdcDevTypeDef));
+  pcdc->Dev.Name = "cdc";
+  pcdc->Dev.Speed = (uint8_t)USBH_SPEED_FULL;
+  pcdc->Dev.pDevDesc = SIM_CdcDevDesc;
+  pcdc->Dev.pCfgDesc = SIM_CdcCfgDesc;
+  pcdc->Dev.pStrDesc = SIM_CdcStrings;
+  pcdc->Dev.NumStrDesc = (uint8_t)(sizeof(SIM_CdcStrings) / sizeof(SIM_CdcStrings[0]));
+  pcdc->Dev.pOps = &SIM_CdcOps;
+  pcdc->Dev.CtlLatency = (uint32_t)USBH_SIM_US(50U);
+  pcdc->Dev.pUser = pcdc;
+  pcdc->Capacity = USBH_SIM_CDC_FIFO_SIZE;
+
+  /* 115200 8N1 */
+  pcdc->LineCoding[0] = 0x00U;
+  pcdc->LineCoding[1] = 0xC2U;
+  pcdc->LineCoding[2] = 0x01U;
+  pcdc->LineCoding[3] = 0x00U;
+  pcdc->LineCoding[6] = 8U;
+}
+
+
+/**
+  * @brief  USBH_SIM_HubInit
+  *         Build a full speed hub.
+  * @param  phub: Device storage
+  * @param  num_ports: Downstream ports, at most USBH_SIM_HUB_MAX_PORTS
+  * @retval None
+  */
+void USBH_SIM_HubInit(USBH_SIM_HubDevTypeDef *phub, uint8_t num_ports)
+{
+  (void)memset(phub, 0, sizeof(USBH_SIM_HubDevTypeDef));
+  phub->Dev.Name = "hub";
+  phub->Dev.Speed = (uint8_t)USBH_SPEED_FULL;
+  phub->Dev.pDevDesc = SIM_HubDevDesc;
+  phub->Dev.pCfgDesc = SIM_HubCfgDesc;
+  phub->Dev.pStrDesc = SIM_HubStrings;
+  phub->Dev.NumStrDesc = (uint8_t)(sizeof(SIM_HubStrings) / sizeof(SIM_HubStrings[0]));
+  phub->Dev.pOps = &SIM_HubOps;
+  phub->Dev.CtlLatency = (uint32_t)USBH_SIM_US(100U);
+  phub->Dev.pUser = phub;
+  phub->NumPorts = (num_ports < USBH_SIM_HUB_MAX_PORTS) ? num_ports : (uint8_t)USBH_SIM_HUB_MAX_PORTS;
+  phub->ResetTime = SIM_HUB_RESET_TIME;
+}
+
+
+/**
+  * @brief  USBH_SIM_CompositeInit
+  *         Build a full speed CDC-ACM loopback and keyboard composite device.
+  * @param  pcomp: Device storage
+  * @retval None
+  */
+void USBH_SIM_CompositeInit(USBH_SIM_CompositeDevTypeDef *pcomp)
+{
+  (void)memset(pcomp, 0, sizeof(USBH_SIM_CompositeDevTypeDef));
+  USBH_SIM_CdcInit(&pcomp->Cdc);
+  USBH_SIM_KeyboardInit(&pcomp->Kbd);
+
+  pcomp->Dev.Name = "composite";
+  pcomp->Dev.Speed = (uint8_t)USBH_SPEED_FULL;
+  pcomp->Dev.pDevDesc = SIM_CompositeDevDesc;
+  pcomp->Dev.pCfgDesc = SIM_CompositeCfgDesc;
+  pcomp->Dev.pStrDesc = SIM_CompositeStrings;
+  pcomp->Dev.NumStrDesc = (uint8_t)(sizeof(SIM_CompositeStrings) / sizeof(SIM_CompositeStrings[0]));
+  pcomp->Dev.pOps = &SIM_CompositeOps;
+  pcomp->Dev.CtlLatency = (uint32_t)USBH_SIM_US(50U);
+  pcomp->Dev.pUser = pcomp;
+}
+
+
+/**
+  * @brief  USBH_SIM_MicrophoneInit
+  *         Build a full speed UAC1 stereo microphone.
+  * @param  pmic: Device storage
+  * @retval None
+  */
+void USBH_SIM_MicrophoneInit(USBH_SIM_AudioDevTypeDef *pmic)
+{
+  (void)memset(pmic, 0, sizeof(USBH_SIM_AudioDevTypeDef));
+  pmic->Dev.Name = "microphone";
+  pmic->Dev.Speed = (uint8_t)USBH_SPEED_FULL;
+  pmic->Dev.pDevDesc = SIM_MicDevDesc;
+  pmic->Dev.pCfgDesc = SIM_MicCfgDesc;
+  pmic->Dev.pStrDesc = SIM_MicStrings;
+  pmic->Dev.NumStrDesc = (uint8_t)(sizeof(SIM_MicStrings) / sizeof(SIM_MicStrings[0]));
+  pmic->Dev.pOps = &SIM_MicOps;
+  pmic->Dev.CtlLatency = (uint32_t)USBH_SIM_US(50U);
+  pmic->Dev.pUser = pmic;
+  pmic->Frequency = 44100U;
+}
+
+
+/**
+  * @brief  USBH_SIM_HubAttach
+  *         Plug a virtual device into a hub port.
+  * @param  phub: Hub
+  * @param  port: Port number, from 1
+  * @param  pdev: Device
+  * @retval USBH Status
+  */
+USBH_StatusTypeDef USBH_SIM_HubAttach(USBH_SIM_HubDevTypeDef *phub, uint8_t port,
+                                      USBH_SIM_DeviceTypeDef *pdev)
+{
+  if ((port == 0U) || (port > phub->NumPorts) || (phub->pPortDev[port - 1U] != NULL))
+  {
+    return USBH_FAIL;
+  }
+
+  phub->pPortDev[port - 1U] = pdev;
+  USBH_SIM_ResetDevice(pdev);
+
+  if ((phub->Status[port - 1U] & SIM_HUB_PORT_POWER) != 0U)
+  {
+    phub->Status[port - 1U] |= SIM_HUB_PORT_CONNECTION;
+    phub->Change[port - 1U] |= SIM_HUB_PORT_CONNECTION;
+  }
+
+  return USBH_OK;
+}
+
+
+/**
+  * @brief  USBH_SIM_HubDetach
+  *         Unplug the device of a hub port.
+  * @param  phub: Hub
+  * @param  port: Port number, from 1
+  * @retval USBH Status
+  */
+USBH_StatusTypeDef USBH_SIM_HubDetach(USBH_SIM_HubDevTypeDef *phub, uint8_t port)
+{
+  if ((port == 0U) || (port > phub->NumPorts) || (phub->pPortDev[port - 1U] == NULL))
+  {
+    return USBH_FAIL;
+  }
+
+  phub->pPortDev[port - 1U] = NULL;
+
+  if ((phub->Status[port - 1U] & SIM_HUB_PORT_CONNECTION) != 0U)
+  {
+    phub->Change[port - 1U] |= SIM_HUB_PORT_CONNECTION;
+  }
+  phub->Status[port - 1U] &= SIM_HUB_PORT_POWER;
+
+  return USBH_OK;
+}
+
+
+/**
+  * @brief  USBH_SIM_HidPushReport
+  *         Queue an input report on a virtual HID device.
+  * @param  phid: Device
+  * @param  report: Report data
+  * @param  length: Report size, at most USBH_SIM_HID_REPORT_SIZE
+  * @retval USBH Status
+  */
+USBH_StatusTypeDef USBH_SIM_HidPushReport(USBH_SIM_HidDevTypeDef *phid,
+                                          const uint8_t *report, uint8_t length)
+{
+  if (((phid->Head - phid->Tail) >= USBH_SIM_HID_QUEUE_SIZE) ||
+      (length > USBH_SIM_HID_REPORT_SIZE))
+  {
+    return USBH_FAIL;
+  }
+
+  (void)memset(phid->Reports[phid->Head % USBH_SIM_HID_QUEUE_SIZE], 0, USBH_SIM_HID_REPORT_SIZE);
+  (void)memcpy(phid->Reports[phid->Head % USBH_SIM_HID_QUEUE_SIZE], report, length);
+  phid->Head++;
+
+  return USBH_OK;
+}
+
+
+/**
+  * @brief  USBH_SIM_KeyboardType
+  *         Queue press/release report pairs typing an ASCII string.
+  * @param  pkbd: Keyboard
+  * @param  text: Characters to type
+  * @retval USBH Status
+  */
+USBH_StatusTypeDef USBH_SIM_KeyboardType(USBH_SIM_HidDevTypeDef *pkbd, const char *text)
+{
+  uint8_t report[USBH_SIM_HID_REPORT_SIZE];
+  uint8_t modifier;
+
+  while (*text != '\0')
+  {
+    (void)memset(report, 0, sizeof(report));
+    report[2] = SIM_KeyUsage(*text, &modifier);
+    report[0] = modifier;
+
+    if ((report[2] == 0U) ||
+        (USBH_SIM_HidPushReport(pkbd, report, sizeof(report)) != USBH_OK))
+    {
+      return USBH_FAIL;
+    }
+
+    (void)memset(report, 0, sizeof(report));
+    if (USBH_SIM_HidPushReport(pkbd, report, sizeof(report)) != USBH_OK)
+    {
+      return USBH_FAIL;
+    }
+    text++;
+  }
+
+  return USBH_OK;
+}
+
+
+/**
+  * @brief  USBH_SIM_HidPending
+  *         Number of reports not yet read by the host.
+  * @param  phid: Device
+  * @retval Count
+  */
+uint32_t USBH_SIM_HidPending(USBH_SIM_HidDevTypeDef *phid)
+{
+  return phid->Head - phid->Tail;
+}
+
+
+/**
+  * @brief  SIM_KeyUsage
+  *         Map an ASCII character to a keyboard usage.
+  * @param  c: Character
+  * @param  modifier: Modifier byte to use
+  * @retval Usage ID, 0 when unsupported
+  */
+static uint8_t SIM_KeyUsage(char c, uint8_t *modifier)
+{
+  static const char symbols[] = "-=[]\\#;'`,./";
+  static const char shifted[] = "_+{}|~:\"~<>?";
+  static const char digits[] = "!@#$%^&*()";
+  uint32_t idx;
+
+  *modifier = 0U;
+
+  if ((c >= 'a') && (c <= 'z'))
+  {
+    return (uint8_t)(0x04U + (uint8_t)(c - 'a'));
+  }
+  if ((c >= 'A') && (c <= 'Z'))
+  {
+    *modifier = SIM_KEY_MOD_LSHIFT;
+    return (uint8_t)(0x04U + (uint8_t)(c - 'A'));
+  }
+  if ((c >= '1') && (c <= '9'))
+  {
+    return (uint8_t)(0x1EU + (uint8_t)(c - '1'));
+  }
+  if (c == '0')
+  {
+    return 0x27U;
+  }
+  if (c == '\n')
+  {
+    return 0x28U;
+  }
+  if (c == ' ')
+  {
+    return 0x2CU;
+  }
+
+  for (idx = 0U; digits[idx] != '\0'; idx++)
+  {
+    if (c == digits[idx])
+    {
+      *modifier = SIM_KEY_MOD_LSHIFT;
+      return (uint8_t)(0x1EU + idx);
+    }
+  }
+
+  for (idx = 0U; symbols[idx] != '\0'; idx++)
+  {
+    if (c == symbols[idx])
+    {
+      return (uint8_t)(0x2DU + idx);
+    }
+    if (c == shifted[idx])
+    {
+      *modifier = SIM_KEY_MOD_LSHIFT;
+      return (uint8_t)(0x2DU + idx);
+    }
+  }
+
+  return 0U;
+}
+
+
+/**
+  * @brief  SIM_HidSetup
+  *         HID class requests and the report descriptor.
+  */
+static USBH_SIM_RespTypeDef SIM_HidSetup(USBH_SIM_DeviceTypeDef *pdev,
+                                         const USB_Setup_TypeDef *setup,
+                                         uint8_t *data, uint16_t *length)
+{
+  USBH_SIM_HidDevTypeDef *phid = (USBH_SIM_HidDevTypeDef *)pdev->pUser;
+  const uint8_t *pdesc;
+  uint16_t len;
+
+  if ((setup->b.bRequest == USB_REQ_GET_DESCRIPTOR) &&
+      ((setup->b.wValue.w >> 8) == SIM_HID_DESC_TYPE_REPORT))
+  {
+    if (phid->ReportSize == 8U)
+    {
+      pdesc = SIM_KbdReportDesc;
+      len = (uint16_t)sizeof(SIM_KbdReportDesc);
+    }
+    else
+    {
+      pdesc = SIM_MouseReportDesc;
+      len = (uint16_t)sizeof(SIM_MouseReportDesc);
+    }
+    if (len > *length)
+    {
+      len = *length;
+    }
+    (void)memcpy(data, pdesc, len);
+    *length = len;
+    return USBH_SIM_ACK;
+  }
+
+  if ((setup->b.bmRequestType & 0x60U) != USB_REQ_TYPE_CLASS)
+  {
+    return USBH_SIM_STALL;
+  }
+
+  switch (setup->b.bRequest)
+  {
+    case SIM_HID_REQ_GET_REPORT:
+      len = phid->ReportSize;
+      if (len > *length)
+      {
+        len = *length;
+      }
+      (void)memset(data, 0, len);
+      *length = len;
+      return USBH_SIM_ACK;
+
+    case SIM_HID_REQ_SET_REPORT:
+      if (*length != 0U)
+      {
+        phid->Leds = data[0];
+      }
+      return USBH_SIM_ACK;
+
+    case SIM_HID_REQ_SET_IDLE:
+      phid->Idle = (uint8_t)(setup->b.wValue.w >> 8);
+      return USBH_SIM_ACK;
+
+    case SIM_HID_REQ_SET_PROTOCOL:
+      phid->Protocol = (uint8_t)setup->b.wValue.w;
+      return USBH_SIM_ACK;
+
+    default:
+      return USBH_SIM_STALL;
+  }
+}
+
+
+/**
+  * @brief  SIM_HidDataIn
+  *         Interrupt IN: next queued report, NAK when idle.
+  */
+static USBH_SIM_RespTypeDef SIM_HidDataIn(USBH_SIM_DeviceTypeDef *pdev, uint8_t ep_addr,
+                                          uint8_t *buff, uint16_t *length)
+{
+  USBH_SIM_HidDevTypeDef *phid = (USBH_SIM_HidDevTypeDef *)pdev->pUser;
+  uint16_t len = phid->ReportSize;
+
+  UNUSED(ep_addr);
+
+  if (phid->Head == phid->Tail)
+  {
+    return USBH_SIM_NAK;
+  }
+
+  if (len > *length)
+  {
+    len = *length;
+  }
+  (void)memcpy(buff, phid->Reports[phid->Tail % USBH_SIM_HID_QUEUE_SIZE], len);
+  phid->Tail++;
+  *length = len;
+
+  return USBH_SIM_ACK;
+}
+
+
+/**
+  * @brief  SIM_HidReset
+  */
+static void SIM_HidReset(USBH_SIM_DeviceTypeDef *pdev)
+{
+  USBH_SIM_HidDevTypeDef *phid = (USBH_SIM_HidDevTypeDef *)pdev->pUser;
+
+  phid->Protocol = 1U;
+  phid->Idle = 0U;
+  phid->Leds = 0U;
+}
+
+
+/**
+  * @brief  SIM_CdcSetup
+  *         CDC-ACM class requests.
+  */
+static USBH_SIM_RespTypeDef SIM_CdcSetup(USBH_SIM_DeviceTypeDef *pdev,
+                                         const USB_Setup_TypeDef *setup,
+                                         uint8_t *data, uint16_t *length)
+{
+  USBH_SIM_CdcDevTypeDef *pcdc = (USBH_SIM_CdcDevTypeDef *)pdev->pUser;
+  uint16_t len;
+
+  if ((setup->b.bmRequestType & 0x60U) != USB_REQ_TYPE_CLASS)
+  {
+    return USBH_SIM_STALL;
+  }
+
+  switch (setup->b.bRequest)
+  {
+    case SIM_CDC_REQ_SET_LINE_CODING:
+      len = (*length < sizeof(pcdc->LineCoding)) ? *length : (uint16_t)sizeof(pcdc->LineCoding);
+      (void)memcpy(pcdc->LineCoding, data, len);
+      return USBH_SIM_ACK;
+
+    case SIM_CDC_REQ_GET_LINE_CODING:
+      len = (*length < sizeof(pcdc->LineCoding)) ? *length : (uint16_t)sizeof(pcdc->LineCoding);
+      (void)memcpy(data, pcdc->LineCoding, len);
+      *length = len;
+      return USBH_SIM_ACK;
+
+    case SIM_CDC_REQ_SET_CONTROL_LINE_STATE:
+      pcdc->LineState = setup->b.wValue.w;
+      return USBH_SIM_ACK;
+
+    default:
+      return USBH_SIM_STALL;
+  }
+}
+
+
+/**
+  * @brief  SIM_CdcDataIn
+  *         Bulk IN returns looped-back data, notification IN always NAKs.
+  */
+static USBH_SIM_RespTypeDef SIM_CdcDataIn(USBH_SIM_DeviceTypeDef *pdev, uint8_t ep_addr,
+                                          uint8_t *buff, uint16_t *length)
+{
+  USBH_SIM_CdcDevTypeDef *pcdc = (USBH_SIM_CdcDevTypeDef *)pdev->pUser;
+  uint16_t len = 0U;
+
+  if ((ep_addr != 0x82U) || (pcdc->Head == pcdc->Tail))
+  {
+    return USBH_SIM_NAK;
+  }
+
+  while ((len < *length) && (pcdc->Tail != pcdc->Head))
+  {
+    buff[len] = pcdc->Fifo[pcdc->Tail % USBH_SIM_CDC_FIFO_SIZE];
+    pcdc->Tail++;
+    len++;
+  }
+  *length = len;
+
+  return USBH_SIM_ACK;
+}
+
+
+/**
+  * @brief  SIM_CdcDataOut
+  *         Bulk OUT is queued for loopback, NAK when the FIFO lacks room.
+  */
+static USBH_SIM_RespTypeDef SIM_CdcDataOut(USBH_SIM_DeviceTypeDef *pdev, uint8_t ep_addr,
+                                           const uint8_t *buff, uint16_t length)
+{
+  USBH_SIM_CdcDevTypeDef *pcdc = (USBH_SIM_CdcDevTypeDef *)pdev->pUser;
+  uint16_t idx;
+
+  if (ep_addr != 0x01U)
+  {
+    return USBH_SIM_STALL;
+  }
+
+  if ((pcdc->Capacity - (pcdc->Head - pcdc->Tail)) < length)
+  {
+    return USBH_SIM_NAK;
+  }
+
+  for (idx = 0U; idx < length; idx++)
+  {
+    pcdc->Fifo[pcdc->Head % USBH_SIM_CDC_FIFO_SIZE] = buff[idx];
+    pcdc->Head++;
+  }
+
+  return USBH_SIM_ACK;
+}
+
+
+/**
+  * @brief  SIM_CdcReset
+  */
+static void SIM_CdcReset(USBH_SIM_DeviceTypeDef *pdev)
+{
+  USBH_SIM_CdcDevTypeDef *pcdc = (USBH_SIM_CdcDevTypeDef *)pdev->pUser;
+
+  pcdc->Head = 0U;
+  pcdc->Tail = 0U;
+  pcdc->LineState = 0U;
+}
+
+
+/**
+  * @brief  SIM_CompositeSetup
+  *         Interface requests go to the function owning the interface.
+  */
+static USBH_SIM_RespTypeDef SIM_CompositeSetup(USBH_SIM_DeviceTypeDef *pdev,
+                                               const USB_Setup_TypeDef *setup,
+                                               uint8_t *data, uint16_t *length)
+{
+  USBH_SIM_CompositeDevTypeDef *pcomp = (USBH_SIM_CompositeDevTypeDef *)pdev->pUser;
+
+  if ((setup->b.bmRequestType & 0x1FU) != USB_REQ_RECIPIENT_INTERFACE)
+  {
+    return USBH_SIM_STALL;
+  }
+
+  if ((setup->b.wIndex.w & 0xFFU) == SIM_COMPOSITE_KBD_INTERFACE)
+  {
+    return SIM_HidSetup(&pcomp->Kbd.Dev, setup, data, length);
+  }
+
+  if ((setup->b.wIndex.w & 0xFFU) == 0U)
+  {
+    return SIM_CdcSetup(&pcomp->Cdc.Dev, setup, data, length);
+  }
+
+  return USBH_SIM_STALL;
+}
+
+
+/**
+  * @brief  SIM_CompositeDataIn
+  */
+static USBH_SIM_RespTypeDef SIM_CompositeDataIn(USBH_SIM_DeviceTypeDef *pdev, uint8_t ep_addr,
+                                                uint8_t *buff, uint16_t *length)
+{
+  USBH_SIM_CompositeDevTypeDef *pcomp = (USBH_SIM_CompositeDevTypeDef *)pdev->pUser;
+
+  if (ep_addr == SIM_COMPOSITE_KBD_EP)
+  {
+    return SIM_HidDataIn(&pcomp->Kbd.Dev, ep_addr, buff, length);
+  }
+
+  return SIM_CdcDataIn(&pcomp->Cdc.Dev, ep_addr, buff, length);
+}
+
+
+/**
+  * @brief  SIM_CompositeDataOut
+  */
+static USBH_SIM_RespTypeDef SIM_CompositeDataOut(USBH_SIM_DeviceTypeDef *pdev, uint8_t ep_addr,
+                                                 const uint8_t *buff, uint16_t length)
+{
+  USBH_SIM_CompositeDevTypeDef *pcomp = (USBH_SIM_CompositeDevTypeDef *)pdev->pUser;
+
+  return SIM_CdcDataOut(&pcomp->Cdc.Dev, ep_addr, buff, length);
+}
+
+
+/**
+  * @brief  SIM_CompositeReset
+  */
+static void SIM_CompositeReset(USBH_SIM_DeviceTypeDef *pdev)
+{
+  USBH_SIM_CompositeDevTypeDef *pcomp = (USBH_SIM_CompositeDevTypeDef *)pdev->pUser;
+
+  SIM_CdcReset(&pcomp->Cdc.Dev);
+  SIM_HidReset(&pcomp->Kbd.Dev);
+}
+
+
+/**
+  * @brief  SIM_HubUpdate
+  *         Complete the port resets whose time has elapsed.
+  */
+static void SIM_HubUpdate(USBH_SIM_HubDevTypeDef *phub)
+{
+  uint8_t idx;
+
+  for (idx = 0U; idx < phub->NumPorts; idx++)
+  {
+    if (((phub->Status[idx] & SIM_HUB_PORT_RESET) != 0U) &&
+        (USBH_SIM_Now() >= phub->ResetDone[idx]))
+    {
+      phub->Status[idx] &= ~SIM_HUB_PORT_RESET;
+      phub->Change[idx] |= SIM_HUB_PORT_RESET;
+
+      if (phub->pPortDev[idx] != NULL)
+      {
+        USBH_SIM_ResetDevice(phub->pPortDev[idx]);
+        phub->Status[idx] |= SIM_HUB_PORT_ENABLE;
+        if (phub->pPortDev[idx]->Speed == (uint8_t)USBH_SPEED_LOW)
+        {
+          phub->Status[idx] |= SIM_HUB_PORT_LOW_SPEED;
+        }
+      }
+    }
+  }
+}
+
+
+/**
+  * @brief  SIM_HubSetup
+  *         Hub class requests.
+  */
+static USBH_SIM_RespTypeDef SIM_HubSetup(USBH_SIM_DeviceTypeDef *pdev,
+                                         const USB_Setup_TypeDef *setup,
+                                         uint8_t *data, uint16_t *length)
+{
+  USBH_SIM_HubDevTypeDef *phub = (USBH_SIM_HubDevTypeDef *)pdev->pUser;
+  uint8_t recipient = setup->b.bmRequestType & 0x1FU;
+  uint8_t port = (uint8_t)setup->b.wIndex.w;
+  uint16_t feature = setup->b.wValue.w;
+  uint16_t len;
+
+  if ((setup->b.bmRequestType & 0x60U) != USB_REQ_TYPE_CLASS)
+  {
+    return USBH_SIM_STALL;
+  }
+
+  SIM_HubUpdate(phub);
+
+  if (recipient == USB_REQ_RECIPIENT_DEVICE)
+  {
+    switch (setup->b.bRequest)
+    {
+      case USB_REQ_GET_DESCRIPTOR:
+        /* Hub descriptor: individual power switching and over-current,
+           100 ms power-on to power-good, no removable ports */
+        data[0] = 9U;
+        data[1] = SIM_HUB_DESC_TYPE;
+        data[2] = phub->NumPorts;
+        data[3] = 0x09U;
+        data[4] = 0x00U;
+        data[5] = 50U;
+        data[6] = 100U;
+        data[7] = 0x00U;
+        data[8] = 0xFFU;
+        len = (*length < 9U) ? *length : 9U;
+        *length = len;
+        return USBH_SIM_ACK;
+
+      case USB_REQ_GET_STATUS:
+        len = (*length < 4U) ? *length : 4U;
+        (void)memset(data, 0, len);
+        *length = len;
+        return USBH_SIM_ACK;
+
+      case USB_REQ_CLEAR_FEATURE:
+        return USBH_SIM_ACK;
+
+      default:
+        return USBH_SIM_STALL;
+    }
+  }
+
+  if ((recipient != USB_REQ_RECIPIENT_OTHER) || (port == 0U) || (port > phub->NumPorts))
+  {
+    return USBH_SIM_STALL;
+  }
+  port--;
+
+  switch (setup->b.bRequest)
+  {
+    case USB_REQ_GET_STATUS:
+      if (*length < 4U)
+      {
+        return USBH_SIM_STALL;
+      }
+      data[0] = (uint8_t)phub->Status[port];
+      data[1] = (uint8_t)(phub->Status[port] >> 8);
+      data[2] = (uint8_t)phub->Change[port];
+      data[3] = (uint8_t)(phub->Change[port] >> 8);
+      *length = 4U;
+      return USBH_SIM_ACK;
+
+    case USB_REQ_SET_FEATURE:
+      if (feature == SIM_HUB_FEATURE_PORT_POWER)
+      {
+        if (((phub->Status[port] & SIM_HUB_PORT_POWER) == 0U) && (phub->pPortDev[port] != NULL))
+        {
+          phub->Status[port] |= SIM_HUB_PORT_CONNECTION;
+          phub->Change[port] |= SIM_HUB_PORT_CONNECTION;
+        }
+        phub->Status[port] |= SIM_HUB_PORT_POWER;
+      }
+      else if (feature == SIM_HUB_FEATURE_PORT_RESET)
+      {
+        if ((phub->Status[port] & SIM_HUB_PORT_CONNECTION) != 0U)
+        {
+          phub->Status[port] &= ~(uint16_t)(SIM_HUB_PORT_ENABLE | SIM_HUB_PORT_LOW_SPEED);
+          phub->Status[port] |= SIM_HUB_PORT_RESET;
+          phub->ResetDone[port] = USBH_SIM_Now() + phub->ResetTime;
+        }
+      }
+      else
+      {
+        /* Suspend and test modes are not modelled */
+      }
+      return USBH_SIM_ACK;
+
+    case USB_REQ_CLEAR_FEATURE:
+      if (feature >= SIM_HUB_FEATURE_C_PORT_CONNECTION)
+      {
+        phub->Change[port] &= ~(uint16_t)(1U << (feature - SIM_HUB_FEATURE_C_PORT_CONNECTION));
+      }
+      else if (feature == SIM_HUB_FEATURE_PORT_POWER)
+      {
+        phub->Status[port] = 0U;
+      }
+      else if (feature < 16U)
+      {
+        phub->Status[port] &= ~(uint16_t)(1U << feature);
+      }
+      else
+      {
+        /* .. */
+      }
+      return USBH_SIM_ACK;
+
+    default:
+      return USBH_SIM_STALL;
+  }
+}
+
+
+/**
+  * @brief  SIM_HubDataIn
+  *         Status change endpoint: bitmap of the ports with a change
+  *         pending, NAK when there is none.
+  */
+static USBH_SIM_RespTypeDef SIM_HubDataIn(USBH_SIM_DeviceTypeDef *pdev, uint8_t ep_addr,
+                                          uint8_t *buff, uint16_t *length)
+{
+  USBH_SIM_HubDevTypeDef *phub = (USBH_SIM_HubDevTypeDef *)pdev->pUser;
+  uint8_t bitmap = 0U;
+  uint8_t idx;
+
+  if ((ep_addr != 0x81U) || (*length == 0U))
+  {
+    return USBH_SIM_STALL;
+  }
+
+  SIM_HubUpdate(phub);
+
+  for (idx = 0U; idx < phub->NumPorts; idx++)
+  {
+    if (phub->Change[idx] != 0U)
+    {
+      bitmap |= (uint8_t)(1U << (idx + 1U));
+    }
+  }
+
+  if (bitmap == 0U)
+  {
+    return USBH_SIM_NAK;
+  }
+
+  buff[0] = bitmap;
+  *length = 1U;
+
+  return USBH_SIM_ACK;
+}
+
+
+/**
+  * @brief  SIM_HubReset
+  *         Bus reset of the hub powers its ports off.
+  */
+static void SIM_HubReset(USBH_SIM_DeviceTypeDef *pdev)
+{
+  USBH_SIM_HubDevTypeDef *phub = (USBH_SIM_HubDevTypeDef *)pdev->pUser;
+
+  (void)memset(phub->Status, 0, sizeof(phub->Status));
+  (void)memset(phub->Change, 0, sizeof(phub->Change));
+}
+
+
+/**
+  * @brief  SIM_HubRoute
+  *         Device answering at an address on an enabled port.
+  */
+static USBH_SIM_DeviceTypeDef *SIM_HubRoute(USBH_SIM_DeviceTypeDef *pdev, uint8_t address)
+{
+  USBH_SIM_HubDevTypeDef *phub = (USBH_SIM_HubDevTypeDef *)pdev->pUser;
+  USBH_SIM_DeviceTypeDef *pport;
+  uint8_t idx;
+
+  /* A hub without an address does not forward anything yet */
+  if (pdev->Address == 0U)
+  {
+    return NULL;
+  }
+
+  SIM_HubUpdate(phub);
+
+  for (idx = 0U; idx < phub->NumPorts; idx++)
+  {
+    pport = phub->pPortDev[idx];
+
+    if ((pport == NULL) || ((phub->Status[idx] & SIM_HUB_PORT_ENABLE) == 0U))
+    {
+      continue;
+    }
+
+    if (pport->Address == address)
+    {
+      return pport;
+    }
+
+    if ((pport->pOps != NULL) && (pport->pOps->Route != NULL))
+    {
+      pport = pport->pOps->Route(pport, address);
+      if (pport != NULL)
+      {
+        return pport;
+      }
+    }
+  }
+
+  return NULL;
+}
+
+
+/**
+  * @brief  SIM_MicSetup
+  *         SET_INTERFACE of the streaming interface and the sampling
+  *         frequency control of the isochronous endpoint.
+  */
+static USBH_SIM_RespTypeDef SIM_MicSetup(USBH_SIM_DeviceTypeDef *pdev,
+                                         const USB_Setup_TypeDef *setup,
+                                         uint8_t *data, uint16_t *length)
+{
+  USBH_SIM_AudioDevTypeDef *pmic = (USBH_SIM_AudioDevTypeDef *)pdev->pUser;
+  uint32_t freq;
+
+  if (setup->b.bmRequestType == (USB_H2D | USB_REQ_TYPE_STANDARD | USB_REQ_RECIPIENT_INTERFACE))
+  {
+    if ((setup->b.bRequest != USB_REQ_SET_INTERFACE) ||
+        (setup->b.wIndex.w != SIM_AUDIO_STREAMING_INTERFACE) || (setup->b.wValue.w > 1U))
+    {
+      return USBH_SIM_STALL;
+    }
+
+    pmic->AltSetting = (uint8_t)setup->b.wValue.w;
+    pmic->StartFrame = USBH_SIM_GetHost()->Frame;
+    pmic->Samples = 0U;
+    return USBH_SIM_ACK;
+  }
+
+  if (((setup->b.bmRequestType & 0x7FU) != (USB_REQ_TYPE_CLASS | USB_REQ_RECIPIENT_ENDPOINT)) ||
+      (setup->b.wIndex.w != SIM_AUDIO_EP) ||
+      (setup->b.wValue.w != (SIM_AUDIO_SAMPLING_FREQ_CONTROL << 8U)) || (*length < 3U))
+  {
+    return USBH_SIM_STALL;
+  }
+
+  switch (setup->b.bRequest)
+  {
+    case SIM_AUDIO_REQ_SET_CUR:
+      freq = (uint32_t)data[0] | ((uint32_t)data[1] << 8) | ((uint32_t)data[2] << 16);
+      if ((freq != 44100U) && (freq != 48000U))
+      {
+        return USBH_SIM_STALL;
+      }
+      pmic->Frequency = freq;
+      return USBH_SIM_ACK;
+
+    case SIM_AUDIO_REQ_GET_CUR:
+      data[0] = (uint8_t)pmic->Frequency;
+      data[1] = (uint8_t)(pmic->Frequency >> 8);
+      data[2] = (uint8_t)(pmic->Frequency >> 16);
+      *length = 3U;
+      return USBH_SIM_ACK;
+
+    default:
+      return USBH_SIM_STALL;
+  }
+}
+
+
+/**
+  * @brief  SIM_MicDataIn
+  *         One packet per frame with the samples due in it, 44 or 45 of
+  *         them at 44.1 kHz. Frames without IN token lose their samples.
+  */
+static USBH_SIM_RespTypeDef SIM_MicDataIn(USBH_SIM_DeviceTypeDef *pdev, uint8_t ep_addr,
+                                          uint8_t *buff, uint16_t *length)
+{
+  USBH_SIM_AudioDevTypeDef *pmic = (USBH_SIM_AudioDevTypeDef *)pdev->pUser;
+  uint64_t frame;
+  uint64_t first;
+  uint64_t count;
+  uint64_t idx;
+  uint16_t len = 0U;
+
+  if ((ep_addr != SIM_AUDIO_EP) || (pmic->AltSetting == 0U))
+  {
+    return USBH_SIM_NAK;
+  }
+
+  frame = (uint64_t)(USBH_SIM_GetHost()->Frame - pmic->StartFrame);
+  first = (frame * pmic->Frequency) / 1000U;
+  count = (((frame + 1U) * pmic->Frequency) / 1000U) - first;
+
+  for (idx = first; (idx < (first + count)) && ((len + SIM_AUDIO_FRAME_SIZE) <= *length); idx++)
+  {
+    buff[len] = (uint8_t)idx;
+    buff[len + 1U] = (uint8_t)(idx >> 8);
+    buff[len + 2U] = (uint8_t)~idx;
+    buff[len + 3U] = (uint8_t)(~idx >> 8);
+    len += SIM_AUDIO_FRAME_SIZE;
+  }
+
+  *length = len;
+  pmic->Packets++;
+  pmic->Samples += len / SIM_AUDIO_FRAME_SIZE;
+
+  return USBH_SIM_ACK;
+}
+
+
+/**
+  * @brief  SIM_MicReset
+  */
+static void SIM_MicReset(USBH_SIM_DeviceTypeDef *pdev)
+{
+  USBH_SIM_AudioDevTypeDef *pmic = (USBH_SIM_AudioDevTypeDef *)pdev->pUser;
+
+  pmic->AltSetting = 0U;
+  pmic->Frequency = 44100U;
+  pmic->Packets = 0U;
+  pmic->Samples = 0U;
+}
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
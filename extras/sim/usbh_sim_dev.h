@@ -0,0 +1,135 @@
+/**
+  ******************************************************************************
+  * @file    usbh_sim_dev.h
+  * @brief   Header file for usbh_sim_dev.c: ready-made virtual devices for
+  *          the simulated host controller.
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __USBH_SIM_DEV_H
+#define __USBH_SIM_DEV_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "usbh_sim.h"
+
+/** @addtogroup USBH_SIM
+  * @{
+  */
+
+/** @defgroup USBH_SIM_DEV_Exported_Defines
+  * @{
+  */
+#define USBH_SIM_HID_QUEUE_SIZE                  64U
+#define USBH_SIM_HID_REPORT_SIZE                 8U
+#define USBH_SIM_CDC_FIFO_SIZE                   4096U
+#define USBH_SIM_HUB_MAX_PORTS                   7U
+/**
+  * @}
+  */
+
+/** @defgroup USBH_SIM_DEV_Exported_Types
+  * @{
+  */
+
+/* Boot keyboard or boot mouse: reports are queued by the application and
+   handed out one per interrupt IN poll, NAK when the queue is empty */
+typedef struct
+{
+  USBH_SIM_DeviceTypeDef    Dev;
+  uint8_t                   ReportSize;
+  uint8_t                   Protocol;
+  uint8_t                   Idle;
+  uint8_t                   Leds;
+  uint32_t                  Head;
+  uint32_t                  Tail;
+  uint8_t                   Reports[USBH_SIM_HID_QUEUE_SIZE][USBH_SIM_HID_REPORT_SIZE];
+} USBH_SIM_HidDevTypeDef;
+
+/* CDC-ACM device whose bulk OUT data is echoed back on bulk IN */
+typedef struct
+{
+  USBH_SIM_DeviceTypeDef    Dev;
+  uint8_t                   LineCoding[7];
+  uint16_t                  LineState;
+  uint32_t                  Head;
+  uint32_t                  Tail;
+  uint32_t                  Capacity;      /* loopback depth, <= USBH_SIM_CDC_FIFO_SIZE */
+  uint8_t                   Fifo[USBH_SIM_CDC_FIFO_SIZE];
+} USBH_SIM_CdcDevTypeDef;
+
+/* Full speed hub with individual port power switching. Port reset takes
+   ResetTime of virtual time, the status change endpoint NAKs when no port
+   has a change pending. */
+typedef struct
+{
+  USBH_SIM_DeviceTypeDef    Dev;
+  uint8_t                   NumPorts;
+  uint64_t                  ResetTime;
+  USBH_SIM_DeviceTypeDef   *pPortDev[USBH_SIM_HUB_MAX_PORTS];
+  uint16_t                  Status[USBH_SIM_HUB_MAX_PORTS];
+  uint16_t                  Change[USBH_SIM_HUB_MAX_PORTS];
+  uint64_t                  ResetDone[USBH_SIM_HUB_MAX_PORTS];
+} USBH_SIM_HubDevTypeDef;
+
+/* Full speed composite terminal: the CDC-ACM loopback on interfaces 0 and 1
+   and a boot keyboard on interface 2, sharing one address */
+typedef struct
+{
+  USBH_SIM_DeviceTypeDef    Dev;
+  USBH_SIM_CdcDevTypeDef    Cdc;
+  USBH_SIM_HidDevTypeDef    Kbd;
+} USBH_SIM_CompositeDevTypeDef;
+
+/* Full speed UAC1 stereo 16-bit microphone at 44.1 or 48 kHz. Alternate
+   setting 1 of interface 1 streams, each frame carries the samples due in
+   it: the left channel counts the samples sent, the right one is its
+   complement. Alternate setting 0 NAKs. */
+typedef struct
+{
+  USBH_SIM_DeviceTypeDef    Dev;
+  uint8_t                   AltSetting;
+  uint32_t                  Frequency;
+  uint32_t                  StartFrame;    /* Frame of the SET_INTERFACE */
+  uint32_t                  Packets;
+  uint64_t                  Samples;
+} USBH_SIM_AudioDevTypeDef;
+/**
+  * @}
+  */
+
+/** @defgroup USBH_SIM_DEV_Exported_FunctionsPrototype
+  * @{
+  */
+void USBH_SIM_KeyboardInit(USBH_SIM_HidDevTypeDef *pkbd);
+void USBH_SIM_MouseInit(USBH_SIM_HidDevTypeDef *pmouse);
+void USBH_SIM_CdcInit(USBH_SIM_CdcDevTypeDef *pcdc);
+void USBH_SIM_HubInit(USBH_SIM_HubDevTypeDef *phub, uint8_t num_ports);
+void USBH_SIM_CompositeInit(USBH_SIM_CompositeDevTypeDef *pcomp);
+void USBH_SIM_MicrophoneInit(USBH_SIM_AudioDevTypeDef *pmic);
+
+USBH_StatusTypeDef USBH_SIM_HubAttach(USBH_SIM_HubDevTypeDef *phub, uint8_t port,
+                                      USBH_SIM_DeviceTypeDef *pdev);
+USBH_StatusTypeDef USBH_SIM_HubDetach(USBH_SIM_HubDevTypeDef *phub, uint8_t port);
+
+USBH_StatusTypeDef USBH_SIM_HidPushReport(USBH_SIM_HidDevTypeDef *phid,
+                                          const uint8_t *report, uint8_t length);
+USBH_StatusTypeDef USBH_SIM_KeyboardType(USBH_SIM_HidDevTypeDef *pkbd, const char *text);
+uint32_t USBH_SIM_HidPending(USBH_SIM_HidDevTypeDef *phid);
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __USBH_SIM_DEV_H */
@@ -0,0 +1,871 @@
+/**
+  ******************************************************************************
+  * @file    usbh_audio.c
+  * @brief   This file is the AUDIO Layer Handlers for USB Host AUDIO class.
+  *
+  * @verbatim
+  *
+  *          ===================================================================
+  *                                AUDIO Class  Description
+  *          ===================================================================
+  *           This module manages the audio input streaming of the
+  *           "Universal Serial Bus Device Class Definition for Audio Devices
+  *           Release 1.0" (UAC1).
+  *           This driver implements the following aspects of the specification:
+  *             - Audio control and audio streaming interfaces of one function
+  *             - Type I PCM formats, discrete or continuous sampling rates
+  *             - Alternate setting selection with SET_INTERFACE
+  *             - Sampling frequency control of the isochronous endpoint
+  *             - Isochronous IN endpoint polled by the periodic schedule,
+  *               one packet per bInterval, into a PCM ring read by the
+  *               application with USBH_AUDIO_Read()
+  *
+  *  @endverbatim
+  *
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2015 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under Ultimate Liberty license
+  * SLA0044, the "License"; You may not use this file except in compliance with
+  * the License. You may obtain a copy of the License at:
+  *                      www.st.com/SLA0044
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "usbh_audio.h"
+
+
+/** @addtogroup USBH_LIB
+* @{
+*/
+
+/** @addtogroup USBH_CLASS
+* @{
+*/
+
+/** @addtogroup USBH_AUDIO_CLASS
+* @{
+*/
+
+/** @defgroup USBH_AUDIO_CORE
+* @brief    This file includes AUDIO Layer Handlers for USB Host AUDIO class.
+* @{
+*/
+
+/** @defgroup USBH_AUDIO_CORE_Private_TypesDefinitions
+* @{
+*/
+
+/* Streaming alternate setting found in the configuration descriptor */
+typedef struct
+{
+  uint8_t              Index;           /* Interface descriptor index */
+  uint8_t              ItfNumber;
+  uint8_t              AltSetting;
+  uint8_t              EpAddr;
+  uint16_t             EpSize;
+  uint8_t              bInterval;
+  uint8_t              FreqControl;
+  uint8_t              FreqMatch;       /* USBH_AUDIO_FREQUENCY is supported */
+  AUDIO_FormatTypeDef  Format;
+}
+AUDIO_AltSettingTypeDef;
+/**
+* @}
+*/
+
+
+/** @defgroup USBH_AUDIO_CORE_Private_Defines
+* @{
+*/
+
+/* Audio control interface header, bInCollection and baInterfaceNr */
+#define AUDIO_AC_HEADER                               0x01U
+#define AUDIO_AC_HEADER_SIZE                          8U
+
+#define AUDIO_AS_GENERAL_SIZE                         7U
+#define AUDIO_FORMAT_TYPE_I_SIZE                      8U
+#define AUDIO_CS_ENDPOINT_SIZE                        7U
+/**
+* @}
+*/
+
+
+/** @defgroup USBH_AUDIO_CORE_Private_Macros
+* @{
+*/
+/**
+* @}
+*/
+
+
+/** @defgroup USBH_AUDIO_CORE_Private_Variables
+* @{
+*/
+
+/**
+* @}
+*/
+
+
+/** @defgroup USBH_AUDIO_CORE_Private_FunctionPrototypes
+* @{
+*/
+
+static USBH_StatusTypeDef USBH_AUDIO_InterfaceInit(USBH_HandleTypeDef *phost);
+static USBH_StatusTypeDef USBH_AUDIO_InterfaceDeInit(USBH_HandleTypeDef *phost);
+static USBH_StatusTypeDef USBH_AUDIO_ClassRequest(USBH_HandleTypeDef *phost);
+static USBH_StatusTypeDef USBH_AUDIO_Process(USBH_HandleTypeDef *phost);
+static void USBH_AUDIO_PipeCallback(USBH_HandleTypeDef *phost, uint8_t pipe,
+                                    USBH_URBStateTypeDef urb_state, uint32_t length);
+static USBH_StatusTypeDef USBH_AUDIO_FindStreaming(USBH_HandleTypeDef *phost, uint8_t interface,
+                                                   AUDIO_AltSettingTypeDef *palt);
+static USBH_StatusTypeDef USBH_AUDIO_ParseAltSetting(USBH_DescIterTypeDef *iter,
+                                                     AUDIO_AltSettingTypeDef *palt);
+static USBH_StatusTypeDef USBH_AUDIO_SetSamplingFreq(USBH_HandleTypeDef *phost);
+
+USBH_ClassTypeDef  AUDIO_Class =
+{
+  "AUDIO",
+  USB_AUDIO_CLASS,
+  USBH_AUDIO_InterfaceInit,
+  USBH_AUDIO_InterfaceDeInit,
+  USBH_AUDIO_ClassRequest,
+  USBH_AUDIO_Process,
+  NULL,
+  NULL,
+};
+/**
+* @}
+*/
+
+
+/** @defgroup USBH_AUDIO_CORE_Private_Functions
+* @{
+*/
+
+
+/**
+  * @brief  USBH_AUDIO_InterfaceInit
+  *         The function init the AUDIO class: binds the audio control
+  *         interface and the input streaming interface of its collection.
+  * @param  phost: Host handle
+  * @retval USBH Status
+  */
+static USBH_StatusTypeDef USBH_AUDIO_InterfaceInit(USBH_HandleTypeDef *phost)
+{
+  USBH_StatusTypeDef status;
+  AUDIO_HandleTypeDef *AUDIO_Handle;
+  AUDIO_AltSettingTypeDef alt;
+  uint32_t interval;
+  uint8_t interface;
+
+  interface = USBH_FindInterface(phost, phost->pActiveClass->ClassCode,
+                                 AUDIO_SUBCLASS_AUDIOCONTROL, 0xFFU);
+
+  if (interface == 0xFFU) /* No Valid Interface */
+  {
+    USBH_DbgLog("Cannot Find the interface for %s class.", phost->pActiveClass->Name);
+    return USBH_FAIL;
+  }
+
+  if (USBH_AUDIO_FindStreaming(phost, interface, &alt) != USBH_OK)
+  {
+    USBH_DbgLog("No PCM input streaming interface for %s class.", phost->pActiveClass->Name);
+    return USBH_FAIL;
+  }
+
+  status = USBH_SelectInterface(phost, interface);
+
+  if (status != USBH_OK)
+  {
+    return USBH_FAIL;
+  }
+
+  /* The streaming interface belongs to this class too */
+  USBH_ClaimInterface(phost, alt.Index);
+
+  phost->pActiveClass->pData = (AUDIO_HandleTypeDef *)USBH_malloc(sizeof(AUDIO_HandleTypeDef));
+  AUDIO_Handle = (AUDIO_HandleTypeDef *) phost->pActiveClass->pData;
+
+  if (AUDIO_Handle == NULL)
+  {
+    USBH_DbgLog("Cannot allocate memory for AUDIO Handle");
+    return USBH_FAIL;
+  }
+
+  /* Initialize audio handler */
+  USBH_memset(AUDIO_Handle, 0, sizeof(AUDIO_HandleTypeDef));
+
+  AUDIO_Handle->state       = AUDIO_INIT;
+  AUDIO_Handle->ctl_state   = AUDIO_REQ_INIT;
+  AUDIO_Handle->InEp        = alt.EpAddr;
+  AUDIO_Handle->InEpSize    = alt.EpSize;
+  AUDIO_Handle->AsItfNumber = alt.ItfNumber;
+  AUDIO_Handle->AltSetting  = alt.AltSetting;
+  AUDIO_Handle->FreqControl = alt.FreqControl;
+  AUDIO_Handle->Format      = alt.Format;
+
+  /* bInterval is a power of two exponent, in microframes at high speed */
+  interval = 1UL << (((alt.bInterval >= 1U) && (alt.bInterval <= 16U)) ? (alt.bInterval - 1U) : 0U);
+
+  if (phost->device.speed == (uint8_t)USBH_SPEED_HIGH)
+  {
+    interval = (interval > 8U) ? (interval / 8U) : 1U;
+  }
+
+  AUDIO_Handle->FreqBuf[0] = (uint8_t)(alt.Format.Frequency);
+  AUDIO_Handle->FreqBuf[1] = (uint8_t)(alt.Format.Frequency >> 8);
+  AUDIO_Handle->FreqBuf[2] = (uint8_t)(alt.Format.Frequency >> 16);
+
+  USBH_UsrLog("Audio: interface %d alternate %d, %d Hz, %d channels, %d bits",
+              AUDIO_Handle->AsItfNumber, AUDIO_Handle->AltSetting,
+              (int)AUDIO_Handle->Format.Frequency, AUDIO_Handle->Format.Channels,
+              AUDIO_Handle->Format.BitResolution);
+
+  AUDIO_Handle->InPipe = USBH_AllocPipe(phost, AUDIO_Handle->InEp);
+
+  if (AUDIO_Handle->InPipe == USBH_PIPE_NONE)
+  {
+    return USBH_FAIL;
+  }
+
+  /* Open pipe for the isochronous IN endpoint */
+  USBH_OpenPipe(phost, AUDIO_Handle->InPipe, AUDIO_Handle->InEp, phost->device.address,
+                phost->device.speed, USB_EP_TYPE_ISOC, AUDIO_Handle->InEpSize);
+
+  (void)USBH_RegisterPipeCallback(phost, AUDIO_Handle->InPipe, USBH_AUDIO_PipeCallback);
+
+  /* The endpoint bandwidth is reserved now, the transfers start once the
+     alternate setting is selected */
+  status = USBH_PeriodicOpen(phost, AUDIO_Handle->InPipe, AUDIO_Handle->InEp,
+                             USB_EP_TYPE_ISOC, interval, AUDIO_Handle->InEpSize);
+
+  if (status == USBH_OK)
+  {
+    AUDIO_Handle->Interval = USBH_PeriodicGetInterval(phost, AUDIO_Handle->InPipe);
+  }
+
+  return status;
+}
+
+/**
+  * @brief  USBH_AUDIO_InterfaceDeInit
+  *         The function DeInit the Pipes used for the AUDIO class.
+  * @param  phost: Host handle
+  * @retval USBH Status
+  */
+static USBH_StatusTypeDef USBH_AUDIO_InterfaceDeInit(USBH_HandleTypeDef *phost)
+{
+  AUDIO_HandleTypeDef *AUDIO_Handle = (AUDIO_HandleTypeDef *) phost->pActiveClass->pData;
+
+  if (AUDIO_Handle->InPipe != 0x00U)
+  {
+    USBH_ClosePipe(phost, AUDIO_Handle->InPipe);
+    USBH_FreePipe(phost, AUDIO_Handle->InPipe);
+    AUDIO_Handle->InPipe = 0U;     /* Reset the pipe as Free */
+  }
+
+  if (phost->pActiveClass->pData)
+  {
+    USBH_free(phost->pActiveClass->pData);
+    phost->pActiveClass->pData = 0U;
+  }
+
+  return USBH_OK;
+}
+
+/**
+  * @brief  USBH_AUDIO_ClassRequest
+  *         The function is responsible for handling Standard requests
+  *         for AUDIO class: select the streaming alternate setting and
+  *         set its sampling frequency.
+  * @param  phost: Host handle
+  * @retval USBH Status
+  */
+static USBH_StatusTypeDef USBH_AUDIO_ClassRequest(USBH_HandleTypeDef *phost)
+{
+  USBH_StatusTypeDef status         = USBH_BUSY;
+  USBH_StatusTypeDef classReqStatus = USBH_BUSY;
+  AUDIO_HandleTypeDef *AUDIO_Handle = (AUDIO_HandleTypeDef *) phost->pActiveClass->pData;
+
+  switch (AUDIO_Handle->ctl_state)
+  {
+    case AUDIO_REQ_INIT:
+    case AUDIO_REQ_SET_INTERFACE:
+
+      classReqStatus = USBH_SetInterface(phost, AUDIO_Handle->AsItfNumber,
+                                         AUDIO_Handle->AltSetting);
+      if (classReqStatus == USBH_OK)
+      {
+        AUDIO_Handle->ctl_state = (AUDIO_Handle->FreqControl != 0U) ?
+                                  AUDIO_REQ_SET_FREQUENCY : AUDIO_REQ_IDLE;
+      }
+      else if (classReqStatus == USBH_NOT_SUPPORTED)
+      {
+        USBH_ErrLog("Control error: AUDIO: Set Interface request failed");
+        status = USBH_FAIL;
+      }
+      else
+      {
+        /* .. */
+      }
+      break;
+
+    case AUDIO_REQ_SET_FREQUENCY:
+
+      classReqStatus = USBH_AUDIO_SetSamplingFreq(phost);
+      if (classReqStatus == USBH_OK)
+      {
+        AUDIO_Handle->ctl_state = AUDIO_REQ_IDLE;
+      }
+      else if (classReqStatus == USBH_NOT_SUPPORTED)
+      {
+        /* The device keeps its current rate */
+        USBH_ErrLog("Control error: AUDIO: Set Sampling Frequency request failed");
+        AUDIO_Handle->ctl_state = AUDIO_REQ_IDLE;
+      }
+      else
+      {
+        /* .. */
+      }
+      break;
+
+    case AUDIO_REQ_IDLE:
+    default:
+      break;
+  }
+
+  if (AUDIO_Handle->ctl_state == AUDIO_REQ_IDLE)
+  {
+    /* all requests performed */
+    phost->pUser(phost, HOST_USER_CLASS_ACTIVE);
+    status = USBH_OK;
+  }
+
+  return status;
+}
+
+/**
+  * @brief  USBH_AUDIO_Process
+  *         The function is for managing state machine for AUDIO data transfers
+  * @param  phost: Host handle
+  * @retval USBH Status
+  */
+static USBH_StatusTypeDef USBH_AUDIO_Process(USBH_HandleTypeDef *phost)
+{
+  USBH_StatusTypeDef status = USBH_OK;
+  AUDIO_HandleTypeDef *AUDIO_Handle = (AUDIO_HandleTypeDef *) phost->pActiveClass->pData;
+
+  switch (AUDIO_Handle->state)
+  {
+    case AUDIO_INIT:
+      /* From now on the periodic schedule issues one IN per interval, the
+         packet buffers are swapped in USBH_AUDIO_PipeCallback */
+      AUDIO_Handle->PacketIdx = 0U;
+      AUDIO_Handle->Skipped = USBH_PeriodicGetSkipped(phost, AUDIO_Handle->InPipe);
+
+      if (USBH_PeriodicStart(phost, AUDIO_Handle->InPipe, AUDIO_Handle->Packet[0],
+                             AUDIO_Handle->InEpSize) == USBH_OK)
+      {
+        AUDIO_Handle->state = AUDIO_STREAMING;
+      }
+      else
+      {
+        AUDIO_Handle->state = AUDIO_ERROR;
+        status = USBH_FAIL;
+      }
+      break;
+
+    case AUDIO_STREAMING:
+      break;
+
+    case AUDIO_ERROR:
+    default:
+      status = USBH_FAIL;
+      break;
+  }
+
+  return status;
+}
+
+/**
+  * @brief  USBH_AUDIO_PipeCallback
+  *         Completion of an isochronous IN packet: the other packet buffer is
+  *         handed to the schedule first, then the PCM data is put in the ring.
+  * @param  phost: Host handle
+  * @param  pipe: Pipe number
+  * @param  urb_state: URB state
+  * @param  length: Bytes received
+  * @retval None
+  */
+static void USBH_AUDIO_PipeCallback(USBH_HandleTypeDef *phost, uint8_t pipe,
+                                    USBH_URBStateTypeDef urb_state, uint32_t length)
+{
+  AUDIO_HandleTypeDef *AUDIO_Handle;
+  uint8_t *pPacket;
+  uint32_t skipped;
+  uint32_t fill;
+  uint32_t head;
+  uint32_t pos;
+  uint32_t chunk;
+
+  if ((phost->pActiveClass == NULL) || (phost->pActiveClass->pData == NULL))
+  {
+    return;
+  }
+
+  AUDIO_Handle = (AUDIO_HandleTypeDef *) phost->pActiveClass->pData;
+
+  if (AUDIO_Handle->state != AUDIO_STREAMING)
+  {
+    return;
+  }
+
+  pPacket = AUDIO_Handle->Packet[AUDIO_Handle->PacketIdx];
+  AUDIO_Handle->PacketIdx ^= 1U;
+  (void)USBH_PeriodicStart(phost, pipe, AUDIO_Handle->Packet[AUDIO_Handle->PacketIdx],
+                           AUDIO_Handle->InEpSize);
+
+  /* Frames the schedule could not serve carried samples too */
+  skipped = USBH_PeriodicGetSkipped(phost, pipe);
+  AUDIO_Handle->Stats.Dropped += skipped - AUDIO_Handle->Skipped;
+  AUDIO_Handle->Skipped = skipped;
+
+  if (urb_state != USBH_URB_DONE)
+  {
+    AUDIO_Handle->Stats.Dropped++;
+    return;
+  }
+
+  AUDIO_Handle->Stats.Packets++;
+
+  if (length == 0U)
+  {
+    AUDIO_Handle->Stats.Empty++;
+    return;
+  }
+
+  if (length > AUDIO_Handle->InEpSize)
+  {
+    length = AUDIO_Handle->InEpSize;
+  }
+
+  head = AUDIO_Handle->Head;
+  fill = head - AUDIO_Handle->Tail;
+
+  if ((USBH_AUDIO_RING_SIZE - fill) < length)
+  {
+    /* Whole packets only, a partial one would shift the channels */
+    AUDIO_Handle->Stats.Overruns++;
+    return;
+  }
+
+  pos = head & (USBH_AUDIO_RING_SIZE - 1U);
+  chunk = USBH_AUDIO_RING_SIZE - pos;
+
+  if (chunk > length)
+  {
+    chunk = length;
+  }
+
+  (void)USBH_memcpy(&AUDIO_Handle->Ring[pos], pPacket, chunk);
+  (void)USBH_memcpy(&AUDIO_Handle->Ring[0], &pPacket[chunk], length - chunk);
+
+  AUDIO_Handle->Head = head + length;
+  AUDIO_Handle->Stats.Bytes += length;
+
+  if ((fill + length) > AUDIO_Handle->Stats.MaxFill)
+  {
+    AUDIO_Handle->Stats.MaxFill = fill + length;
+  }
+
+  USBH_AUDIO_ReceiveCallback(phost);
+
+#if (USBH_USE_OS == 1U)
+  USBH_OS_PostEvent(phost, USBH_URB_EVENT);
+#endif
+}
+
+/**
+  * @brief  USBH_AUDIO_FindStreaming
+  *         Find the input streaming alternate setting to use among the
+  *         interfaces of the audio control interface collection.
+  * @param  phost: Host handle
+  * @param  interface: Index of the audio control interface
+  * @param  palt: Alternate setting found
+  * @retval USBH_OK, USBH_FAIL when there is none
+  */
+static USBH_StatusTypeDef USBH_AUDIO_FindStreaming(USBH_HandleTypeDef *phost, uint8_t interface,
+                                                   AUDIO_AltSettingTypeDef *palt)
+{
+  USBH_DescIterTypeDef iter;
+  USBH_InterfaceDescTypeDef itf;
+  AUDIO_AltSettingTypeDef alt;
+  uint8_t collection[USBH_MAX_NUM_INTERFACES];
+  uint8_t *pdesc;
+  uint8_t count = 0U;
+  uint8_t found = 0U;
+  uint8_t match = 0U;
+  uint8_t idx;
+
+  /* The header lists the streaming interfaces of the function */
+  (void)USBH_DescIter_SeekInterface(phost, &iter, interface, NULL);
+
+  pdesc = USBH_DescIter_NextClassDesc(&iter, AUDIO_CS_INTERFACE);
+
+  if ((pdesc == NULL) || (pdesc[2] != AUDIO_AC_HEADER) || (pdesc[0] < AUDIO_AC_HEADER_SIZE))
+  {
+    return USBH_FAIL;
+  }
+
+  for (idx = 0U; (idx < pdesc[7]) && ((AUDIO_AC_HEADER_SIZE + idx) < pdesc[0]) &&
+       (count < USBH_MAX_NUM_INTERFACES); idx++)
+  {
+    collection[count] = pdesc[AUDIO_AC_HEADER_SIZE + idx];
+    count++;
+  }
+
+  USBH_DescIter_Init(phost, &iter);
+
+  while (USBH_DescIter_NextInterface(&iter, &itf) == USBH_OK)
+  {
+    if ((itf.bInterfaceClass != USB_AUDIO_CLASS) ||
+        (itf.bInterfaceSubClass != AUDIO_SUBCLASS_AUDIOSTREAMING) ||
+        (itf.bAlternateSetting == 0U) ||
+        (USBH_IsInterfaceClaimed(phost, itf.bInterfaceNumber) != 0U))
+    {
+      continue;
+    }
+
+    for (idx = 0U; idx < count; idx++)
+    {
+      if (collection[idx] == itf.bInterfaceNumber)
+      {
+        break;
+      }
+    }
+
+    if (idx == count)
+    {
+      continue;
+    }
+
+    USBH_memset(&alt, 0, sizeof(alt));
+    alt.Index = iter.ItfIndex;
+    alt.ItfNumber = itf.bInterfaceNumber;
+    alt.AltSetting = itf.bAlternateSetting;
+
+    if (USBH_AUDIO_ParseAltSetting(&iter, &alt) != USBH_OK)
+    {
+      continue;
+    }
+
+    /* The first usable one, or the first one at the requested rate */
+    if ((found == 0U) || ((match == 0U) && (alt.FreqMatch != 0U)))
+    {
+      *palt = alt;
+      found = 1U;
+      match = alt.FreqMatch;
+    }
+  }
+
+  return (found != 0U) ? USBH_OK : USBH_FAIL;
+}
+
+/**
+  * @brief  USBH_AUDIO_ParseAltSetting
+  *         Parse the class-specific descriptors and the endpoint of a
+  *         streaming alternate setting.
+  * @param  iter: Walk, positioned on the interface descriptor
+  * @param  palt: Alternate setting to complete
+  * @retval USBH_OK when it streams PCM in on an isochronous endpoint
+  */
+static USBH_StatusTypeDef USBH_AUDIO_ParseAltSetting(USBH_DescIterTypeDef *iter,
+                                                     AUDIO_AltSettingTypeDef *palt)
+{
+  USBH_DescIterTypeDef ep_iter = *iter;
+  USBH_EpDescTypeDef ep;
+  uint8_t *pdesc;
+  uint16_t format_tag = 0U;
+  uint32_t freq;
+  uint32_t upper;
+  uint8_t idx;
+
+  while ((pdesc = USBH_DescIter_NextClassDesc(iter, AUDIO_CS_INTERFACE)) != NULL)
+  {
+    if ((pdesc[2] == AUDIO_AS_GENERAL) && (pdesc[0] >= AUDIO_AS_GENERAL_SIZE))
+    {
+      format_tag = LE16(&pdesc[5]);
+    }
+    else if ((pdesc[2] == AUDIO_FORMAT_TYPE) && (pdesc[0] >= AUDIO_FORMAT_TYPE_I_SIZE) &&
+             (pdesc[3] == AUDIO_FORMAT_TYPE_I))
+    {
+      palt->Format.Channels = pdesc[4];
+      palt->Format.SubframeSize = pdesc[5];
+      palt->Format.BitResolution = pdesc[6];
+
+      if (pdesc[7] == 0U)
+      {
+        /* Continuous range, lower and upper bounds */
+        if (pdesc[0] >= (AUDIO_FORMAT_TYPE_I_SIZE + 6U))
+        {
+          freq = LE24(&pdesc[8]);
+          upper = LE24(&pdesc[11]);
+          palt->Format.Frequency = freq;
+
+          if ((USBH_AUDIO_FREQUENCY >= freq) && (USBH_AUDIO_FREQUENCY <= upper))
+          {
+            palt->Format.Frequency = USBH_AUDIO_FREQUENCY;
+            palt->FreqMatch = 1U;
+          }
+        }
+      }
+      else
+      {
+        for (idx = 0U; (idx < pdesc[7]) &&
+             ((AUDIO_FORMAT_TYPE_I_SIZE + (3U * (uint32_t)idx) + 3U) <= pdesc[0]); idx++)
+        {
+          freq = LE24(&pdesc[AUDIO_FORMAT_TYPE_I_SIZE + (3U * (uint32_t)idx)]);
+
+          if (idx == 0U)
+          {
+            palt->Format.Frequency = freq;
+          }
+
+          if (freq == USBH_AUDIO_FREQUENCY)
+          {
+            palt->Format.Frequency = freq;
+            palt->FreqMatch = 1U;
+          }
+        }
+      }
+    }
+    else
+    {
+      /* .. */
+    }
+  }
+
+  if ((format_tag != AUDIO_FORMAT_PCM) || (palt->Format.Frequency == 0U) ||
+      (palt->Format.Channels == 0U) || (palt->Format.SubframeSize == 0U))
+  {
+    return USBH_FAIL;
+  }
+
+  if (USBH_DescIter_NextEndpoint(&ep_iter, &ep) != USBH_OK)
+  {
+    return USBH_FAIL;
+  }
+
+  if (((ep.bEndpointAddress & 0x80U) == 0U) ||
+      ((ep.bmAttributes & 0x03U) != USB_EP_TYPE_ISOC) ||
+      (ep.wMaxPacketSize == 0U) || (ep.wMaxPacketSize > USBH_AUDIO_MAX_PACKET_SIZE))
+  {
+    return USBH_FAIL;
+  }
+
+  palt->EpAddr = ep.bEndpointAddress;
+  palt->EpSize = ep.wMaxPacketSize;
+  palt->bInterval = ep.bInterval;
+
+  pdesc = USBH_DescIter_NextClassDesc(&ep_iter, AUDIO_CS_ENDPOINT);
+
+  if ((pdesc != NULL) && (pdesc[0] >= AUDIO_CS_ENDPOINT_SIZE) && (pdesc[2] == AUDIO_EP_GENERAL))
+  {
+    palt->FreqControl = pdesc[3] & AUDIO_EP_SAMPLING_FREQ_CONTROL;
+  }
+
+  return USBH_OK;
+}
+
+/**
+  * @brief  USBH_AUDIO_SetSamplingFreq
+  *         SET_CUR of the sampling frequency control of the endpoint.
+  * @param  phost: Host handle
+  * @retval USBH Status
+  */
+static USBH_StatusTypeDef USBH_AUDIO_SetSamplingFreq(USBH_HandleTypeDef *phost)
+{
+  AUDIO_HandleTypeDef *AUDIO_Handle = (AUDIO_HandleTypeDef *) phost->pActiveClass->pData;
+
+  if (phost->RequestState == CMD_SEND)
+  {
+    phost->Control.setup.b.bmRequestType = USB_H2D | USB_REQ_RECIPIENT_ENDPOINT |
+                                           USB_REQ_TYPE_CLASS;
+
+    phost->Control.setup.b.bRequest = AUDIO_REQ_SET_CUR;
+    phost->Control.setup.b.wValue.w = (uint16_t)AUDIO_SAMPLING_FREQ_CONTROL << 8U;
+    phost->Control.setup.b.wIndex.w = AUDIO_Handle->InEp;
+    phost->Control.setup.b.wLength.w = sizeof(AUDIO_Handle->FreqBuf);
+  }
+
+  return USBH_CtlReq(phost, AUDIO_Handle->FreqBuf, sizeof(AUDIO_Handle->FreqBuf));
+}
+/**
+* @}
+*/
+
+
+/** @defgroup USBH_AUDIO_CORE_Exported_Functions
+* @{
+*/
+
+/**
+  * @brief  USBH_AUDIO_Read
+  *         Take PCM data from the ring, whole samples of all the channels.
+  * @param  phost: Host handle
+  * @param  pbuf: Destination
+  * @param  length: Room in pbuf, in bytes
+  * @retval Bytes read
+  */
+uint32_t USBH_AUDIO_Read(USBH_HandleTypeDef *phost, uint8_t *pbuf, uint32_t length)
+{
+  AUDIO_HandleTypeDef *AUDIO_Handle;
+  uint32_t frame_size;
+  uint32_t tail;
+  uint32_t pos;
+  uint32_t chunk;
+  uint32_t fill;
+
+  if ((phost->gState != HOST_CLASS) || (phost->pActiveClass == NULL) ||
+      (phost->pActiveClass->ClassCode != USB_AUDIO_CLASS) ||
+      (phost->pActiveClass->pData == NULL))
+  {
+    return 0U;
+  }
+
+  AUDIO_Handle = (AUDIO_HandleTypeDef *) phost->pActiveClass->pData;
+
+  tail = AUDIO_Handle->Tail;
+  fill = AUDIO_Handle->Head - tail;
+  frame_size = (uint32_t)AUDIO_Handle->Format.Channels * AUDIO_Handle->Format.SubframeSize;
+
+  if (length > fill)
+  {
+    length = fill;
+  }
+
+  length -= length % frame_size;
+
+  pos = tail & (USBH_AUDIO_RING_SIZE - 1U);
+  chunk = USBH_AUDIO_RING_SIZE - pos;
+
+  if (chunk > length)
+  {
+    chunk = length;
+  }
+
+  (void)USBH_memcpy(pbuf, &AUDIO_Handle->Ring[pos], chunk);
+  (void)USBH_memcpy(&pbuf[chunk], &AUDIO_Handle->Ring[0], length - chunk);
+
+  AUDIO_Handle->Tail = tail + length;
+
+  return length;
+}
+
+/**
+  * @brief  USBH_AUDIO_GetFill
+  *         Bytes waiting in the ring.
+  * @param  phost: Host handle
+  * @retval Bytes
+  */
+uint32_t USBH_AUDIO_GetFill(USBH_HandleTypeDef *phost)
+{
+  AUDIO_HandleTypeDef *AUDIO_Handle;
+
+  if ((phost->gState != HOST_CLASS) || (phost->pActiveClass == NULL) ||
+      (phost->pActiveClass->ClassCode != USB_AUDIO_CLASS) ||
+      (phost->pActiveClass->pData == NULL))
+  {
+    return 0U;
+  }
+
+  AUDIO_Handle = (AUDIO_HandleTypeDef *) phost->pActiveClass->pData;
+
+  return AUDIO_Handle->Head - AUDIO_Handle->Tail;
+}
+
+/**
+  * @brief  USBH_AUDIO_GetFormat
+  *         PCM format of the stream.
+  * @param  phost: Host handle
+  * @param  format: Format
+  * @retval USBH Status
+  */
+USBH_StatusTypeDef USBH_AUDIO_GetFormat(USBH_HandleTypeDef *phost, AUDIO_FormatTypeDef *format)
+{
+  AUDIO_HandleTypeDef *AUDIO_Handle;
+
+  if ((phost->pActiveClass == NULL) ||
+      (phost->pActiveClass->ClassCode != USB_AUDIO_CLASS) ||
+      (phost->pActiveClass->pData == NULL))
+  {
+    return USBH_FAIL;
+  }
+
+  AUDIO_Handle = (AUDIO_HandleTypeDef *) phost->pActiveClass->pData;
+  *format = AUDIO_Handle->Format;
+
+  return USBH_OK;
+}
+
+/**
+  * @brief  USBH_AUDIO_GetStats
+  *         Streaming counters.
+  * @param  phost: Host handle
+  * @retval Counters, NULL when the audio class is not running
+  */
+const AUDIO_StatsTypeDef *USBH_AUDIO_GetStats(USBH_HandleTypeDef *phost)
+{
+  AUDIO_HandleTypeDef *AUDIO_Handle;
+
+  if ((phost->pActiveClass == NULL) ||
+      (phost->pActiveClass->ClassCode != USB_AUDIO_CLASS) ||
+      (phost->pActiveClass->pData == NULL))
+  {
+    return NULL;
+  }
+
+  AUDIO_Handle = (AUDIO_HandleTypeDef *) phost->pActiveClass->pData;
+
+  return &AUDIO_Handle->Stats;
+}
+
+/**
+  * @brief  The function informs user that PCM data was received
+  *  @param  phost: Selected device
+  * @retval None
+  */
+__weak void USBH_AUDIO_ReceiveCallback(USBH_HandleTypeDef *phost)
+{
+  /* Prevent unused argument(s) compilation warning */
+  UNUSED(phost);
+}
+/**
+* @}
+*/
+
+/**
+* @}
+*/
+
+/**
+* @}
+*/
+
+/**
+* @}
+*/
+
+/**
+* @}
+*/
+
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
@@ -0,0 +1,222 @@
+/**
+  ******************************************************************************
+  * @file    usbh_audio.h
+  * @brief   This file contains all the prototypes for the usbh_audio.c
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2015 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under Ultimate Liberty license
+  * SLA0044, the "License"; You may not use this file except in compliance with
+  * the License. You may obtain a copy of the License at:
+  *                      www.st.com/SLA0044
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive  ----------------------------------------------*/
+#ifndef __USBH_AUDIO_H
+#define __USBH_AUDIO_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "usbh_core.h"
+
+/** @addtogroup USBH_LIB
+  * @{
+  */
+
+/** @addtogroup USBH_CLASS
+  * @{
+  */
+
+/** @addtogroup USBH_AUDIO_CLASS
+  * @{
+  */
+
+/** @defgroup USBH_AUDIO_CORE
+  * @brief This file is the Header file for usbh_audio.c
+  * @{
+  */
+
+
+/** @defgroup USBH_AUDIO_CORE_Exported_Types
+  * @{
+  */
+
+/* Sampling frequency asked to the device, in Hz. An alternate setting
+   supporting it is preferred, otherwise the first one streaming PCM. */
+#ifndef USBH_AUDIO_FREQUENCY
+#define USBH_AUDIO_FREQUENCY                          48000U
+#endif /* USBH_AUDIO_FREQUENCY */
+
+/* PCM ring between the isochronous endpoint and USBH_AUDIO_Read(), in
+   bytes, a power of two. 4096 bytes hold 21 ms of 48 kHz stereo 16-bit. */
+#ifndef USBH_AUDIO_RING_SIZE
+#define USBH_AUDIO_RING_SIZE                          4096U
+#endif /* USBH_AUDIO_RING_SIZE */
+
+/* Largest isochronous packet handled: 49 samples of 48 kHz stereo 32-bit */
+#ifndef USBH_AUDIO_MAX_PACKET_SIZE
+#define USBH_AUDIO_MAX_PACKET_SIZE                    392U
+#endif /* USBH_AUDIO_MAX_PACKET_SIZE */
+
+#if ((USBH_AUDIO_RING_SIZE & (USBH_AUDIO_RING_SIZE - 1U)) != 0U)
+#error "USBH_AUDIO_RING_SIZE must be a power of two"
+#endif /* USBH_AUDIO_RING_SIZE */
+
+/* Audio class codes, USB Device Class Definition for Audio Devices 1.0 */
+#define USB_AUDIO_CLASS                               0x01U
+#define AUDIO_SUBCLASS_AUDIOCONTROL                   0x01U
+#define AUDIO_SUBCLASS_AUDIOSTREAMING                 0x02U
+
+/* Class-specific descriptor types and subtypes */
+#define AUDIO_CS_INTERFACE                            0x24U
+#define AUDIO_CS_ENDPOINT                             0x25U
+#define AUDIO_AS_GENERAL                              0x01U
+#define AUDIO_FORMAT_TYPE                             0x02U
+#define AUDIO_EP_GENERAL                              0x01U
+
+#define AUDIO_FORMAT_TYPE_I                           0x01U
+#define AUDIO_FORMAT_PCM                              0x0001U
+
+/* AUDIO_CS_ENDPOINT bmAttributes */
+#define AUDIO_EP_SAMPLING_FREQ_CONTROL                0x01U
+
+/* Class-specific requests */
+#define AUDIO_REQ_SET_CUR                             0x01U
+#define AUDIO_REQ_GET_CUR                             0x81U
+#define AUDIO_SAMPLING_FREQ_CONTROL                   0x01U
+
+/* States for AUDIO State Machine */
+typedef enum
+{
+  AUDIO_INIT = 0U,
+  AUDIO_STREAMING,
+  AUDIO_ERROR,
+}
+AUDIO_StateTypeDef;
+
+typedef enum
+{
+  AUDIO_REQ_INIT = 0U,
+  AUDIO_REQ_SET_INTERFACE,
+  AUDIO_REQ_SET_FREQUENCY,
+  AUDIO_REQ_IDLE,
+}
+AUDIO_CtlStateTypeDef;
+
+/* PCM format of the streaming alternate setting */
+typedef struct
+{
+  uint32_t             Frequency;       /* Hz */
+  uint8_t              Channels;
+  uint8_t              SubframeSize;    /* Bytes per sample of one channel */
+  uint8_t              BitResolution;
+}
+AUDIO_FormatTypeDef;
+
+typedef struct
+{
+  uint32_t             Packets;         /* Isochronous packets received */
+  uint32_t             Bytes;           /* PCM bytes put in the ring */
+  uint32_t             Empty;           /* Packets without data */
+  uint32_t             Dropped;         /* Frames lost: no IN token sent, or a transfer error */
+  uint32_t             Overruns;        /* Packets lost to a full ring */
+  uint32_t             MaxFill;         /* Most bytes waiting in the ring */
+}
+AUDIO_StatsTypeDef;
+
+/* Structure for AUDIO process */
+typedef struct _AUDIO_Process
+{
+  AUDIO_StateTypeDef   state;
+  AUDIO_CtlStateTypeDef ctl_state;
+  uint8_t              InPipe;
+  uint8_t              InEp;
+  uint16_t             InEpSize;
+  uint8_t              Interval;        /* Frames between packets */
+  uint8_t              AsItfNumber;     /* Streaming interface */
+  uint8_t              AltSetting;      /* Its alternate setting streaming Format */
+  uint8_t              FreqControl;     /* Sampling frequency settable on the endpoint */
+  uint8_t              FreqBuf[3];
+  uint8_t              PacketIdx;       /* Packet buffer of the transfer in flight */
+  AUDIO_FormatTypeDef  Format;
+  AUDIO_StatsTypeDef   Stats;
+  uint32_t             Skipped;         /* Frames skipped by the schedule, already counted */
+  __IO uint32_t        Head;            /* Ring write index, free running */
+  __IO uint32_t        Tail;            /* Ring read index, free running */
+  uint8_t              Packet[2][USBH_AUDIO_MAX_PACKET_SIZE];
+  uint8_t              Ring[USBH_AUDIO_RING_SIZE];
+}
+AUDIO_HandleTypeDef;
+
+/**
+  * @}
+  */
+
+/** @defgroup USBH_AUDIO_CORE_Exported_Defines
+  * @{
+  */
+
+/**
+  * @}
+  */
+
+/** @defgroup USBH_AUDIO_CORE_Exported_Macros
+  * @{
+  */
+/**
+  * @}
+  */
+
+/** @defgroup USBH_AUDIO_CORE_Exported_Variables
+  * @{
+  */
+extern USBH_ClassTypeDef  AUDIO_Class;
+#define USBH_AUDIO_CLASS    &AUDIO_Class
+
+/**
+  * @}
+  */
+
+/** @defgroup USBH_AUDIO_CORE_Exported_FunctionsPrototype
+  * @{
+  */
+uint32_t USBH_AUDIO_Read(USBH_HandleTypeDef *phost, uint8_t *pbuf, uint32_t length);
+uint32_t USBH_AUDIO_GetFill(USBH_HandleTypeDef *phost);
+USBH_StatusTypeDef USBH_AUDIO_GetFormat(USBH_HandleTypeDef *phost, AUDIO_FormatTypeDef *format);
+const AUDIO_StatsTypeDef *USBH_AUDIO_GetStats(USBH_HandleTypeDef *phost);
+void USBH_AUDIO_ReceiveCallback(USBH_HandleTypeDef *phost);
+/**
+  * @}
+  */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __USBH_AUDIO_H */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
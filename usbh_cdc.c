@@ -108,23 +108,31 @@ static USBH_StatusTypeDef USBH_CDC_InterfaceDeInit(USBH_HandleTypeDef *phost);
 
 static USBH_StatusTypeDef USBH_CDC_Process(USBH_HandleTypeDef *phost);
 
-static USBH_StatusTypeDef USBH_CDC_SOFProcess(USBH_HandleTypeDef *phost);
-
 static USBH_StatusTypeDef USBH_CDC_ClassRequest(USBH_HandleTypeDef *phost);
 
 static USBH_StatusTypeDef GetLineCoding(USBH_HandleTypeDef *phost,
                                         CDC_LineCodingTypeDef *linecoding);
 
-static USBH_StatusTypeDef SetLineCoding(USBH_HandleTypeDef *phost,
-                                        CDC_LineCodingTypeDef *linecoding);
+static void GetLineCodingSetup(USBH_HandleTypeDef *phost, USB_Setup_TypeDef *setup);
+
+static void SetLineCodingSetup(USBH_HandleTypeDef *phost, USB_Setup_TypeDef *setup);
+
+static void SetControlLineStateSetup(USBH_HandleTypeDef *phost, USB_Setup_TypeDef *setup,
+                                     uint8_t dtr, uint8_t rts);
 
-static USBH_StatusTypeDef SetControlLineState(USBH_HandleTypeDef *phost,
-                                        uint8_t dtr, uint8_t rts);
+static void LineCodingDone(USBH_HandleTypeDef *phost, USBH_StatusTypeDef status,
+                           void *pContext);
 
 static void CDC_ProcessTransmission(USBH_HandleTypeDef *phost);
 
 static void CDC_ProcessReception(USBH_HandleTypeDef *phost);
 
+static void CDC_TimerCallback(USBH_HandleTypeDef *phost);
+static uint16_t CDC_UrbLength(uint32_t length, uint16_t mps, uint32_t max);
+
+static void CDC_PipeCallback(USBH_HandleTypeDef *phost, uint8_t pipe,
+                             USBH_URBStateTypeDef urb_state, uint32_t length);
+
 USBH_ClassTypeDef  CDC_Class =
 {
   "CDC",
@@ -133,7 +141,7 @@ USBH_ClassTypeDef  CDC_Class =
   USBH_CDC_InterfaceDeInit,
   USBH_CDC_ClassRequest,
   USBH_CDC_Process,
-  USBH_CDC_SOFProcess,
+  NULL,
   NULL,
 };
 /**
@@ -156,12 +164,17 @@ static USBH_StatusTypeDef USBH_CDC_InterfaceInit(USBH_HandleTypeDef *phost)
 
   USBH_StatusTypeDef status;
   uint8_t interface;
+  uint8_t data_itf = 0xFFU;
+  uint8_t *pdesc;
+  USBH_DescIterTypeDef iter;
+  USBH_InterfaceDescTypeDef itf;
+  USBH_EpDescTypeDef ep;
   CDC_HandleTypeDef *CDC_Handle;
 
   interface = USBH_FindInterface(phost, COMMUNICATION_INTERFACE_CLASS_CODE,
                                    ABSTRACT_CONTROL_MODEL, COMMON_AT_COMMAND);
 
-  if ((interface == 0xFFU) || (interface >= USBH_MAX_NUM_INTERFACES)) /* No Valid Interface */
+  if (interface == 0xFFU) /* No Valid Interface */
   {
     USBH_DbgLog("Cannot Find the interface for Communication Interface Class.", phost->pActiveClass->Name);
     return USBH_FAIL;
@@ -186,53 +199,77 @@ static USBH_StatusTypeDef USBH_CDC_InterfaceInit(USBH_HandleTypeDef *phost)
   /* Initialize cdc handler */
   (void)USBH_memset(CDC_Handle, 0, sizeof(CDC_HandleTypeDef));
 
+  /* The union functional descriptor names the data interface of this
+     communication interface, a composite device may have several */
+  (void)USBH_DescIter_SeekInterface(phost, &iter, interface, NULL);
+
+  while ((pdesc = USBH_DescIter_NextClassDesc(&iter, CS_INTERFACE)) != NULL)
+  {
+    if ((pdesc[0] >= 5U) && (pdesc[2] == CDC_UNION_FUNC_DESC))
+    {
+      data_itf = USBH_FindInterfaceIndex(phost, pdesc[4], 0U);
+      break;
+    }
+  }
+
   /*Collect the notification endpoint address and length*/
-  if ((phost->device.CfgDesc.Itf_Desc[interface].Ep_Desc[0].bEndpointAddress & 0x80U) != 0U)
+  (void)USBH_DescIter_SeekInterface(phost, &iter, interface, NULL);
+
+  if ((USBH_DescIter_NextEndpoint(&iter, &ep) == USBH_OK) &&
+      ((ep.bEndpointAddress & 0x80U) != 0U))
   {
-    CDC_Handle->CommItf.NotifEp = phost->device.CfgDesc.Itf_Desc[interface].Ep_Desc[0].bEndpointAddress;
-    CDC_Handle->CommItf.NotifEpSize  = phost->device.CfgDesc.Itf_Desc[interface].Ep_Desc[0].wMaxPacketSize;
+    CDC_Handle->CommItf.NotifEp = ep.bEndpointAddress;
+    CDC_Handle->CommItf.NotifEpSize  = ep.wMaxPacketSize;
   }
 
   /*Allocate the length for host channel number in*/
   CDC_Handle->CommItf.NotifPipe = USBH_AllocPipe(phost, CDC_Handle->CommItf.NotifEp);
 
+  if (CDC_Handle->CommItf.NotifPipe == USBH_PIPE_NONE)
+  {
+    return USBH_FAIL;
+  }
+
   /* Open pipe for Notification endpoint */
   (void)USBH_OpenPipe(phost, CDC_Handle->CommItf.NotifPipe, CDC_Handle->CommItf.NotifEp,
                       phost->device.address, phost->device.speed, USB_EP_TYPE_INTR,
                       CDC_Handle->CommItf.NotifEpSize);
 
-  (void)USBH_LL_SetToggle(phost, CDC_Handle->CommItf.NotifPipe, 0U);
+  (void)USBH_SetToggle(phost, CDC_Handle->CommItf.NotifPipe, 0U);
 
-  interface = USBH_FindInterface(phost, DATA_INTERFACE_CLASS_CODE,
-                                   RESERVED, NO_CLASS_SPECIFIC_PROTOCOL_CODE);
+  /* Without union descriptor, the first free data interface is taken */
+  if ((data_itf == 0xFFU) ||
+      (USBH_DescIter_SeekInterface(phost, &iter, data_itf, &itf) != USBH_OK) ||
+      (itf.bInterfaceClass != DATA_INTERFACE_CLASS_CODE))
+  {
+    data_itf = USBH_FindInterface(phost, DATA_INTERFACE_CLASS_CODE,
+                                  RESERVED, NO_CLASS_SPECIFIC_PROTOCOL_CODE);
+  }
 
-  if ((interface == 0xFFU) || (interface >= USBH_MAX_NUM_INTERFACES)) /* No Valid Interface */
+  if (data_itf == 0xFFU) /* No Valid Interface */
   {
     USBH_DbgLog("Cannot Find the interface for Data Interface Class.", phost->pActiveClass->Name);
     return USBH_FAIL;
   }
 
+  /* The data interface belongs to this function of a composite device */
+  USBH_ClaimInterface(phost, data_itf);
+
   /*Collect the class specific endpoint address and length*/
-  if ((phost->device.CfgDesc.Itf_Desc[interface].Ep_Desc[0].bEndpointAddress & 0x80U) != 0U)
-  {
-    CDC_Handle->DataItf.InEp = phost->device.CfgDesc.Itf_Desc[interface].Ep_Desc[0].bEndpointAddress;
-    CDC_Handle->DataItf.InEpSize  = phost->device.CfgDesc.Itf_Desc[interface].Ep_Desc[0].wMaxPacketSize;
-  }
-  else
-  {
-    CDC_Handle->DataItf.OutEp = phost->device.CfgDesc.Itf_Desc[interface].Ep_Desc[0].bEndpointAddress;
-    CDC_Handle->DataItf.OutEpSize  = phost->device.CfgDesc.Itf_Desc[interface].Ep_Desc[0].wMaxPacketSize;
-  }
+  (void)USBH_DescIter_SeekInterface(phost, &iter, data_itf, NULL);
 
-  if ((phost->device.CfgDesc.Itf_Desc[interface].Ep_Desc[1].bEndpointAddress & 0x80U) != 0U)
+  while (USBH_DescIter_NextEndpoint(&iter, &ep) == USBH_OK)
   {
-    CDC_Handle->DataItf.InEp = phost->device.CfgDesc.Itf_Desc[interface].Ep_Desc[1].bEndpointAddress;
-    CDC_Handle->DataItf.InEpSize  = phost->device.CfgDesc.Itf_Desc[interface].Ep_Desc[1].wMaxPacketSize;
-  }
-  else
-  {
-    CDC_Handle->DataItf.OutEp = phost->device.CfgDesc.Itf_Desc[interface].Ep_Desc[1].bEndpointAddress;
-    CDC_Handle->DataItf.OutEpSize = phost->device.CfgDesc.Itf_Desc[interface].Ep_Desc[1].wMaxPacketSize;
+    if ((ep.bEndpointAddress & 0x80U) != 0U)
+    {
+      CDC_Handle->DataItf.InEp = ep.bEndpointAddress;
+      CDC_Handle->DataItf.InEpSize  = ep.wMaxPacketSize;
+    }
+    else
+    {
+      CDC_Handle->DataItf.OutEp = ep.bEndpointAddress;
+      CDC_Handle->DataItf.OutEpSize  = ep.wMaxPacketSize;
+    }
   }
 
   /*Allocate the length for host channel number out*/
@@ -241,6 +278,12 @@ static USBH_StatusTypeDef USBH_CDC_InterfaceInit(USBH_HandleTypeDef *phost)
   /*Allocate the length for host channel number in*/
   CDC_Handle->DataItf.InPipe = USBH_AllocPipe(phost, CDC_Handle->DataItf.InEp);
 
+  if ((CDC_Handle->DataItf.OutPipe == USBH_PIPE_NONE) ||
+      (CDC_Handle->DataItf.InPipe == USBH_PIPE_NONE))
+  {
+    return USBH_FAIL;
+  }
+
   /* Open channel for OUT endpoint */
   (void)USBH_OpenPipe(phost, CDC_Handle->DataItf.OutPipe, CDC_Handle->DataItf.OutEp,
                       phost->device.address, phost->device.speed, USB_EP_TYPE_BULK,
@@ -256,6 +299,9 @@ static USBH_StatusTypeDef USBH_CDC_InterfaceInit(USBH_HandleTypeDef *phost)
   (void)USBH_LL_SetToggle(phost, CDC_Handle->DataItf.OutPipe, 0U);
   (void)USBH_LL_SetToggle(phost, CDC_Handle->DataItf.InPipe, 0U);
 
+  (void)USBH_RegisterPipeCallback(phost, CDC_Handle->DataItf.OutPipe, CDC_PipeCallback);
+  (void)USBH_RegisterPipeCallback(phost, CDC_Handle->DataItf.InPipe, CDC_PipeCallback);
+
   return USBH_OK;
 }
 
@@ -271,6 +317,8 @@ static USBH_StatusTypeDef USBH_CDC_InterfaceDeInit(USBH_HandleTypeDef *phost)
 {
   CDC_HandleTypeDef *CDC_Handle = (CDC_HandleTypeDef *) phost->pActiveClass->pData;
 
+  (void)USBH_TimerStop(phost, CDC_TimerCallback);
+
   if ((CDC_Handle->CommItf.NotifPipe) != 0U)
   {
     (void)USBH_ClosePipe(phost, CDC_Handle->CommItf.NotifPipe);
@@ -344,6 +392,9 @@ static USBH_StatusTypeDef USBH_CDC_Process(USBH_HandleTypeDef *phost)
   USBH_StatusTypeDef req_status = USBH_OK;
   CDC_HandleTypeDef *CDC_Handle = (CDC_HandleTypeDef *) phost->pActiveClass->pData;
 
+  /* Transfers queued from here start on this very pass */
+  USBH_CDC_ProcessCallback(phost);
+
   switch (CDC_Handle->state)
   {
 
@@ -351,65 +402,6 @@ static USBH_StatusTypeDef USBH_CDC_Process(USBH_HandleTypeDef *phost)
       status = USBH_OK;
       break;
 
-    case CDC_SET_CONTROL_LINE_STATE_STATE:
-      req_status = SetControlLineState(phost, CDC_Handle->dtr, CDC_Handle->rts);
-
-      if (req_status == USBH_OK)
-      {
-        CDC_Handle->state = CDC_IDLE_STATE;
-      }
-
-      else
-      {
-        if (req_status != USBH_BUSY)
-        {
-          CDC_Handle->state = CDC_ERROR_STATE;
-        }
-      }
-      break;
-
-    case CDC_SET_LINE_CODING_STATE:
-      req_status = SetLineCoding(phost, CDC_Handle->pUserLineCoding);
-
-      if (req_status == USBH_OK)
-      {
-        CDC_Handle->state = CDC_GET_LAST_LINE_CODING_STATE;
-      }
-
-      else
-      {
-        if (req_status != USBH_BUSY)
-        {
-          CDC_Handle->state = CDC_ERROR_STATE;
-        }
-      }
-      break;
-
-
-    case CDC_GET_LAST_LINE_CODING_STATE:
-      req_status = GetLineCoding(phost, &(CDC_Handle->LineCoding));
-
-      if (req_status == USBH_OK)
-      {
-        CDC_Handle->state = CDC_IDLE_STATE;
-
-        if ((CDC_Handle->LineCoding.b.bCharFormat == CDC_Handle->pUserLineCoding->b.bCharFormat) &&
-            (CDC_Handle->LineCoding.b.bDataBits == CDC_Handle->pUserLineCoding->b.bDataBits) &&
-            (CDC_Handle->LineCoding.b.bParityType == CDC_Handle->pUserLineCoding->b.bParityType) &&
-            (CDC_Handle->LineCoding.b.dwDTERate == CDC_Handle->pUserLineCoding->b.dwDTERate))
-        {
-          USBH_CDC_LineCodingChanged(phost);
-        }
-      }
-      else
-      {
-        if (req_status != USBH_BUSY)
-        {
-          CDC_Handle->state = CDC_ERROR_STATE;
-        }
-      }
-      break;
-
     case CDC_TRANSFER_DATA:
       CDC_ProcessTransmission(phost);
       CDC_ProcessReception(phost);
@@ -433,21 +425,6 @@ static USBH_StatusTypeDef USBH_CDC_Process(USBH_HandleTypeDef *phost)
   return status;
 }
 
-/**
-  * @brief  USBH_CDC_SOFProcess
-  *         The function is for managing SOF callback
-  * @param  phost: Host handle
-  * @retval USBH Status
-  */
-static USBH_StatusTypeDef USBH_CDC_SOFProcess(USBH_HandleTypeDef *phost)
-{
-  /* Prevent unused argument(s) compilation warning */
-  UNUSED(phost);
-
-  return USBH_OK;
-}
-
-
 /**
   * @brief  USBH_CDC_Stop
   *         Stop current CDC Transmission
@@ -476,16 +453,27 @@ USBH_StatusTypeDef USBH_CDC_Stop(USBH_HandleTypeDef *phost)
   */
 static USBH_StatusTypeDef GetLineCoding(USBH_HandleTypeDef *phost, CDC_LineCodingTypeDef *linecoding)
 {
+  GetLineCodingSetup(phost, &phost->Control.setup);
 
-  phost->Control.setup.b.bmRequestType = USB_D2H | USB_REQ_TYPE_CLASS | \
-                                         USB_REQ_RECIPIENT_INTERFACE;
+  return USBH_CtlReq(phost, linecoding->Array, LINE_CODING_STRUCTURE_SIZE);
+}
 
-  phost->Control.setup.b.bRequest = CDC_GET_LINE_CODING;
-  phost->Control.setup.b.wValue.w = 0U;
-  phost->Control.setup.b.wIndex.w = 0U;
-  phost->Control.setup.b.wLength.w = LINE_CODING_STRUCTURE_SIZE;
 
-  return USBH_CtlReq(phost, linecoding->Array, LINE_CODING_STRUCTURE_SIZE);
+/**
+  * @brief  Setup packet of the request reading the line coding.
+  * @param  pdev: Selected device
+  * @param  setup: Setup packet to fill
+  * @retval None
+  */
+static void GetLineCodingSetup(USBH_HandleTypeDef *phost, USB_Setup_TypeDef *setup)
+{
+  setup->b.bmRequestType = USB_D2H | USB_REQ_TYPE_CLASS | \
+                           USB_REQ_RECIPIENT_INTERFACE;
+
+  setup->b.bRequest = CDC_GET_LINE_CODING;
+  setup->b.wValue.w = 0U;
+  setup->b.wIndex.w = USBH_CURRENT_ITF_NUMBER(phost);
+  setup->b.wLength.w = LINE_CODING_STRUCTURE_SIZE;
 }
 
 
@@ -495,87 +483,115 @@ static USBH_StatusTypeDef GetLineCoding(USBH_HandleTypeDef *phost, CDC_LineCodin
   * This request applies to asynchronous byte stream data class interfaces
   * and endpoints
   * @param  pdev: Selected device
-  * @retval USBH_StatusTypeDef : USB ctl xfer status
+  * @param  setup: Setup packet to fill
+  * @retval None
   */
-static USBH_StatusTypeDef SetLineCoding(USBH_HandleTypeDef *phost,
-                                        CDC_LineCodingTypeDef *linecoding)
+static void SetLineCodingSetup(USBH_HandleTypeDef *phost, USB_Setup_TypeDef *setup)
 {
-  phost->Control.setup.b.bmRequestType = USB_H2D | USB_REQ_TYPE_CLASS |
-                                         USB_REQ_RECIPIENT_INTERFACE;
-
-  phost->Control.setup.b.bRequest = CDC_SET_LINE_CODING;
-  phost->Control.setup.b.wValue.w = 0U;
+  setup->b.bmRequestType = USB_H2D | USB_REQ_TYPE_CLASS |
+                           USB_REQ_RECIPIENT_INTERFACE;
 
-  phost->Control.setup.b.wIndex.w = 0U;
+  setup->b.bRequest = CDC_SET_LINE_CODING;
+  setup->b.wValue.w = 0U;
 
-  phost->Control.setup.b.wLength.w = LINE_CODING_STRUCTURE_SIZE;
+  setup->b.wIndex.w = USBH_CURRENT_ITF_NUMBER(phost);
 
-  return USBH_CtlReq(phost, linecoding->Array, LINE_CODING_STRUCTURE_SIZE);
+  setup->b.wLength.w = LINE_CODING_STRUCTURE_SIZE;
 }
 
-static USBH_StatusTypeDef SetControlLineState(USBH_HandleTypeDef *phost,
-                                        uint8_t dtr,  uint8_t rts)
+static void SetControlLineStateSetup(USBH_HandleTypeDef *phost, USB_Setup_TypeDef *setup,
+                                     uint8_t dtr, uint8_t rts)
 {
-  phost->Control.setup.b.bmRequestType = USB_H2D | USB_REQ_TYPE_CLASS |
-                                         USB_REQ_RECIPIENT_INTERFACE;
-
-  phost->Control.setup.b.bRequest = CDC_SET_CONTROL_LINE_STATE;
-  phost->Control.setup.b.wValue.w = dtr | (rts << 1);
+  setup->b.bmRequestType = USB_H2D | USB_REQ_TYPE_CLASS |
+                           USB_REQ_RECIPIENT_INTERFACE;
 
-  phost->Control.setup.b.wIndex.w = 0U;
+  setup->b.bRequest = CDC_SET_CONTROL_LINE_STATE;
+  setup->b.wValue.w = dtr | (rts << 1);
 
-  phost->Control.setup.b.wLength.w = 0U;
+  setup->b.wIndex.w = USBH_CURRENT_ITF_NUMBER(phost);
 
-  return USBH_CtlReq(phost, NULL, 0);
+  setup->b.wLength.w = 0U;
 }
 
 /**
-  * @brief  This function prepares the state before issuing the class specific commands
-  * @param  None
+  * @brief  Completion of the line coding change: the device reports the
+  *         line coding it took. The user is told the outcome in every case.
+  * @param  phost: Host handle
+  * @param  status: Status of the request sequence
+  * @param  pContext: CDC handle
   * @retval None
   */
+static void LineCodingDone(USBH_HandleTypeDef *phost, USBH_StatusTypeDef status,
+                           void *pContext)
+{
+  CDC_HandleTypeDef *CDC_Handle = (CDC_HandleTypeDef *)pContext;
+
+  if (status != USBH_OK)
+  {
+    USBH_ErrLog("Control error: CDC: Device Set Line Coding request failed");
+  }
+  else if ((CDC_Handle->LineCoding.b.bCharFormat != CDC_Handle->pUserLineCoding->b.bCharFormat) ||
+           (CDC_Handle->LineCoding.b.bDataBits != CDC_Handle->pUserLineCoding->b.bDataBits) ||
+           (CDC_Handle->LineCoding.b.bParityType != CDC_Handle->pUserLineCoding->b.bParityType) ||
+           (CDC_Handle->LineCoding.b.dwDTERate != CDC_Handle->pUserLineCoding->b.dwDTERate))
+  {
+    USBH_DbgLog("CDC: Device kept another line coding");
+    status = USBH_NOT_SUPPORTED;
+  }
+
+  USBH_CDC_LineCodingCallback(phost, status);
+}
+
+/**
+  * @brief  Queue the line coding change and the request reading it back,
+  *         in one control sequence. The transfers keep running meanwhile.
+  * @param  phost: Host handle
+  * @param  linecoding: Line coding, valid until USBH_CDC_LineCodingCallback()
+  *         reports the outcome of the change
+  * @retval USBH_OK, USBH_BUSY when the control queue is full
+  */
 USBH_StatusTypeDef USBH_CDC_SetLineCoding(USBH_HandleTypeDef *phost,
                                           CDC_LineCodingTypeDef *linecoding)
 {
   CDC_HandleTypeDef *CDC_Handle = (CDC_HandleTypeDef *) phost->pActiveClass->pData;
+  USBH_CtlSeqItemTypeDef req[2];
 
   if (phost->gState == HOST_CLASS)
   {
-    CDC_Handle->state = CDC_SET_LINE_CODING_STATE;
     CDC_Handle->pUserLineCoding = linecoding;
 
-#if (USBH_USE_OS == 1U)
-    phost->os_msg = (uint32_t)USBH_CLASS_EVENT;
-#if (osCMSIS < 0x20000U)
-    (void)osMessagePut(phost->os_event, phost->os_msg, 0U);
-#else
-    (void)osMessageQueuePut(phost->os_event, &phost->os_msg, 0U, 0U);
-#endif
-#endif
+    SetLineCodingSetup(phost, &req[0].setup);
+    req[0].buff = linecoding->Array;
+    req[0].Flags = 0U;
+
+    GetLineCodingSetup(phost, &req[1].setup);
+    req[1].buff = CDC_Handle->LineCoding.Array;
+    req[1].Flags = 0U;
+
+    return USBH_CtlSubmitSeq(phost, req, 2U, LineCodingDone, CDC_Handle);
   }
 
   return USBH_OK;
 }
 
+/**
+  * @brief  Queue the request setting the DTR and RTS signals, it runs after
+  *         a line coding change queued before.
+  * @param  phost: Host handle
+  * @param  dtr: DTR state
+  * @param  rts: RTS state
+  * @retval USBH_OK, USBH_BUSY when the control queue is full
+  */
 USBH_StatusTypeDef USBH_CDC_SetControlLineState(USBH_HandleTypeDef *phost,
                                           uint8_t dtr, uint8_t rts)
 {
-  CDC_HandleTypeDef *CDC_Handle = (CDC_HandleTypeDef *) phost->pActiveClass->pData;
+  USB_Setup_TypeDef setup;
 
   if (phost->gState == HOST_CLASS)
   {
-    CDC_Handle->state = CDC_SET_CONTROL_LINE_STATE_STATE;
-    CDC_Handle->dtr = dtr;
-    CDC_Handle->rts = rts;
+    SetControlLineStateSetup(phost, &setup, dtr, rts);
 
-#if (USBH_USE_OS == 1U)
-    phost->os_msg = (uint32_t)USBH_CLASS_EVENT;
-#if (osCMSIS < 0x20000U)
-    (void)osMessagePut(phost->os_event, phost->os_msg, 0U);
-#else
-    (void)osMessageQueuePut(phost->os_event, &phost->os_msg, 0U, 0U);
-#endif
-#endif
+    return USBH_CtlSubmit(phost, &setup, NULL, NULL, NULL);
   }
 
   return USBH_OK;
@@ -604,25 +620,26 @@ USBH_StatusTypeDef USBH_CDC_GetLineCoding(USBH_HandleTypeDef *phost,
 }
 
 /**
-  * @brief  This function return last received data size
+  * @brief  This function return the size of the data received by the last
+  *         USBH_CDC_Receive()
   * @param  None
   * @retval None
   */
-uint16_t USBH_CDC_GetLastReceivedDataSize(USBH_HandleTypeDef *phost)
+uint32_t USBH_CDC_GetLastReceivedDataSize(USBH_HandleTypeDef *phost)
 {
   uint32_t dataSize;
   CDC_HandleTypeDef *CDC_Handle = (CDC_HandleTypeDef *) phost->pActiveClass->pData;
 
   if (phost->gState == HOST_CLASS)
   {
-    dataSize = USBH_LL_GetLastXferSize(phost, CDC_Handle->DataItf.InPipe);
+    dataSize = CDC_Handle->RxDataCount;
   }
   else
   {
     dataSize =  0U;
   }
 
-  return (uint16_t)dataSize;
+  return dataSize;
 }
 
 /**
@@ -644,12 +661,7 @@ USBH_StatusTypeDef USBH_CDC_Transmit(USBH_HandleTypeDef *phost, uint8_t *pbuff,
     Status = USBH_OK;
 
 #if (USBH_USE_OS == 1U)
-    phost->os_msg = (uint32_t)USBH_CLASS_EVENT;
-#if (osCMSIS < 0x20000U)
-    (void)osMessagePut(phost->os_event, phost->os_msg, 0U);
-#else
-    (void)osMessageQueuePut(phost->os_event, &phost->os_msg, 0U, 0U);
-#endif
+    USBH_OS_PostEvent(phost, USBH_CLASS_EVENT);
 #endif
   }
   return Status;
@@ -670,17 +682,13 @@ USBH_StatusTypeDef USBH_CDC_Receive(USBH_HandleTypeDef *phost, uint8_t *pbuff, u
   {
     CDC_Handle->pRxData = pbuff;
     CDC_Handle->RxDataLength = length;
+    CDC_Handle->RxDataCount = 0U;
     CDC_Handle->state = CDC_TRANSFER_DATA;
     CDC_Handle->data_rx_state = CDC_RECEIVE_DATA;
     Status = USBH_OK;
 
 #if (USBH_USE_OS == 1U)
-    phost->os_msg = (uint32_t)USBH_CLASS_EVENT;
-#if (osCMSIS < 0x20000U)
-    (void)osMessagePut(phost->os_event, phost->os_msg, 0U);
-#else
-    (void)osMessageQueuePut(phost->os_event, &phost->os_msg, 0U, 0U);
-#endif
+    USBH_OS_PostEvent(phost, USBH_CLASS_EVENT);
 #endif
   }
   return Status;
@@ -694,83 +702,24 @@ USBH_StatusTypeDef USBH_CDC_Receive(USBH_HandleTypeDef *phost, uint8_t *pbuff, u
 static void CDC_ProcessTransmission(USBH_HandleTypeDef *phost)
 {
   CDC_HandleTypeDef *CDC_Handle = (CDC_HandleTypeDef *) phost->pActiveClass->pData;
-  USBH_URBStateTypeDef URB_Status = USBH_URB_IDLE;
 
   switch (CDC_Handle->data_tx_state)
   {
     case CDC_SEND_DATA:
-      if (CDC_Handle->TxDataLength > CDC_Handle->DataItf.OutEpSize)
-      {
-        (void)USBH_BulkSendData(phost,
-                                CDC_Handle->pTxData,
-                                CDC_Handle->DataItf.OutEpSize,
-                                CDC_Handle->DataItf.OutPipe,
-                                1U);
-      }
-      else
-      {
-        (void)USBH_BulkSendData(phost,
-                                CDC_Handle->pTxData,
-                                (uint16_t)CDC_Handle->TxDataLength,
-                                CDC_Handle->DataItf.OutPipe,
-                                1U);
-      }
+      /* The HCD splits the transfer into packets */
+      (void)USBH_BulkSendData(phost,
+                              CDC_Handle->pTxData,
+                              CDC_UrbLength(CDC_Handle->TxDataLength,
+                                            CDC_Handle->DataItf.OutEpSize,
+                                            USBH_CDC_TX_URB_SIZE),
+                              CDC_Handle->DataItf.OutPipe,
+                              1U);
 
       CDC_Handle->data_tx_state = CDC_SEND_DATA_WAIT;
       break;
 
     case CDC_SEND_DATA_WAIT:
-
-      URB_Status = USBH_LL_GetURBState(phost, CDC_Handle->DataItf.OutPipe);
-
-      /* Check the status done for transmission */
-      if (URB_Status == USBH_URB_DONE)
-      {
-        if (CDC_Handle->TxDataLength > CDC_Handle->DataItf.OutEpSize)
-        {
-          CDC_Handle->TxDataLength -= CDC_Handle->DataItf.OutEpSize;
-          CDC_Handle->pTxData += CDC_Handle->DataItf.OutEpSize;
-        }
-        else
-        {
-          CDC_Handle->TxDataLength = 0U;
-        }
-
-        if (CDC_Handle->TxDataLength > 0U)
-        {
-          CDC_Handle->data_tx_state = CDC_SEND_DATA;
-        }
-        else
-        {
-          CDC_Handle->data_tx_state = CDC_IDLE;
-          USBH_CDC_TransmitCallback(phost);
-        }
-
-#if (USBH_USE_OS == 1U)
-        phost->os_msg = (uint32_t)USBH_CLASS_EVENT;
-#if (osCMSIS < 0x20000U)
-        (void)osMessagePut(phost->os_event, phost->os_msg, 0U);
-#else
-        (void)osMessageQueuePut(phost->os_event, &phost->os_msg, 0U, 0U);
-#endif
-#endif
-      }
-      else
-      {
-        if (URB_Status == USBH_URB_NOTREADY)
-        {
-          CDC_Handle->data_tx_state = CDC_SEND_DATA;
-
-#if (USBH_USE_OS == 1U)
-          phost->os_msg = (uint32_t)USBH_CLASS_EVENT;
-#if (osCMSIS < 0x20000U)
-          (void)osMessagePut(phost->os_event, phost->os_msg, 0U);
-#else
-          (void)osMessageQueuePut(phost->os_event, &phost->os_msg, 0U, 0U);
-#endif
-#endif
-        }
-      }
+      /* Completion is delivered to CDC_PipeCallback */
       break;
 
     default:
@@ -786,7 +735,6 @@ static void CDC_ProcessTransmission(USBH_HandleTypeDef *phost)
 static void CDC_ProcessReception(USBH_HandleTypeDef *phost)
 {
   CDC_HandleTypeDef *CDC_Handle = (CDC_HandleTypeDef *) phost->pActiveClass->pData;
-  USBH_URBStateTypeDef URB_Status = USBH_URB_IDLE;
   uint32_t length;
 
   switch (CDC_Handle->data_rx_state)
@@ -794,9 +742,17 @@ static void CDC_ProcessReception(USBH_HandleTypeDef *phost)
 
     case CDC_RECEIVE_DATA:
 
+      /* The HCD receives whole packets: completes on a short packet or
+         once the packets fitting in the buffer are in */
+      length = CDC_Handle->RxDataLength;
+      if (length >= CDC_Handle->DataItf.InEpSize)
+      {
+        length -= length % CDC_Handle->DataItf.InEpSize;
+      }
+
       (void)USBH_BulkReceiveData(phost,
                                  CDC_Handle->pRxData,
-                                 CDC_Handle->DataItf.InEpSize,
+                                 CDC_UrbLength(length, CDC_Handle->DataItf.InEpSize, 0xFFFFU),
                                  CDC_Handle->DataItf.InPipe);
 
       CDC_Handle->data_rx_state = CDC_RECEIVE_DATA_WAIT;
@@ -804,42 +760,157 @@ static void CDC_ProcessReception(USBH_HandleTypeDef *phost)
       break;
 
     case CDC_RECEIVE_DATA_WAIT:
+      /* Completion is delivered to CDC_PipeCallback */
+      break;
+
+    default:
+      break;
+  }
+}
 
-      URB_Status = USBH_LL_GetURBState(phost, CDC_Handle->DataItf.InPipe);
+/**
+  * @brief  Bulk transfer completed on one of the data pipes
+  *  @param  pdev: Selected device
+  * @param  pipe: Pipe index
+  * @param  urb_state: Final URB state
+  * @param  length: Number of bytes transferred
+  * @retval None
+  */
+static void CDC_PipeCallback(USBH_HandleTypeDef *phost, uint8_t pipe,
+                             USBH_URBStateTypeDef urb_state, uint32_t length)
+{
+  CDC_HandleTypeDef *CDC_Handle;
+
+  if ((phost->pActiveClass == NULL) || (phost->pActiveClass->pData == NULL))
+  {
+    return;
+  }
 
-      /*Check the status done for reception*/
-      if (URB_Status == USBH_URB_DONE)
+  CDC_Handle = (CDC_HandleTypeDef *) phost->pActiveClass->pData;
+
+  if ((pipe == CDC_Handle->DataItf.OutPipe) && (CDC_Handle->data_tx_state == CDC_SEND_DATA_WAIT))
+  {
+    /* Check the status done for transmission */
+    if (urb_state == USBH_URB_DONE)
+    {
+      length = CDC_UrbLength(CDC_Handle->TxDataLength, CDC_Handle->DataItf.OutEpSize,
+                             USBH_CDC_TX_URB_SIZE);
+      CDC_Handle->TxDataLength -= length;
+      CDC_Handle->pTxData += length;
+
+      if (CDC_Handle->TxDataLength > 0U)
       {
-        length = USBH_LL_GetLastXferSize(phost, CDC_Handle->DataItf.InPipe);
-
-        if (((CDC_Handle->RxDataLength - length) > 0U) && (length > CDC_Handle->DataItf.InEpSize))
-        {
-          CDC_Handle->RxDataLength -= length;
-          CDC_Handle->pRxData += length;
-          CDC_Handle->data_rx_state = CDC_RECEIVE_DATA;
-        }
-        else
-        {
-          CDC_Handle->data_rx_state = CDC_IDLE;
-          USBH_CDC_ReceiveCallback(phost);
-        }
+        CDC_Handle->data_tx_state = CDC_SEND_DATA;
+      }
+      else
+      {
+        CDC_Handle->data_tx_state = CDC_IDLE;
+        USBH_CDC_TransmitCallback(phost);
+      }
 
 #if (USBH_USE_OS == 1U)
-        phost->os_msg = (uint32_t)USBH_CLASS_EVENT;
-#if (osCMSIS < 0x20000U)
-        (void)osMessagePut(phost->os_event, phost->os_msg, 0U);
-#else
-        (void)osMessageQueuePut(phost->os_event, &phost->os_msg, 0U, 0U);
-#endif
+      USBH_OS_PostEvent(phost, USBH_CLASS_EVENT);
 #endif
+    }
+    else if (urb_state == USBH_URB_NOTREADY)
+    {
+      /* The device NAKed: keep the packets it acknowledged and retry the
+         rest on the next frame rather than spinning */
+      if (length < CDC_Handle->TxDataLength)
+      {
+        CDC_Handle->TxDataLength -= length;
+        CDC_Handle->pTxData += length;
       }
-      break;
+      (void)USBH_TimerStart(phost, phost->Timer + 1U, CDC_TimerCallback);
+    }
+    else
+    {
+      /* .. */
+    }
+  }
+  else if ((pipe == CDC_Handle->DataItf.InPipe) && (CDC_Handle->data_rx_state == CDC_RECEIVE_DATA_WAIT))
+  {
+    /*Check the status done for reception*/
+    if (urb_state == USBH_URB_DONE)
+    {
+      if (length > CDC_Handle->RxDataLength)
+      {
+        length = CDC_Handle->RxDataLength;
+      }
+      CDC_Handle->RxDataLength -= length;
+      CDC_Handle->RxDataCount += length;
+      CDC_Handle->pRxData += length;
 
-    default:
-      break;
+      /* Only whole packets: the transfer goes on while a packet fits */
+      if ((length != 0U) && ((length % CDC_Handle->DataItf.InEpSize) == 0U) &&
+          (CDC_Handle->RxDataLength >= CDC_Handle->DataItf.InEpSize))
+      {
+        CDC_Handle->data_rx_state = CDC_RECEIVE_DATA;
+      }
+      else
+      {
+        CDC_Handle->data_rx_state = CDC_IDLE;
+        USBH_CDC_ReceiveCallback(phost);
+      }
+
+#if (USBH_USE_OS == 1U)
+      USBH_OS_PostEvent(phost, USBH_CLASS_EVENT);
+#endif
+    }
+  }
+  else
+  {
+    /* .. */
+  }
+}
+
+/**
+  * @brief  Frame timer: resend the packet the device NAKed
+  *  @param  pdev: Selected device
+  * @retval None
+  */
+static void CDC_TimerCallback(USBH_HandleTypeDef *phost)
+{
+  CDC_HandleTypeDef *CDC_Handle;
+
+  if ((phost->pActiveClass == NULL) || (phost->pActiveClass->pData == NULL))
+  {
+    return;
+  }
+
+  CDC_Handle = (CDC_HandleTypeDef *) phost->pActiveClass->pData;
+
+  if ((CDC_Handle->data_tx_state == CDC_SEND_DATA_WAIT) &&
+      (USBH_LL_GetURBState(phost, CDC_Handle->DataItf.OutPipe) == USBH_URB_NOTREADY))
+  {
+    CDC_Handle->data_tx_state = CDC_SEND_DATA;
   }
 }
 
+/**
+  * @brief  Length of the next bulk transfer: all of the data up to max,
+  *         larger transfers are cut at a packet boundary
+  * @param  length: Bytes left to transfer
+  * @param  mps: Endpoint max packet size
+  * @param  max: Largest transfer accepted by the HCD
+  * @retval Transfer length
+  */
+static uint16_t CDC_UrbLength(uint32_t length, uint16_t mps, uint32_t max)
+{
+  uint32_t limit = max;
+
+  if (mps != 0U)
+  {
+    limit -= max % mps;
+    if (limit == 0U)
+    {
+      limit = mps;
+    }
+  }
+
+  return (uint16_t)((length > limit) ? limit : length);
+}
+
 /**
   * @brief  The function informs user that data have been received
   *  @param  pdev: Selected device
@@ -862,6 +933,38 @@ __weak void USBH_CDC_ReceiveCallback(USBH_HandleTypeDef *phost)
   UNUSED(phost);
 }
 
+/**
+  * @brief  The function lets the user start transfers from the host thread.
+  *         It is called on every pass of the class process, so that
+  *         USBH_CDC_Transmit() and USBH_CDC_Receive() are not called from
+  *         another thread while the class runs.
+  *  @param  pdev: Selected device
+  * @retval None
+  */
+__weak void USBH_CDC_ProcessCallback(USBH_HandleTypeDef *phost)
+{
+  /* Prevent unused argument(s) compilation warning */
+  UNUSED(phost);
+}
+
+/**
+  * @brief  The function informs user of the outcome of a line coding change
+  *         queued by USBH_CDC_SetLineCoding(). The default reports the
+  *         changes the device took to USBH_CDC_LineCodingChanged().
+  *  @param  pdev: Selected device
+  * @param  status: USBH_OK, USBH_NOT_SUPPORTED when the device kept another
+  *         line coding, USBH_FAIL when a request failed
+  * @retval None
+  */
+__weak void USBH_CDC_LineCodingCallback(USBH_HandleTypeDef *phost,
+                                        USBH_StatusTypeDef status)
+{
+  if (status == USBH_OK)
+  {
+    USBH_CDC_LineCodingChanged(phost);
+  }
+}
+
 /**
   * @brief  The function informs user that Settings have been changed
   *  @param  pdev: Selected device
@@ -75,6 +75,10 @@ extern "C" {
 #define CS_INTERFACE                                            0x24U
 #define CDC_PAGE_SIZE_64                                        0x40U
 
+/* Functional Descriptor Subtypes */
+#define CDC_HEADER_FUNC_DESC                                    0x00U
+#define CDC_UNION_FUNC_DESC                                     0x06U
+
 /*Class-Specific Request Codes*/
 #define CDC_SEND_ENCAPSULATED_COMMAND                           0x00U
 #define CDC_GET_ENCAPSULATED_RESPONSE                           0x01U
@@ -125,6 +129,13 @@ extern "C" {
 #define CDC_DEACTIVATE_SIGNAL_DTR                               0x0000U
 
 #define LINE_CODING_STRUCTURE_SIZE                              0x07U
+
+/* Largest bulk OUT transfer handed to the HCD at once, in bytes, rounded
+   down to a multiple of the endpoint size. Without DMA the OTG HAL writes
+   the whole transfer to the non-periodic TX FIFO, 1 KB in host mode. */
+#ifndef USBH_CDC_TX_URB_SIZE
+#define USBH_CDC_TX_URB_SIZE                                    1024U
+#endif /* USBH_CDC_TX_URB_SIZE */
 /**
   * @}
   */
@@ -147,9 +158,6 @@ CDC_DataStateTypeDef;
 typedef enum
 {
   CDC_IDLE_STATE = 0U,
-  CDC_SET_LINE_CODING_STATE,
-  CDC_GET_LAST_LINE_CODING_STATE,
-  CDC_SET_CONTROL_LINE_STATE_STATE,
   CDC_TRANSFER_DATA,
   CDC_ERROR_STATE,
 }
@@ -164,7 +172,7 @@ typedef union _CDC_LineCodingStructure
   struct
   {
 
-    uint16_t             dwDTERate;     /*Data terminal rate, in bits per second*/
+    uint32_t             dwDTERate;     /*Data terminal rate, in bits per second*/
     uint8_t              bCharFormat;   /*Stop bits
     0 - 1 Stop bit
     1 - 1.5 Stop bits
@@ -361,6 +369,7 @@ typedef struct _CDC_Process
   uint8_t                           *pRxData;
   uint32_t                           TxDataLength;
   uint32_t                           RxDataLength;
+  uint32_t                           RxDataCount;   /* Bytes received since USBH_CDC_Receive() */
   CDC_InterfaceDesc_Typedef         CDC_Desc;
   CDC_LineCodingTypeDef             LineCoding;
   CDC_LineCodingTypeDef             *pUserLineCoding;
@@ -368,8 +377,6 @@ typedef struct _CDC_Process
   CDC_DataStateTypeDef              data_tx_state;
   CDC_DataStateTypeDef              data_rx_state;
   uint8_t                           Rx_Poll;
-  uint8_t                           dtr;
-  uint8_t                           rts;
 }
 CDC_HandleTypeDef;
 
@@ -423,16 +430,20 @@ USBH_StatusTypeDef  USBH_CDC_Receive(USBH_HandleTypeDef *phost,
                                      uint32_t length);
 
 
-uint16_t            USBH_CDC_GetLastReceivedDataSize(USBH_HandleTypeDef *phost);
+uint32_t            USBH_CDC_GetLastReceivedDataSize(USBH_HandleTypeDef *phost);
 
 USBH_StatusTypeDef  USBH_CDC_Stop(USBH_HandleTypeDef *phost);
 
 void USBH_CDC_LineCodingChanged(USBH_HandleTypeDef *phost);
 
+void USBH_CDC_LineCodingCallback(USBH_HandleTypeDef *phost, USBH_StatusTypeDef status);
+
 void USBH_CDC_TransmitCallback(USBH_HandleTypeDef *phost);
 
 void USBH_CDC_ReceiveCallback(USBH_HandleTypeDef *phost);
 
+void USBH_CDC_ProcessCallback(USBH_HandleTypeDef *phost);
+
 void USBH_CDC_PartialReceiveCallback(uint8_t* data, size_t len);
 
 /**
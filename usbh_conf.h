@@ -1,195 +1,250 @@
-/* USER CODE BEGIN Header */
-/**
-  ******************************************************************************
-  * @file           : Target/usbh_conf.h
-  * @version        : v1.0_Cube
-  * @brief          : Header for usbh_conf.c file.
-  ******************************************************************************
-  * @attention
-  *
-  * Copyright (c) 2022 STMicroelectronics.
-  * All rights reserved.
-  *
-  * This software is licensed under terms that can be found in the LICENSE file
-  * in the root directory of this software component.
-  * If no LICENSE file comes with this software, it is provided AS-IS.
-  *
-  ******************************************************************************
-  */
-/* USER CODE END Header */
-
-/* Define to prevent recursive inclusion -------------------------------------*/
-#ifndef __USBH_CONF__H__
-#define __USBH_CONF__H__
-#ifdef __cplusplus
- extern "C" {
-#endif
-/* Includes ------------------------------------------------------------------*/
-
-#include <stdio.h>
-#include <stdlib.h>
-#include <string.h>
-#include "main.h"
-
-#include "stm32h7xx.h"
-#include "stm32h7xx_hal.h"
-
-/* USER CODE BEGIN INCLUDE */
-
-/* USER CODE END INCLUDE */
-
-/** @addtogroup STM32_USB_HOST_LIBRARY
-  * @{
-  */
-
-/** @defgroup USBH_CONF
-  * @brief usb host low level driver configuration file
-  * @{
-  */
-
-/** @defgroup USBH_CONF_Exported_Variables USBH_CONF_Exported_Variables
-  * @brief Public variables.
-  * @{
-  */
-
-/**
-  * @}
-  */
-
-/** @defgroup USBH_CONF_Exported_Defines USBH_CONF_Exported_Defines
-  * @brief Defines for configuration of the Usb host.
-  * @{
-  */
-
-/*----------   -----------*/
-#define USBH_MAX_NUM_ENDPOINTS      8U
-
-/*----------   -----------*/
-#define USBH_MAX_NUM_INTERFACES      4U
-
-/*----------   -----------*/
-#define USBH_MAX_NUM_CONFIGURATION      1U
-
-/*----------   -----------*/
-#define USBH_KEEP_CFG_DESCRIPTOR      1U
-
-/*----------   -----------*/
-#define USBH_MAX_NUM_SUPPORTED_CLASS      4U
-
-/*----------   -----------*/
-#define USBH_MAX_SIZE_CONFIGURATION      256U
-
-/*----------   -----------*/
-#define USBH_MAX_DATA_BUFFER      512U
-
-/*----------   -----------*/
-#define USBH_DEBUG_LEVEL      4U
-
-/*----------   -----------*/
-#define USBH_USE_OS      1U
-
-/****************************************/
-/* #define for FS and HS identification */
-#define HOST_HS 		0
-#define HOST_FS 		1
-
-#if (USBH_USE_OS == 1)
-  #include "cmsis_os2.h"
-  #include "cmsis_os.h"
-  #define USBH_PROCESS_PRIO          osPriorityNormal
-  #define USBH_PROCESS_STACK_SIZE    ((uint16_t)4096)
-#endif /* (USBH_USE_OS == 1) */
-
-/**
-  * @}
-  */
-
-/** @defgroup USBH_CONF_Exported_Macros USBH_CONF_Exported_Macros
-  * @brief Aliases.
-  * @{
-  */
-
-/* Memory management macros */
-
-/** Alias for memory allocation. */
-#define USBH_malloc         malloc
-
-/** Alias for memory release. */
-#define USBH_free           free
-
-/** Alias for memory set. */
-#define USBH_memset         memset
-
-/** Alias for memory copy. */
-#define USBH_memcpy         memcpy
-
-/* DEBUG macros */
-
-#if (USBH_DEBUG_LEVEL > 0U)
-#define  USBH_UsrLog(...)   do { \
-                            printf(__VA_ARGS__); \
-                            printf("\n"); \
-} while (0)
-#else
-#define USBH_UsrLog(...) do {} while (0)
-#endif
-
-#if (USBH_DEBUG_LEVEL > 1U)
-
-#define  USBH_ErrLog(...) do { \
-                            printf("ERROR: ") ; \
-                            printf(__VA_ARGS__); \
-                            printf("\n"); \
-} while (0)
-#else
-#define USBH_ErrLog(...) do {} while (0)
-#endif
-
-#if (USBH_DEBUG_LEVEL > 2U)
-#define  USBH_DbgLog(...)   do { \
-                            printf("DEBUG : ") ; \
-                            printf(__VA_ARGS__); \
-                            printf("\n"); \
-} while (0)
-#else
-#define USBH_DbgLog(...) do {} while (0)
-#endif
-
-/**
-  * @}
-  */
-
-/** @defgroup USBH_CONF_Exported_Types USBH_CONF_Exported_Types
-  * @brief Types.
-  * @{
-  */
-
-/**
-  * @}
-  */
-
-/** @defgroup USBH_CONF_Exported_FunctionsPrototype USBH_CONF_Exported_FunctionsPrototype
-  * @brief Declaration of public functions for Usb host.
-  * @{
-  */
-
-/* Exported functions -------------------------------------------------------*/
-
-/**
-  * @}
-  */
-
-/**
-  * @}
-  */
-
-/**
-  * @}
-  */
-
-#ifdef __cplusplus
-}
-#endif
-
-#endif /* __USBH_CONF__H__ */
-
+/* USER CODE BEGIN Header */
+/**
+  ******************************************************************************
+  * @file           : Target/usbh_conf.h
+  * @version        : v1.0_Cube
+  * @brief          : Header for usbh_conf.c file.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2022 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+/* USER CODE END Header */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __USBH_CONF__H__
+#define __USBH_CONF__H__
+#ifdef __cplusplus
+ extern "C" {
+#endif
+/* Includes ------------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "main.h"
+
+#include "stm32h7xx.h"
+#include "stm32h7xx_hal.h"
+
+/* USER CODE BEGIN INCLUDE */
+
+/* USER CODE END INCLUDE */
+
+/** @addtogroup STM32_USB_HOST_LIBRARY
+  * @{
+  */
+
+/** @defgroup USBH_CONF
+  * @brief usb host low level driver configuration file
+  * @{
+  */
+
+/** @defgroup USBH_CONF_Exported_Variables USBH_CONF_Exported_Variables
+  * @brief Public variables.
+  * @{
+  */
+
+/**
+  * @}
+  */
+
+/** @defgroup USBH_CONF_Exported_Defines USBH_CONF_Exported_Defines
+  * @brief Defines for configuration of the Usb host.
+  * @{
+  */
+
+/*----------   -----------*/
+#define USBH_MAX_NUM_ENDPOINTS      8U
+
+/*----------   -----------*/
+#define USBH_MAX_NUM_INTERFACES      4U
+
+/*----------   -----------*/
+#define USBH_MAX_NUM_CONFIGURATION      1U
+
+/*----------   -----------*/
+#define USBH_KEEP_CFG_DESCRIPTOR      1U
+
+/*----------   -----------*/
+/* MX_USB_HOST_Init() registers four classes (HID, CDC, hub, audio), the
+   rest is left for the application */
+#define USBH_MAX_NUM_SUPPORTED_CLASS      8U
+
+/*----------   -----------*/
+/* Bytes of the configuration descriptor kept in each device handle, a
+   longer descriptor is read truncated to its first bytes */
+#ifndef USBH_MAX_SIZE_CONFIGURATION
+#define USBH_MAX_SIZE_CONFIGURATION      256U
+#endif /* USBH_MAX_SIZE_CONFIGURATION */
+
+/*----------   -----------*/
+/* Control transfer buffer of each device handle, it holds any string
+   descriptor so it cannot be smaller than 255 bytes */
+#ifndef USBH_MAX_DATA_BUFFER
+#define USBH_MAX_DATA_BUFFER      512U
+#endif /* USBH_MAX_DATA_BUFFER */
+
+/*----------   -----------*/
+/* Handles of the root port, the devices behind hubs and the extra functions
+   of composite devices */
+#ifndef USBH_MAX_NUM_DEVICES
+#define USBH_MAX_NUM_DEVICES      8U
+#endif /* USBH_MAX_NUM_DEVICES */
+
+/*----------   -----------*/
+/* Descriptors of the devices seen last, to skip most of the enumeration
+   requests when they come back, 0U disables the cache */
+#ifndef USBH_DESC_CACHE_ENTRIES
+#define USBH_DESC_CACHE_ENTRIES      4U
+#endif /* USBH_DESC_CACHE_ENTRIES */
+
+/*----------   -----------*/
+/* Bytes kept of each cached string descriptor, a longer string is only
+   compared on its first bytes and not returned by USBH_GetString() */
+#ifndef USBH_DESC_CACHE_STRING_SIZE
+#define USBH_DESC_CACHE_STRING_SIZE      64U
+#endif /* USBH_DESC_CACHE_STRING_SIZE */
+
+/*----------   -----------*/
+#ifndef USBH_DEBUG_LEVEL
+#define USBH_DEBUG_LEVEL      4U
+#endif /* USBH_DEBUG_LEVEL */
+
+/*----------   -----------*/
+#ifndef USBH_USE_OS
+#define USBH_USE_OS      1U
+#endif /* USBH_USE_OS */
+
+/*----------   -----------*/
+#ifndef USBH_USE_OS_EVENT_FLAGS
+#define USBH_USE_OS_EVENT_FLAGS      0U
+#endif /* USBH_USE_OS_EVENT_FLAGS */
+
+/*----------   -----------*/
+#ifndef USBH_FAST_ATTACH
+#define USBH_FAST_ATTACH      0U
+#endif /* USBH_FAST_ATTACH */
+
+/*----------   -----------*/
+/* 1U skips the manufacturer, product and serial number strings during
+   enumeration, the application reads them with USBH_GetString() */
+#ifndef USBH_LAZY_STRINGS
+#define USBH_LAZY_STRINGS      0U
+#endif /* USBH_LAZY_STRINGS */
+
+/****************************************/
+/* #define for FS and HS identification */
+#define HOST_HS 		0
+#define HOST_FS 		1
+
+#if (USBH_USE_OS == 1)
+  #include "cmsis_os2.h"
+  #include "cmsis_os.h"
+  #define USBH_PROCESS_PRIO          osPriorityNormal
+  #define USBH_PROCESS_STACK_SIZE    ((uint16_t)4096)
+#endif /* (USBH_USE_OS == 1) */
+
+/**
+  * @}
+  */
+
+/** @defgroup USBH_CONF_Exported_Macros USBH_CONF_Exported_Macros
+  * @brief Aliases.
+  * @{
+  */
+
+/* Memory management macros */
+
+/** Alias for memory allocation. */
+#define USBH_malloc         malloc
+
+/** Alias for memory release. */
+#define USBH_free           free
+
+/** Alias for memory set. */
+#define USBH_memset         memset
+
+/** Alias for memory copy. */
+#define USBH_memcpy         memcpy
+
+/** Alias for memory compare. */
+#define USBH_memcmp         memcmp
+
+/* DEBUG macros */
+
+#if (USBH_DEBUG_LEVEL > 0U)
+#define  USBH_UsrLog(...)   do { \
+                            printf(__VA_ARGS__); \
+                            printf("\n"); \
+} while (0)
+#else
+#define USBH_UsrLog(...) do {} while (0)
+#endif
+
+#if (USBH_DEBUG_LEVEL > 1U)
+
+#define  USBH_ErrLog(...) do { \
+                            printf("ERROR: ") ; \
+                            printf(__VA_ARGS__); \
+                            printf("\n"); \
+} while (0)
+#else
+#define USBH_ErrLog(...) do {} while (0)
+#endif
+
+#if (USBH_DEBUG_LEVEL > 2U)
+#define  USBH_DbgLog(...)   do { \
+                            printf("DEBUG : ") ; \
+                            printf(__VA_ARGS__); \
+                            printf("\n"); \
+} while (0)
+#else
+#define USBH_DbgLog(...) do {} while (0)
+#endif
+
+/**
+  * @}
+  */
+
+/** @defgroup USBH_CONF_Exported_Types USBH_CONF_Exported_Types
+  * @brief Types.
+  * @{
+  */
+
+/**
+  * @}
+  */
+
+/** @defgroup USBH_CONF_Exported_FunctionsPrototype USBH_CONF_Exported_FunctionsPrototype
+  * @brief Declaration of public functions for Usb host.
+  * @{
+  */
+
+/* Exported functions -------------------------------------------------------*/
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __USBH_CONF__H__ */
+
@@ -1,1384 +1,2514 @@
-/**
-  ******************************************************************************
-  * @file    usbh_core.c
-  * @author  MCD Application Team
-  * @brief   This file implements the functions for the core state machine process
-  *          the enumeration and the control transfer process
-  ******************************************************************************
-  * @attention
-  *
-  * <h2><center>&copy; Copyright (c) 2015 STMicroelectronics.
-  * All rights reserved.</center></h2>
-  *
-  * This software component is licensed by ST under Ultimate Liberty license
-  * SLA0044, the "License"; You may not use this file except in compliance with
-  * the License. You may obtain a copy of the License at:
-  *                      www.st.com/SLA0044
-  *
-  ******************************************************************************
-  */
-
-/* Includes ------------------------------------------------------------------*/
-#include "usbh_core.h"
-
-/** @addtogroup USBH_LIB
-  * @{
-  */
-
-/** @addtogroup USBH_LIB_CORE
-  * @{
-  */
-
-/** @defgroup USBH_CORE
-  * @brief This file handles the basic enumeration when a device is connected
-  *          to the host.
-  * @{
-  */
-
-
-/** @defgroup USBH_CORE_Private_Defines
-  * @{
-  */
-#define USBH_ADDRESS_DEFAULT                     0x00U
-#define USBH_ADDRESS_ASSIGNED                    0x01U
-#define USBH_MPS_DEFAULT                         0x40U
-/**
-  * @}
-  */
-
-/** @defgroup USBH_CORE_Private_Macros
-  * @{
-  */
-/**
-  * @}
-  */
-
-
-/** @defgroup USBH_CORE_Private_Variables
-  * @{
-  */
-#if (USBH_USE_OS == 1U)
-#if (osCMSIS >= 0x20000U)
-osThreadAttr_t USBH_Thread_Atrr;
-#endif
-#endif
-
-
-/**
-  * @}
-  */
-
-
-/** @defgroup USBH_CORE_Private_Functions
-  * @{
-  */
-static USBH_StatusTypeDef USBH_HandleEnum(USBH_HandleTypeDef *phost);
-static void USBH_HandleSof(USBH_HandleTypeDef *phost);
-static USBH_StatusTypeDef DeInitStateMachine(USBH_HandleTypeDef *phost);
-
-#if (USBH_USE_OS == 1U)
-#if (osCMSIS < 0x20000U)
-static void USBH_Process_OS(void const *argument);
-#else
-static void USBH_Process_OS(void *argument);
-#endif
-#endif
-
-
-/**
-  * @brief  HCD_Init
-  *         Initialize the HOST Core.
-  * @param  phost: Host Handle
-  * @param  pUsrFunc: User Callback
-  * @retval USBH Status
-  */
-USBH_StatusTypeDef  USBH_Init(USBH_HandleTypeDef *phost,
-                              void (*pUsrFunc)(USBH_HandleTypeDef *phost,
-                              uint8_t id), uint8_t id)
-{
-  /* Check whether the USB Host handle is valid */
-  if (phost == NULL)
-  {
-    USBH_ErrLog("Invalid Host handle");
-    return USBH_FAIL;
-  }
-
-  /* Set DRiver ID */
-  phost->id = id;
-
-  /* Unlink class*/
-  phost->pActiveClass = NULL;
-  phost->ClassNumber = 0U;
-
-  /* Restore default states and prepare EP0 */
-  DeInitStateMachine(phost);
-
-  /* Restore default Device connection states */
-  phost->device.PortEnabled = 0U;
-  phost->device.is_connected = 0U;
-  phost->device.is_disconnected = 0U;
-  phost->device.is_ReEnumerated = 0U;
-
-  /* Assign User process */
-  if (pUsrFunc != NULL)
-  {
-    phost->pUser = pUsrFunc;
-  }
-
-#if (USBH_USE_OS == 1U)
-#if (osCMSIS < 0x20000U)
-
-  /* Create USB Host Queue */
-  osMessageQDef(USBH_Queue, MSGQUEUE_OBJECTS, uint16_t);
-  phost->os_event = osMessageCreate(osMessageQ(USBH_Queue), NULL);
-
-  /* Create USB Host Task */
-#if defined (USBH_PROCESS_STACK_SIZE)
-  osThreadDef(USBH_Thread, USBH_Process_OS, USBH_PROCESS_PRIO, 0U, USBH_PROCESS_STACK_SIZE);
-#else
-  osThreadDef(USBH_Thread, USBH_Process_OS, USBH_PROCESS_PRIO, 0U, 8U * configMINIMAL_STACK_SIZE);
-#endif /* defined (USBH_PROCESS_STACK_SIZE) */
-
-  phost->thread = osThreadCreate(osThread(USBH_Thread), phost);
-
-#else
-
-  static osMessageQueueAttr_t msgq_attrs;
-  static char _queue_mem[1024 * sizeof(uint32_t) + sizeof(osRtxMessageQueue_t)];
-  static osRtxMessageQueue_t _obj_mem[MSGQUEUE_OBJECTS];
-
-  msgq_attrs.mq_mem = _queue_mem;
-  msgq_attrs.mq_size = sizeof(_queue_mem);
-  msgq_attrs.cb_mem = &_obj_mem;
-  msgq_attrs.cb_size = sizeof(_obj_mem);
-
-  /* Create USB Host Queue */
-  phost->os_event = osMessageQueueNew(MSGQUEUE_OBJECTS, sizeof(uint32_t), &msgq_attrs);
-
-  /* Create USB Host Task */
-  USBH_Thread_Atrr.name = "USBH_Queue";
-
-#if defined (USBH_PROCESS_STACK_SIZE)
-  USBH_Thread_Atrr.stack_size = USBH_PROCESS_STACK_SIZE;
-#else
-  USBH_Thread_Atrr.stack_size = (8U * configMINIMAL_STACK_SIZE);
-#endif /* defined (USBH_PROCESS_STACK_SIZE) */
-
-  static osRtxThread_t thread_cb;
-
-  USBH_Thread_Atrr.stack_mem  = malloc(USBH_Thread_Atrr.stack_size);
-  USBH_Thread_Atrr.cb_mem  = &thread_cb;
-  USBH_Thread_Atrr.cb_size = sizeof(osRtxThread_t);
-
-  USBH_Thread_Atrr.priority = USBH_PROCESS_PRIO;
-  phost->thread = osThreadNew(USBH_Process_OS, phost, &USBH_Thread_Atrr);
-
-#endif /* (osCMSIS < 0x20000U) */
-#endif /* (USBH_USE_OS == 1U) */
-
-  /* Initialize low level driver */
-  USBH_LL_Init(phost);
-
-  return USBH_OK;
-}
-
-
-/**
-  * @brief  HCD_Init
-  *         De-Initialize the Host portion of the driver.
-  * @param  phost: Host Handle
-  * @retval USBH Status
-  */
-USBH_StatusTypeDef USBH_DeInit(USBH_HandleTypeDef *phost)
-{
-  DeInitStateMachine(phost);
-
-  /* Restore default Device connection states */
-  phost->device.PortEnabled = 0U;
-  phost->device.is_connected = 0U;
-  phost->device.is_disconnected = 0U;
-  phost->device.is_ReEnumerated = 0U;
-  phost->device.RstCnt = 0U;
-  phost->device.EnumCnt = 0U;
-
-  if (phost->pData != NULL)
-  {
-    USBH_LL_Stop(phost);
-  }
-
-  return USBH_OK;
-}
-
-
-/**
-  * @brief  DeInitStateMachine
-  *         De-Initialize the Host state machine.
-  * @param  phost: Host Handle
-  * @retval USBH Status
-  */
-static USBH_StatusTypeDef DeInitStateMachine(USBH_HandleTypeDef *phost)
-{
-  uint32_t i = 0U;
-
-  /* Clear Pipes flags*/
-  for (i = 0U; i < USBH_MAX_PIPES_NBR; i++)
-  {
-    phost->Pipes[i] = 0U;
-  }
-
-  for (i = 0U; i < USBH_MAX_DATA_BUFFER; i++)
-  {
-    phost->device.Data[i] = 0U;
-  }
-
-  phost->gState = HOST_IDLE;
-  phost->EnumState = ENUM_IDLE;
-  phost->RequestState = CMD_SEND;
-  phost->Timer = 0U;
-
-  phost->Control.state = CTRL_SETUP;
-  phost->Control.pipe_size = USBH_MPS_DEFAULT;
-  phost->Control.errorcount = 0U;
-
-  phost->device.address = USBH_ADDRESS_DEFAULT;
-  phost->device.speed = USBH_SPEED_FULL;
-  phost->device.RstCnt = 0U;
-  phost->device.EnumCnt = 0U;
-
-  return USBH_OK;
-}
-
-
-/**
-  * @brief  USBH_RegisterClass
-  *         Link class driver to Host Core.
-  * @param  phost : Host Handle
-  * @param  pclass: Class handle
-  * @retval USBH Status
-  */
-USBH_StatusTypeDef USBH_RegisterClass(USBH_HandleTypeDef *phost, USBH_ClassTypeDef *pclass)
-{
-  USBH_StatusTypeDef status = USBH_OK;
-
-  if (pclass != NULL)
-  {
-    if (phost->ClassNumber < USBH_MAX_NUM_SUPPORTED_CLASS)
-    {
-      /* link the class to the USB Host handle */
-      phost->pClass[phost->ClassNumber++] = pclass;
-      status = USBH_OK;
-    }
-    else
-    {
-      USBH_ErrLog("Max Class Number reached");
-      status = USBH_FAIL;
-    }
-  }
-  else
-  {
-    USBH_ErrLog("Invalid Class handle");
-    status = USBH_FAIL;
-  }
-
-  return status;
-}
-
-
-/**
-  * @brief  USBH_SelectInterface
-  *         Select current interface.
-  * @param  phost: Host Handle
-  * @param  interface: Interface number
-  * @retval USBH Status
-  */
-USBH_StatusTypeDef USBH_SelectInterface(USBH_HandleTypeDef *phost, uint8_t interface)
-{
-  USBH_StatusTypeDef status = USBH_OK;
-
-  if (interface < phost->device.CfgDesc.bNumInterfaces)
-  {
-    phost->device.current_interface = interface;
-    USBH_UsrLog("Switching to Interface (#%d)", interface);
-    USBH_UsrLog("Class    : %xh", phost->device.CfgDesc.Itf_Desc[interface].bInterfaceClass);
-    USBH_UsrLog("SubClass : %xh", phost->device.CfgDesc.Itf_Desc[interface].bInterfaceSubClass);
-    USBH_UsrLog("Protocol : %xh", phost->device.CfgDesc.Itf_Desc[interface].bInterfaceProtocol);
-  }
-  else
-  {
-    USBH_ErrLog("Cannot Select This Interface.");
-    status = USBH_FAIL;
-  }
-
-  return status;
-}
-
-
-/**
-  * @brief  USBH_GetActiveClass
-  *         Return Device Class.
-  * @param  phost: Host Handle
-  * @param  interface: Interface index
-  * @retval Class Code
-  */
-uint8_t USBH_GetActiveClass(USBH_HandleTypeDef *phost)
-{
-  return (phost->device.CfgDesc.Itf_Desc[0].bInterfaceClass);
-}
-
-
-/**
-  * @brief  USBH_FindInterface
-  *         Find the interface index for a specific class.
-  * @param  phost: Host Handle
-  * @param  Class: Class code
-  * @param  SubClass: SubClass code
-  * @param  Protocol: Protocol code
-  * @retval interface index in the configuration structure
-  * @note : (1)interface index 0xFF means interface index not found
-  */
-uint8_t  USBH_FindInterface(USBH_HandleTypeDef *phost, uint8_t Class, uint8_t SubClass, uint8_t Protocol)
-{
-  USBH_InterfaceDescTypeDef *pif;
-  USBH_CfgDescTypeDef *pcfg;
-  uint8_t if_ix = 0U;
-
-  pif = (USBH_InterfaceDescTypeDef *)0;
-  pcfg = &phost->device.CfgDesc;
-
-  while (if_ix < USBH_MAX_NUM_INTERFACES)
-  {
-    pif = &pcfg->Itf_Desc[if_ix];
-    if (((pif->bInterfaceClass == Class) || (Class == 0xFFU)) &&
-        ((pif->bInterfaceSubClass == SubClass) || (SubClass == 0xFFU)) &&
-        ((pif->bInterfaceProtocol == Protocol) || (Protocol == 0xFFU)))
-    {
-      return  if_ix;
-    }
-    if_ix++;
-  }
-  return 0xFFU;
-}
-
-
-/**
-  * @brief  USBH_FindInterfaceIndex
-  *         Find the interface index for a specific class interface and alternate setting number.
-  * @param  phost: Host Handle
-  * @param  interface_number: interface number
-  * @param  alt_settings    : alternate setting number
-  * @retval interface index in the configuration structure
-  * @note : (1)interface index 0xFF means interface index not found
-  */
-uint8_t  USBH_FindInterfaceIndex(USBH_HandleTypeDef *phost, uint8_t interface_number, uint8_t alt_settings)
-{
-  USBH_InterfaceDescTypeDef *pif;
-  USBH_CfgDescTypeDef *pcfg;
-  uint8_t if_ix = 0U;
-
-  pif = (USBH_InterfaceDescTypeDef *)0;
-  pcfg = &phost->device.CfgDesc;
-
-  while (if_ix < USBH_MAX_NUM_INTERFACES)
-  {
-    pif = &pcfg->Itf_Desc[if_ix];
-    if ((pif->bInterfaceNumber == interface_number) && (pif->bAlternateSetting == alt_settings))
-    {
-      return  if_ix;
-    }
-    if_ix++;
-  }
-  return 0xFFU;
-}
-
-
-/**
-  * @brief  USBH_Start
-  *         Start the USB Host Core.
-  * @param  phost: Host Handle
-  * @retval USBH Status
-  */
-USBH_StatusTypeDef  USBH_Start(USBH_HandleTypeDef *phost)
-{
-  /* Start the low level driver  */
-  USBH_LL_Start(phost);
-
-  /* Activate VBUS on the port */
-  USBH_LL_DriverVBUS(phost, TRUE);
-
-  return USBH_OK;
-}
-
-
-/**
-  * @brief  USBH_Stop
-  *         Stop the USB Host Core.
-  * @param  phost: Host Handle
-  * @retval USBH Status
-  */
-USBH_StatusTypeDef  USBH_Stop(USBH_HandleTypeDef *phost)
-{
-  /* DeActivate VBUS on the port */
-  USBH_LL_DriverVBUS(phost, FALSE);
-
-  /* Stop and cleanup the low level driver  */
-  USBH_LL_Stop(phost);
-
-  /* Free Control Pipes */
-  USBH_FreePipe(phost, phost->Control.pipe_in);
-  USBH_FreePipe(phost, phost->Control.pipe_out);
-
-  return USBH_OK;
-}
-
-
-/**
-  * @brief  HCD_ReEnumerate
-  *         Perform a new Enumeration phase.
-  * @param  phost: Host Handle
-  * @retval USBH Status
-  */
-USBH_StatusTypeDef USBH_ReEnumerate(USBH_HandleTypeDef *phost)
-{
-  if (USBH_IsPortEnabled(phost))
-  {
-    phost->device.is_ReEnumerated = 1U;
-
-    /* Stop Host */
-    USBH_Stop(phost);
-
-    phost->device.is_disconnected = 1U;
-  }
-
-#if (USBH_USE_OS == 1U)
-  phost->os_msg = (uint32_t)USBH_PORT_EVENT;
-#if (osCMSIS < 0x20000U)
-  (void)osMessagePut(phost->os_event, phost->os_msg, 0U);
-#else
-  (void)osMessageQueuePut(phost->os_event, &phost->os_msg, 0U, 0U);
-#endif
-#endif
-
-  return USBH_OK;
-}
-
-
-/**
-  * @brief  USBH_Process
-  *         Background process of the USB Core.
-  * @param  phost: Host Handle
-  * @retval USBH Status
-  */
-USBH_StatusTypeDef  USBH_Process(USBH_HandleTypeDef *phost)
-{
-  __IO USBH_StatusTypeDef status = USBH_FAIL;
-  uint8_t idx = 0U;
-
-  /* check for Host pending port disconnect event */
-  if (phost->device.is_disconnected == 1U)
-  {
-    phost->gState = HOST_DEV_DISCONNECTED;
-  }
-
-  switch (phost->gState)
-  {
-    case HOST_IDLE :
-
-      if (phost->device.is_connected)
-      {
-        USBH_UsrLog("USB Device Connected");
-
-        /* Wait for 200 ms after connection */
-        phost->gState = HOST_DEV_WAIT_FOR_ATTACHMENT;
-        USBH_Delay(200U);
-        USBH_LL_ResetPort(phost);
-
-        /* Make sure to start with Default address */
-        phost->device.address = USBH_ADDRESS_DEFAULT;
-        phost->Timeout = 0U;
-
-#if (USBH_USE_OS == 1U)
-        phost->os_msg = (uint32_t)USBH_PORT_EVENT;
-#if (osCMSIS < 0x20000U)
-        (void)osMessagePut(phost->os_event, phost->os_msg, 0U);
-#else
-        (void)osMessageQueuePut(phost->os_event, &phost->os_msg, 0U, 0U);
-#endif
-#endif
-      }
-      break;
-
-    case HOST_DEV_WAIT_FOR_ATTACHMENT: /* Wait for Port Enabled */
-
-      if (phost->device.PortEnabled == 1U)
-      {
-        USBH_UsrLog("USB Device Reset Completed");
-        phost->device.RstCnt = 0U;
-        phost->gState = HOST_DEV_ATTACHED;
-      }
-      else
-      {
-        if (phost->Timeout > USBH_DEV_RESET_TIMEOUT)
-        {
-          phost->device.RstCnt++;
-          if (phost->device.RstCnt > 3U)
-          {
-            /* Buggy Device can't complete reset */
-            USBH_UsrLog("USB Reset Failed, Please unplug the Device.");
-            phost->gState = HOST_ABORT_STATE;
-          }
-          else
-          {
-            phost->gState = HOST_IDLE;
-          }
-        }
-        else
-        {
-          phost->Timeout += 10U;
-          USBH_Delay(10U);
-        }
-      }
-#if (USBH_USE_OS == 1U)
-      phost->os_msg = (uint32_t)USBH_PORT_EVENT;
-#if (osCMSIS < 0x20000U)
-      (void)osMessagePut(phost->os_event, phost->os_msg, 0U);
-#else
-      (void)osMessageQueuePut(phost->os_event, &phost->os_msg, 0U, 0U);
-#endif
-#endif
-      break;
-
-    case HOST_DEV_ATTACHED :
-
-      if (phost->pUser != NULL)
-      {
-        phost->pUser(phost, HOST_USER_CONNECTION);
-      }
-
-      /* Wait for 100 ms after Reset */
-      USBH_Delay(100U);
-
-      phost->device.speed = USBH_LL_GetSpeed(phost);
-
-      phost->gState = HOST_ENUMERATION;
-
-      phost->Control.pipe_out = USBH_AllocPipe(phost, 0x00U);
-      phost->Control.pipe_in  = USBH_AllocPipe(phost, 0x80U);
-
-      /* Open Control pipes */
-      USBH_OpenPipe(phost, phost->Control.pipe_in, 0x80U,
-                    phost->device.address, phost->device.speed,
-                    USBH_EP_CONTROL, (uint16_t)phost->Control.pipe_size);
-
-      /* Open Control pipes */
-      USBH_OpenPipe(phost, phost->Control.pipe_out, 0x00U,
-                    phost->device.address, phost->device.speed,
-                    USBH_EP_CONTROL, (uint16_t)phost->Control.pipe_size);
-
-#if (USBH_USE_OS == 1U)
-      phost->os_msg = (uint32_t)USBH_PORT_EVENT;
-#if (osCMSIS < 0x20000U)
-      (void)osMessagePut(phost->os_event, phost->os_msg, 0U);
-#else
-      (void)osMessageQueuePut(phost->os_event, &phost->os_msg, 0U, 0U);
-#endif
-#endif
-      break;
-
-    case HOST_ENUMERATION:
-      /* Check for enumeration status */
-      status = USBH_HandleEnum(phost);
-      if (status == USBH_OK)
-      {
-        /* The function shall return USBH_OK when full enumeration is complete */
-        USBH_UsrLog("Enumeration done.");
-
-        phost->device.current_interface = 0U;
-
-        if (phost->device.DevDesc.bNumConfigurations == 1U)
-        {
-          USBH_UsrLog("This device has only 1 configuration.");
-          phost->gState = HOST_SET_CONFIGURATION;
-        }
-        else
-        {
-          phost->gState = HOST_INPUT;
-        }
-#if (USBH_USE_OS == 1U)
-        phost->os_msg = (uint32_t)USBH_STATE_CHANGED_EVENT;
-#if (osCMSIS < 0x20000U)
-        (void)osMessagePut(phost->os_event, phost->os_msg, 0U);
-#else
-        (void)osMessageQueuePut(phost->os_event, &phost->os_msg, 0U, 0U);
-#endif
-#endif
-      }
-      break;
-
-    case HOST_INPUT:
-    {
-      /* user callback for end of device basic enumeration */
-      if (phost->pUser != NULL)
-      {
-        phost->pUser(phost, HOST_USER_SELECT_CONFIGURATION);
-        phost->gState = HOST_SET_CONFIGURATION;
-
-#if (USBH_USE_OS == 1U)
-        phost->os_msg = (uint32_t)USBH_STATE_CHANGED_EVENT;
-#if (osCMSIS < 0x20000U)
-        (void)osMessagePut(phost->os_event, phost->os_msg, 0U);
-#else
-        (void)osMessageQueuePut(phost->os_event, &phost->os_msg, 0U, 0U);
-#endif
-#endif
-      }
-    }
-    break;
-
-    case HOST_SET_CONFIGURATION:
-      /* set configuration */
-      if (USBH_SetCfg(phost, (uint16_t)phost->device.CfgDesc.bConfigurationValue) == USBH_OK)
-      {
-        phost->gState = HOST_SET_WAKEUP_FEATURE;
-        USBH_UsrLog("Default configuration set.");
-      }
-
-#if (USBH_USE_OS == 1U)
-      phost->os_msg = (uint32_t)USBH_PORT_EVENT;
-#if (osCMSIS < 0x20000U)
-      (void)osMessagePut(phost->os_event, phost->os_msg, 0U);
-#else
-      (void)osMessageQueuePut(phost->os_event, &phost->os_msg, 0U, 0U);
-#endif
-#endif
-      break;
-
-    case  HOST_SET_WAKEUP_FEATURE:
-
-      if ((phost->device.CfgDesc.bmAttributes) & (1U << 5))
-      {
-        if (USBH_SetFeature(phost, FEATURE_SELECTOR_REMOTEWAKEUP) == USBH_OK)
-        {
-          USBH_UsrLog("Device remote wakeup enabled");
-          phost->gState = HOST_CHECK_CLASS;
-        }
-      }
-      else
-      {
-        phost->gState = HOST_CHECK_CLASS;
-      }
-
-#if (USBH_USE_OS == 1U)
-      phost->os_msg = (uint32_t)USBH_PORT_EVENT;
-#if (osCMSIS < 0x20000U)
-      (void)osMessagePut(phost->os_event, phost->os_msg, 0U);
-#else
-      (void)osMessageQueuePut(phost->os_event, &phost->os_msg, 0U, 0U);
-#endif
-#endif
-      break;
-
-    case HOST_CHECK_CLASS:
-
-      if (phost->ClassNumber == 0U)
-      {
-        USBH_UsrLog("No Class has been registered.");
-      }
-      else
-      {
-        phost->pActiveClass = NULL;
-
-        for (idx = 0U; idx < USBH_MAX_NUM_SUPPORTED_CLASS; idx++)
-        {
-          if (phost->pClass[idx]->ClassCode == phost->device.CfgDesc.Itf_Desc[0].bInterfaceClass)
-          {
-            phost->pActiveClass = phost->pClass[idx];
-            break;
-          }
-        }
-
-        if (phost->pActiveClass != NULL)
-        {
-          if (phost->pActiveClass->Init(phost) == USBH_OK)
-          {
-            phost->gState = HOST_CLASS_REQUEST;
-            USBH_UsrLog("%s class started.", phost->pActiveClass->Name);
-
-            /* Inform user that a class has been activated */
-            phost->pUser(phost, HOST_USER_CLASS_SELECTED);
-          }
-          else
-          {
-            phost->gState = HOST_ABORT_STATE;
-            USBH_UsrLog("Device not supporting %s class.", phost->pActiveClass->Name);
-          }
-        }
-        else
-        {
-          phost->gState = HOST_ABORT_STATE;
-          USBH_UsrLog("No registered class for this device.");
-        }
-      }
-
-#if (USBH_USE_OS == 1U)
-      phost->os_msg = (uint32_t)USBH_STATE_CHANGED_EVENT;
-#if (osCMSIS < 0x20000U)
-      (void)osMessagePut(phost->os_event, phost->os_msg, 0U);
-#else
-      (void)osMessageQueuePut(phost->os_event, &phost->os_msg, 0U, 0U);
-#endif
-#endif
-      break;
-
-    case HOST_CLASS_REQUEST:
-      /* process class standard control requests state machine */
-      if (phost->pActiveClass != NULL)
-      {
-        status = phost->pActiveClass->Requests(phost);
-
-        if (status == USBH_OK)
-        {
-          phost->gState = HOST_CLASS;
-        }
-        else if (status == USBH_FAIL)
-        {
-          phost->gState = HOST_ABORT_STATE;
-          USBH_ErrLog("Device not responding Please Unplug.");
-        }
-        else
-        {
-          /* .. */
-        }
-      }
-      else
-      {
-        phost->gState = HOST_ABORT_STATE;
-        USBH_ErrLog("Invalid Class Driver.");
-      }
-#if (USBH_USE_OS == 1U)
-      phost->os_msg = (uint32_t)USBH_STATE_CHANGED_EVENT;
-#if (osCMSIS < 0x20000U)
-      (void)osMessagePut(phost->os_event, phost->os_msg, 0U);
-#else
-      (void)osMessageQueuePut(phost->os_event, &phost->os_msg, 0U, 0U);
-#endif
-#endif
-      break;
-
-    case HOST_CLASS:
-      /* process class state machine */
-      if (phost->pActiveClass != NULL)
-      {
-        phost->pActiveClass->BgndProcess(phost);
-      }
-      break;
-
-    case HOST_DEV_DISCONNECTED :
-      phost->device.is_disconnected = 0U;
-
-      DeInitStateMachine(phost);
-
-      /* Re-Initilaize Host for new Enumeration */
-      if (phost->pActiveClass != NULL)
-      {
-        phost->pActiveClass->DeInit(phost);
-        phost->pActiveClass = NULL;
-      }
-
-      if (phost->pUser != NULL)
-      {
-        phost->pUser(phost, HOST_USER_DISCONNECTION);
-      }
-      USBH_UsrLog("USB Device disconnected");
-
-      if (phost->device.is_ReEnumerated == 1U)
-      {
-        phost->device.is_ReEnumerated = 0U;
-
-        /* Start the host and re-enable Vbus */
-        USBH_Start(phost);
-      }
-      else
-      {
-        /* Device Disconnection Completed, start USB Driver */
-        USBH_LL_Start(phost);
-      }
-
-#if (USBH_USE_OS == 1U)
-      phost->os_msg = (uint32_t)USBH_PORT_EVENT;
-#if (osCMSIS < 0x20000U)
-      (void)osMessagePut(phost->os_event, phost->os_msg, 0U);
-#else
-      (void)osMessageQueuePut(phost->os_event, &phost->os_msg, 0U, 0U);
-#endif
-#endif
-      break;
-
-    case HOST_ABORT_STATE:
-    default :
-      break;
-  }
-  return USBH_OK;
-}
-
-
-/**
-  * @brief  USBH_HandleEnum
-  *         This function includes the complete enumeration process
-  * @param  phost: Host Handle
-  * @retval USBH_Status
-  */
-static USBH_StatusTypeDef USBH_HandleEnum(USBH_HandleTypeDef *phost)
-{
-  USBH_StatusTypeDef Status = USBH_BUSY;
-  USBH_StatusTypeDef ReqStatus = USBH_BUSY;
-
-  switch (phost->EnumState)
-  {
-    case ENUM_IDLE:
-      /* Get Device Desc for only 1st 8 bytes : To get EP0 MaxPacketSize */
-      ReqStatus = USBH_Get_DevDesc(phost, 8U);
-      if (ReqStatus == USBH_OK)
-      {
-        phost->Control.pipe_size = phost->device.DevDesc.bMaxPacketSize;
-
-        phost->EnumState = ENUM_GET_FULL_DEV_DESC;
-
-        /* modify control channels configuration for MaxPacket size */
-        USBH_OpenPipe(phost, phost->Control.pipe_in, 0x80U, phost->device.address,
-                      phost->device.speed, USBH_EP_CONTROL,
-                      (uint16_t)phost->Control.pipe_size);
-
-        /* Open Control pipes */
-        USBH_OpenPipe(phost, phost->Control.pipe_out, 0x00U, phost->device.address,
-                      phost->device.speed, USBH_EP_CONTROL,
-                      (uint16_t)phost->Control.pipe_size);
-      }
-      else if (ReqStatus == USBH_NOT_SUPPORTED)
-      {
-        USBH_ErrLog("Control error: Get Device Descriptor request failed");
-        phost->device.EnumCnt++;
-        if (phost->device.EnumCnt > 3U)
-        {
-          /* Buggy Device can't complete get device desc request */
-          USBH_UsrLog("Control error, Device not Responding Please unplug the Device.");
-          phost->gState = HOST_ABORT_STATE;
-        }
-        else
-        {
-          /* free control pipes */
-          USBH_FreePipe(phost, phost->Control.pipe_out);
-          USBH_FreePipe(phost, phost->Control.pipe_in);
-
-          /* Reset the USB Device */
-          phost->gState = HOST_IDLE;
-        }
-      }
-      else
-      {
-        /* .. */
-      }
-      break;
-
-    case ENUM_GET_FULL_DEV_DESC:
-      /* Get FULL Device Desc  */
-      ReqStatus = USBH_Get_DevDesc(phost, USB_DEVICE_DESC_SIZE);
-      if (ReqStatus == USBH_OK)
-      {
-        USBH_UsrLog("PID: %xh", phost->device.DevDesc.idProduct);
-        USBH_UsrLog("VID: %xh", phost->device.DevDesc.idVendor);
-
-        phost->EnumState = ENUM_SET_ADDR;
-      }
-      else if (ReqStatus == USBH_NOT_SUPPORTED)
-      {
-        USBH_ErrLog("Control error: Get Full Device Descriptor request failed");
-        phost->device.EnumCnt++;
-        if (phost->device.EnumCnt > 3U)
-        {
-          /* Buggy Device can't complete get device desc request */
-          USBH_UsrLog("Control error, Device not Responding Please unplug the Device.");
-          phost->gState = HOST_ABORT_STATE;
-        }
-        else
-        {
-          /* Free control pipes */
-          USBH_FreePipe(phost, phost->Control.pipe_out);
-          USBH_FreePipe(phost, phost->Control.pipe_in);
-
-          /* Reset the USB Device */
-          phost->EnumState = ENUM_IDLE;
-          phost->gState = HOST_IDLE;
-        }
-      }
-      else
-      {
-        /* .. */
-      }
-      break;
-
-    case ENUM_SET_ADDR:
-      /* set address */
-      ReqStatus = USBH_SetAddress(phost, USBH_DEVICE_ADDRESS);
-      if (ReqStatus == USBH_OK)
-      {
-        USBH_Delay(2U);
-        phost->device.address = USBH_DEVICE_ADDRESS;
-
-        /* user callback for device address assigned */
-        USBH_UsrLog("Address (#%d) assigned.", phost->device.address);
-        phost->EnumState = ENUM_GET_CFG_DESC;
-
-        /* modify control channels to update device address */
-        USBH_OpenPipe(phost, phost->Control.pipe_in, 0x80U,  phost->device.address,
-                      phost->device.speed, USBH_EP_CONTROL,
-                      (uint16_t)phost->Control.pipe_size);
-
-        /* Open Control pipes */
-        USBH_OpenPipe(phost, phost->Control.pipe_out, 0x00U, phost->device.address,
-                      phost->device.speed, USBH_EP_CONTROL,
-                      (uint16_t)phost->Control.pipe_size);
-      }
-      else if (ReqStatus == USBH_NOT_SUPPORTED)
-      {
-        USBH_ErrLog("Control error: Device Set Address request failed");
-
-        /* Buggy Device can't complete get device desc request */
-        USBH_UsrLog("Control error, Device not Responding Please unplug the Device.");
-        phost->gState = HOST_ABORT_STATE;
-        phost->EnumState = ENUM_IDLE;
-      }
-      else
-      {
-        /* .. */
-      }
-      break;
-
-    case ENUM_GET_CFG_DESC:
-      /* get standard configuration descriptor */
-      ReqStatus = USBH_Get_CfgDesc(phost, USB_CONFIGURATION_DESC_SIZE);
-      if (ReqStatus == USBH_OK)
-      {
-        phost->EnumState = ENUM_GET_FULL_CFG_DESC;
-      }
-      else if (ReqStatus == USBH_NOT_SUPPORTED)
-      {
-        USBH_ErrLog("Control error: Get Device configuration descriptor request failed");
-        phost->device.EnumCnt++;
-        if (phost->device.EnumCnt > 3U)
-        {
-          /* Buggy Device can't complete get device desc request */
-          USBH_UsrLog("Control error, Device not Responding Please unplug the Device.");
-          phost->gState = HOST_ABORT_STATE;
-        }
-        else
-        {
-          /* Free control pipes */
-          USBH_FreePipe(phost, phost->Control.pipe_out);
-          USBH_FreePipe(phost, phost->Control.pipe_in);
-
-          /* Reset the USB Device */
-          phost->EnumState = ENUM_IDLE;
-          phost->gState = HOST_IDLE;
-        }
-      }
-      else
-      {
-        /* .. */
-      }
-      break;
-
-    case ENUM_GET_FULL_CFG_DESC:
-      /* get FULL config descriptor (config, interface, endpoints) */
-      ReqStatus = USBH_Get_CfgDesc(phost, phost->device.CfgDesc.wTotalLength);
-      if (ReqStatus == USBH_OK)
-      {
-        phost->EnumState = ENUM_GET_MFC_STRING_DESC;
-      }
-      else if (ReqStatus == USBH_NOT_SUPPORTED)
-      {
-        USBH_ErrLog("Control error: Get Device configuration descriptor request failed");
-        phost->device.EnumCnt++;
-        if (phost->device.EnumCnt > 3U)
-        {
-          /* Buggy Device can't complete get device desc request */
-          USBH_UsrLog("Control error, Device not Responding Please unplug the Device.");
-          phost->gState = HOST_ABORT_STATE;
-        }
-        else
-        {
-          /* Free control pipes */
-          USBH_FreePipe(phost, phost->Control.pipe_out);
-          USBH_FreePipe(phost, phost->Control.pipe_in);
-
-          /* Reset the USB Device */
-          phost->EnumState = ENUM_IDLE;
-          phost->gState = HOST_IDLE;
-        }
-      }
-      else
-      {
-        /* .. */
-      }
-      break;
-
-    case ENUM_GET_MFC_STRING_DESC:
-      if (phost->device.DevDesc.iManufacturer != 0U)
-      {
-        /* Check that Manufacturer String is available */
-        ReqStatus = USBH_Get_StringDesc(phost, phost->device.DevDesc.iManufacturer,
-                                        phost->device.Data, 0xFFU);
-        if (ReqStatus == USBH_OK)
-        {
-          /* User callback for Manufacturing string */
-          USBH_UsrLog("Manufacturer : %s", (char *)(void *)phost->device.Data);
-          phost->EnumState = ENUM_GET_PRODUCT_STRING_DESC;
-
-#if (USBH_USE_OS == 1U)
-          phost->os_msg = (uint32_t)USBH_STATE_CHANGED_EVENT;
-#if (osCMSIS < 0x20000U)
-          (void)osMessagePut(phost->os_event, phost->os_msg, 0U);
-#else
-          (void)osMessageQueuePut(phost->os_event, &phost->os_msg, 0U, 0U);
-#endif
-#endif
-        }
-        else if (ReqStatus == USBH_NOT_SUPPORTED)
-        {
-          USBH_UsrLog("Manufacturer : N/A");
-          phost->EnumState = ENUM_GET_PRODUCT_STRING_DESC;
-
-#if (USBH_USE_OS == 1U)
-          phost->os_msg = (uint32_t)USBH_STATE_CHANGED_EVENT;
-#if (osCMSIS < 0x20000U)
-          (void)osMessagePut(phost->os_event, phost->os_msg, 0U);
-#else
-          (void)osMessageQueuePut(phost->os_event, &phost->os_msg, 0U, 0U);
-#endif
-#endif
-        }
-        else
-        {
-          /* .. */
-        }
-      }
-      else
-      {
-        USBH_UsrLog("Manufacturer : N/A");
-        phost->EnumState = ENUM_GET_PRODUCT_STRING_DESC;
-
-#if (USBH_USE_OS == 1U)
-        phost->os_msg = (uint32_t)USBH_STATE_CHANGED_EVENT;
-#if (osCMSIS < 0x20000U)
-        (void)osMessagePut(phost->os_event, phost->os_msg, 0U);
-#else
-        (void)osMessageQueuePut(phost->os_event, &phost->os_msg, 0U, 0U);
-#endif
-#endif
-      }
-      break;
-
-    case ENUM_GET_PRODUCT_STRING_DESC:
-      if (phost->device.DevDesc.iProduct != 0U)
-      {
-        /* Check that Product string is available */
-        ReqStatus = USBH_Get_StringDesc(phost, phost->device.DevDesc.iProduct,
-                                        phost->device.Data, 0xFFU);
-        if (ReqStatus == USBH_OK)
-        {
-          /* User callback for Product string */
-          USBH_UsrLog("Product : %s", (char *)(void *)phost->device.Data);
-          phost->EnumState = ENUM_GET_SERIALNUM_STRING_DESC;
-        }
-        else if (ReqStatus == USBH_NOT_SUPPORTED)
-        {
-          USBH_UsrLog("Product : N/A");
-          phost->EnumState = ENUM_GET_SERIALNUM_STRING_DESC;
-
-#if (USBH_USE_OS == 1U)
-          phost->os_msg = (uint32_t)USBH_STATE_CHANGED_EVENT;
-#if (osCMSIS < 0x20000U)
-          (void)osMessagePut(phost->os_event, phost->os_msg, 0U);
-#else
-          (void)osMessageQueuePut(phost->os_event, &phost->os_msg, 0U, 0U);
-#endif
-#endif
-        }
-        else
-        {
-          /* .. */
-        }
-      }
-      else
-      {
-        USBH_UsrLog("Product : N/A");
-        phost->EnumState = ENUM_GET_SERIALNUM_STRING_DESC;
-
-#if (USBH_USE_OS == 1U)
-        phost->os_msg = (uint32_t)USBH_STATE_CHANGED_EVENT;
-#if (osCMSIS < 0x20000U)
-        (void)osMessagePut(phost->os_event, phost->os_msg, 0U);
-#else
-        (void)osMessageQueuePut(phost->os_event, &phost->os_msg, 0U, 0U);
-#endif
-#endif
-      }
-      break;
-
-    case ENUM_GET_SERIALNUM_STRING_DESC:
-      if (phost->device.DevDesc.iSerialNumber != 0U)
-      {
-        /* Check that Serial number string is available */
-        ReqStatus = USBH_Get_StringDesc(phost, phost->device.DevDesc.iSerialNumber,
-                                        phost->device.Data, 0xFFU);
-        if (ReqStatus == USBH_OK)
-        {
-          /* User callback for Serial number string */
-          USBH_UsrLog("Serial Number : %s", (char *)(void *)phost->device.Data);
-          Status = USBH_OK;
-        }
-        else if (ReqStatus == USBH_NOT_SUPPORTED)
-        {
-          USBH_UsrLog("Serial Number : N/A");
-          Status = USBH_OK;
-        }
-        else
-        {
-          /* .. */
-        }
-      }
-      else
-      {
-        USBH_UsrLog("Serial Number : N/A");
-        Status = USBH_OK;
-      }
-      break;
-
-    default:
-      break;
-  }
-  return Status;
-}
-
-
-/**
-  * @brief  USBH_LL_SetTimer
-  *         Set the initial Host Timer tick
-  * @param  phost: Host Handle
-  * @retval None
-  */
-void  USBH_LL_SetTimer(USBH_HandleTypeDef *phost, uint32_t time)
-{
-  phost->Timer = time;
-}
-
-
-/**
-  * @brief  USBH_LL_IncTimer
-  *         Increment Host Timer tick
-  * @param  phost: Host Handle
-  * @retval None
-  */
-void  USBH_LL_IncTimer(USBH_HandleTypeDef *phost)
-{
-  phost->Timer++;
-  USBH_HandleSof(phost);
-}
-
-
-/**
-  * @brief  USBH_HandleSof
-  *         Call SOF process
-  * @param  phost: Host Handle
-  * @retval None
-  */
-static void  USBH_HandleSof(USBH_HandleTypeDef *phost)
-{
-  if ((phost->gState == HOST_CLASS) && (phost->pActiveClass != NULL))
-  {
-    phost->pActiveClass->SOFProcess(phost);
-  }
-}
-
-
-/**
-  * @brief  USBH_PortEnabled
-  *         Port Enabled
-  * @param  phost: Host Handle
-  * @retval None
-  */
-void USBH_LL_PortEnabled(USBH_HandleTypeDef *phost)
-{
-  phost->device.PortEnabled = 1U;
-
-#if (USBH_USE_OS == 1U)
-  phost->os_msg = (uint32_t)USBH_PORT_EVENT;
-#if (osCMSIS < 0x20000U)
-  (void)osMessagePut(phost->os_event, phost->os_msg, 0U);
-#else
-  (void)osMessageQueuePut(phost->os_event, &phost->os_msg, 0U, 0U);
-#endif
-#endif
-
-  return;
-}
-
-
-/**
-  * @brief  USBH_LL_PortDisabled
-  *         Port Disabled
-  * @param  phost: Host Handle
-  * @retval None
-  */
-void USBH_LL_PortDisabled(USBH_HandleTypeDef *phost)
-{
-  phost->device.PortEnabled = 0U;
-
-  return;
-}
-
-
-/**
-  * @brief  HCD_IsPortEnabled
-  *         Is Port Enabled
-  * @param  phost: Host Handle
-  * @retval None
-  */
-uint8_t USBH_IsPortEnabled(USBH_HandleTypeDef *phost)
-{
-  return (phost->device.PortEnabled);
-}
-
-
-/**
-  * @brief  USBH_LL_Connect
-  *         Handle USB Host connexion event
-  * @param  phost: Host Handle
-  * @retval USBH_Status
-  */
-USBH_StatusTypeDef  USBH_LL_Connect(USBH_HandleTypeDef *phost)
-{
-  phost->device.is_connected = 1U;
-  phost->device.is_disconnected = 0U;
-  phost->device.is_ReEnumerated = 0U;
-
-
-#if (USBH_USE_OS == 1U)
-  phost->os_msg = (uint32_t)USBH_PORT_EVENT;
-#if (osCMSIS < 0x20000U)
-  (void)osMessagePut(phost->os_event, phost->os_msg, 0U);
-#else
-  (void)osMessageQueuePut(phost->os_event, &phost->os_msg, 0U, 0U);
-#endif
-#endif
-
-  return USBH_OK;
-}
-
-
-/**
-  * @brief  USBH_LL_Disconnect
-  *         Handle USB Host disconnection event
-  * @param  phost: Host Handle
-  * @retval USBH_Status
-  */
-USBH_StatusTypeDef  USBH_LL_Disconnect(USBH_HandleTypeDef *phost)
-{
-  /* update device connection states */
-  phost->device.is_disconnected = 1U;
-  phost->device.is_connected = 0U;
-  phost->device.PortEnabled = 0U;
-
-  /* Stop Host */
-  USBH_LL_Stop(phost);
-
-  /* FRee Control Pipes */
-  USBH_FreePipe(phost, phost->Control.pipe_in);
-  USBH_FreePipe(phost, phost->Control.pipe_out);
-#if (USBH_USE_OS == 1U)
-  phost->os_msg = (uint32_t)USBH_PORT_EVENT;
-#if (osCMSIS < 0x20000U)
-  (void)osMessagePut(phost->os_event, phost->os_msg, 0U);
-#else
-  (void)osMessageQueuePut(phost->os_event, &phost->os_msg, 0U, 0U);
-#endif
-#endif
-
-  return USBH_OK;
-}
-
-
-#if (USBH_USE_OS == 1U)
-/**
-  * @brief  USB Host Thread task
-  * @param  pvParameters not used
-  * @retval None
-  */
-
-#if (osCMSIS < 0x20000U)
-static void USBH_Process_OS(void const *argument)
-{
-  osEvent event;
-
-  for (;;)
-  {
-    event = osMessageGet(((USBH_HandleTypeDef *)argument)->os_event, osWaitForever);
-    if (event.status == osEventMessage)
-    {
-      USBH_Process((USBH_HandleTypeDef *)argument);
-    }
-  }
-}
-#else
-static void USBH_Process_OS(void *argument)
-{
-  osStatus_t status;
-
-  for (;;)
-  {
-    status = osMessageQueueGet(((USBH_HandleTypeDef *)argument)->os_event,
-                               &((USBH_HandleTypeDef *)argument)->os_msg, NULL, osWaitForever);
-    if (status == osOK)
-    {
-      USBH_Process((USBH_HandleTypeDef *)argument);
-    }
-  }
-}
-#endif /* (osCMSIS < 0x20000U) */
-
-
-/**
-* @brief  USBH_LL_NotifyURBChange
-*         Notify URB state Change
-* @param  phost: Host handle
-* @retval USBH Status
-*/
-USBH_StatusTypeDef  USBH_LL_NotifyURBChange(USBH_HandleTypeDef *phost)
-{
-  phost->os_msg = (uint32_t)USBH_PORT_EVENT;
-
-#if (osCMSIS < 0x20000U)
-  (void)osMessagePut(phost->os_event, phost->os_msg, 0U);
-#else
-  (void)osMessageQueuePut(phost->os_event, &phost->os_msg, 0U, 0U);
-#endif
-
-  return USBH_OK;
-}
-#endif
-/**
-  * @}
-  */
-
-/**
-  * @}
-  */
-
-/**
-  * @}
-  */
-
-/**
-  * @}
-  */
-
-/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
+/**
+  ******************************************************************************
+  * @file    usbh_core.c
+  * @author  MCD Application Team
+  * @brief   This file implements the functions for the core state machine process
+  *          the enumeration and the control transfer process
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2015 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under Ultimate Liberty license
+  * SLA0044, the "License"; You may not use this file except in compliance with
+  * the License. You may obtain a copy of the License at:
+  *                      www.st.com/SLA0044
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "usbh_core.h"
+#include "usbh_desc_cache.h"
+
+/** @addtogroup USBH_LIB
+  * @{
+  */
+
+/** @addtogroup USBH_LIB_CORE
+  * @{
+  */
+
+/** @defgroup USBH_CORE
+  * @brief This file handles the basic enumeration when a device is connected
+  *          to the host.
+  * @{
+  */
+
+
+/** @defgroup USBH_CORE_Private_Defines
+  * @{
+  */
+#define USBH_ADDRESS_DEFAULT                     0x00U
+#define USBH_ADDRESS_ASSIGNED                    0x01U
+#define USBH_MPS_DEFAULT                         0x40U
+
+/* Strings are read whole into device.Data, the descriptors with their
+   length on 16 bits */
+USBH_STATIC_ASSERT(USBH_MAX_DATA_BUFFER >= 0xFFU,
+                   "USBH_MAX_DATA_BUFFER must hold a string descriptor");
+USBH_STATIC_ASSERT((USBH_MAX_SIZE_CONFIGURATION >= USB_CONFIGURATION_DESC_SIZE) &&
+                   (USBH_MAX_SIZE_CONFIGURATION <= 0xFFFFU),
+                   "USBH_MAX_SIZE_CONFIGURATION out of range");
+/**
+  * @}
+  */
+
+/** @defgroup USBH_CORE_Private_Macros
+  * @{
+  */
+/**
+  * @}
+  */
+
+
+/** @defgroup USBH_CORE_Private_Variables
+  * @{
+  */
+#if (USBH_USE_OS == 1U)
+#if (osCMSIS >= 0x20000U)
+osThreadAttr_t USBH_Thread_Atrr;
+#endif
+#endif
+
+/* Channels, schedules and thread of each root handle, free when pRoot is NULL */
+static USBH_PortTypeDef USBH_Ports[USBH_MAX_NUM_PORTS];
+
+#if (USBH_MAX_NUM_DEVICES > 1U)
+/* Handles of the devices attached behind hubs, free when pRoot is NULL */
+static USBH_HandleTypeDef USBH_Devices[USBH_MAX_NUM_DEVICES - 1U];
+#endif
+
+
+/**
+  * @}
+  */
+
+
+/** @defgroup USBH_CORE_Private_Functions
+  * @{
+  */
+static USBH_StatusTypeDef USBH_HandleEnum(USBH_HandleTypeDef *phost);
+static void USBH_HandleSof(USBH_HandleTypeDef *phost);
+static void USBH_HandleTimers(USBH_HandleTypeDef *phost);
+static void USBH_HandlePipeEvents(USBH_HandleTypeDef *phost);
+static USBH_StatusTypeDef DeInitStateMachine(USBH_HandleTypeDef *phost);
+static void USBH_StringDone(USBH_HandleTypeDef *phost, USBH_StatusTypeDef status,
+                            void *pContext);
+static void USBH_FreeControlPipes(USBH_HandleTypeDef *phost);
+static USBH_HandleTypeDef *USBH_AddFunction(USBH_HandleTypeDef *phost, USBH_ClassTypeDef *pclass);
+static void USBH_RemoveFunctions(USBH_HandleTypeDef *phost);
+
+#if (USBH_FAST_ATTACH == 1U)
+static USBH_StatusTypeDef USBH_WaitDeadline(USBH_HandleTypeDef *phost, uint32_t time);
+#endif
+
+#if (USBH_USE_OS == 1U)
+static uint32_t USBH_OS_WaitTime(USBH_HandleTypeDef *phost);
+#if (osCMSIS < 0x20000U)
+static void USBH_Process_OS(void const *argument);
+#else
+static void USBH_Process_OS(void *argument);
+#endif
+#endif
+
+
+/**
+  * @brief  HCD_Init
+  *         Initialize the HOST Core.
+  * @param  phost: Host Handle
+  * @param  pUsrFunc: User Callback
+  * @retval USBH Status
+  */
+USBH_StatusTypeDef  USBH_Init(USBH_HandleTypeDef *phost,
+                              void (*pUsrFunc)(USBH_HandleTypeDef *phost,
+                              uint8_t id), uint8_t id)
+{
+  USBH_PortTypeDef *pport = NULL;
+  uint32_t idx;
+
+  /* Check whether the USB Host handle is valid */
+  if (phost == NULL)
+  {
+    USBH_ErrLog("Invalid Host handle");
+    return USBH_FAIL;
+  }
+
+  /* Keep the port of a handle initialized before, else take a free one */
+  for (idx = 0U; idx < USBH_MAX_NUM_PORTS; idx++)
+  {
+    if (USBH_Ports[idx].pRoot == phost)
+    {
+      pport = &USBH_Ports[idx];
+      break;
+    }
+    if ((USBH_Ports[idx].pRoot == NULL) && (pport == NULL))
+    {
+      pport = &USBH_Ports[idx];
+    }
+  }
+
+  if (pport == NULL)
+  {
+    USBH_ErrLog("No free host port");
+    return USBH_FAIL;
+  }
+
+  /* Set DRiver ID */
+  phost->id = id;
+
+  /* The handle is the root of the device tree */
+  pport->pRoot = phost;
+  phost->pPort = pport;
+  phost->pRoot = phost;
+  phost->pParent = NULL;
+  phost->HubPort = 0U;
+  phost->DevAddress = USBH_DEVICE_ADDRESS;
+  phost->pDevice = phost;
+  (void)USBH_memset(pport->CtlQueue, 0, sizeof(pport->CtlQueue));
+  pport->CtlQueueSeq = 0U;
+  (void)USBH_memset(&phost->CtlStats, 0, sizeof(USBH_CtlStatsTypeDef));
+#if (USBH_MAX_VPIPES_NBR > 0U)
+  (void)USBH_memset(&pport->VPipeStats, 0, sizeof(USBH_VPipeStatsTypeDef));
+#endif /* (USBH_MAX_VPIPES_NBR > 0U) */
+  (void)USBH_memset(&pport->PeriodicStats, 0, sizeof(USBH_PeriodicStatsTypeDef));
+
+  /* Unlink class*/
+  phost->pActiveClass = NULL;
+  phost->ClassNumber = 0U;
+
+  /* Restore default states and prepare EP0 */
+  DeInitStateMachine(phost);
+
+  /* Restore default Device connection states */
+  phost->device.PortEnabled = 0U;
+  phost->device.is_connected = 0U;
+  phost->device.is_disconnected = 0U;
+  phost->device.is_ReEnumerated = 0U;
+
+  /* Assign User process */
+  if (pUsrFunc != NULL)
+  {
+    phost->pUser = pUsrFunc;
+  }
+
+#if (USBH_USE_OS == 1U)
+  (void)USBH_memset(&pport->os_stats, 0, sizeof(USBH_OSStatsTypeDef));
+#if (USBH_USE_OS_EVENT_FLAGS == 1U)
+  pport->os_pending = 0U;
+#endif
+
+#if (osCMSIS < 0x20000U)
+
+#if (USBH_USE_OS_EVENT_FLAGS == 0U)
+  /* Create USB Host Queue */
+  osMessageQDef(USBH_Queue, MSGQUEUE_OBJECTS, uint16_t);
+  pport->os_event = osMessageCreate(osMessageQ(USBH_Queue), NULL);
+#endif
+
+  /* Create USB Host Task */
+#if defined (USBH_PROCESS_STACK_SIZE)
+  osThreadDef(USBH_Thread, USBH_Process_OS, USBH_PROCESS_PRIO, 0U, USBH_PROCESS_STACK_SIZE);
+#else
+  osThreadDef(USBH_Thread, USBH_Process_OS, USBH_PROCESS_PRIO, 0U, 8U * configMINIMAL_STACK_SIZE);
+#endif /* defined (USBH_PROCESS_STACK_SIZE) */
+
+  pport->thread = osThreadCreate(osThread(USBH_Thread), phost);
+
+#else
+
+#if (USBH_USE_OS_EVENT_FLAGS == 0U)
+  static osMessageQueueAttr_t msgq_attrs;
+  static char _queue_mem[1024 * sizeof(uint32_t) + sizeof(osRtxMessageQueue_t)];
+  static osRtxMessageQueue_t _obj_mem[MSGQUEUE_OBJECTS];
+
+  msgq_attrs.mq_mem = _queue_mem;
+  msgq_attrs.mq_size = sizeof(_queue_mem);
+  msgq_attrs.cb_mem = &_obj_mem;
+  msgq_attrs.cb_size = sizeof(_obj_mem);
+
+  /* Create USB Host Queue */
+  pport->os_event = osMessageQueueNew(MSGQUEUE_OBJECTS, sizeof(uint32_t), &msgq_attrs);
+#endif
+
+  /* Create USB Host Task */
+  USBH_Thread_Atrr.name = "USBH_Queue";
+
+#if defined (USBH_PROCESS_STACK_SIZE)
+  USBH_Thread_Atrr.stack_size = USBH_PROCESS_STACK_SIZE;
+#else
+  USBH_Thread_Atrr.stack_size = (8U * configMINIMAL_STACK_SIZE);
+#endif /* defined (USBH_PROCESS_STACK_SIZE) */
+
+  static osRtxThread_t thread_cb;
+
+  USBH_Thread_Atrr.stack_mem  = malloc(USBH_Thread_Atrr.stack_size);
+  USBH_Thread_Atrr.cb_mem  = &thread_cb;
+  USBH_Thread_Atrr.cb_size = sizeof(osRtxThread_t);
+
+  USBH_Thread_Atrr.priority = USBH_PROCESS_PRIO;
+  pport->thread = osThreadNew(USBH_Process_OS, phost, &USBH_Thread_Atrr);
+
+#endif /* (osCMSIS < 0x20000U) */
+#endif /* (USBH_USE_OS == 1U) */
+
+  /* Initialize low level driver */
+  USBH_LL_Init(phost);
+
+  return USBH_OK;
+}
+
+
+/**
+  * @brief  HCD_Init
+  *         De-Initialize the Host portion of the driver.
+  * @param  phost: Host Handle
+  * @retval USBH Status
+  */
+USBH_StatusTypeDef USBH_DeInit(USBH_HandleTypeDef *phost)
+{
+  DeInitStateMachine(phost);
+
+  /* Restore default Device connection states */
+  phost->device.PortEnabled = 0U;
+  phost->device.is_connected = 0U;
+  phost->device.is_disconnected = 0U;
+  phost->device.is_ReEnumerated = 0U;
+  phost->device.RstCnt = 0U;
+  phost->device.EnumCnt = 0U;
+
+  if (phost->pData != NULL)
+  {
+    USBH_LL_Stop(phost);
+  }
+
+  return USBH_OK;
+}
+
+
+/**
+  * @brief  DeInitStateMachine
+  *         De-Initialize the Host state machine.
+  * @param  phost: Host Handle
+  * @retval USBH Status
+  */
+static USBH_StatusTypeDef DeInitStateMachine(USBH_HandleTypeDef *phost)
+{
+  USBH_PortTypeDef *pport = phost->pPort;
+  uint32_t i = 0U;
+
+  /* The port is shared by the whole tree, only its root handle resets it */
+  if (phost->pRoot == phost)
+  {
+    /* Clear Pipes flags*/
+    for (i = 0U; i < USBH_NUM_PIPES; i++)
+    {
+      pport->Pipes[i] = 0U;
+      pport->PipeCallback[i] = NULL;
+      pport->PipeEvent[i] = USBH_URB_IDLE;
+      pport->PipeDevice[i] = NULL;
+      pport->PipeClass[i] = NULL;
+    }
+    pport->PipeMap = 0U;
+#if (USBH_MAX_VPIPES_NBR > 0U)
+    (void)USBH_memset(pport->VPipe, 0, sizeof(pport->VPipe));
+    (void)USBH_memset(pport->ChanVPipe, (int)USBH_PIPE_NONE, sizeof(pport->ChanVPipe));
+    pport->VChanMap = 0U;
+    pport->VChanCache = 0U;
+    pport->VPipePending = 0U;
+#endif /* (USBH_MAX_VPIPES_NBR > 0U) */
+
+    pport->AddressMap = 1UL << phost->DevAddress;
+    pport->pCtlOwner = NULL;
+    pport->pCtlDevice = NULL;
+  }
+  (void)USBH_memset(phost->EpPipe, 0, sizeof(phost->EpPipe));
+  (void)USBH_memset(phost->ItfClaimed, 0, sizeof(phost->ItfClaimed));
+
+#if (USBH_DESC_CACHE_ENTRIES > 0U)
+  USBH_DescCache_Release(phost);
+  phost->device.DescCacheEntry = USBH_DESC_CACHE_NONE;
+#endif
+  USBH_CtlFlush(phost);
+  phost->StringReq.State = USBH_STRING_IDLE;
+
+  for (i = 0U; i < USBH_MAX_DATA_BUFFER; i++)
+  {
+    phost->device.Data[i] = 0U;
+  }
+
+  phost->gState = HOST_IDLE;
+  phost->EnumState = ENUM_IDLE;
+  phost->RequestState = CMD_SEND;
+  phost->Timer = 0U;
+  if (phost->pRoot == phost)
+  {
+    pport->TimerCount = 0U;
+    pport->SofActive = 0U;
+    USBH_PeriodicInit(phost);
+  }
+
+  phost->Control.state = CTRL_SETUP;
+  phost->Control.pipe_size = USBH_MPS_DEFAULT;
+  phost->Control.errorcount = 0U;
+
+  phost->device.address = USBH_ADDRESS_DEFAULT;
+  phost->device.speed = USBH_SPEED_FULL;
+  phost->device.RstCnt = 0U;
+  phost->device.EnumCnt = 0U;
+
+#if (USBH_FAST_ATTACH == 1U)
+  phost->WaitPending = 0U;
+#endif
+
+  return USBH_OK;
+}
+
+
+/**
+  * @brief  USBH_FreeControlPipes
+  *         Free the EP0 pipes, unless they belong to the root port.
+  * @param  phost: Host Handle
+  * @retval None
+  */
+static void USBH_FreeControlPipes(USBH_HandleTypeDef *phost)
+{
+  if (phost->pRoot == phost)
+  {
+    USBH_FreePipe(phost, phost->Control.pipe_out);
+    USBH_FreePipe(phost, phost->Control.pipe_in);
+  }
+}
+
+
+/**
+  * @brief  USBH_RegisterClass
+  *         Link class driver to Host Core.
+  * @param  phost : Host Handle
+  * @param  pclass: Class handle
+  * @retval USBH Status
+  */
+USBH_StatusTypeDef USBH_RegisterClass(USBH_HandleTypeDef *phost, USBH_ClassTypeDef *pclass)
+{
+  USBH_StatusTypeDef status = USBH_OK;
+
+  if (pclass != NULL)
+  {
+    if (phost->ClassNumber < USBH_MAX_NUM_SUPPORTED_CLASS)
+    {
+      /* link the class to the USB Host handle */
+      phost->pClass[phost->ClassNumber++] = pclass;
+      status = USBH_OK;
+    }
+    else
+    {
+      USBH_ErrLog("Max Class Number reached");
+      status = USBH_FAIL;
+    }
+  }
+  else
+  {
+    USBH_ErrLog("Invalid Class handle");
+    status = USBH_FAIL;
+  }
+
+  return status;
+}
+
+
+/**
+  * @brief  USBH_SelectInterface
+  *         Select current interface and claim it for the class.
+  * @param  phost: Host Handle
+  * @param  interface: Interface number
+  * @retval USBH Status
+  */
+USBH_StatusTypeDef USBH_SelectInterface(USBH_HandleTypeDef *phost, uint8_t interface)
+{
+  USBH_StatusTypeDef status = USBH_OK;
+  USBH_DescIterTypeDef iter;
+  USBH_InterfaceDescTypeDef itf;
+
+  if (USBH_DescIter_SeekInterface(phost, &iter, interface, &itf) == USBH_OK)
+  {
+    phost->device.current_interface = interface;
+    phost->device.current_itf_number = itf.bInterfaceNumber;
+    USBH_ClaimInterface(phost, interface);
+    USBH_UsrLog("Switching to Interface (#%d)", interface);
+    USBH_UsrLog("Class    : %xh", itf.bInterfaceClass);
+    USBH_UsrLog("SubClass : %xh", itf.bInterfaceSubClass);
+    USBH_UsrLog("Protocol : %xh", itf.bInterfaceProtocol);
+  }
+  else
+  {
+    USBH_ErrLog("Cannot Select This Interface.");
+    status = USBH_FAIL;
+  }
+
+  return status;
+}
+
+
+/**
+  * @brief  USBH_ClaimInterface
+  *         Bind an interface to the class of the handle, so that the other
+  *         classes of a composite device no longer find it. Every alternate
+  *         setting of the interface is claimed with it.
+  * @param  phost: Host Handle
+  * @param  interface: Interface index
+  * @retval None
+  */
+void USBH_ClaimInterface(USBH_HandleTypeDef *phost, uint8_t interface)
+{
+  USBH_DescIterTypeDef iter;
+  USBH_InterfaceDescTypeDef itf;
+
+  if (USBH_DescIter_SeekInterface(phost, &iter, interface, &itf) == USBH_OK)
+  {
+    phost->pDevice->ItfClaimed[itf.bInterfaceNumber >> 3] |= (uint8_t)(1U << (itf.bInterfaceNumber & 7U));
+  }
+}
+
+
+/**
+  * @brief  USBH_IsInterfaceClaimed
+  *         Tell whether an interface is bound to a class of the device.
+  * @param  phost: Host Handle
+  * @param  number: bInterfaceNumber of the interface
+  * @retval 1 if claimed, 0 otherwise
+  */
+uint8_t USBH_IsInterfaceClaimed(USBH_HandleTypeDef *phost, uint8_t number)
+{
+  return ((phost->pDevice->ItfClaimed[number >> 3] & (1U << (number & 7U))) != 0U) ? 1U : 0U;
+}
+
+
+/**
+  * @brief  USBH_GetActiveClass
+  *         Return Device Class.
+  * @param  phost: Host Handle
+  * @param  interface: Interface index
+  * @retval Class Code
+  */
+uint8_t USBH_GetActiveClass(USBH_HandleTypeDef *phost)
+{
+  USBH_DescIterTypeDef iter;
+  USBH_InterfaceDescTypeDef itf;
+
+  if (USBH_DescIter_SeekInterface(phost, &iter, 0U, &itf) != USBH_OK)
+  {
+    return 0U;
+  }
+
+  return (itf.bInterfaceClass);
+}
+
+
+/**
+  * @brief  USBH_FindInterface
+  *         Find the interface index for a specific class, among the
+  *         interfaces not yet claimed by a class.
+  * @param  phost: Host Handle
+  * @param  Class: Class code
+  * @param  SubClass: SubClass code
+  * @param  Protocol: Protocol code
+  * @retval index of the interface descriptor in the configuration descriptor
+  * @note : (1)interface index 0xFF means interface index not found
+  */
+uint8_t  USBH_FindInterface(USBH_HandleTypeDef *phost, uint8_t Class, uint8_t SubClass, uint8_t Protocol)
+{
+  USBH_DescIterTypeDef iter;
+  USBH_InterfaceDescTypeDef itf;
+
+  USBH_DescIter_Init(phost, &iter);
+
+  while (USBH_DescIter_NextInterface(&iter, &itf) == USBH_OK)
+  {
+    if ((USBH_IsInterfaceClaimed(phost, itf.bInterfaceNumber) == 0U) &&
+        ((itf.bInterfaceClass == Class) || (Class == 0xFFU)) &&
+        ((itf.bInterfaceSubClass == SubClass) || (SubClass == 0xFFU)) &&
+        ((itf.bInterfaceProtocol == Protocol) || (Protocol == 0xFFU)))
+    {
+      return iter.ItfIndex;
+    }
+  }
+  return 0xFFU;
+}
+
+
+/**
+  * @brief  USBH_FindInterfaceIndex
+  *         Find the interface index for a specific class interface and alternate setting number.
+  * @param  phost: Host Handle
+  * @param  interface_number: interface number
+  * @param  alt_settings    : alternate setting number
+  * @retval index of the interface descriptor in the configuration descriptor
+  * @note : (1)interface index 0xFF means interface index not found
+  */
+uint8_t  USBH_FindInterfaceIndex(USBH_HandleTypeDef *phost, uint8_t interface_number, uint8_t alt_settings)
+{
+  USBH_DescIterTypeDef iter;
+  USBH_InterfaceDescTypeDef itf;
+
+  USBH_DescIter_Init(phost, &iter);
+
+  while (USBH_DescIter_NextInterface(&iter, &itf) == USBH_OK)
+  {
+    if ((itf.bInterfaceNumber == interface_number) && (itf.bAlternateSetting == alt_settings))
+    {
+      return iter.ItfIndex;
+    }
+  }
+  return 0xFFU;
+}
+
+
+/**
+  * @brief  USBH_Start
+  *         Start the USB Host Core.
+  * @param  phost: Host Handle
+  * @retval USBH Status
+  */
+USBH_StatusTypeDef  USBH_Start(USBH_HandleTypeDef *phost)
+{
+  /* Start the low level driver  */
+  USBH_LL_Start(phost);
+
+  /* Activate VBUS on the port */
+  USBH_LL_DriverVBUS(phost, TRUE);
+
+  return USBH_OK;
+}
+
+
+/**
+  * @brief  USBH_Stop
+  *         Stop the USB Host Core.
+  * @param  phost: Host Handle
+  * @retval USBH Status
+  */
+USBH_StatusTypeDef  USBH_Stop(USBH_HandleTypeDef *phost)
+{
+  /* DeActivate VBUS on the port */
+  USBH_LL_DriverVBUS(phost, FALSE);
+
+  /* Stop and cleanup the low level driver  */
+  USBH_LL_Stop(phost);
+
+  /* Free Control Pipes */
+  USBH_FreePipe(phost, phost->Control.pipe_in);
+  USBH_FreePipe(phost, phost->Control.pipe_out);
+
+  return USBH_OK;
+}
+
+
+/**
+  * @brief  HCD_ReEnumerate
+  *         Perform a new Enumeration phase.
+  * @param  phost: Host Handle
+  * @retval USBH Status
+  */
+USBH_StatusTypeDef USBH_ReEnumerate(USBH_HandleTypeDef *phost)
+{
+  if (USBH_IsPortEnabled(phost))
+  {
+    phost->device.is_ReEnumerated = 1U;
+
+    /* Stop Host */
+    USBH_Stop(phost);
+
+    phost->device.is_disconnected = 1U;
+  }
+
+#if (USBH_USE_OS == 1U)
+  USBH_OS_PostEvent(phost, USBH_PORT_EVENT);
+#endif
+
+  return USBH_OK;
+}
+
+
+/**
+  * @brief  USBH_AddDevice
+  *         Give a handle to a device a hub has reset and enabled. The device
+  *         is enumerated from the default address by its own state machine,
+  *         which the hub class runs with USBH_Process().
+  * @param  phost: Handle of the hub
+  * @param  port: Hub port the device is attached to
+  * @param  speed: USBH_SPEED_FULL or USBH_SPEED_LOW
+  * @retval Device handle, NULL when the device table is full
+  */
+USBH_HandleTypeDef *USBH_AddDevice(USBH_HandleTypeDef *phost, uint8_t port, uint8_t speed)
+{
+#if (USBH_MAX_NUM_DEVICES > 1U)
+  USBH_HandleTypeDef *proot = phost->pRoot;
+  USBH_HandleTypeDef *pdev = NULL;
+  uint32_t idx;
+  uint8_t address;
+
+  for (idx = 0U; idx < (USBH_MAX_NUM_DEVICES - 1U); idx++)
+  {
+    if (USBH_Devices[idx].pRoot == NULL)
+    {
+      pdev = &USBH_Devices[idx];
+      break;
+    }
+  }
+
+  for (address = 1U; address < 32U; address++)
+  {
+    if ((phost->pPort->AddressMap & (1UL << address)) == 0U)
+    {
+      break;
+    }
+  }
+
+  if ((pdev == NULL) || (address >= 32U))
+  {
+    USBH_ErrLog("Device table full, hub port %d ignored", port);
+    return NULL;
+  }
+
+  (void)USBH_memset(pdev, 0, sizeof(USBH_HandleTypeDef));
+
+  pdev->pPort = proot->pPort;
+  pdev->pDevice = pdev;
+  pdev->id = proot->id;
+  pdev->pData = proot->pData;
+  pdev->pUser = proot->pUser;
+  for (idx = 0U; idx < proot->ClassNumber; idx++)
+  {
+    pdev->pClass[idx] = proot->pClass[idx];
+  }
+  pdev->ClassNumber = proot->ClassNumber;
+
+  pdev->pRoot = proot;
+  pdev->pParent = phost;
+  pdev->HubPort = port;
+  pdev->DevAddress = address;
+  phost->pPort->AddressMap |= 1UL << address;
+
+  DeInitStateMachine(pdev);
+  pdev->Timer = proot->Timer;
+
+  /* The hub has done the reset and its recovery time, start from the
+     default address on the EP0 pipes of the root port */
+  pdev->device.speed = speed;
+  pdev->device.is_connected = 1U;
+  pdev->device.PortEnabled = 1U;
+  pdev->Control.pipe_in = proot->Control.pipe_in;
+  pdev->Control.pipe_out = proot->Control.pipe_out;
+  pdev->gState = HOST_ENUMERATION;
+
+  USBH_UsrLog("USB Device Connected on hub port %d", port);
+
+  if (pdev->pUser != NULL)
+  {
+    pdev->pUser(pdev, HOST_USER_CONNECTION);
+  }
+
+#if (USBH_USE_OS == 1U)
+  USBH_OS_PostEvent(pdev, USBH_PORT_EVENT);
+#endif
+
+  return pdev;
+#else
+  UNUSED(phost);
+  UNUSED(port);
+  UNUSED(speed);
+
+  return NULL;
+#endif /* (USBH_MAX_NUM_DEVICES > 1U) */
+}
+
+
+/**
+  * @brief  USBH_RemoveDevice
+  *         Release a device behind a hub, or a function of a composite
+  *         device: stop its class, abort its control transfer, free its
+  *         timers, pipes and address.
+  * @param  phost: Device handle returned by USBH_AddDevice()
+  * @retval None
+  */
+void USBH_RemoveDevice(USBH_HandleTypeDef *phost)
+{
+  USBH_HandleTypeDef *proot = phost->pRoot;
+  USBH_PortTypeDef *pport = phost->pPort;
+  uint32_t idx;
+
+  if ((proot == NULL) || (proot == phost))
+  {
+    return;
+  }
+
+  USBH_RemoveFunctions(phost);
+
+#if (USBH_DESC_CACHE_ENTRIES > 0U)
+  USBH_DescCache_Release(phost);
+#endif
+  USBH_CtlFlush(phost);
+
+  if (phost->pActiveClass != NULL)
+  {
+    phost->pActiveClass->DeInit(phost);
+    phost->pActiveClass = NULL;
+  }
+
+  if (pport->pCtlOwner == phost)
+  {
+    (void)USBH_ClosePipe(proot, proot->Control.pipe_in);
+    (void)USBH_ClosePipe(proot, proot->Control.pipe_out);
+    pport->pCtlOwner = NULL;
+  }
+
+  if (pport->pCtlDevice == phost)
+  {
+    pport->pCtlDevice = NULL;
+  }
+
+  idx = 0U;
+  while (idx < pport->TimerCount)
+  {
+    if (pport->Timers[idx].phost == phost)
+    {
+      (void)USBH_TimerStop(phost, pport->Timers[idx].Callback);
+    }
+    else
+    {
+      idx++;
+    }
+  }
+
+  (void)USBH_CheckPipeLeaks(phost);
+
+  /* A function shares the address of its device */
+  if (phost->pDevice == phost)
+  {
+    pport->AddressMap &= ~(1UL << phost->DevAddress);
+
+    if (phost->pUser != NULL)
+    {
+      phost->pUser(phost, HOST_USER_DISCONNECTION);
+    }
+    USBH_UsrLog("USB Device disconnected from hub port %d", phost->HubPort);
+  }
+
+  phost->gState = HOST_IDLE;
+  phost->pRoot = NULL;
+}
+
+
+/**
+  * @brief  USBH_AddFunction
+  *         Start a further class on a composite device. The function handle
+  *         is a copy of the device handle, it shares the device address and
+  *         descriptors and runs its own class instance, pipes and timers.
+  * @param  phost: Device handle
+  * @param  pclass: Class to start
+  * @retval Function handle, NULL when the class did not start
+  */
+static USBH_HandleTypeDef *USBH_AddFunction(USBH_HandleTypeDef *phost, USBH_ClassTypeDef *pclass)
+{
+#if (USBH_MAX_NUM_DEVICES > 1U)
+  USBH_HandleTypeDef *pfunc = NULL;
+  uint32_t idx;
+
+  for (idx = 0U; idx < (USBH_MAX_NUM_DEVICES - 1U); idx++)
+  {
+    if (USBH_Devices[idx].pRoot == NULL)
+    {
+      pfunc = &USBH_Devices[idx];
+      break;
+    }
+  }
+
+  if (pfunc == NULL)
+  {
+    USBH_ErrLog("Device table full, %s function ignored", pclass->Name);
+    return NULL;
+  }
+
+  (void)USBH_memcpy(pfunc, phost, sizeof(USBH_HandleTypeDef));
+
+  pfunc->pDevice = phost;
+  (void)USBH_memset(pfunc->EpPipe, 0, sizeof(pfunc->EpPipe));
+  pfunc->ActiveClass = *pclass;
+  pfunc->ActiveClass.pData = NULL;
+  pfunc->pActiveClass = &pfunc->ActiveClass;
+  pfunc->RequestState = CMD_SEND;
+  pfunc->gState = HOST_CLASS_REQUEST;
+
+  if (pfunc->pActiveClass->Init(pfunc) != USBH_OK)
+  {
+    USBH_UsrLog("Device not supporting %s class.", pclass->Name);
+
+    if (pfunc->ActiveClass.pData != NULL)
+    {
+      (void)pfunc->pActiveClass->DeInit(pfunc);
+    }
+    (void)USBH_CheckPipeLeaks(pfunc);
+    pfunc->pRoot = NULL;
+
+    return NULL;
+  }
+
+  USBH_UsrLog("%s class started.", pclass->Name);
+
+  /* Inform user that a class has been activated */
+  pfunc->pUser(pfunc, HOST_USER_CLASS_SELECTED);
+
+  return pfunc;
+#else
+  UNUSED(phost);
+  UNUSED(pclass);
+  USBH_ErrLog("Device table full, %s function ignored", pclass->Name);
+
+  return NULL;
+#endif /* (USBH_MAX_NUM_DEVICES > 1U) */
+}
+
+
+/**
+  * @brief  USBH_RemoveFunctions
+  *         Release the functions of a composite device.
+  * @param  phost: Device handle
+  * @retval None
+  */
+static void USBH_RemoveFunctions(USBH_HandleTypeDef *phost)
+{
+#if (USBH_MAX_NUM_DEVICES > 1U)
+  uint32_t idx;
+
+  for (idx = 0U; idx < (USBH_MAX_NUM_DEVICES - 1U); idx++)
+  {
+    if ((USBH_Devices[idx].pRoot != NULL) && (USBH_Devices[idx].pDevice == phost) &&
+        (&USBH_Devices[idx] != phost))
+    {
+      USBH_RemoveDevice(&USBH_Devices[idx]);
+    }
+  }
+#else
+  UNUSED(phost);
+#endif /* (USBH_MAX_NUM_DEVICES > 1U) */
+}
+
+
+/**
+  * @brief  USBH_FindDevice
+  *         Look up a device or function whose class is running, on the root
+  *         port or behind a hub.
+  * @param  phost: Host Handle
+  * @param  class_code: Class code of the active class
+  * @param  instance: Rank of the device among those running the class
+  * @retval Device handle, NULL when not found
+  */
+USBH_HandleTypeDef *USBH_FindDevice(USBH_HandleTypeDef *phost, uint8_t class_code, uint8_t instance)
+{
+  USBH_HandleTypeDef *proot = phost->pRoot;
+  USBH_HandleTypeDef *pdev;
+  uint32_t idx;
+
+  for (idx = 0U; idx < USBH_MAX_NUM_DEVICES; idx++)
+  {
+#if (USBH_MAX_NUM_DEVICES > 1U)
+    pdev = (idx == 0U) ? proot : &USBH_Devices[idx - 1U];
+#else
+    pdev = proot;
+#endif
+
+    if ((pdev->pRoot == proot) && (pdev->gState == HOST_CLASS) &&
+        (pdev->pActiveClass != NULL) && (pdev->pActiveClass->ClassCode == class_code))
+    {
+      if (instance == 0U)
+      {
+        return pdev;
+      }
+      instance--;
+    }
+  }
+
+  return NULL;
+}
+
+
+/**
+  * @brief  USBH_GetString
+  *         Read a string descriptor of the device as UTF-8 text. The text
+  *         comes from the descriptor cache when it holds it; otherwise the
+  *         request goes through USBH_CtlSubmit() and USBH_StringCallback()
+  *         reports the outcome.
+  * @param  phost: Device handle
+  * @param  string_index: String index, as iProduct in the device descriptor
+  * @param  buff: Buffer for the NUL-terminated text, valid until the callback
+  * @param  size: Size of buff, the text is cut at a character boundary
+  * @retval USBH_OK if buff already holds the text, USBH_BUSY if the request
+  *         is queued, USBH_FAIL if another one is pending, if the control
+  *         queue is full or on a wrong argument
+  */
+USBH_StatusTypeDef USBH_GetString(USBH_HandleTypeDef *phost, uint8_t string_index,
+                                  char *buff, uint16_t size)
+{
+  USB_Setup_TypeDef setup;
+#if (USBH_DESC_CACHE_ENTRIES > 0U)
+  const uint8_t *pdesc;
+#endif
+
+  if ((string_index == 0U) || (buff == NULL) || (size == 0U) ||
+      (phost->StringReq.State != USBH_STRING_IDLE))
+  {
+    return USBH_FAIL;
+  }
+
+#if (USBH_DESC_CACHE_ENTRIES > 0U)
+  pdesc = USBH_DescCache_GetString(phost, string_index);
+  if (pdesc != NULL)
+  {
+    (void)USBH_StringToUTF8(pdesc, buff, size);
+    return USBH_OK;
+  }
+#endif
+
+  setup.b.bmRequestType = USB_D2H | USB_REQ_RECIPIENT_DEVICE | USB_REQ_TYPE_STANDARD;
+  setup.b.bRequest = USB_REQ_GET_DESCRIPTOR;
+  setup.b.wValue.w = USB_DESC_STRING | string_index;
+  setup.b.wIndex.w = 0x0409U;
+  setup.b.wLength.w = 0xFFU;
+
+  if (USBH_CtlSubmit(phost, &setup, phost->device.Data, USBH_StringDone, NULL) != USBH_OK)
+  {
+    return USBH_FAIL;
+  }
+
+  phost->StringReq.Index = string_index;
+  phost->StringReq.pBuff = buff;
+  phost->StringReq.Size = size;
+  phost->StringReq.State = USBH_STRING_PENDING;
+
+  return USBH_BUSY;
+}
+
+
+/**
+  * @brief  USBH_StringCallback
+  *         Completion of a string read started by USBH_GetString().
+  * @param  phost: Device handle
+  * @param  string_index: String index
+  * @param  status: USBH_OK when the text is in the buffer, else as for a
+  *         USBH_CtlCallbackTypeDef
+  * @retval None
+  */
+__weak void USBH_StringCallback(USBH_HandleTypeDef *phost, uint8_t string_index,
+                                USBH_StatusTypeDef status)
+{
+  /* Prevent unused argument(s) compilation warning */
+  UNUSED(phost);
+  UNUSED(string_index);
+  UNUSED(status);
+}
+
+
+/**
+  * @brief  USBH_Process
+  *         Background process of the USB Core.
+  * @param  phost: Host Handle
+  * @retval USBH Status
+  */
+USBH_StatusTypeDef  USBH_Process(USBH_HandleTypeDef *phost)
+{
+  __IO USBH_StatusTypeDef status = USBH_FAIL;
+  uint8_t idx = 0U;
+  USBH_DescIterTypeDef iter;
+  USBH_InterfaceDescTypeDef itf;
+
+  /* check for Host pending port disconnect event */
+  if (phost->device.is_disconnected == 1U)
+  {
+    phost->gState = HOST_DEV_DISCONNECTED;
+  }
+  else if (phost->pRoot == phost)
+  {
+    USBH_HandleTimers(phost);
+    USBH_HandleSof(phost);
+    USBH_HandlePipeEvents(phost);
+    USBH_PeriodicProcess(phost);
+  }
+  else
+  {
+    /* Completions of the pipes of a hub device are dispatched by the root */
+  }
+
+  switch (phost->gState)
+  {
+    case HOST_IDLE :
+
+      /* The port of a device behind a hub is reset by the hub class, the
+         functions of a composite device are never reset */
+      if ((phost->device.is_connected) && (phost->pRoot == phost))
+      {
+#if (USBH_FAST_ATTACH == 1U)
+        /* Debounce the attach without blocking the host thread */
+        if (USBH_WaitDeadline(phost, USBH_ATTACH_DEBOUNCE_TIME) != USBH_OK)
+        {
+          break;
+        }
+#endif
+
+        USBH_UsrLog("USB Device Connected");
+
+        phost->gState = HOST_DEV_WAIT_FOR_ATTACHMENT;
+#if (USBH_FAST_ATTACH == 0U)
+        /* Wait for 200 ms after connection */
+        USBH_Delay(200U);
+#endif
+        USBH_LL_ResetPort(phost);
+
+        /* Make sure to start with Default address */
+        phost->device.address = USBH_ADDRESS_DEFAULT;
+        phost->Timeout = 0U;
+
+#if (USBH_USE_OS == 1U)
+        USBH_OS_PostEvent(phost, USBH_PORT_EVENT);
+#endif
+      }
+      break;
+
+    case HOST_DEV_WAIT_FOR_ATTACHMENT: /* Wait for Port Enabled */
+
+      if (phost->device.PortEnabled == 1U)
+      {
+        USBH_UsrLog("USB Device Reset Completed");
+        phost->device.RstCnt = 0U;
+        phost->gState = HOST_DEV_ATTACHED;
+#if (USBH_FAST_ATTACH == 1U)
+        phost->WaitPending = 0U;
+#endif
+      }
+      else
+      {
+#if (USBH_FAST_ATTACH == 1U)
+        /* Woken up by the port enabled event, the deadline only catches a
+           reset that never completes */
+        if (USBH_WaitDeadline(phost, USBH_DEV_RESET_TIMEOUT) == USBH_OK)
+#else
+        if (phost->Timeout > USBH_DEV_RESET_TIMEOUT)
+#endif
+        {
+          phost->device.RstCnt++;
+          if (phost->device.RstCnt > 3U)
+          {
+            /* Buggy Device can't complete reset */
+            USBH_UsrLog("USB Reset Failed, Please unplug the Device.");
+            phost->gState = HOST_ABORT_STATE;
+          }
+          else
+          {
+            phost->gState = HOST_IDLE;
+          }
+        }
+        else
+        {
+#if (USBH_FAST_ATTACH == 0U)
+          phost->Timeout += 10U;
+          USBH_Delay(10U);
+#endif
+        }
+      }
+#if (USBH_USE_OS == 1U)
+#if (USBH_FAST_ATTACH == 1U)
+      if (phost->gState != HOST_DEV_WAIT_FOR_ATTACHMENT)
+#endif
+      {
+        USBH_OS_PostEvent(phost, USBH_PORT_EVENT);
+      }
+#endif
+      break;
+
+    case HOST_DEV_ATTACHED :
+
+#if (USBH_FAST_ATTACH == 1U)
+      /* Reset recovery without blocking the host thread */
+      if (USBH_WaitDeadline(phost, USBH_RESET_RECOVERY_TIME) != USBH_OK)
+      {
+        break;
+      }
+#endif
+
+      if (phost->pUser != NULL)
+      {
+        phost->pUser(phost, HOST_USER_CONNECTION);
+      }
+
+#if (USBH_FAST_ATTACH == 0U)
+      /* Wait for 100 ms after Reset */
+      USBH_Delay(100U);
+#endif
+
+      phost->device.speed = USBH_LL_GetSpeed(phost);
+
+      phost->gState = HOST_ENUMERATION;
+
+      phost->Control.pipe_out = USBH_AllocPipe(phost, 0x00U);
+      phost->Control.pipe_in  = USBH_AllocPipe(phost, 0x80U);
+
+      /* Open Control pipes */
+      USBH_OpenPipe(phost, phost->Control.pipe_in, 0x80U,
+                    phost->device.address, phost->device.speed,
+                    USBH_EP_CONTROL, (uint16_t)phost->Control.pipe_size);
+
+      /* Open Control pipes */
+      USBH_OpenPipe(phost, phost->Control.pipe_out, 0x00U,
+                    phost->device.address, phost->device.speed,
+                    USBH_EP_CONTROL, (uint16_t)phost->Control.pipe_size);
+      phost->pPort->pCtlDevice = phost;
+
+#if (USBH_USE_OS == 1U)
+      USBH_OS_PostEvent(phost, USBH_PORT_EVENT);
+#endif
+      break;
+
+    case HOST_ENUMERATION:
+      /* Check for enumeration status */
+      status = USBH_HandleEnum(phost);
+      if (status == USBH_OK)
+      {
+        /* The function shall return USBH_OK when full enumeration is complete */
+        USBH_UsrLog("Enumeration done.");
+
+#if (USBH_DESC_CACHE_ENTRIES > 0U)
+        USBH_DescCache_Store(phost);
+#endif
+
+        phost->device.current_interface = 0U;
+        phost->device.current_itf_number = 0U;
+
+        if (phost->device.DevDesc.bNumConfigurations == 1U)
+        {
+          USBH_UsrLog("This device has only 1 configuration.");
+          phost->gState = HOST_SET_CONFIGURATION;
+        }
+        else
+        {
+          phost->gState = HOST_INPUT;
+        }
+#if (USBH_USE_OS == 1U)
+        USBH_OS_PostEvent(phost, USBH_STATE_CHANGED_EVENT);
+#endif
+      }
+      break;
+
+    case HOST_INPUT:
+    {
+      /* user callback for end of device basic enumeration */
+      if (phost->pUser != NULL)
+      {
+        phost->pUser(phost, HOST_USER_SELECT_CONFIGURATION);
+        phost->gState = HOST_SET_CONFIGURATION;
+
+#if (USBH_USE_OS == 1U)
+        USBH_OS_PostEvent(phost, USBH_STATE_CHANGED_EVENT);
+#endif
+      }
+    }
+    break;
+
+    case HOST_SET_CONFIGURATION:
+      /* set configuration */
+      if (USBH_SetCfg(phost, (uint16_t)phost->device.CfgDesc.bConfigurationValue) == USBH_OK)
+      {
+        phost->gState = HOST_SET_WAKEUP_FEATURE;
+        USBH_UsrLog("Default configuration set.");
+      }
+
+#if (USBH_USE_OS == 1U)
+      USBH_OS_PostEvent(phost, USBH_PORT_EVENT);
+#endif
+      break;
+
+    case  HOST_SET_WAKEUP_FEATURE:
+
+      if ((phost->device.CfgDesc.bmAttributes) & (1U << 5))
+      {
+        if (USBH_SetFeature(phost, FEATURE_SELECTOR_REMOTEWAKEUP) == USBH_OK)
+        {
+          USBH_UsrLog("Device remote wakeup enabled");
+          phost->gState = HOST_CHECK_CLASS;
+        }
+      }
+      else
+      {
+        phost->gState = HOST_CHECK_CLASS;
+      }
+
+#if (USBH_USE_OS == 1U)
+      USBH_OS_PostEvent(phost, USBH_PORT_EVENT);
+#endif
+      break;
+
+    case HOST_CHECK_CLASS:
+
+      if (phost->ClassNumber == 0U)
+      {
+        USBH_UsrLog("No Class has been registered.");
+      }
+      else
+      {
+        phost->pActiveClass = NULL;
+
+        /* Every interface left unclaimed by the classes already started is
+           offered to the registered classes: the first class runs on the
+           device handle, the next ones on function handles */
+        USBH_DescIter_Init(phost, &iter);
+
+        while (USBH_DescIter_NextInterface(&iter, &itf) == USBH_OK)
+        {
+          if ((itf.bAlternateSetting == 0U) &&
+              (USBH_IsInterfaceClaimed(phost, itf.bInterfaceNumber) == 0U))
+          {
+            for (idx = 0U; idx < phost->ClassNumber; idx++)
+            {
+              if (phost->pClass[idx]->ClassCode == itf.bInterfaceClass)
+              {
+                break;
+              }
+            }
+
+            if (idx == phost->ClassNumber)
+            {
+              /* No registered class for this interface */
+            }
+            else if (phost->pActiveClass == NULL)
+            {
+              /* Each device runs its own instance of the class */
+              phost->ActiveClass = *phost->pClass[idx];
+              phost->ActiveClass.pData = NULL;
+              phost->pActiveClass = &phost->ActiveClass;
+
+              if (phost->pActiveClass->Init(phost) == USBH_OK)
+              {
+                USBH_UsrLog("%s class started.", phost->pActiveClass->Name);
+
+                /* Inform user that a class has been activated */
+                phost->pUser(phost, HOST_USER_CLASS_SELECTED);
+              }
+              else
+              {
+                USBH_UsrLog("Device not supporting %s class.", phost->pActiveClass->Name);
+
+                if (phost->ActiveClass.pData != NULL)
+                {
+                  (void)phost->pActiveClass->DeInit(phost);
+                }
+                (void)USBH_CheckPipeLeaks(phost);
+                phost->pActiveClass = NULL;
+              }
+            }
+            else
+            {
+              (void)USBH_AddFunction(phost, phost->pClass[idx]);
+            }
+          }
+        }
+
+        if (phost->pActiveClass != NULL)
+        {
+          phost->gState = HOST_CLASS_REQUEST;
+        }
+        else
+        {
+          phost->gState = HOST_ABORT_STATE;
+          USBH_UsrLog("No registered class for this device.");
+        }
+      }
+
+#if (USBH_USE_OS == 1U)
+      USBH_OS_PostEvent(phost, USBH_STATE_CHANGED_EVENT);
+#endif
+      break;
+
+    case HOST_CLASS_REQUEST:
+      /* process class standard control requests state machine, the control
+         sequences it submits run first */
+      if (phost->pActiveClass != NULL)
+      {
+        status = USBH_CtlProcess(phost);
+        if (status != USBH_BUSY)
+        {
+          status = phost->pActiveClass->Requests(phost);
+        }
+
+        if (status == USBH_OK)
+        {
+          phost->gState = HOST_CLASS;
+        }
+        else if (status == USBH_FAIL)
+        {
+          phost->gState = HOST_ABORT_STATE;
+          USBH_ErrLog("Device not responding Please Unplug.");
+        }
+        else
+        {
+          /* .. */
+        }
+      }
+      else
+      {
+        phost->gState = HOST_ABORT_STATE;
+        USBH_ErrLog("Invalid Class Driver.");
+      }
+#if (USBH_USE_OS == 1U)
+      USBH_OS_PostEvent(phost, USBH_STATE_CHANGED_EVENT);
+#endif
+      break;
+
+    case HOST_CLASS:
+      /* Queued control requests run between two requests of the class,
+         which waits for them to complete */
+      if (USBH_CtlProcess(phost) == USBH_BUSY)
+      {
+        break;
+      }
+
+      /* process class state machine */
+      if (phost->pActiveClass != NULL)
+      {
+        phost->pActiveClass->BgndProcess(phost);
+      }
+      break;
+
+    case HOST_DEV_DISCONNECTED :
+      phost->device.is_disconnected = 0U;
+
+      USBH_RemoveFunctions(phost);
+
+      /* Fail the queued requests while their class is still there, then
+         stop the class and release what it left before the pipes are reset */
+      USBH_CtlFlush(phost);
+
+      if (phost->pActiveClass != NULL)
+      {
+        phost->pActiveClass->DeInit(phost);
+        (void)USBH_CheckPipeLeaks(phost);
+        phost->pActiveClass = NULL;
+      }
+
+      /* Re-Initilaize Host for new Enumeration */
+      DeInitStateMachine(phost);
+
+      if (phost->pUser != NULL)
+      {
+        phost->pUser(phost, HOST_USER_DISCONNECTION);
+      }
+      USBH_UsrLog("USB Device disconnected");
+
+      if (phost->device.is_ReEnumerated == 1U)
+      {
+        phost->device.is_ReEnumerated = 0U;
+
+        /* Start the host and re-enable Vbus */
+        USBH_Start(phost);
+      }
+      else
+      {
+        /* Device Disconnection Completed, start USB Driver */
+        USBH_LL_Start(phost);
+      }
+
+#if (USBH_USE_OS == 1U)
+      USBH_OS_PostEvent(phost, USBH_PORT_EVENT);
+#endif
+      break;
+
+    case HOST_ABORT_STATE:
+    default :
+      break;
+  }
+
+#if (USBH_MAX_NUM_DEVICES > 1U)
+  /* The functions of a composite device are run with their device */
+  if (phost->pDevice == phost)
+  {
+    for (idx = 0U; idx < (USBH_MAX_NUM_DEVICES - 1U); idx++)
+    {
+      if ((USBH_Devices[idx].pRoot != NULL) && (USBH_Devices[idx].pDevice == phost) &&
+          (&USBH_Devices[idx] != phost))
+      {
+        (void)USBH_Process(&USBH_Devices[idx]);
+      }
+    }
+  }
+#endif
+
+  return USBH_OK;
+}
+
+
+/**
+  * @brief  USBH_HandleEnum
+  *         This function includes the complete enumeration process
+  * @param  phost: Host Handle
+  * @retval USBH_Status
+  */
+static USBH_StatusTypeDef USBH_HandleEnum(USBH_HandleTypeDef *phost)
+{
+  USBH_StatusTypeDef Status = USBH_BUSY;
+  USBH_StatusTypeDef ReqStatus = USBH_BUSY;
+
+  switch (phost->EnumState)
+  {
+    case ENUM_IDLE:
+      /* Get Device Desc for only 1st 8 bytes : To get EP0 MaxPacketSize */
+      ReqStatus = USBH_Get_DevDesc(phost, 8U);
+      if (ReqStatus == USBH_OK)
+      {
+        phost->Control.pipe_size = phost->device.DevDesc.bMaxPacketSize;
+
+        phost->EnumState = ENUM_GET_FULL_DEV_DESC;
+
+        /* modify control channels configuration for MaxPacket size */
+        USBH_OpenPipe(phost, phost->Control.pipe_in, 0x80U, phost->device.address,
+                      phost->device.speed, USBH_EP_CONTROL,
+                      (uint16_t)phost->Control.pipe_size);
+
+        /* Open Control pipes */
+        USBH_OpenPipe(phost, phost->Control.pipe_out, 0x00U, phost->device.address,
+                      phost->device.speed, USBH_EP_CONTROL,
+                      (uint16_t)phost->Control.pipe_size);
+      }
+      else if (ReqStatus == USBH_NOT_SUPPORTED)
+      {
+        USBH_ErrLog("Control error: Get Device Descriptor request failed");
+        phost->device.EnumCnt++;
+        if (phost->device.EnumCnt > 3U)
+        {
+          /* Buggy Device can't complete get device desc request */
+          USBH_UsrLog("Control error, Device not Responding Please unplug the Device.");
+          phost->gState = HOST_ABORT_STATE;
+        }
+        else
+        {
+          /* free control pipes */
+          USBH_FreeControlPipes(phost);
+
+          /* Reset the USB Device */
+          phost->gState = HOST_IDLE;
+        }
+      }
+      else
+      {
+        /* .. */
+      }
+      break;
+
+    case ENUM_GET_FULL_DEV_DESC:
+      /* Get FULL Device Desc  */
+      ReqStatus = USBH_Get_DevDesc(phost, USB_DEVICE_DESC_SIZE);
+      if (ReqStatus == USBH_OK)
+      {
+        USBH_UsrLog("PID: %xh", phost->device.DevDesc.idProduct);
+        USBH_UsrLog("VID: %xh", phost->device.DevDesc.idVendor);
+
+#if (USBH_DESC_CACHE_ENTRIES > 0U)
+        (void)USBH_memcpy(phost->device.DevDesc_Raw, phost->device.Data, USB_DEVICE_DESC_SIZE);
+#endif
+
+        phost->EnumState = ENUM_SET_ADDR;
+      }
+      else if (ReqStatus == USBH_NOT_SUPPORTED)
+      {
+        USBH_ErrLog("Control error: Get Full Device Descriptor request failed");
+        phost->device.EnumCnt++;
+        if (phost->device.EnumCnt > 3U)
+        {
+          /* Buggy Device can't complete get device desc request */
+          USBH_UsrLog("Control error, Device not Responding Please unplug the Device.");
+          phost->gState = HOST_ABORT_STATE;
+        }
+        else
+        {
+          /* Free control pipes */
+          USBH_FreeControlPipes(phost);
+
+          /* Reset the USB Device */
+          phost->EnumState = ENUM_IDLE;
+          phost->gState = HOST_IDLE;
+        }
+      }
+      else
+      {
+        /* .. */
+      }
+      break;
+
+    case ENUM_SET_ADDR:
+      /* set address */
+      ReqStatus = USBH_SetAddress(phost, phost->DevAddress);
+      if (ReqStatus == USBH_OK)
+      {
+#if (USBH_FAST_ATTACH == 1U)
+        /* Set address recovery, waited for in ENUM_GET_CFG_DESC */
+        (void)USBH_WaitDeadline(phost, USBH_SET_ADDRESS_RECOVERY_TIME);
+#else
+        USBH_Delay(2U);
+#endif
+        phost->device.address = phost->DevAddress;
+
+        /* user callback for device address assigned */
+        USBH_UsrLog("Address (#%d) assigned.", phost->device.address);
+        phost->EnumState = ENUM_GET_CFG_DESC;
+
+#if (USBH_DESC_CACHE_ENTRIES > 0U)
+        if (USBH_DescCache_Match(phost) != 0U)
+        {
+          phost->EnumState = ENUM_CHECK_CACHE;
+        }
+        else
+        {
+          USBH_DescCache_Begin(phost);
+        }
+#endif
+
+        /* modify control channels to update device address */
+        USBH_OpenPipe(phost, phost->Control.pipe_in, 0x80U,  phost->device.address,
+                      phost->device.speed, USBH_EP_CONTROL,
+                      (uint16_t)phost->Control.pipe_size);
+
+        /* Open Control pipes */
+        USBH_OpenPipe(phost, phost->Control.pipe_out, 0x00U, phost->device.address,
+                      phost->device.speed, USBH_EP_CONTROL,
+                      (uint16_t)phost->Control.pipe_size);
+      }
+      else if (ReqStatus == USBH_NOT_SUPPORTED)
+      {
+        USBH_ErrLog("Control error: Device Set Address request failed");
+
+        /* Buggy Device can't complete get device desc request */
+        USBH_UsrLog("Control error, Device not Responding Please unplug the Device.");
+        phost->gState = HOST_ABORT_STATE;
+        phost->EnumState = ENUM_IDLE;
+      }
+      else
+      {
+        /* .. */
+      }
+      break;
+
+    case ENUM_GET_CFG_DESC:
+#if (USBH_FAST_ATTACH == 1U)
+      if ((phost->WaitPending != 0U) && (USBH_WaitDeadline(phost, 0U) != USBH_OK))
+      {
+        break;
+      }
+#endif
+      /* get standard configuration descriptor */
+      ReqStatus = USBH_Get_CfgDesc(phost, USB_CONFIGURATION_DESC_SIZE);
+      if (ReqStatus == USBH_OK)
+      {
+        if (phost->device.CfgDesc.wTotalLength > USBH_MAX_SIZE_CONFIGURATION)
+        {
+          USBH_UsrLog("Configuration descriptor of %u bytes, only %u are read",
+                      (unsigned int)phost->device.CfgDesc.wTotalLength,
+                      (unsigned int)USBH_MAX_SIZE_CONFIGURATION);
+        }
+        phost->EnumState = ENUM_GET_FULL_CFG_DESC;
+      }
+      else if (ReqStatus == USBH_NOT_SUPPORTED)
+      {
+        USBH_ErrLog("Control error: Get Device configuration descriptor request failed");
+        phost->device.EnumCnt++;
+        if (phost->device.EnumCnt > 3U)
+        {
+          /* Buggy Device can't complete get device desc request */
+          USBH_UsrLog("Control error, Device not Responding Please unplug the Device.");
+          phost->gState = HOST_ABORT_STATE;
+        }
+        else
+        {
+          /* Free control pipes */
+          USBH_FreeControlPipes(phost);
+
+          /* Reset the USB Device */
+          phost->EnumState = ENUM_IDLE;
+          phost->gState = HOST_IDLE;
+        }
+      }
+      else
+      {
+        /* .. */
+      }
+      break;
+
+    case ENUM_GET_FULL_CFG_DESC:
+      /* get FULL config descriptor (config, interface, endpoints) */
+      ReqStatus = USBH_Get_CfgDesc(phost, phost->device.CfgDesc.wTotalLength);
+      if (ReqStatus == USBH_OK)
+      {
+#if (USBH_LAZY_STRINGS == 1U)
+#if (USBH_DESC_CACHE_ENTRIES > 0U)
+        /* Strings are read on request, but the serial number tells devices
+           with the same descriptors apart in the cache */
+        phost->EnumState = ENUM_GET_SERIALNUM_STRING_DESC;
+#else
+        /* Strings are read on request, see USBH_GetString() */
+        Status = USBH_OK;
+#endif
+#else
+        phost->EnumState = ENUM_GET_MFC_STRING_DESC;
+#endif
+      }
+      else if (ReqStatus == USBH_NOT_SUPPORTED)
+      {
+        USBH_ErrLog("Control error: Get Device configuration descriptor request failed");
+        phost->device.EnumCnt++;
+        if (phost->device.EnumCnt > 3U)
+        {
+          /* Buggy Device can't complete get device desc request */
+          USBH_UsrLog("Control error, Device not Responding Please unplug the Device.");
+          phost->gState = HOST_ABORT_STATE;
+        }
+        else
+        {
+          /* Free control pipes */
+          USBH_FreeControlPipes(phost);
+
+          /* Reset the USB Device */
+          phost->EnumState = ENUM_IDLE;
+          phost->gState = HOST_IDLE;
+        }
+      }
+      else
+      {
+        /* .. */
+      }
+      break;
+
+    case ENUM_GET_MFC_STRING_DESC:
+      if (phost->device.DevDesc.iManufacturer != 0U)
+      {
+        /* Check that Manufacturer String is available */
+        ReqStatus = USBH_Get_StringDesc(phost, phost->device.DevDesc.iManufacturer,
+                                        phost->device.Data, 0xFFU);
+        if (ReqStatus == USBH_OK)
+        {
+          /* User callback for Manufacturing string */
+          USBH_UsrLog("Manufacturer : %s", (char *)(void *)phost->device.Data);
+          phost->EnumState = ENUM_GET_PRODUCT_STRING_DESC;
+
+#if (USBH_USE_OS == 1U)
+          USBH_OS_PostEvent(phost, USBH_STATE_CHANGED_EVENT);
+#endif
+        }
+        else if (ReqStatus == USBH_NOT_SUPPORTED)
+        {
+          USBH_UsrLog("Manufacturer : N/A");
+          phost->EnumState = ENUM_GET_PRODUCT_STRING_DESC;
+
+#if (USBH_USE_OS == 1U)
+          USBH_OS_PostEvent(phost, USBH_STATE_CHANGED_EVENT);
+#endif
+        }
+        else
+        {
+          /* .. */
+        }
+      }
+      else
+      {
+        USBH_UsrLog("Manufacturer : N/A");
+        phost->EnumState = ENUM_GET_PRODUCT_STRING_DESC;
+
+#if (USBH_USE_OS == 1U)
+        USBH_OS_PostEvent(phost, USBH_STATE_CHANGED_EVENT);
+#endif
+      }
+      break;
+
+    case ENUM_GET_PRODUCT_STRING_DESC:
+      if (phost->device.DevDesc.iProduct != 0U)
+      {
+        /* Check that Product string is available */
+        ReqStatus = USBH_Get_StringDesc(phost, phost->device.DevDesc.iProduct,
+                                        phost->device.Data, 0xFFU);
+        if (ReqStatus == USBH_OK)
+        {
+          /* User callback for Product string */
+          USBH_UsrLog("Product : %s", (char *)(void *)phost->device.Data);
+          phost->EnumState = ENUM_GET_SERIALNUM_STRING_DESC;
+        }
+        else if (ReqStatus == USBH_NOT_SUPPORTED)
+        {
+          USBH_UsrLog("Product : N/A");
+          phost->EnumState = ENUM_GET_SERIALNUM_STRING_DESC;
+
+#if (USBH_USE_OS == 1U)
+          USBH_OS_PostEvent(phost, USBH_STATE_CHANGED_EVENT);
+#endif
+        }
+        else
+        {
+          /* .. */
+        }
+      }
+      else
+      {
+        USBH_UsrLog("Product : N/A");
+        phost->EnumState = ENUM_GET_SERIALNUM_STRING_DESC;
+
+#if (USBH_USE_OS == 1U)
+        USBH_OS_PostEvent(phost, USBH_STATE_CHANGED_EVENT);
+#endif
+      }
+      break;
+
+    case ENUM_GET_SERIALNUM_STRING_DESC:
+      if (phost->device.DevDesc.iSerialNumber != 0U)
+      {
+        /* Check that Serial number string is available */
+        ReqStatus = USBH_Get_StringDesc(phost, phost->device.DevDesc.iSerialNumber,
+                                        phost->device.Data, 0xFFU);
+        if (ReqStatus == USBH_OK)
+        {
+          /* User callback for Serial number string */
+          USBH_UsrLog("Serial Number : %s", (char *)(void *)phost->device.Data);
+          Status = USBH_OK;
+        }
+        else if (ReqStatus == USBH_NOT_SUPPORTED)
+        {
+          USBH_UsrLog("Serial Number : N/A");
+          Status = USBH_OK;
+        }
+        else
+        {
+          /* .. */
+        }
+      }
+      else
+      {
+        USBH_UsrLog("Serial Number : N/A");
+        Status = USBH_OK;
+      }
+      break;
+
+#if (USBH_DESC_CACHE_ENTRIES > 0U)
+    case ENUM_CHECK_CACHE:
+#if (USBH_FAST_ATTACH == 1U)
+      if ((phost->WaitPending != 0U) && (USBH_WaitDeadline(phost, 0U) != USBH_OK))
+      {
+        break;
+      }
+#endif
+      /* A known device descriptor: the serial number, if any, tells which
+         of the devices sharing it this is */
+      if (phost->device.DevDesc.iSerialNumber != 0U)
+      {
+        ReqStatus = USBH_GetDescriptor(phost,
+                                       USB_REQ_RECIPIENT_DEVICE | USB_REQ_TYPE_STANDARD,
+                                       USB_DESC_STRING | phost->device.DevDesc.iSerialNumber,
+                                       phost->device.Data, 0xFFU);
+      }
+      else
+      {
+        ReqStatus = USBH_OK;
+      }
+
+      if (ReqStatus == USBH_OK)
+      {
+        if (USBH_DescCache_Load(phost, (phost->device.DevDesc.iSerialNumber != 0U) ?
+                                phost->device.Data : NULL) == USBH_OK)
+        {
+          USBH_UsrLog("Descriptors loaded from the cache.");
+          Status = USBH_OK;
+        }
+        else
+        {
+          USBH_DescCache_Begin(phost);
+          if (phost->device.DevDesc.iSerialNumber != 0U)
+          {
+            USBH_DescCache_PutString(phost, phost->device.DevDesc.iSerialNumber,
+                                     phost->device.Data);
+          }
+          phost->EnumState = ENUM_GET_CFG_DESC;
+        }
+      }
+      else if (ReqStatus == USBH_NOT_SUPPORTED)
+      {
+        /* Not usable as a key, enumerate as usual */
+        USBH_DescCache_Begin(phost);
+        phost->EnumState = ENUM_GET_CFG_DESC;
+      }
+      else
+      {
+        /* .. */
+      }
+      break;
+#endif /* (USBH_DESC_CACHE_ENTRIES > 0U) */
+
+    default:
+      break;
+  }
+  return Status;
+}
+
+
+/**
+  * @brief  USBH_StringDone
+  *         Completion of the string read queued by USBH_GetString().
+  * @param  phost: Device handle
+  * @param  status: Outcome of the request
+  * @param  pContext: Unused
+  * @retval None
+  */
+static void USBH_StringDone(USBH_HandleTypeDef *phost, USBH_StatusTypeDef status,
+                            void *pContext)
+{
+  USBH_StringReqTypeDef *preq = &phost->StringReq;
+
+  UNUSED(pContext);
+
+  if (preq->State != USBH_STRING_PENDING)
+  {
+    return;
+  }
+  preq->State = USBH_STRING_IDLE;
+
+  if (status == USBH_OK)
+  {
+    if ((phost->device.Data[0] < 2U) || (phost->device.Data[1] != USB_DESC_TYPE_STRING))
+    {
+      status = USBH_FAIL;
+    }
+    else
+    {
+#if (USBH_DESC_CACHE_ENTRIES > 0U)
+      USBH_DescCache_PutString(phost, preq->Index, phost->device.Data);
+#endif
+      (void)USBH_StringToUTF8(phost->device.Data, preq->pBuff, preq->Size);
+    }
+  }
+
+  USBH_StringCallback(phost, preq->Index, status);
+}
+
+
+#if (USBH_FAST_ATTACH == 1U)
+/**
+  * @brief  USBH_WaitDeadline
+  *         Non-blocking replacement of USBH_Delay for the fast attach mode.
+  *         Arms a wait of at least time ms unless one is already pending;
+  *         the call that finds it elapsed clears it.
+  * @param  phost: Host Handle
+  * @param  time: Wait duration in ms
+  * @retval USBH_OK once the wait has elapsed, USBH_BUSY before
+  */
+static USBH_StatusTypeDef USBH_WaitDeadline(USBH_HandleTypeDef *phost, uint32_t time)
+{
+  if (phost->WaitPending == 0U)
+  {
+    phost->WaitStart = USBH_GetTick();
+    phost->WaitTime = time;
+    phost->WaitPending = 1U;
+  }
+
+  /* One extra tick: the wait may have been armed late in the current one */
+  if ((USBH_GetTick() - phost->WaitStart) <= phost->WaitTime)
+  {
+    return USBH_BUSY;
+  }
+
+  phost->WaitPending = 0U;
+
+  return USBH_OK;
+}
+#endif /* (USBH_FAST_ATTACH == 1U) */
+
+
+/**
+  * @brief  USBH_LL_SetTimer
+  *         Set the initial Host Timer tick
+  * @param  phost: Host Handle
+  * @retval None
+  */
+void  USBH_LL_SetTimer(USBH_HandleTypeDef *phost, uint32_t time)
+{
+  phost->Timer = time;
+}
+
+
+/**
+  * @brief  USBH_LL_IncTimer
+  *         Increment Host Timer tick
+  * @param  phost: Host Handle
+  * @retval None
+  */
+void  USBH_LL_IncTimer(USBH_HandleTypeDef *phost)
+{
+#if (USBH_USE_OS == 1U)
+  USBH_PortTypeDef *pport = phost->pPort;
+#endif
+#if (USBH_MAX_NUM_DEVICES > 1U)
+  uint32_t idx;
+#endif
+
+  phost->Timer++;
+
+#if (USBH_MAX_NUM_DEVICES > 1U)
+  /* Devices behind a hub share the frame counter of the root port */
+  for (idx = 0U; idx < (USBH_MAX_NUM_DEVICES - 1U); idx++)
+  {
+    if (USBH_Devices[idx].pRoot == phost)
+    {
+      USBH_Devices[idx].Timer = phost->Timer;
+    }
+  }
+#endif
+
+#if (USBH_USE_OS == 1U)
+  /* Wake the thread when the control transfer in progress times out or
+     its retry is due */
+  if ((pport->pCtlOwner != NULL) &&
+      (pport->pCtlOwner->Control.deadline == phost->Timer))
+  {
+    USBH_OS_PostEvent(pport->pCtlOwner, USBH_CONTROL_EVENT);
+  }
+
+  /* Wake it as well when the periodic schedule has transfers due */
+  if (USBH_PeriodicDue(phost) != 0U)
+  {
+    USBH_OS_PostEvent(phost, USBH_URB_EVENT);
+  }
+
+  /* and when a frame timer is due: the callbacks run in the thread, the
+     interrupt never walks the timer list the thread is sorting */
+  if ((pport->TimerCount != 0U) && ((int32_t)(phost->Timer - pport->TimerNext) >= 0))
+  {
+    USBH_OS_PostEvent(phost, USBH_TIMER_EVENT);
+  }
+
+  /* and on every frame while a class has a SOF process to run */
+  if (pport->SofActive != 0U)
+  {
+    USBH_OS_PostEvent(phost, USBH_SOF_EVENT);
+  }
+#endif
+}
+
+
+/**
+  * @brief  USBH_TimerStart
+  *         Schedule Callback at an absolute frame number (phost->Timer).
+  *         Starting a timer again reschedules it.
+  * @param  phost: Host Handle
+  * @param  frame: Frame number the callback is due at
+  * @param  Callback: Function called from USBH_Process() of the root
+  *                   handle, it also identifies the timer together with phost
+  * @retval USBH Status
+  */
+USBH_StatusTypeDef USBH_TimerStart(USBH_HandleTypeDef *phost, uint32_t frame,
+                                   void (*Callback)(USBH_HandleTypeDef *phost))
+{
+  USBH_PortTypeDef *pport = phost->pPort;
+  uint32_t idx;
+
+  if (Callback == NULL)
+  {
+    return USBH_FAIL;
+  }
+
+  for (idx = 0U; idx < pport->TimerCount; idx++)
+  {
+    if ((pport->Timers[idx].Callback == Callback) && (pport->Timers[idx].phost == phost))
+    {
+      if (pport->Timers[idx].Frame == frame)
+      {
+        return USBH_OK;
+      }
+      break;
+    }
+  }
+
+  (void)USBH_TimerStop(phost, Callback);
+
+  if (pport->TimerCount >= USBH_MAX_NUM_TIMERS)
+  {
+    USBH_ErrLog("No free frame timer");
+    return USBH_FAIL;
+  }
+
+  /* Keep the wheel sorted so that only the head is checked on each SOF */
+  idx = pport->TimerCount;
+  while ((idx > 0U) && ((int32_t)(pport->Timers[idx - 1U].Frame - frame) > 0))
+  {
+    pport->Timers[idx] = pport->Timers[idx - 1U];
+    idx--;
+  }
+
+  pport->Timers[idx].Frame = frame;
+  pport->Timers[idx].Callback = Callback;
+  pport->Timers[idx].phost = phost;
+  pport->TimerNext = pport->Timers[0].Frame;
+  pport->TimerCount++;
+
+  return USBH_OK;
+}
+
+
+/**
+  * @brief  USBH_TimerStop
+  *         Cancel a pending timer.
+  * @param  phost: Host Handle
+  * @param  Callback: Callback of the timer
+  * @retval USBH Status
+  */
+USBH_StatusTypeDef USBH_TimerStop(USBH_HandleTypeDef *phost,
+                                  void (*Callback)(USBH_HandleTypeDef *phost))
+{
+  USBH_PortTypeDef *pport = phost->pPort;
+  uint32_t idx;
+
+  for (idx = 0U; idx < pport->TimerCount; idx++)
+  {
+    if ((pport->Timers[idx].Callback == Callback) && (pport->Timers[idx].phost == phost))
+    {
+      for (; (idx + 1U) < pport->TimerCount; idx++)
+      {
+        pport->Timers[idx] = pport->Timers[idx + 1U];
+      }
+      pport->TimerNext = pport->Timers[0].Frame;
+      pport->TimerCount--;
+      return USBH_OK;
+    }
+  }
+
+  return USBH_FAIL;
+}
+
+
+/**
+  * @brief  USBH_HandleTimers
+  *         Fire the timers that are due. Runs in USBH_Process() of the root
+  *         handle, the only context that starts and stops timers, so the
+  *         list needs no lock against the SOF interrupt.
+  * @param  phost: Host Handle
+  * @retval None
+  */
+static void USBH_HandleTimers(USBH_HandleTypeDef *phost)
+{
+  USBH_PortTypeDef *pport = phost->pPort;
+  void (*Callback)(USBH_HandleTypeDef *phost);
+  USBH_HandleTypeDef *powner;
+  uint32_t idx;
+
+  while ((pport->TimerCount > 0U) &&
+         ((int32_t)(phost->Timer - pport->Timers[0].Frame) >= 0))
+  {
+    Callback = pport->Timers[0].Callback;
+    powner = pport->Timers[0].phost;
+
+    for (idx = 0U; (idx + 1U) < pport->TimerCount; idx++)
+    {
+      pport->Timers[idx] = pport->Timers[idx + 1U];
+    }
+    pport->TimerNext = pport->Timers[0].Frame;
+    pport->TimerCount--;
+
+    /* The callback may restart its timer */
+    Callback(powner);
+  }
+}
+
+
+/**
+  * @brief  USBH_HandlePipeEvents
+  *         Hand the completed URBs to the classes owning the pipes
+  * @param  phost: Host Handle
+  * @retval None
+  */
+static void USBH_HandlePipeEvents(USBH_HandleTypeDef *phost)
+{
+  USBH_PortTypeDef *pport = phost->pPort;
+  USBH_URBStateTypeDef urb_state;
+  uint32_t map = pport->PipeMap;
+  uint32_t size;
+  uint8_t pipe;
+
+  /* Only the allocated pipes can have a completion */
+  while (map != 0U)
+  {
+    pipe = (uint8_t)USBH_CTZ(map);
+    map &= map - 1U;
+    urb_state = pport->PipeEvent[pipe];
+
+    if (urb_state != USBH_URB_IDLE)
+    {
+      pport->PipeEvent[pipe] = USBH_URB_IDLE;
+      USBH_ATOMIC_CLEAR(pport->PeriodicBusy, 1UL << pipe);
+
+#if (USBH_MAX_VPIPES_NBR > 0U)
+      /* The channel is free again before the owner resubmits */
+      if (pipe >= USBH_MAX_PIPES_NBR)
+      {
+        size = USBH_VPipeRelease(phost, pipe);
+      }
+      else
+#endif /* (USBH_MAX_VPIPES_NBR > 0U) */
+      {
+        size = USBH_LL_GetLastXferSize(phost, pipe);
+      }
+
+      if (pport->PipeCallback[pipe] != NULL)
+      {
+        pport->PipeCallback[pipe](pport->PipeDevice[pipe], pipe, urb_state, size);
+      }
+    }
+  }
+
+#if (USBH_MAX_VPIPES_NBR > 0U)
+  USBH_VPipeSchedule(phost);
+#endif /* (USBH_MAX_VPIPES_NBR > 0U) */
+}
+
+
+/**
+  * @brief  USBH_HandleSof
+  *         Call the SOF process of every device and function of the tree,
+  *         once per frame. Runs in USBH_Process() of the root handle like the
+  *         timers, so the classes are never torn down under it.
+  * @param  phost: Host Handle
+  * @retval None
+  */
+static void  USBH_HandleSof(USBH_HandleTypeDef *phost)
+{
+  USBH_PortTypeDef *pport = phost->pPort;
+  USBH_HandleTypeDef *pdev;
+  uint32_t frame = phost->Timer;
+  uint8_t active = 0U;
+  uint32_t idx;
+
+  for (idx = 0U; idx < USBH_MAX_NUM_DEVICES; idx++)
+  {
+#if (USBH_MAX_NUM_DEVICES > 1U)
+    pdev = (idx == 0U) ? phost : &USBH_Devices[idx - 1U];
+#else
+    pdev = phost;
+#endif
+
+    if ((pdev->pRoot == phost) && (pdev->gState == HOST_CLASS) &&
+        (pdev->pActiveClass != NULL) && (pdev->pActiveClass->SOFProcess != NULL))
+    {
+      active = 1U;
+      if (frame != pport->SofFrame)
+      {
+        pdev->pActiveClass->SOFProcess(pdev);
+      }
+    }
+  }
+
+  pport->SofFrame = frame;
+  pport->SofActive = active;
+}
+
+
+/**
+  * @brief  USBH_PortEnabled
+  *         Port Enabled
+  * @param  phost: Host Handle
+  * @retval None
+  */
+void USBH_LL_PortEnabled(USBH_HandleTypeDef *phost)
+{
+  phost->device.PortEnabled = 1U;
+
+#if (USBH_USE_OS == 1U)
+  USBH_OS_PostEvent(phost, USBH_PORT_EVENT);
+#endif
+
+  return;
+}
+
+
+/**
+  * @brief  USBH_LL_PortDisabled
+  *         Port Disabled
+  * @param  phost: Host Handle
+  * @retval None
+  */
+void USBH_LL_PortDisabled(USBH_HandleTypeDef *phost)
+{
+  phost->device.PortEnabled = 0U;
+
+  return;
+}
+
+
+/**
+  * @brief  HCD_IsPortEnabled
+  *         Is Port Enabled
+  * @param  phost: Host Handle
+  * @retval None
+  */
+uint8_t USBH_IsPortEnabled(USBH_HandleTypeDef *phost)
+{
+  return (phost->device.PortEnabled);
+}
+
+
+/**
+  * @brief  USBH_LL_Connect
+  *         Handle USB Host connexion event
+  * @param  phost: Host Handle
+  * @retval USBH_Status
+  */
+USBH_StatusTypeDef  USBH_LL_Connect(USBH_HandleTypeDef *phost)
+{
+  phost->device.is_connected = 1U;
+  phost->device.is_disconnected = 0U;
+  phost->device.is_ReEnumerated = 0U;
+
+
+#if (USBH_USE_OS == 1U)
+  USBH_OS_PostEvent(phost, USBH_PORT_EVENT);
+#endif
+
+  return USBH_OK;
+}
+
+
+/**
+  * @brief  USBH_LL_Disconnect
+  *         Handle USB Host disconnection event
+  * @param  phost: Host Handle
+  * @retval USBH_Status
+  */
+USBH_StatusTypeDef  USBH_LL_Disconnect(USBH_HandleTypeDef *phost)
+{
+  /* update device connection states */
+  phost->device.is_disconnected = 1U;
+  phost->device.is_connected = 0U;
+  phost->device.PortEnabled = 0U;
+
+  /* Stop Host */
+  USBH_LL_Stop(phost);
+
+  /* FRee Control Pipes */
+  USBH_FreePipe(phost, phost->Control.pipe_in);
+  USBH_FreePipe(phost, phost->Control.pipe_out);
+#if (USBH_USE_OS == 1U)
+  USBH_OS_PostEvent(phost, USBH_PORT_EVENT);
+#endif
+
+  return USBH_OK;
+}
+
+
+#if (USBH_USE_OS == 1U)
+/**
+  * @brief  USBH_OS_WaitTime
+  *         How long the host thread may sleep waiting for an event.
+  * @param  phost: Host Handle
+  * @retval Timeout in kernel ticks
+  */
+static uint32_t USBH_OS_WaitTime(USBH_HandleTypeDef *phost)
+{
+#if (USBH_FAST_ATTACH == 1U)
+  uint32_t elapsed;
+  uint32_t remaining = 1U;
+
+  if (phost->WaitPending != 0U)
+  {
+    /* Wake up when the pending attach wait elapses */
+    elapsed = USBH_GetTick() - phost->WaitStart;
+    if (elapsed <= phost->WaitTime)
+    {
+      remaining = phost->WaitTime - elapsed + 1U;
+    }
+#if (osCMSIS < 0x20000U)
+    return remaining;
+#else
+    return ((remaining * osKernelGetTickFreq()) + 999U) / 1000U;
+#endif
+  }
+#else
+  UNUSED(phost);
+#endif /* (USBH_FAST_ATTACH == 1U) */
+
+  return osWaitForever;
+}
+
+
+/**
+  * @brief  USBH_OS_PostEvent
+  *         Wake up the host thread. In event flags mode each event type is
+  *         one thread flag, so repeated posts of a pending event coalesce
+  *         into a single wake-up and are never lost to a full queue.
+  * @param  phost: Host Handle
+  * @param  event: Event type
+  * @retval None
+  */
+void USBH_OS_PostEvent(USBH_HandleTypeDef *phost, USBH_OSEventTypeDef event)
+{
+  /* Devices behind a hub are serviced by the thread of the root port */
+  USBH_PortTypeDef *pport = phost->pPort;
+#if (USBH_USE_OS_EVENT_FLAGS == 1U)
+  uint32_t flag = 1UL << (uint32_t)event;
+#endif
+
+#if (USBH_USE_OS_EVENT_FLAGS == 1U)
+  pport->os_stats.Posted++;
+
+  if ((pport->os_pending & flag) != 0U)
+  {
+    pport->os_stats.Coalesced++;
+  }
+  pport->os_pending |= flag;
+
+  /* Always set the flag: os_pending only feeds the statistics */
+#if (osCMSIS < 0x20000U)
+  if (osSignalSet(pport->thread, (int32_t)flag) == (int32_t)0x80000000U)
+#else
+  if ((osThreadFlagsSet(pport->thread, flag) & osFlagsError) != 0U)
+#endif
+  {
+    pport->os_stats.Dropped++;
+  }
+#else
+  pport->os_stats.Posted++;
+  pport->os_msg = (uint32_t)event;
+
+#if (osCMSIS < 0x20000U)
+  if (osMessagePut(pport->os_event, pport->os_msg, 0U) != osOK)
+#else
+  if (osMessageQueuePut(pport->os_event, &pport->os_msg, 0U, 0U) != osOK)
+#endif
+  {
+    pport->os_stats.Dropped++;
+  }
+#endif /* (USBH_USE_OS_EVENT_FLAGS == 1U) */
+}
+
+
+/**
+  * @brief  USB Host Thread task
+  * @param  pvParameters not used
+  * @retval None
+  */
+
+#if (osCMSIS < 0x20000U)
+static void USBH_Process_OS(void const *argument)
+{
+  osEvent event;
+
+  for (;;)
+  {
+#if (USBH_USE_OS_EVENT_FLAGS == 1U)
+    /* Wait for any event flag, all set flags are consumed at once */
+    event = osSignalWait(0, USBH_OS_WaitTime((USBH_HandleTypeDef *)argument));
+    if (event.status == osEventSignal)
+    {
+      ((USBH_HandleTypeDef *)argument)->pPort->os_pending &= ~(uint32_t)event.value.signals;
+    }
+    if ((event.status == osEventSignal) || (event.status == osEventTimeout))
+#else
+    event = osMessageGet(((USBH_HandleTypeDef *)argument)->pPort->os_event,
+                         USBH_OS_WaitTime((USBH_HandleTypeDef *)argument));
+    if ((event.status == osEventMessage) || (event.status == osEventTimeout))
+#endif /* (USBH_USE_OS_EVENT_FLAGS == 1U) */
+    {
+      ((USBH_HandleTypeDef *)argument)->pPort->os_stats.Wakeups++;
+      USBH_Process((USBH_HandleTypeDef *)argument);
+    }
+  }
+}
+#else
+static void USBH_Process_OS(void *argument)
+{
+#if (USBH_USE_OS_EVENT_FLAGS == 1U)
+  uint32_t flags;
+
+  for (;;)
+  {
+    /* Wait for any event flag, all set flags are consumed at once */
+    flags = osThreadFlagsWait(USBH_OS_EVENT_FLAGS_ALL, osFlagsWaitAny,
+                              USBH_OS_WaitTime((USBH_HandleTypeDef *)argument));
+    if ((flags & osFlagsError) == 0U)
+    {
+      ((USBH_HandleTypeDef *)argument)->pPort->os_pending &= ~flags;
+    }
+    if (((flags & osFlagsError) == 0U) || (flags == (uint32_t)osFlagsErrorTimeout))
+#else
+  osStatus_t status;
+
+  for (;;)
+  {
+    status = osMessageQueueGet(((USBH_HandleTypeDef *)argument)->pPort->os_event,
+                               &((USBH_HandleTypeDef *)argument)->pPort->os_msg, NULL,
+                               USBH_OS_WaitTime((USBH_HandleTypeDef *)argument));
+    if ((status == osOK) || (status == osErrorTimeout))
+#endif /* (USBH_USE_OS_EVENT_FLAGS == 1U) */
+    {
+      ((USBH_HandleTypeDef *)argument)->pPort->os_stats.Wakeups++;
+      USBH_Process((USBH_HandleTypeDef *)argument);
+    }
+  }
+}
+#endif /* (osCMSIS < 0x20000U) */
+#endif
+
+
+/**
+* @brief  USBH_LL_NotifyURBChange
+*         Notify URB state Change, queue the completion for the pipe owner
+* @param  phost: Host handle
+* @param  pipe: Pipe index
+* @param  urb_state: Final URB state
+* @retval USBH Status
+*/
+USBH_StatusTypeDef  USBH_LL_NotifyURBChange(USBH_HandleTypeDef *phost, uint8_t pipe,
+                                            USBH_URBStateTypeDef urb_state)
+{
+  USBH_PortTypeDef *pport = phost->pPort;
+  /* A pipe has a single URB in flight, the slot is free until the owner resubmits */
+  if (pipe < USBH_MAX_PIPES_NBR)
+  {
+#if (USBH_MAX_VPIPES_NBR > 0U)
+    /* A channel lent to a virtual pipe has to be returned, even without owner */
+    if ((pport->VChanMap & (1UL << pipe)) != 0U)
+    {
+      pport->PipeEvent[USBH_MAX_PIPES_NBR + pport->ChanVPipe[pipe]] = urb_state;
+    }
+    else
+#endif /* (USBH_MAX_VPIPES_NBR > 0U) */
+    if ((pport->PipeCallback[pipe] != NULL) ||
+        ((pport->PeriodicBusy & (1UL << pipe)) != 0U))
+    {
+      pport->PipeEvent[pipe] = urb_state;
+    }
+    else
+    {
+      /* .. */
+    }
+  }
+
+#if (USBH_USE_OS == 1U)
+  USBH_OS_PostEvent(phost, USBH_URB_EVENT);
+#endif
+
+  return USBH_OK;
+}
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
@@ -1,1003 +1,1621 @@
-/**
-  ******************************************************************************
-  * @file    usbh_ctlreq.c
-  * @author  MCD Application Team
-  * @brief   This file implements the control requests for device enumeration
-  ******************************************************************************
-  * @attention
-  *
-  * <h2><center>&copy; Copyright (c) 2015 STMicroelectronics.
-  * All rights reserved.</center></h2>
-  *
-  * This software component is licensed by ST under Ultimate Liberty license
-  * SLA0044, the "License"; You may not use this file except in compliance with
-  * the License. You may obtain a copy of the License at:
-  *                      www.st.com/SLA0044
-  *
-  ******************************************************************************
-  */
-
-/* Includes ------------------------------------------------------------------*/
-#include "usbh_ctlreq.h"
-
-/** @addtogroup USBH_LIB
-* @{
-*/
-
-/** @addtogroup USBH_LIB_CORE
-* @{
-*/
-
-/** @defgroup USBH_CTLREQ
-* @brief This file implements the standard requests for device enumeration
-* @{
-*/
-
-
-/** @defgroup USBH_CTLREQ_Private_Defines
-* @{
-*/
-/**
-* @}
-*/
-
-
-/** @defgroup USBH_CTLREQ_Private_TypesDefinitions
-* @{
-*/
-/**
-* @}
-*/
-
-
-
-/** @defgroup USBH_CTLREQ_Private_Macros
-* @{
-*/
-/**
-* @}
-*/
-
-
-/** @defgroup USBH_CTLREQ_Private_Variables
-* @{
-*/
-/**
-* @}
-*/
-
-/** @defgroup USBH_CTLREQ_Private_FunctionPrototypes
-* @{
-*/
-static USBH_StatusTypeDef USBH_HandleControl(USBH_HandleTypeDef *phost);
-
-static void USBH_ParseDevDesc(USBH_DevDescTypeDef *dev_desc,
-                              uint8_t *buf, uint16_t length);
-
-static void USBH_ParseCfgDesc(USBH_CfgDescTypeDef *cfg_desc,
-                              uint8_t *buf, uint16_t length);
-
-static void USBH_ParseEPDesc(USBH_EpDescTypeDef  *ep_descriptor, uint8_t *buf);
-static void USBH_ParseStringDesc(uint8_t *psrc, uint8_t *pdest, uint16_t length);
-static void USBH_ParseInterfaceDesc(USBH_InterfaceDescTypeDef  *if_descriptor, uint8_t *buf);
-
-
-/**
-* @}
-*/
-
-
-/** @defgroup USBH_CTLREQ_Private_Functions
-* @{
-*/
-
-
-/**
-  * @brief  USBH_Get_DevDesc
-  *         Issue Get Device Descriptor command to the device. Once the response
-  *         received, it parses the device descriptor and updates the status.
-  * @param  phost: Host Handle
-  * @param  length: Length of the descriptor
-  * @retval USBH Status
-  */
-USBH_StatusTypeDef USBH_Get_DevDesc(USBH_HandleTypeDef *phost, uint8_t length)
-{
-  USBH_StatusTypeDef status;
-
-  if ((status = USBH_GetDescriptor(phost,
-                                   USB_REQ_RECIPIENT_DEVICE | USB_REQ_TYPE_STANDARD,
-                                   USB_DESC_DEVICE, phost->device.Data,
-                                   (uint16_t)length)) == USBH_OK)
-  {
-    /* Commands successfully sent and Response Received */
-    USBH_ParseDevDesc(&phost->device.DevDesc, phost->device.Data,
-                      (uint16_t)length);
-  }
-
-  return status;
-}
-
-
-/**
-  * @brief  USBH_Get_CfgDesc
-  *         Issues Configuration Descriptor to the device. Once the response
-  *         received, it parses the configuration descriptor and updates the
-  *         status.
-  * @param  phost: Host Handle
-  * @param  length: Length of the descriptor
-  * @retval USBH Status
-  */
-USBH_StatusTypeDef USBH_Get_CfgDesc(USBH_HandleTypeDef *phost,
-                                    uint16_t length)
-
-{
-  USBH_StatusTypeDef status;
-  uint8_t *pData = phost->device.CfgDesc_Raw;;
-
-  if ((status = USBH_GetDescriptor(phost, (USB_REQ_RECIPIENT_DEVICE | USB_REQ_TYPE_STANDARD),
-                                   USB_DESC_CONFIGURATION, pData, length)) == USBH_OK)
-  {
-    /* Commands successfully sent and Response Received  */
-    USBH_ParseCfgDesc(&phost->device.CfgDesc, pData, length);
-  }
-
-  return status;
-}
-
-
-/**
-  * @brief  USBH_Get_StringDesc
-  *         Issues string Descriptor command to the device. Once the response
-  *         received, it parses the string descriptor and updates the status.
-  * @param  phost: Host Handle
-  * @param  string_index: String index for the descriptor
-  * @param  buff: Buffer address for the descriptor
-  * @param  length: Length of the descriptor
-  * @retval USBH Status
-  */
-USBH_StatusTypeDef USBH_Get_StringDesc(USBH_HandleTypeDef *phost,
-                                       uint8_t string_index, uint8_t *buff,
-                                       uint16_t length)
-{
-  USBH_StatusTypeDef status;
-
-  if ((status = USBH_GetDescriptor(phost,
-                                   USB_REQ_RECIPIENT_DEVICE | USB_REQ_TYPE_STANDARD,
-                                   USB_DESC_STRING | string_index,
-                                   phost->device.Data, length)) == USBH_OK)
-  {
-    /* Commands successfully sent and Response Received  */
-    USBH_ParseStringDesc(phost->device.Data, buff, length);
-  }
-
-  return status;
-}
-
-
-/**
-  * @brief  USBH_GetDescriptor
-  *         Issues Descriptor command to the device. Once the response received,
-  *         it parses the descriptor and updates the status.
-  * @param  phost: Host Handle
-  * @param  req_type: Descriptor type
-  * @param  value_idx: Value for the GetDescriptr request
-  * @param  buff: Buffer to store the descriptor
-  * @param  length: Length of the descriptor
-  * @retval USBH Status
-  */
-USBH_StatusTypeDef USBH_GetDescriptor(USBH_HandleTypeDef *phost,
-                                      uint8_t  req_type,
-                                      uint16_t value_idx,
-                                      uint8_t *buff,
-                                      uint16_t length)
-{
-  if (phost->RequestState == CMD_SEND)
-  {
-    phost->Control.setup.b.bmRequestType = USB_D2H | req_type;
-    phost->Control.setup.b.bRequest = USB_REQ_GET_DESCRIPTOR;
-    phost->Control.setup.b.wValue.w = value_idx;
-
-    if ((value_idx & 0xff00U) == USB_DESC_STRING)
-    {
-      phost->Control.setup.b.wIndex.w = 0x0409U;
-    }
-    else
-    {
-      phost->Control.setup.b.wIndex.w = 0U;
-    }
-    phost->Control.setup.b.wLength.w = length;
-  }
-
-  return USBH_CtlReq(phost, buff, length);
-}
-
-
-/**
-  * @brief  USBH_SetAddress
-  *         This command sets the address to the connected device
-  * @param  phost: Host Handle
-  * @param  DeviceAddress: Device address to assign
-  * @retval USBH Status
-  */
-USBH_StatusTypeDef USBH_SetAddress(USBH_HandleTypeDef *phost,
-                                   uint8_t DeviceAddress)
-{
-  if (phost->RequestState == CMD_SEND)
-  {
-    phost->Control.setup.b.bmRequestType = USB_H2D | USB_REQ_RECIPIENT_DEVICE | \
-                                           USB_REQ_TYPE_STANDARD;
-
-    phost->Control.setup.b.bRequest = USB_REQ_SET_ADDRESS;
-
-    phost->Control.setup.b.wValue.w = (uint16_t)DeviceAddress;
-    phost->Control.setup.b.wIndex.w = 0U;
-    phost->Control.setup.b.wLength.w = 0U;
-  }
-
-  return USBH_CtlReq(phost, 0U, 0U);
-}
-
-
-/**
-  * @brief  USBH_SetCfg
-  *         The command sets the configuration value to the connected device
-  * @param  phost: Host Handle
-  * @param  cfg_idx: Configuration value
-  * @retval USBH Status
-  */
-USBH_StatusTypeDef USBH_SetCfg(USBH_HandleTypeDef *phost, uint16_t cfg_idx)
-{
-  if (phost->RequestState == CMD_SEND)
-  {
-    phost->Control.setup.b.bmRequestType = USB_H2D | USB_REQ_RECIPIENT_DEVICE
-                                           | USB_REQ_TYPE_STANDARD;
-
-    phost->Control.setup.b.bRequest = USB_REQ_SET_CONFIGURATION;
-    phost->Control.setup.b.wValue.w = cfg_idx;
-    phost->Control.setup.b.wIndex.w = 0U;
-    phost->Control.setup.b.wLength.w = 0U;
-  }
-
-  return USBH_CtlReq(phost, 0U, 0U);
-}
-
-
-/**
-  * @brief  USBH_SetInterface
-  *         The command sets the Interface value to the connected device
-  * @param  phost: Host Handle
-  * @param  altSetting: Interface value
-  * @retval USBH Status
-  */
-USBH_StatusTypeDef USBH_SetInterface(USBH_HandleTypeDef *phost, uint8_t ep_num,
-                                     uint8_t altSetting)
-{
-  if (phost->RequestState == CMD_SEND)
-  {
-    phost->Control.setup.b.bmRequestType = USB_H2D | USB_REQ_RECIPIENT_INTERFACE
-                                           | USB_REQ_TYPE_STANDARD;
-
-    phost->Control.setup.b.bRequest = USB_REQ_SET_INTERFACE;
-    phost->Control.setup.b.wValue.w = altSetting;
-    phost->Control.setup.b.wIndex.w = ep_num;
-    phost->Control.setup.b.wLength.w = 0U;
-  }
-
-  return USBH_CtlReq(phost, 0U, 0U);
-}
-
-
-/**
-  * @brief  USBH_SetFeature
-  *         The command sets the device features (remote wakeup feature,..)
-  * @param  pdev: Selected device
-  * @param  itf_idx
-  * @retval Status
-*/
-USBH_StatusTypeDef USBH_SetFeature(USBH_HandleTypeDef *phost, uint8_t wValue)
-{
-  if (phost->RequestState == CMD_SEND)
-  {
-    phost->Control.setup.b.bmRequestType = USB_H2D | USB_REQ_RECIPIENT_DEVICE
-                                           | USB_REQ_TYPE_STANDARD;
-
-    phost->Control.setup.b.bRequest = USB_REQ_SET_FEATURE;
-    phost->Control.setup.b.wValue.w = wValue;
-    phost->Control.setup.b.wIndex.w = 0U;
-    phost->Control.setup.b.wLength.w = 0U;
-  }
-
-  return USBH_CtlReq(phost, 0U, 0U);
-}
-
-
-/**
-  * @brief  USBH_ClrFeature
-  *         This request is used to clear or disable a specific feature.
-  * @param  phost: Host Handle
-  * @param  ep_num: endpoint number
-  * @param  hc_num: Host channel number
-  * @retval USBH Status
-  */
-USBH_StatusTypeDef USBH_ClrFeature(USBH_HandleTypeDef *phost, uint8_t ep_num)
-{
-  if (phost->RequestState == CMD_SEND)
-  {
-    phost->Control.setup.b.bmRequestType = USB_H2D | USB_REQ_RECIPIENT_ENDPOINT
-                                           | USB_REQ_TYPE_STANDARD;
-
-    phost->Control.setup.b.bRequest = USB_REQ_CLEAR_FEATURE;
-    phost->Control.setup.b.wValue.w = FEATURE_SELECTOR_ENDPOINT;
-    phost->Control.setup.b.wIndex.w = ep_num;
-    phost->Control.setup.b.wLength.w = 0U;
-  }
-  return USBH_CtlReq(phost, 0U, 0U);
-}
-
-
-/**
-  * @brief  USBH_ParseDevDesc
-  *         This function Parses the device descriptor
-  * @param  dev_desc: device_descriptor destination address
-  * @param  buf: Buffer where the source descriptor is available
-  * @param  length: Length of the descriptor
-  * @retval None
-  */
-static void  USBH_ParseDevDesc(USBH_DevDescTypeDef *dev_desc, uint8_t *buf,
-                               uint16_t length)
-{
-  dev_desc->bLength            = *(uint8_t *)(buf +  0);
-  dev_desc->bDescriptorType    = *(uint8_t *)(buf +  1);
-  dev_desc->bcdUSB             = LE16(buf +  2);
-  dev_desc->bDeviceClass       = *(uint8_t *)(buf +  4);
-  dev_desc->bDeviceSubClass    = *(uint8_t *)(buf +  5);
-  dev_desc->bDeviceProtocol    = *(uint8_t *)(buf +  6);
-  dev_desc->bMaxPacketSize     = *(uint8_t *)(buf +  7);
-
-  if (length > 8U)
-  {
-    /* For 1st time after device connection, Host may issue only 8 bytes for
-    Device Descriptor Length  */
-    dev_desc->idVendor           = LE16(buf +  8);
-    dev_desc->idProduct          = LE16(buf + 10);
-    dev_desc->bcdDevice          = LE16(buf + 12);
-    dev_desc->iManufacturer      = *(uint8_t *)(buf + 14);
-    dev_desc->iProduct           = *(uint8_t *)(buf + 15);
-    dev_desc->iSerialNumber      = *(uint8_t *)(buf + 16);
-    dev_desc->bNumConfigurations = *(uint8_t *)(buf + 17);
-  }
-}
-
-
-/**
-  * @brief  USBH_ParseCfgDesc
-  *         This function Parses the configuration descriptor
-  * @param  cfg_desc: Configuration Descriptor address
-  * @param  buf: Buffer where the source descriptor is available
-  * @param  length: Length of the descriptor
-  * @retval None
-  */
-static void USBH_ParseCfgDesc(USBH_CfgDescTypeDef *cfg_desc, uint8_t *buf,
-                              uint16_t length)
-{
-  USBH_InterfaceDescTypeDef    *pif ;
-  USBH_EpDescTypeDef           *pep;
-  USBH_DescHeader_t            *pdesc = (USBH_DescHeader_t *)(void *)buf;
-  uint16_t                     ptr;
-  uint8_t                      if_ix = 0U;
-  uint8_t                      ep_ix = 0U;
-
-  pdesc   = (USBH_DescHeader_t *)(void *)buf;
-
-  /* Parse configuration descriptor */
-  cfg_desc->bLength             = *(uint8_t *)(buf + 0);
-  cfg_desc->bDescriptorType     = *(uint8_t *)(buf + 1);
-  cfg_desc->wTotalLength        = LE16(buf + 2);
-  cfg_desc->bNumInterfaces      = *(uint8_t *)(buf + 4);
-  cfg_desc->bConfigurationValue = *(uint8_t *)(buf + 5);
-  cfg_desc->iConfiguration      = *(uint8_t *)(buf + 6);
-  cfg_desc->bmAttributes        = *(uint8_t *)(buf + 7);
-  cfg_desc->bMaxPower           = *(uint8_t *)(buf + 8);
-
-  if (length > USB_CONFIGURATION_DESC_SIZE)
-  {
-    ptr = USB_LEN_CFG_DESC;
-    pif = (USBH_InterfaceDescTypeDef *)0;
-
-    while ((if_ix < USBH_MAX_NUM_INTERFACES) && (ptr < cfg_desc->wTotalLength))
-    {
-      pdesc = USBH_GetNextDesc((uint8_t *)(void *)pdesc, &ptr);
-      if (pdesc->bDescriptorType   == USB_DESC_TYPE_INTERFACE)
-      {
-        pif = &cfg_desc->Itf_Desc[if_ix];
-        USBH_ParseInterfaceDesc(pif, (uint8_t *)(void *)pdesc);
-
-        ep_ix = 0U;
-        pep = (USBH_EpDescTypeDef *)0;
-        while ((ep_ix < pif->bNumEndpoints) && (ptr < cfg_desc->wTotalLength))
-        {
-          pdesc = USBH_GetNextDesc((uint8_t *)(void *)pdesc, &ptr);
-          if (pdesc->bDescriptorType   == USB_DESC_TYPE_ENDPOINT)
-          {
-            pep = &cfg_desc->Itf_Desc[if_ix].Ep_Desc[ep_ix];
-            USBH_ParseEPDesc(pep, (uint8_t *)(void *)pdesc);
-            ep_ix++;
-          }
-        }
-        if_ix++;
-      }
-    }
-  }
-}
-
-
-/**
-  * @brief  USBH_ParseInterfaceDesc
-  *         This function Parses the interface descriptor
-  * @param  if_descriptor : Interface descriptor destination
-  * @param  buf: Buffer where the descriptor data is available
-  * @retval None
-  */
-static void  USBH_ParseInterfaceDesc(USBH_InterfaceDescTypeDef *if_descriptor,
-                                     uint8_t *buf)
-{
-  if_descriptor->bLength            = *(uint8_t *)(buf + 0);
-  if_descriptor->bDescriptorType    = *(uint8_t *)(buf + 1);
-  if_descriptor->bInterfaceNumber   = *(uint8_t *)(buf + 2);
-  if_descriptor->bAlternateSetting  = *(uint8_t *)(buf + 3);
-  if_descriptor->bNumEndpoints      = *(uint8_t *)(buf + 4);
-  if_descriptor->bInterfaceClass    = *(uint8_t *)(buf + 5);
-  if_descriptor->bInterfaceSubClass = *(uint8_t *)(buf + 6);
-  if_descriptor->bInterfaceProtocol = *(uint8_t *)(buf + 7);
-  if_descriptor->iInterface         = *(uint8_t *)(buf + 8);
-}
-
-
-/**
-  * @brief  USBH_ParseEPDesc
-  *         This function Parses the endpoint descriptor
-  * @param  ep_descriptor: Endpoint descriptor destination address
-  * @param  buf: Buffer where the parsed descriptor stored
-  * @retval None
-  */
-static void  USBH_ParseEPDesc(USBH_EpDescTypeDef  *ep_descriptor,
-                              uint8_t *buf)
-{
-  ep_descriptor->bLength          = *(uint8_t *)(buf + 0);
-  ep_descriptor->bDescriptorType  = *(uint8_t *)(buf + 1);
-  ep_descriptor->bEndpointAddress = *(uint8_t *)(buf + 2);
-  ep_descriptor->bmAttributes     = *(uint8_t *)(buf + 3);
-  ep_descriptor->wMaxPacketSize   = LE16(buf + 4);
-  ep_descriptor->bInterval        = *(uint8_t *)(buf + 6);
-}
-
-
-/**
-  * @brief  USBH_ParseStringDesc
-  *         This function Parses the string descriptor
-  * @param  psrc: Source pointer containing the descriptor data
-  * @param  pdest: Destination address pointer
-  * @param  length: Length of the descriptor
-  * @retval None
-  */
-static void USBH_ParseStringDesc(uint8_t *psrc, uint8_t *pdest, uint16_t length)
-{
-  uint16_t strlength;
-  uint16_t idx;
-
-  /* The UNICODE string descriptor is not NULL-terminated. The string length is
-  computed by substracting two from the value of the first byte of the descriptor.
-  */
-
-  /* Check which is lower size, the Size of string or the length of bytes read
-  from the device */
-
-  if (psrc[1] == USB_DESC_TYPE_STRING)
-  {
-    /* Make sure the Descriptor is String Type */
-
-    /* psrc[0] contains Size of Descriptor, subtract 2 to get the length of string */
-    strlength = ((((uint16_t)psrc[0] - 2U) <= length) ? ((uint16_t)psrc[0] - 2U) : length);
-
-    /* Adjust the offset ignoring the String Len and Descriptor type */
-    psrc += 2U;
-
-    for (idx = 0U; idx < strlength; idx += 2U)
-    {
-      /* Copy Only the string and ignore the UNICODE ID, hence add the src */
-      *pdest =  psrc[idx];
-      pdest++;
-    }
-    *pdest = 0U; /* mark end of string */
-  }
-}
-
-
-/**
-  * @brief  USBH_GetNextDesc
-  *         This function return the next descriptor header
-  * @param  buf: Buffer where the cfg descriptor is available
-  * @param  ptr: data pointer inside the cfg descriptor
-  * @retval next header
-  */
-USBH_DescHeader_t  *USBH_GetNextDesc(uint8_t   *pbuf, uint16_t  *ptr)
-{
-  USBH_DescHeader_t  *pnext;
-
-  *ptr += ((USBH_DescHeader_t *)(void *)pbuf)->bLength;
-  pnext = (USBH_DescHeader_t *)(void *)((uint8_t *)(void *)pbuf + \
-                                        ((USBH_DescHeader_t *)(void *)pbuf)->bLength);
-
-  return (pnext);
-}
-
-
-/**
-  * @brief  USBH_CtlReq
-  *         USBH_CtlReq sends a control request and provide the status after
-  *            completion of the request
-  * @param  phost: Host Handle
-  * @param  req: Setup Request Structure
-  * @param  buff: data buffer address to store the response
-  * @param  length: length of the response
-  * @retval USBH Status
-  */
-USBH_StatusTypeDef USBH_CtlReq(USBH_HandleTypeDef *phost, uint8_t *buff,
-                               uint16_t length)
-{
-  USBH_StatusTypeDef status;
-  status = USBH_BUSY;
-
-  switch (phost->RequestState)
-  {
-    case CMD_SEND:
-      /* Start a SETUP transfer */
-      phost->Control.buff = buff;
-      phost->Control.length = length;
-      phost->Control.state = CTRL_SETUP;
-      phost->RequestState = CMD_WAIT;
-      status = USBH_BUSY;
-
-#if (USBH_USE_OS == 1U)
-      phost->os_msg = (uint32_t)USBH_CONTROL_EVENT;
-#if (osCMSIS < 0x20000U)
-      (void)osMessagePut(phost->os_event, phost->os_msg, 0U);
-#else
-      (void)osMessageQueuePut(phost->os_event, &phost->os_msg, 0U, 0U);
-#endif
-#endif
-      break;
-
-    case CMD_WAIT:
-      status = USBH_HandleControl(phost);
-      if ((status == USBH_OK) || (status == USBH_NOT_SUPPORTED))
-      {
-        /* Transaction completed, move control state to idle */
-        phost->RequestState = CMD_SEND;
-        phost->Control.state = CTRL_IDLE;
-      }
-      else if (status == USBH_FAIL)
-      {
-        /* Failure Mode */
-        phost->RequestState = CMD_SEND;
-      }
-      else
-      {
-        /* .. */
-      }
-#if (USBH_USE_OS == 1U)
-      phost->os_msg = (uint32_t)USBH_CONTROL_EVENT;
-#if (osCMSIS < 0x20000U)
-      (void)osMessagePut(phost->os_event, phost->os_msg, 0U);
-#else
-      (void)osMessageQueuePut(phost->os_event, &phost->os_msg, 0U, 0U);
-#endif
-#endif
-      break;
-
-    default:
-      break;
-  }
-  return status;
-}
-
-
-/**
-  * @brief  USBH_HandleControl
-  *         Handles the USB control transfer state machine
-  * @param  phost: Host Handle
-  * @retval USBH Status
-  */
-static USBH_StatusTypeDef USBH_HandleControl(USBH_HandleTypeDef *phost)
-{
-  uint8_t direction;
-  USBH_StatusTypeDef status = USBH_BUSY;
-  USBH_URBStateTypeDef URB_Status = USBH_URB_IDLE;
-
-  switch (phost->Control.state)
-  {
-    case CTRL_SETUP:
-      /* send a SETUP packet */
-      USBH_CtlSendSetup(phost, (uint8_t *)(void *)phost->Control.setup.d8,
-                        phost->Control.pipe_out);
-
-      phost->Control.state = CTRL_SETUP_WAIT;
-      break;
-
-    case CTRL_SETUP_WAIT:
-
-      URB_Status = USBH_LL_GetURBState(phost, phost->Control.pipe_out);
-      /* case SETUP packet sent successfully */
-      if (URB_Status == USBH_URB_DONE)
-      {
-        direction = (phost->Control.setup.b.bmRequestType & USB_REQ_DIR_MASK);
-
-        /* check if there is a data stage */
-        if (phost->Control.setup.b.wLength.w != 0U)
-        {
-          if (direction == USB_D2H)
-          {
-            /* Data Direction is IN */
-            phost->Control.state = CTRL_DATA_IN;
-          }
-          else
-          {
-            /* Data Direction is OUT */
-            phost->Control.state = CTRL_DATA_OUT;
-          }
-        }
-        /* No DATA stage */
-        else
-        {
-          /* If there is No Data Transfer Stage */
-          if (direction == USB_D2H)
-          {
-            /* Data Direction is IN */
-            phost->Control.state = CTRL_STATUS_OUT;
-          }
-          else
-          {
-            /* Data Direction is OUT */
-            phost->Control.state = CTRL_STATUS_IN;
-          }
-        }
-
-#if (USBH_USE_OS == 1U)
-        phost->os_msg = (uint32_t)USBH_CONTROL_EVENT;
-#if (osCMSIS < 0x20000U)
-        (void)osMessagePut(phost->os_event, phost->os_msg, 0U);
-#else
-        (void)osMessageQueuePut(phost->os_event, &phost->os_msg, 0U, 0U);
-#endif
-#endif
-      }
-      else
-      {
-        if ((URB_Status == USBH_URB_ERROR) || (URB_Status == USBH_URB_NOTREADY))
-        {
-          phost->Control.state = CTRL_ERROR;
-
-#if (USBH_USE_OS == 1U)
-          phost->os_msg = (uint32_t)USBH_CONTROL_EVENT;
-#if (osCMSIS < 0x20000U)
-          (void)osMessagePut(phost->os_event, phost->os_msg, 0U);
-#else
-          (void)osMessageQueuePut(phost->os_event, &phost->os_msg, 0U, 0U);
-#endif
-#endif
-        }
-      }
-      break;
-
-    case CTRL_DATA_IN:
-      /* Issue an IN token */
-      phost->Control.timer = (uint16_t)phost->Timer;
-      USBH_CtlReceiveData(phost, phost->Control.buff, phost->Control.length,
-                          phost->Control.pipe_in);
-
-      phost->Control.state = CTRL_DATA_IN_WAIT;
-      break;
-
-    case CTRL_DATA_IN_WAIT:
-
-      URB_Status = USBH_LL_GetURBState(phost, phost->Control.pipe_in);
-
-      /* check is DATA packet transferred successfully */
-      if (URB_Status == USBH_URB_DONE)
-      {
-        phost->Control.state = CTRL_STATUS_OUT;
-
-#if (USBH_USE_OS == 1U)
-        phost->os_msg = (uint32_t)USBH_CONTROL_EVENT;
-#if (osCMSIS < 0x20000U)
-        (void)osMessagePut(phost->os_event, phost->os_msg, 0U);
-#else
-        (void)osMessageQueuePut(phost->os_event, &phost->os_msg, 0U, 0U);
-#endif
-#endif
-      }
-
-      /* manage error cases*/
-      if (URB_Status == USBH_URB_STALL)
-      {
-        /* In stall case, return to previous machine state*/
-        status = USBH_NOT_SUPPORTED;
-
-#if (USBH_USE_OS == 1U)
-        phost->os_msg = (uint32_t)USBH_CONTROL_EVENT;
-#if (osCMSIS < 0x20000U)
-        (void)osMessagePut(phost->os_event, phost->os_msg, 0U);
-#else
-        (void)osMessageQueuePut(phost->os_event, &phost->os_msg, 0U, 0U);
-#endif
-#endif
-      }
-      else
-      {
-        if (URB_Status == USBH_URB_ERROR)
-        {
-          /* Device error */
-          phost->Control.state = CTRL_ERROR;
-
-#if (USBH_USE_OS == 1U)
-          phost->os_msg = (uint32_t)USBH_CONTROL_EVENT;
-#if (osCMSIS < 0x20000U)
-          (void)osMessagePut(phost->os_event, phost->os_msg, 0U);
-#else
-          (void)osMessageQueuePut(phost->os_event, &phost->os_msg, 0U, 0U);
-#endif
-#endif
-        }
-      }
-      break;
-
-    case CTRL_DATA_OUT:
-
-      USBH_CtlSendData(phost, phost->Control.buff, phost->Control.length,
-                       phost->Control.pipe_out, 1U);
-
-      phost->Control.timer = (uint16_t)phost->Timer;
-      phost->Control.state = CTRL_DATA_OUT_WAIT;
-      break;
-
-    case CTRL_DATA_OUT_WAIT:
-
-      URB_Status = USBH_LL_GetURBState(phost, phost->Control.pipe_out);
-
-      if (URB_Status == USBH_URB_DONE)
-      {
-        /* If the Setup Pkt is sent successful, then change the state */
-        phost->Control.state = CTRL_STATUS_IN;
-
-#if (USBH_USE_OS == 1U)
-        phost->os_msg = (uint32_t)USBH_CONTROL_EVENT;
-#if (osCMSIS < 0x20000U)
-        (void)osMessagePut(phost->os_event, phost->os_msg, 0U);
-#else
-        (void)osMessageQueuePut(phost->os_event, &phost->os_msg, 0U, 0U);
-#endif
-#endif
-      }
-
-      /* handle error cases */
-      else if (URB_Status == USBH_URB_STALL)
-      {
-        /* In stall case, return to previous machine state*/
-        phost->Control.state = CTRL_STALLED;
-        status = USBH_NOT_SUPPORTED;
-
-#if (USBH_USE_OS == 1U)
-        phost->os_msg = (uint32_t)USBH_CONTROL_EVENT;
-#if (osCMSIS < 0x20000U)
-        (void)osMessagePut(phost->os_event, phost->os_msg, 0U);
-#else
-        (void)osMessageQueuePut(phost->os_event, &phost->os_msg, 0U, 0U);
-#endif
-#endif
-      }
-      else if (URB_Status == USBH_URB_NOTREADY)
-      {
-        /* Nack received from device */
-        phost->Control.state = CTRL_DATA_OUT;
-
-#if (USBH_USE_OS == 1U)
-        phost->os_msg = (uint32_t)USBH_CONTROL_EVENT;
-#if (osCMSIS < 0x20000U)
-        (void)osMessagePut(phost->os_event, phost->os_msg, 0U);
-#else
-        (void)osMessageQueuePut(phost->os_event, &phost->os_msg, 0U, 0U);
-#endif
-#endif
-      }
-      else
-      {
-        if (URB_Status == USBH_URB_ERROR)
-        {
-          /* device error */
-          phost->Control.state = CTRL_ERROR;
-          status = USBH_FAIL;
-
-#if (USBH_USE_OS == 1U)
-          phost->os_msg = (uint32_t)USBH_CONTROL_EVENT;
-#if (osCMSIS < 0x20000U)
-          (void)osMessagePut(phost->os_event, phost->os_msg, 0U);
-#else
-          (void)osMessageQueuePut(phost->os_event, &phost->os_msg, 0U, 0U);
-#endif
-#endif
-        }
-      }
-      break;
-
-    case CTRL_STATUS_IN:
-      /* Send 0 bytes out packet */
-      USBH_CtlReceiveData(phost, 0U, 0U, phost->Control.pipe_in);
-
-      phost->Control.timer = (uint16_t)phost->Timer;
-      phost->Control.state = CTRL_STATUS_IN_WAIT;
-
-      break;
-
-    case CTRL_STATUS_IN_WAIT:
-
-      URB_Status = USBH_LL_GetURBState(phost, phost->Control.pipe_in);
-
-      if (URB_Status == USBH_URB_DONE)
-      {
-        /* Control transfers completed, Exit the State Machine */
-        phost->Control.state = CTRL_COMPLETE;
-        status = USBH_OK;
-
-#if (USBH_USE_OS == 1U)
-        phost->os_msg = (uint32_t)USBH_CONTROL_EVENT;
-#if (osCMSIS < 0x20000U)
-        (void)osMessagePut(phost->os_event, phost->os_msg, 0U);
-#else
-        (void)osMessageQueuePut(phost->os_event, &phost->os_msg, 0U, 0U);
-#endif
-#endif
-      }
-      else if (URB_Status == USBH_URB_ERROR)
-      {
-        phost->Control.state = CTRL_ERROR;
-
-#if (USBH_USE_OS == 1U)
-        phost->os_msg = (uint32_t)USBH_CONTROL_EVENT;
-#if (osCMSIS < 0x20000U)
-        (void)osMessagePut(phost->os_event, phost->os_msg, 0U);
-#else
-        (void)osMessageQueuePut(phost->os_event, &phost->os_msg, 0U, 0U);
-#endif
-#endif
-      }
-      else
-      {
-        if (URB_Status == USBH_URB_STALL)
-        {
-          /* Control transfers completed, Exit the State Machine */
-          status = USBH_NOT_SUPPORTED;
-
-#if (USBH_USE_OS == 1U)
-          phost->os_msg = (uint32_t)USBH_CONTROL_EVENT;
-#if (osCMSIS < 0x20000U)
-          (void)osMessagePut(phost->os_event, phost->os_msg, 0U);
-#else
-          (void)osMessageQueuePut(phost->os_event, &phost->os_msg, 0U, 0U);
-#endif
-#endif
-        }
-      }
-      break;
-
-    case CTRL_STATUS_OUT:
-      USBH_CtlSendData(phost, 0U, 0U, phost->Control.pipe_out, 1U);
-
-      phost->Control.timer = (uint16_t)phost->Timer;
-      phost->Control.state = CTRL_STATUS_OUT_WAIT;
-      break;
-
-    case CTRL_STATUS_OUT_WAIT:
-      URB_Status = USBH_LL_GetURBState(phost, phost->Control.pipe_out);
-      if (URB_Status == USBH_URB_DONE)
-      {
-        status = USBH_OK;
-        phost->Control.state = CTRL_COMPLETE;
-
-#if (USBH_USE_OS == 1U)
-        phost->os_msg = (uint32_t)USBH_CONTROL_EVENT;
-#if (osCMSIS < 0x20000U)
-        (void)osMessagePut(phost->os_event, phost->os_msg, 0U);
-#else
-        (void)osMessageQueuePut(phost->os_event, &phost->os_msg, 0U, 0U);
-#endif
-#endif
-      }
-      else if (URB_Status == USBH_URB_NOTREADY)
-      {
-        phost->Control.state = CTRL_STATUS_OUT;
-
-#if (USBH_USE_OS == 1U)
-        phost->os_msg = (uint32_t)USBH_CONTROL_EVENT;
-#if (osCMSIS < 0x20000U)
-        (void)osMessagePut(phost->os_event, phost->os_msg, 0U);
-#else
-        (void)osMessageQueuePut(phost->os_event, &phost->os_msg, 0U, 0U);
-#endif
-#endif
-      }
-      else
-      {
-        if (URB_Status == USBH_URB_ERROR)
-        {
-          phost->Control.state = CTRL_ERROR;
-
-#if (USBH_USE_OS == 1U)
-          phost->os_msg = (uint32_t)USBH_CONTROL_EVENT;
-#if (osCMSIS < 0x20000U)
-          (void)osMessagePut(phost->os_event, phost->os_msg, 0U);
-#else
-          (void)osMessageQueuePut(phost->os_event, &phost->os_msg, 0U, 0U);
-#endif
-#endif
-        }
-      }
-      break;
-
-    case CTRL_ERROR:
-      /*
-      After a halt condition is encountered or an error is detected by the
-      host, a control endpoint is allowed to recover by accepting the next Setup
-      PID; i.e., recovery actions via some other pipe are not required for control
-      endpoints. For the Default Control Pipe, a device reset will ultimately be
-      required to clear the halt or error condition if the next Setup PID is not
-      accepted.
-      */
-      if (++phost->Control.errorcount <= USBH_MAX_ERROR_COUNT)
-      {
-        /* Do the transmission again, starting from SETUP Packet */
-        phost->Control.state = CTRL_SETUP;
-        phost->RequestState = CMD_SEND;
-      }
-      else
-      {
-        phost->pUser(phost, HOST_USER_UNRECOVERED_ERROR);
-        phost->Control.errorcount = 0U;
-        USBH_ErrLog("Control error: Device not responding");
-
-        /* Free control pipes */
-        USBH_FreePipe(phost, phost->Control.pipe_out);
-        USBH_FreePipe(phost, phost->Control.pipe_in);
-
-        phost->gState = HOST_IDLE;
-        status = USBH_FAIL;
-      }
-      break;
-
-    default:
-      break;
-  }
-
-  return status;
-}
-
-/**
-* @}
-*/
-
-/**
-* @}
-*/
-
-/**
-* @}
-*/
-
-/**
-* @}
-*/
-
-/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
-
-
-
-
+/**
+  ******************************************************************************
+  * @file    usbh_ctlreq.c
+  * @author  MCD Application Team
+  * @brief   This file implements the control requests for device enumeration
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2015 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under Ultimate Liberty license
+  * SLA0044, the "License"; You may not use this file except in compliance with
+  * the License. You may obtain a copy of the License at:
+  *                      www.st.com/SLA0044
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "usbh_ctlreq.h"
+#include "usbh_desc_cache.h"
+
+/** @addtogroup USBH_LIB
+* @{
+*/
+
+/** @addtogroup USBH_LIB_CORE
+* @{
+*/
+
+/** @defgroup USBH_CTLREQ
+* @brief This file implements the standard requests for device enumeration
+* @{
+*/
+
+
+/** @defgroup USBH_CTLREQ_Private_Defines
+* @{
+*/
+/**
+* @}
+*/
+
+
+/** @defgroup USBH_CTLREQ_Private_TypesDefinitions
+* @{
+*/
+/**
+* @}
+*/
+
+
+
+/** @defgroup USBH_CTLREQ_Private_Macros
+* @{
+*/
+/**
+* @}
+*/
+
+
+/** @defgroup USBH_CTLREQ_Private_Variables
+* @{
+*/
+/**
+* @}
+*/
+
+/** @defgroup USBH_CTLREQ_Private_FunctionPrototypes
+* @{
+*/
+static USBH_StatusTypeDef USBH_HandleControl(USBH_HandleTypeDef *phost);
+
+static void USBH_ParseDevDesc(USBH_DevDescTypeDef *dev_desc,
+                              uint8_t *buf, uint16_t length);
+
+static void USBH_ParseCfgDesc(USBH_CfgDescTypeDef *cfg_desc,
+                              uint8_t *buf, uint16_t length);
+
+static void USBH_ParseEPDesc(USBH_EpDescTypeDef  *ep_descriptor, uint8_t *buf);
+static void USBH_ParseStringDesc(uint8_t *psrc, uint8_t *pdest, uint16_t length);
+static void USBH_ParseInterfaceDesc(USBH_InterfaceDescTypeDef  *if_descriptor, uint8_t *buf);
+static uint8_t *USBH_DescIter_NextInItf(USBH_DescIterTypeDef *iter);
+static void USBH_CtlOpenPipes(USBH_HandleTypeDef *phost);
+static void USBH_CtlDone(USBH_HandleTypeDef *phost);
+static USBH_CtlQueueEntryTypeDef *USBH_CtlSeqAbort(USBH_PortTypeDef *pport,
+                                                   USBH_CtlQueueEntryTypeDef *pentry);
+
+
+/**
+* @}
+*/
+
+
+/** @defgroup USBH_CTLREQ_Private_Functions
+* @{
+*/
+
+
+/**
+  * @brief  USBH_Get_DevDesc
+  *         Issue Get Device Descriptor command to the device. Once the response
+  *         received, it parses the device descriptor and updates the status.
+  * @param  phost: Host Handle
+  * @param  length: Length of the descriptor
+  * @retval USBH Status
+  */
+USBH_StatusTypeDef USBH_Get_DevDesc(USBH_HandleTypeDef *phost, uint8_t length)
+{
+  USBH_StatusTypeDef status;
+
+  if ((status = USBH_GetDescriptor(phost,
+                                   USB_REQ_RECIPIENT_DEVICE | USB_REQ_TYPE_STANDARD,
+                                   USB_DESC_DEVICE, phost->device.Data,
+                                   (uint16_t)length)) == USBH_OK)
+  {
+    /* Commands successfully sent and Response Received */
+    USBH_ParseDevDesc(&phost->device.DevDesc, phost->device.Data,
+                      (uint16_t)length);
+  }
+
+  return status;
+}
+
+
+/**
+  * @brief  USBH_Get_CfgDesc
+  *         Issues Configuration Descriptor to the device. Once the response
+  *         received, it parses the configuration descriptor and updates the
+  *         status.
+  * @param  phost: Host Handle
+  * @param  length: Length of the descriptor
+  * @retval USBH Status
+  */
+USBH_StatusTypeDef USBH_Get_CfgDesc(USBH_HandleTypeDef *phost,
+                                    uint16_t length)
+
+{
+  USBH_StatusTypeDef status;
+  uint8_t *pData = phost->device.CfgDesc_Raw;
+
+  /* Only the first bytes of a longer descriptor are kept, the interfaces
+     past the end are not seen by the classes */
+  if (length > USBH_MAX_SIZE_CONFIGURATION)
+  {
+    length = USBH_MAX_SIZE_CONFIGURATION;
+  }
+
+  if ((status = USBH_GetDescriptor(phost, (USB_REQ_RECIPIENT_DEVICE | USB_REQ_TYPE_STANDARD),
+                                   USB_DESC_CONFIGURATION, pData, length)) == USBH_OK)
+  {
+    /* Commands successfully sent and Response Received  */
+    USBH_ParseCfgDesc(&phost->device.CfgDesc, pData, length);
+  }
+
+  return status;
+}
+
+
+/**
+  * @brief  USBH_Load_CfgDesc
+  *         Parses a configuration descriptor obtained without a request, as
+  *         if it had been read with USBH_Get_CfgDesc.
+  * @param  phost: Host Handle
+  * @param  pdesc: Full configuration descriptor
+  * @param  length: Length of the descriptor
+  * @retval USBH_OK, USBH_FAIL if the descriptor does not fit or is not one
+  */
+USBH_StatusTypeDef USBH_Load_CfgDesc(USBH_HandleTypeDef *phost,
+                                     const uint8_t *pdesc, uint16_t length)
+{
+  if ((length < USB_CONFIGURATION_DESC_SIZE) ||
+      (length > USBH_MAX_SIZE_CONFIGURATION) ||
+      (pdesc[1] != USB_DESC_TYPE_CONFIGURATION) ||
+      (LE16(&pdesc[2]) != length))
+  {
+    return USBH_FAIL;
+  }
+
+  (void)USBH_memcpy(phost->device.CfgDesc_Raw, pdesc, length);
+  USBH_ParseCfgDesc(&phost->device.CfgDesc, phost->device.CfgDesc_Raw, length);
+
+  return USBH_OK;
+}
+
+
+/**
+  * @brief  USBH_Get_StringDesc
+  *         Issues string Descriptor command to the device. Once the response
+  *         received, it parses the string descriptor and updates the status.
+  * @param  phost: Host Handle
+  * @param  string_index: String index for the descriptor
+  * @param  buff: Buffer address for the descriptor
+  * @param  length: Length of the descriptor
+  * @retval USBH Status
+  */
+USBH_StatusTypeDef USBH_Get_StringDesc(USBH_HandleTypeDef *phost,
+                                       uint8_t string_index, uint8_t *buff,
+                                       uint16_t length)
+{
+  USBH_StatusTypeDef status;
+
+  if ((status = USBH_GetDescriptor(phost,
+                                   USB_REQ_RECIPIENT_DEVICE | USB_REQ_TYPE_STANDARD,
+                                   USB_DESC_STRING | string_index,
+                                   phost->device.Data, length)) == USBH_OK)
+  {
+    /* Commands successfully sent and Response Received  */
+#if (USBH_DESC_CACHE_ENTRIES > 0U)
+    USBH_DescCache_PutString(phost, string_index, phost->device.Data);
+#endif
+    USBH_ParseStringDesc(phost->device.Data, buff, length);
+  }
+
+  return status;
+}
+
+
+/**
+  * @brief  USBH_GetDescriptor
+  *         Issues Descriptor command to the device. Once the response received,
+  *         it parses the descriptor and updates the status.
+  * @param  phost: Host Handle
+  * @param  req_type: Descriptor type
+  * @param  value_idx: Value for the GetDescriptr request
+  * @param  buff: Buffer to store the descriptor
+  * @param  length: Length of the descriptor
+  * @retval USBH Status
+  */
+USBH_StatusTypeDef USBH_GetDescriptor(USBH_HandleTypeDef *phost,
+                                      uint8_t  req_type,
+                                      uint16_t value_idx,
+                                      uint8_t *buff,
+                                      uint16_t length)
+{
+  if (phost->RequestState == CMD_SEND)
+  {
+    phost->Control.setup.b.bmRequestType = USB_D2H | req_type;
+    phost->Control.setup.b.bRequest = USB_REQ_GET_DESCRIPTOR;
+    phost->Control.setup.b.wValue.w = value_idx;
+
+    if ((value_idx & 0xff00U) == USB_DESC_STRING)
+    {
+      phost->Control.setup.b.wIndex.w = 0x0409U;
+    }
+    else if ((req_type & 0x03U) == USB_REQ_RECIPIENT_INTERFACE)
+    {
+      /* Class descriptors of the interface of the function */
+      phost->Control.setup.b.wIndex.w = USBH_CURRENT_ITF_NUMBER(phost);
+    }
+    else
+    {
+      phost->Control.setup.b.wIndex.w = 0U;
+    }
+    phost->Control.setup.b.wLength.w = length;
+  }
+
+  return USBH_CtlReq(phost, buff, length);
+}
+
+
+/**
+  * @brief  USBH_SetAddress
+  *         This command sets the address to the connected device
+  * @param  phost: Host Handle
+  * @param  DeviceAddress: Device address to assign
+  * @retval USBH Status
+  */
+USBH_StatusTypeDef USBH_SetAddress(USBH_HandleTypeDef *phost,
+                                   uint8_t DeviceAddress)
+{
+  if (phost->RequestState == CMD_SEND)
+  {
+    phost->Control.setup.b.bmRequestType = USB_H2D | USB_REQ_RECIPIENT_DEVICE | \
+                                           USB_REQ_TYPE_STANDARD;
+
+    phost->Control.setup.b.bRequest = USB_REQ_SET_ADDRESS;
+
+    phost->Control.setup.b.wValue.w = (uint16_t)DeviceAddress;
+    phost->Control.setup.b.wIndex.w = 0U;
+    phost->Control.setup.b.wLength.w = 0U;
+  }
+
+  return USBH_CtlReq(phost, 0U, 0U);
+}
+
+
+/**
+  * @brief  USBH_SetCfg
+  *         The command sets the configuration value to the connected device
+  * @param  phost: Host Handle
+  * @param  cfg_idx: Configuration value
+  * @retval USBH Status
+  */
+USBH_StatusTypeDef USBH_SetCfg(USBH_HandleTypeDef *phost, uint16_t cfg_idx)
+{
+  if (phost->RequestState == CMD_SEND)
+  {
+    phost->Control.setup.b.bmRequestType = USB_H2D | USB_REQ_RECIPIENT_DEVICE
+                                           | USB_REQ_TYPE_STANDARD;
+
+    phost->Control.setup.b.bRequest = USB_REQ_SET_CONFIGURATION;
+    phost->Control.setup.b.wValue.w = cfg_idx;
+    phost->Control.setup.b.wIndex.w = 0U;
+    phost->Control.setup.b.wLength.w = 0U;
+  }
+
+  return USBH_CtlReq(phost, 0U, 0U);
+}
+
+
+/**
+  * @brief  USBH_SetInterface
+  *         The command sets the Interface value to the connected device
+  * @param  phost: Host Handle
+  * @param  altSetting: Interface value
+  * @retval USBH Status
+  */
+USBH_StatusTypeDef USBH_SetInterface(USBH_HandleTypeDef *phost, uint8_t ep_num,
+                                     uint8_t altSetting)
+{
+  if (phost->RequestState == CMD_SEND)
+  {
+    phost->Control.setup.b.bmRequestType = USB_H2D | USB_REQ_RECIPIENT_INTERFACE
+                                           | USB_REQ_TYPE_STANDARD;
+
+    phost->Control.setup.b.bRequest = USB_REQ_SET_INTERFACE;
+    phost->Control.setup.b.wValue.w = altSetting;
+    phost->Control.setup.b.wIndex.w = ep_num;
+    phost->Control.setup.b.wLength.w = 0U;
+  }
+
+  return USBH_CtlReq(phost, 0U, 0U);
+}
+
+
+/**
+  * @brief  USBH_SetFeature
+  *         The command sets the device features (remote wakeup feature,..)
+  * @param  pdev: Selected device
+  * @param  itf_idx
+  * @retval Status
+*/
+USBH_StatusTypeDef USBH_SetFeature(USBH_HandleTypeDef *phost, uint8_t wValue)
+{
+  if (phost->RequestState == CMD_SEND)
+  {
+    phost->Control.setup.b.bmRequestType = USB_H2D | USB_REQ_RECIPIENT_DEVICE
+                                           | USB_REQ_TYPE_STANDARD;
+
+    phost->Control.setup.b.bRequest = USB_REQ_SET_FEATURE;
+    phost->Control.setup.b.wValue.w = wValue;
+    phost->Control.setup.b.wIndex.w = 0U;
+    phost->Control.setup.b.wLength.w = 0U;
+  }
+
+  return USBH_CtlReq(phost, 0U, 0U);
+}
+
+
+/**
+  * @brief  USBH_ClrFeature
+  *         This request is used to clear or disable a specific feature.
+  * @param  phost: Host Handle
+  * @param  ep_num: endpoint number
+  * @param  hc_num: Host channel number
+  * @retval USBH Status
+  */
+USBH_StatusTypeDef USBH_ClrFeature(USBH_HandleTypeDef *phost, uint8_t ep_num)
+{
+  if (phost->RequestState == CMD_SEND)
+  {
+    phost->Control.setup.b.bmRequestType = USB_H2D | USB_REQ_RECIPIENT_ENDPOINT
+                                           | USB_REQ_TYPE_STANDARD;
+
+    phost->Control.setup.b.bRequest = USB_REQ_CLEAR_FEATURE;
+    phost->Control.setup.b.wValue.w = FEATURE_SELECTOR_ENDPOINT;
+    phost->Control.setup.b.wIndex.w = ep_num;
+    phost->Control.setup.b.wLength.w = 0U;
+  }
+  return USBH_CtlReq(phost, 0U, 0U);
+}
+
+
+/**
+  * @brief  USBH_ParseDevDesc
+  *         This function Parses the device descriptor
+  * @param  dev_desc: device_descriptor destination address
+  * @param  buf: Buffer where the source descriptor is available
+  * @param  length: Length of the descriptor
+  * @retval None
+  */
+static void  USBH_ParseDevDesc(USBH_DevDescTypeDef *dev_desc, uint8_t *buf,
+                               uint16_t length)
+{
+  dev_desc->bLength            = *(uint8_t *)(buf +  0);
+  dev_desc->bDescriptorType    = *(uint8_t *)(buf +  1);
+  dev_desc->bcdUSB             = LE16(buf +  2);
+  dev_desc->bDeviceClass       = *(uint8_t *)(buf +  4);
+  dev_desc->bDeviceSubClass    = *(uint8_t *)(buf +  5);
+  dev_desc->bDeviceProtocol    = *(uint8_t *)(buf +  6);
+  dev_desc->bMaxPacketSize     = *(uint8_t *)(buf +  7);
+
+  if (length > 8U)
+  {
+    /* For 1st time after device connection, Host may issue only 8 bytes for
+    Device Descriptor Length  */
+    dev_desc->idVendor           = LE16(buf +  8);
+    dev_desc->idProduct          = LE16(buf + 10);
+    dev_desc->bcdDevice          = LE16(buf + 12);
+    dev_desc->iManufacturer      = *(uint8_t *)(buf + 14);
+    dev_desc->iProduct           = *(uint8_t *)(buf + 15);
+    dev_desc->iSerialNumber      = *(uint8_t *)(buf + 16);
+    dev_desc->bNumConfigurations = *(uint8_t *)(buf + 17);
+  }
+}
+
+
+/**
+  * @brief  USBH_ParseCfgDesc
+  *         This function Parses the configuration descriptor
+  * @param  cfg_desc: Configuration Descriptor address
+  * @param  buf: Buffer where the source descriptor is available
+  * @param  length: Length of the descriptor
+  * @retval None
+  */
+static void USBH_ParseCfgDesc(USBH_CfgDescTypeDef *cfg_desc, uint8_t *buf,
+                              uint16_t length)
+{
+  UNUSED(length);
+
+  /* Parse configuration descriptor, the interfaces and endpoints are read
+     from the raw descriptor with USBH_DescIter_xxx() */
+  cfg_desc->bLength             = *(uint8_t *)(buf + 0);
+  cfg_desc->bDescriptorType     = *(uint8_t *)(buf + 1);
+  cfg_desc->wTotalLength        = LE16(buf + 2);
+  cfg_desc->bNumInterfaces      = *(uint8_t *)(buf + 4);
+  cfg_desc->bConfigurationValue = *(uint8_t *)(buf + 5);
+  cfg_desc->iConfiguration      = *(uint8_t *)(buf + 6);
+  cfg_desc->bmAttributes        = *(uint8_t *)(buf + 7);
+  cfg_desc->bMaxPower           = *(uint8_t *)(buf + 8);
+}
+
+
+/**
+  * @brief  USBH_ParseInterfaceDesc
+  *         This function Parses the interface descriptor
+  * @param  if_descriptor : Interface descriptor destination
+  * @param  buf: Buffer where the descriptor data is available
+  * @retval None
+  */
+static void  USBH_ParseInterfaceDesc(USBH_InterfaceDescTypeDef *if_descriptor,
+                                     uint8_t *buf)
+{
+  if_descriptor->bLength            = *(uint8_t *)(buf + 0);
+  if_descriptor->bDescriptorType    = *(uint8_t *)(buf + 1);
+  if_descriptor->bInterfaceNumber   = *(uint8_t *)(buf + 2);
+  if_descriptor->bAlternateSetting  = *(uint8_t *)(buf + 3);
+  if_descriptor->bNumEndpoints      = *(uint8_t *)(buf + 4);
+  if_descriptor->bInterfaceClass    = *(uint8_t *)(buf + 5);
+  if_descriptor->bInterfaceSubClass = *(uint8_t *)(buf + 6);
+  if_descriptor->bInterfaceProtocol = *(uint8_t *)(buf + 7);
+  if_descriptor->iInterface         = *(uint8_t *)(buf + 8);
+}
+
+
+/**
+  * @brief  USBH_ParseEPDesc
+  *         This function Parses the endpoint descriptor
+  * @param  ep_descriptor: Endpoint descriptor destination address
+  * @param  buf: Buffer where the parsed descriptor stored
+  * @retval None
+  */
+static void  USBH_ParseEPDesc(USBH_EpDescTypeDef  *ep_descriptor,
+                              uint8_t *buf)
+{
+  ep_descriptor->bLength          = *(uint8_t *)(buf + 0);
+  ep_descriptor->bDescriptorType  = *(uint8_t *)(buf + 1);
+  ep_descriptor->bEndpointAddress = *(uint8_t *)(buf + 2);
+  ep_descriptor->bmAttributes     = *(uint8_t *)(buf + 3);
+  ep_descriptor->wMaxPacketSize   = LE16(buf + 4);
+  ep_descriptor->bInterval        = *(uint8_t *)(buf + 6);
+}
+
+
+/**
+  * @brief  USBH_ParseStringDesc
+  *         This function Parses the string descriptor
+  * @param  psrc: Source pointer containing the descriptor data
+  * @param  pdest: Destination address pointer
+  * @param  length: Length of the descriptor
+  * @retval None
+  */
+static void USBH_ParseStringDesc(uint8_t *psrc, uint8_t *pdest, uint16_t length)
+{
+  uint16_t strlength;
+  uint16_t idx;
+
+  /* The UNICODE string descriptor is not NULL-terminated. The string length is
+  computed by substracting two from the value of the first byte of the descriptor.
+  */
+
+  /* Check which is lower size, the Size of string or the length of bytes read
+  from the device */
+
+  if (psrc[1] == USB_DESC_TYPE_STRING)
+  {
+    /* Make sure the Descriptor is String Type */
+
+    /* psrc[0] contains Size of Descriptor, subtract 2 to get the length of string */
+    strlength = ((((uint16_t)psrc[0] - 2U) <= length) ? ((uint16_t)psrc[0] - 2U) : length);
+
+    /* Adjust the offset ignoring the String Len and Descriptor type */
+    psrc += 2U;
+
+    for (idx = 0U; idx < strlength; idx += 2U)
+    {
+      /* Copy Only the string and ignore the UNICODE ID, hence add the src */
+      *pdest =  psrc[idx];
+      pdest++;
+    }
+    *pdest = 0U; /* mark end of string */
+  }
+}
+
+
+/**
+  * @brief  USBH_StringToUTF8
+  *         Converts the UTF-16LE text of a string descriptor to UTF-8.
+  *         Surrogate pairs give one character, a lone surrogate is replaced
+  *         by U+FFFD. The text is cut at a character boundary to fit in size
+  *         bytes, the terminating NUL included.
+  * @param  pdesc: Raw string descriptor
+  * @param  pdest: Destination buffer
+  * @param  size: Size of the destination buffer
+  * @retval Length of the text, NUL excluded
+  */
+uint16_t USBH_StringToUTF8(const uint8_t *pdesc, char *pdest, uint16_t size)
+{
+  uint32_t count;
+  uint32_t idx;
+  uint32_t code;
+  uint32_t low;
+  uint32_t nbytes;
+  uint16_t len = 0U;
+
+  if (size == 0U)
+  {
+    return 0U;
+  }
+
+  if ((pdesc[0] < 2U) || (pdesc[1] != USB_DESC_TYPE_STRING))
+  {
+    pdest[0] = '\0';
+    return 0U;
+  }
+
+  count = ((uint32_t)pdesc[0] - 2U) / 2U;
+
+  for (idx = 0U; idx < count; idx++)
+  {
+    code = LE16(&pdesc[2U + (2U * idx)]);
+
+    if ((code >= 0xD800U) && (code <= 0xDBFFU) && ((idx + 1U) < count))
+    {
+      low = LE16(&pdesc[4U + (2U * idx)]);
+      if ((low >= 0xDC00U) && (low <= 0xDFFFU))
+      {
+        code = 0x10000U + ((code - 0xD800U) << 10) + (low - 0xDC00U);
+        idx++;
+      }
+    }
+
+    if ((code >= 0xD800U) && (code <= 0xDFFFU))
+    {
+      code = 0xFFFDU;
+    }
+
+    if (code < 0x80U)
+    {
+      nbytes = 1U;
+    }
+    else if (code < 0x800U)
+    {
+      nbytes = 2U;
+    }
+    else if (code < 0x10000U)
+    {
+      nbytes = 3U;
+    }
+    else
+    {
+      nbytes = 4U;
+    }
+
+    if (((uint32_t)len + nbytes) >= size)
+    {
+      break;
+    }
+
+    switch (nbytes)
+    {
+      case 1U:
+        pdest[len] = (char)code;
+        break;
+
+      case 2U:
+        pdest[len] = (char)(0xC0U | (code >> 6));
+        pdest[len + 1U] = (char)(0x80U | (code & 0x3FU));
+        break;
+
+      case 3U:
+        pdest[len] = (char)(0xE0U | (code >> 12));
+        pdest[len + 1U] = (char)(0x80U | ((code >> 6) & 0x3FU));
+        pdest[len + 2U] = (char)(0x80U | (code & 0x3FU));
+        break;
+
+      default:
+        pdest[len] = (char)(0xF0U | (code >> 18));
+        pdest[len + 1U] = (char)(0x80U | ((code >> 12) & 0x3FU));
+        pdest[len + 2U] = (char)(0x80U | ((code >> 6) & 0x3FU));
+        pdest[len + 3U] = (char)(0x80U | (code & 0x3FU));
+        break;
+    }
+    len += (uint16_t)nbytes;
+  }
+
+  pdest[len] = '\0';
+
+  return len;
+}
+
+
+/**
+  * @brief  USBH_GetNextDesc
+  *         This function return the next descriptor header
+  * @param  buf: Buffer where the cfg descriptor is available
+  * @param  ptr: data pointer inside the cfg descriptor
+  * @retval next header
+  */
+USBH_DescHeader_t  *USBH_GetNextDesc(uint8_t   *pbuf, uint16_t  *ptr)
+{
+  USBH_DescHeader_t  *pnext;
+
+  *ptr += ((USBH_DescHeader_t *)(void *)pbuf)->bLength;
+  pnext = (USBH_DescHeader_t *)(void *)((uint8_t *)(void *)pbuf + \
+                                        ((USBH_DescHeader_t *)(void *)pbuf)->bLength);
+
+  return (pnext);
+}
+
+
+/**
+  * @brief  USBH_DescIter_Init
+  *         Start a walk of the configuration descriptor of the device, the
+  *         next descriptor returned is the first one after the configuration
+  *         descriptor.
+  * @param  phost: Host Handle
+  * @param  iter: Walk to initialize
+  * @retval None
+  */
+void USBH_DescIter_Init(USBH_HandleTypeDef *phost, USBH_DescIterTypeDef *iter)
+{
+  uint16_t length = phost->device.CfgDesc.wTotalLength;
+
+  iter->pCfg = phost->device.CfgDesc_Raw;
+  iter->Length = (length < USBH_MAX_SIZE_CONFIGURATION) ? length : USBH_MAX_SIZE_CONFIGURATION;
+  iter->Pos = USB_LEN_CFG_DESC;
+  iter->pItf = NULL;
+  iter->ItfIndex = 0xFFU;
+}
+
+
+/**
+  * @brief  USBH_DescIter_Next
+  *         Return the next descriptor of any type. The walk stops at the end
+  *         of the configuration or at a descriptor that does not fit in it.
+  * @param  iter: Walk
+  * @retval Descriptor, NULL at the end of the configuration
+  */
+uint8_t *USBH_DescIter_Next(USBH_DescIterTypeDef *iter)
+{
+  uint8_t *pdesc;
+
+  if ((iter->Pos + 2U) > iter->Length)
+  {
+    return NULL;
+  }
+
+  pdesc = &iter->pCfg[iter->Pos];
+
+  if ((pdesc[0] < 2U) || ((iter->Pos + pdesc[0]) > iter->Length))
+  {
+    /* Malformed, nothing after it can be trusted */
+    iter->Pos = iter->Length;
+    return NULL;
+  }
+
+  iter->Pos += pdesc[0];
+
+  if ((pdesc[1] == USB_DESC_TYPE_INTERFACE) && (pdesc[0] >= USB_INTERFACE_DESC_SIZE))
+  {
+    iter->pItf = pdesc;
+    iter->ItfIndex++;
+  }
+
+  return pdesc;
+}
+
+
+/**
+  * @brief  USBH_DescIter_NextInterface
+  *         Move to the next interface descriptor, every alternate setting
+  *         has its own descriptor.
+  * @param  iter: Walk
+  * @param  pif: Receives the interface descriptor, may be NULL
+  * @retval USBH_OK, USBH_FAIL at the end of the configuration
+  */
+USBH_StatusTypeDef USBH_DescIter_NextInterface(USBH_DescIterTypeDef *iter,
+                                               USBH_InterfaceDescTypeDef *pif)
+{
+  uint8_t *pdesc;
+
+  while ((pdesc = USBH_DescIter_Next(iter)) != NULL)
+  {
+    if (pdesc == iter->pItf)
+    {
+      if (pif != NULL)
+      {
+        USBH_ParseInterfaceDesc(pif, pdesc);
+      }
+      return USBH_OK;
+    }
+  }
+
+  return USBH_FAIL;
+}
+
+
+/**
+  * @brief  USBH_DescIter_SeekInterface
+  *         Restart the walk at an interface descriptor of the device.
+  * @param  phost: Host Handle
+  * @param  iter: Walk
+  * @param  interface: Interface index, as returned by USBH_FindInterface()
+  * @param  pif: Receives the interface descriptor, may be NULL
+  * @retval USBH_OK, USBH_FAIL if the device has no such interface
+  */
+USBH_StatusTypeDef USBH_DescIter_SeekInterface(USBH_HandleTypeDef *phost,
+                                               USBH_DescIterTypeDef *iter,
+                                               uint8_t interface,
+                                               USBH_InterfaceDescTypeDef *pif)
+{
+  USBH_DescIter_Init(phost, iter);
+
+  while (USBH_DescIter_NextInterface(iter, NULL) == USBH_OK)
+  {
+    if (iter->ItfIndex == interface)
+    {
+      if (pif != NULL)
+      {
+        USBH_ParseInterfaceDesc(pif, iter->pItf);
+      }
+      return USBH_OK;
+    }
+  }
+
+  return USBH_FAIL;
+}
+
+
+/**
+  * @brief  USBH_DescIter_NextInItf
+  *         Return the next descriptor of the current interface, without
+  *         moving past the descriptor that starts the next one.
+  * @param  iter: Walk
+  * @retval Descriptor, NULL at the end of the interface
+  */
+static uint8_t *USBH_DescIter_NextInItf(USBH_DescIterTypeDef *iter)
+{
+  uint8_t *pdesc;
+
+  if ((iter->pItf == NULL) || ((iter->Pos + 2U) > iter->Length))
+  {
+    return NULL;
+  }
+
+  pdesc = &iter->pCfg[iter->Pos];
+
+  if ((pdesc[1] == USB_DESC_TYPE_INTERFACE) || (pdesc[1] == USB_DESC_TYPE_IAD))
+  {
+    /* Starts the next interface, left for USBH_DescIter_NextInterface() */
+    return NULL;
+  }
+
+  return USBH_DescIter_Next(iter);
+}
+
+
+/**
+  * @brief  USBH_DescIter_NextEndpoint
+  *         Move to the next endpoint descriptor of the current interface.
+  * @param  iter: Walk
+  * @param  pep: Receives the endpoint descriptor
+  * @retval USBH_OK, USBH_FAIL at the end of the interface
+  */
+USBH_StatusTypeDef USBH_DescIter_NextEndpoint(USBH_DescIterTypeDef *iter,
+                                              USBH_EpDescTypeDef *pep)
+{
+  uint8_t *pdesc;
+
+  while ((pdesc = USBH_DescIter_NextInItf(iter)) != NULL)
+  {
+    if ((pdesc[1] == USB_DESC_TYPE_ENDPOINT) && (pdesc[0] >= USB_ENDPOINT_DESC_SIZE))
+    {
+      USBH_ParseEPDesc(pep, pdesc);
+      return USBH_OK;
+    }
+  }
+
+  return USBH_FAIL;
+}
+
+
+/**
+  * @brief  USBH_DescIter_NextClassDesc
+  *         Move to the next descriptor of a given type in the current
+  *         interface, such as the HID or the CDC functional descriptors.
+  * @param  iter: Walk
+  * @param  type: bDescriptorType to look for
+  * @retval Descriptor, in place in the configuration descriptor, NULL at the
+  *         end of the interface
+  */
+uint8_t *USBH_DescIter_NextClassDesc(USBH_DescIterTypeDef *iter, uint8_t type)
+{
+  uint8_t *pdesc;
+
+  while ((pdesc = USBH_DescIter_NextInItf(iter)) != NULL)
+  {
+    if (pdesc[1] == type)
+    {
+      break;
+    }
+  }
+
+  return pdesc;
+}
+
+
+/**
+  * @brief  USBH_CtlReq
+  *         USBH_CtlReq sends a control request and provide the status after
+  *            completion of the request
+  * @param  phost: Host Handle
+  * @param  req: Setup Request Structure
+  * @param  buff: data buffer address to store the response
+  * @param  length: length of the response
+  * @retval USBH Status
+  */
+USBH_StatusTypeDef USBH_CtlReq(USBH_HandleTypeDef *phost, uint8_t *buff,
+                               uint16_t length)
+{
+  USBH_HandleTypeDef *proot = phost->pRoot;
+  USBH_PortTypeDef *pport = phost->pPort;
+  USBH_StatusTypeDef status;
+  status = USBH_BUSY;
+
+  switch (phost->RequestState)
+  {
+    case CMD_SEND:
+      /* The EP0 pipes of the root port are shared by the devices behind a
+         hub, one control transfer at a time */
+      if ((pport->pCtlOwner != NULL) && (pport->pCtlOwner != phost))
+      {
+        break;
+      }
+      pport->pCtlOwner = phost;
+      USBH_CtlOpenPipes(phost);
+
+      /* Start a SETUP transfer */
+      phost->Control.buff = buff;
+      phost->Control.length = length;
+      phost->Control.state = CTRL_SETUP;
+      phost->Control.errorcount = 0U;
+      phost->Control.timer = phost->Timer;
+      phost->Control.deadline = phost->Timer + USBH_CTL_TIMEOUT;
+      phost->RequestState = CMD_WAIT;
+      status = USBH_BUSY;
+
+#if (USBH_USE_OS == 1U)
+      USBH_OS_PostEvent(phost, USBH_CONTROL_EVENT);
+#endif
+      break;
+
+    case CMD_WAIT:
+      status = USBH_HandleControl(phost);
+      if ((status == USBH_OK) || (status == USBH_NOT_SUPPORTED))
+      {
+        /* Transaction completed, move control state to idle */
+        USBH_CtlDone(phost);
+        phost->RequestState = CMD_SEND;
+        phost->Control.state = CTRL_IDLE;
+        pport->pCtlOwner = NULL;
+      }
+      else if (status == USBH_FAIL)
+      {
+        /* Failure Mode */
+        USBH_CtlDone(phost);
+        phost->RequestState = CMD_SEND;
+        pport->pCtlOwner = NULL;
+      }
+      else if ((phost->Control.state != CTRL_ERROR) &&
+               (phost->Control.state != CTRL_RETRY_WAIT) &&
+               (((phost->Timer - phost->Control.deadline) & 0x80000000U) == 0U))
+      {
+        /* The device NAKs or does not answer: halt the EP0 channels, the
+           retry opens them again */
+        USBH_ErrLog("Control error: request timed out");
+        phost->CtlStats.Timeouts++;
+        (void)USBH_ClosePipe(proot, proot->Control.pipe_in);
+        (void)USBH_ClosePipe(proot, proot->Control.pipe_out);
+        pport->pCtlDevice = NULL;
+        phost->Control.state = CTRL_TIMEOUT;
+      }
+      else
+      {
+        /* .. */
+      }
+#if (USBH_USE_OS == 1U)
+      USBH_OS_PostEvent(phost, USBH_CONTROL_EVENT);
+#endif
+      break;
+
+    default:
+      break;
+  }
+  return status;
+}
+
+
+/**
+  * @brief  USBH_CtlSubmit
+  *         Queue a control request to a device. Requests to one device run in
+  *         submission order, back-to-back, between two requests of its class;
+  *         the callback reports the outcome from USBH_Process. Call it from
+  *         the context running USBH_Process, as the rest of the host API.
+  * @param  phost: Device handle
+  * @param  setup: Setup packet, copied
+  * @param  buff: Data stage buffer, wLength bytes, valid until the callback
+  * @param  Callback: Completion callback, may be NULL
+  * @param  pContext: Passed to the callback
+  * @retval USBH_OK when queued, USBH_BUSY when the queue is full
+  */
+USBH_StatusTypeDef USBH_CtlSubmit(USBH_HandleTypeDef *phost, const USB_Setup_TypeDef *setup,
+                                  uint8_t *buff, USBH_CtlCallbackTypeDef Callback,
+                                  void *pContext)
+{
+  USBH_CtlSeqItemTypeDef item;
+
+  item.setup = *setup;
+  item.buff = buff;
+  item.Flags = 0U;
+
+  return USBH_CtlSubmitSeq(phost, &item, 1U, Callback, pContext);
+}
+
+
+/**
+  * @brief  USBH_CtlSubmitSeq
+  *         Queue a sequence of control requests to a device. They run
+  *         back-to-back on EP0 in array order, a request that fails ends the
+  *         sequence and the callback is called once, with the status of the
+  *         last request run.
+  * @param  phost: Device handle
+  * @param  items: Requests, copied, their buffers valid until the callback
+  * @param  count: Number of requests, at most USBH_CTL_QUEUE_SIZE
+  * @param  Callback: Completion callback, may be NULL
+  * @param  pContext: Passed to the callback
+  * @retval USBH_OK when queued, USBH_BUSY when the queue has not room for
+  *         all of them, USBH_FAIL when count is out of range
+  */
+USBH_StatusTypeDef USBH_CtlSubmitSeq(USBH_HandleTypeDef *phost, const USBH_CtlSeqItemTypeDef *items,
+                                     uint8_t count, USBH_CtlCallbackTypeDef Callback,
+                                     void *pContext)
+{
+  USBH_PortTypeDef *pport = phost->pPort;
+  USBH_CtlQueueEntryTypeDef *pentry;
+  uint32_t idx;
+  uint32_t free = 0U;
+  uint8_t n = 0U;
+
+  if ((count == 0U) || (count > USBH_CTL_QUEUE_SIZE))
+  {
+    return USBH_FAIL;
+  }
+
+  for (idx = 0U; idx < USBH_CTL_QUEUE_SIZE; idx++)
+  {
+    if (pport->CtlQueue[idx].State == USBH_CTL_QUEUE_FREE)
+    {
+      free++;
+    }
+  }
+
+  if (free < count)
+  {
+    return USBH_BUSY;
+  }
+
+  for (idx = 0U; n < count; idx++)
+  {
+    pentry = &pport->CtlQueue[idx];
+
+    if (pentry->State == USBH_CTL_QUEUE_FREE)
+    {
+      pentry->phost = phost;
+      pentry->setup = items[n].setup;
+      pentry->buff = items[n].buff;
+      pentry->Flags = items[n].Flags & USBH_CTL_SEQ_STALL_OK;
+      pentry->Callback = NULL;
+      pentry->pContext = pContext;
+      pentry->Seq = pport->CtlQueueSeq;
+      pport->CtlQueueSeq++;
+      pentry->State = USBH_CTL_QUEUE_WAITING;
+      n++;
+
+      if (n < count)
+      {
+        pentry->Flags |= USBH_CTL_SEQ_MORE;
+      }
+      else
+      {
+        pentry->Callback = Callback;
+      }
+    }
+  }
+
+#if (USBH_USE_OS == 1U)
+  USBH_OS_PostEvent(phost, USBH_CONTROL_EVENT);
+#endif
+
+  return USBH_OK;
+}
+
+
+/**
+  * @brief  USBH_CtlProcess
+  *         Run the queued control requests of a device, called by the core
+  *         while the class of the device starts and runs. A request starts
+  *         when the class has none of its own in progress, the requests of
+  *         a sequence follow each other without returning.
+  * @param  phost: Device handle
+  * @retval USBH_BUSY while a queued request of the device is in progress,
+  *         USBH_OK otherwise
+  */
+USBH_StatusTypeDef USBH_CtlProcess(USBH_HandleTypeDef *phost)
+{
+  USBH_PortTypeDef *pport = phost->pPort;
+  USBH_CtlQueueEntryTypeDef *pentry;
+  USBH_StatusTypeDef status;
+  HOST_StateTypeDef gstate = phost->gState;
+  uint32_t idx;
+
+  for (;;)
+  {
+    pentry = NULL;
+
+    for (idx = 0U; idx < USBH_CTL_QUEUE_SIZE; idx++)
+    {
+      if ((pport->CtlQueue[idx].State != USBH_CTL_QUEUE_FREE) &&
+          (pport->CtlQueue[idx].phost == phost) &&
+          ((pentry == NULL) ||
+           (pport->CtlQueue[idx].State == USBH_CTL_QUEUE_ACTIVE) ||
+           (((pport->CtlQueue[idx].Seq - pentry->Seq) & 0x80000000U) != 0U)))
+      {
+        pentry = &pport->CtlQueue[idx];
+        if (pentry->State == USBH_CTL_QUEUE_ACTIVE)
+        {
+          break;
+        }
+      }
+    }
+
+    if (pentry == NULL)
+    {
+      return USBH_OK;
+    }
+
+    if (pentry->State == USBH_CTL_QUEUE_WAITING)
+    {
+      if (phost->RequestState != CMD_SEND)
+      {
+        return USBH_OK;
+      }
+      phost->Control.setup = pentry->setup;
+      pentry->State = USBH_CTL_QUEUE_ACTIVE;
+
+      /* Claim EP0, then send the SETUP packet in the same pass */
+      status = USBH_CtlReq(phost, pentry->buff, pentry->setup.b.wLength.w);
+      if (phost->RequestState == CMD_SEND)
+      {
+        return status;
+      }
+    }
+
+    status = USBH_CtlReq(phost, pentry->buff, pentry->setup.b.wLength.w);
+
+    if (status == USBH_BUSY)
+    {
+      return USBH_BUSY;
+    }
+
+    if ((status == USBH_FAIL) && (phost->Control.state == CTRL_TIMEOUT))
+    {
+      status = USBH_TIMEOUT;
+    }
+    else if ((status == USBH_NOT_SUPPORTED) && ((pentry->Flags & USBH_CTL_SEQ_STALL_OK) != 0U))
+    {
+      status = USBH_OK;
+    }
+    else
+    {
+      /* .. */
+    }
+
+    pentry->State = USBH_CTL_QUEUE_FREE;
+
+    if ((pentry->Flags & USBH_CTL_SEQ_MORE) != 0U)
+    {
+      if (status == USBH_OK)
+      {
+        /* The next request of the sequence starts right away */
+        continue;
+      }
+
+      /* The rest of the sequence is dropped, its last request holds the
+         callback */
+      pentry = USBH_CtlSeqAbort(pport, pentry);
+    }
+
+    if (pentry->Callback != NULL)
+    {
+      pentry->Callback(phost, status, pentry->pContext);
+    }
+
+    /* A failed request resets the device */
+    if ((status == USBH_FAIL) || (status == USBH_TIMEOUT) ||
+        (phost->gState != gstate))
+    {
+      return USBH_OK;
+    }
+  }
+}
+
+
+/**
+  * @brief  USBH_CtlSeqAbort
+  *         Drop the requests left in a sequence after one of them failed.
+  * @param  pport: Host port
+  * @param  pentry: Request that failed
+  * @retval Last request of the sequence
+  */
+static USBH_CtlQueueEntryTypeDef *USBH_CtlSeqAbort(USBH_PortTypeDef *pport,
+                                                   USBH_CtlQueueEntryTypeDef *pentry)
+{
+  uint32_t seq = pentry->Seq;
+  uint32_t idx;
+
+  while ((pentry->Flags & USBH_CTL_SEQ_MORE) != 0U)
+  {
+    seq++;
+
+    for (idx = 0U; idx < USBH_CTL_QUEUE_SIZE; idx++)
+    {
+      if ((pport->CtlQueue[idx].State == USBH_CTL_QUEUE_WAITING) &&
+          (pport->CtlQueue[idx].Seq == seq))
+      {
+        break;
+      }
+    }
+
+    if (idx == USBH_CTL_QUEUE_SIZE)
+    {
+      break;
+    }
+
+    pentry = &pport->CtlQueue[idx];
+    pentry->State = USBH_CTL_QUEUE_FREE;
+  }
+
+  return pentry;
+}
+
+
+/**
+  * @brief  USBH_CtlFlush
+  *         Drop the queued control requests of a device that is going away,
+  *         their callbacks get USBH_FAIL.
+  * @param  phost: Device handle
+  * @retval None
+  */
+void USBH_CtlFlush(USBH_HandleTypeDef *phost)
+{
+  USBH_CtlQueueEntryTypeDef *pentry;
+  uint32_t idx;
+
+  for (idx = 0U; idx < USBH_CTL_QUEUE_SIZE; idx++)
+  {
+    pentry = &phost->pPort->CtlQueue[idx];
+
+    if ((pentry->State != USBH_CTL_QUEUE_FREE) && (pentry->phost == phost))
+    {
+      pentry->State = USBH_CTL_QUEUE_FREE;
+      if (pentry->Callback != NULL)
+      {
+        pentry->Callback(phost, USBH_FAIL, pentry->pContext);
+      }
+    }
+  }
+}
+
+
+/**
+  * @brief  USBH_HandleControl
+  *         Handles the USB control transfer state machine
+  * @param  phost: Host Handle
+  * @retval USBH Status
+  */
+static USBH_StatusTypeDef USBH_HandleControl(USBH_HandleTypeDef *phost)
+{
+  uint8_t direction;
+  uint32_t delay;
+  USBH_StatusTypeDef status = USBH_BUSY;
+  USBH_URBStateTypeDef URB_Status = USBH_URB_IDLE;
+
+  switch (phost->Control.state)
+  {
+    case CTRL_SETUP:
+      /* send a SETUP packet */
+      USBH_CtlSendSetup(phost, (uint8_t *)(void *)phost->Control.setup.d8,
+                        phost->Control.pipe_out);
+
+      phost->Control.state = CTRL_SETUP_WAIT;
+      break;
+
+    case CTRL_SETUP_WAIT:
+
+      URB_Status = USBH_LL_GetURBState(phost, phost->Control.pipe_out);
+      /* case SETUP packet sent successfully */
+      if (URB_Status == USBH_URB_DONE)
+      {
+        direction = (phost->Control.setup.b.bmRequestType & USB_REQ_DIR_MASK);
+
+        /* check if there is a data stage */
+        if (phost->Control.setup.b.wLength.w != 0U)
+        {
+          if (direction == USB_D2H)
+          {
+            /* Data Direction is IN */
+            phost->Control.state = CTRL_DATA_IN;
+          }
+          else
+          {
+            /* Data Direction is OUT */
+            phost->Control.state = CTRL_DATA_OUT;
+          }
+        }
+        /* No DATA stage */
+        else
+        {
+          /* If there is No Data Transfer Stage */
+          if (direction == USB_D2H)
+          {
+            /* Data Direction is IN */
+            phost->Control.state = CTRL_STATUS_OUT;
+          }
+          else
+          {
+            /* Data Direction is OUT */
+            phost->Control.state = CTRL_STATUS_IN;
+          }
+        }
+
+#if (USBH_USE_OS == 1U)
+        USBH_OS_PostEvent(phost, USBH_CONTROL_EVENT);
+#endif
+      }
+      else
+      {
+        if ((URB_Status == USBH_URB_ERROR) || (URB_Status == USBH_URB_NOTREADY))
+        {
+          phost->Control.state = CTRL_ERROR;
+
+#if (USBH_USE_OS == 1U)
+          USBH_OS_PostEvent(phost, USBH_CONTROL_EVENT);
+#endif
+        }
+      }
+      break;
+
+    case CTRL_DATA_IN:
+      /* Issue an IN token */
+      USBH_CtlReceiveData(phost, phost->Control.buff, phost->Control.length,
+                          phost->Control.pipe_in);
+
+      phost->Control.state = CTRL_DATA_IN_WAIT;
+      break;
+
+    case CTRL_DATA_IN_WAIT:
+
+      URB_Status = USBH_LL_GetURBState(phost, phost->Control.pipe_in);
+
+      /* check is DATA packet transferred successfully */
+      if (URB_Status == USBH_URB_DONE)
+      {
+        phost->Control.state = CTRL_STATUS_OUT;
+
+#if (USBH_USE_OS == 1U)
+        USBH_OS_PostEvent(phost, USBH_CONTROL_EVENT);
+#endif
+      }
+
+      /* manage error cases*/
+      if (URB_Status == USBH_URB_STALL)
+      {
+        /* In stall case, return to previous machine state*/
+        status = USBH_NOT_SUPPORTED;
+
+#if (USBH_USE_OS == 1U)
+        USBH_OS_PostEvent(phost, USBH_CONTROL_EVENT);
+#endif
+      }
+      else
+      {
+        if (URB_Status == USBH_URB_ERROR)
+        {
+          /* Device error */
+          phost->Control.state = CTRL_ERROR;
+
+#if (USBH_USE_OS == 1U)
+          USBH_OS_PostEvent(phost, USBH_CONTROL_EVENT);
+#endif
+        }
+      }
+      break;
+
+    case CTRL_DATA_OUT:
+
+      USBH_CtlSendData(phost, phost->Control.buff, phost->Control.length,
+                       phost->Control.pipe_out, 1U);
+
+      phost->Control.state = CTRL_DATA_OUT_WAIT;
+      break;
+
+    case CTRL_DATA_OUT_WAIT:
+
+      URB_Status = USBH_LL_GetURBState(phost, phost->Control.pipe_out);
+
+      if (URB_Status == USBH_URB_DONE)
+      {
+        /* If the Setup Pkt is sent successful, then change the state */
+        phost->Control.state = CTRL_STATUS_IN;
+
+#if (USBH_USE_OS == 1U)
+        USBH_OS_PostEvent(phost, USBH_CONTROL_EVENT);
+#endif
+      }
+
+      /* handle error cases */
+      else if (URB_Status == USBH_URB_STALL)
+      {
+        /* In stall case, return to previous machine state*/
+        phost->Control.state = CTRL_STALLED;
+        status = USBH_NOT_SUPPORTED;
+
+#if (USBH_USE_OS == 1U)
+        USBH_OS_PostEvent(phost, USBH_CONTROL_EVENT);
+#endif
+      }
+      else if (URB_Status == USBH_URB_NOTREADY)
+      {
+        /* Nack received from device */
+        phost->Control.state = CTRL_DATA_OUT;
+
+#if (USBH_USE_OS == 1U)
+        USBH_OS_PostEvent(phost, USBH_CONTROL_EVENT);
+#endif
+      }
+      else
+      {
+        if (URB_Status == USBH_URB_ERROR)
+        {
+          /* device error */
+          phost->Control.state = CTRL_ERROR;
+          status = USBH_FAIL;
+
+#if (USBH_USE_OS == 1U)
+          USBH_OS_PostEvent(phost, USBH_CONTROL_EVENT);
+#endif
+        }
+      }
+      break;
+
+    case CTRL_STATUS_IN:
+      /* Send 0 bytes out packet */
+      USBH_CtlReceiveData(phost, 0U, 0U, phost->Control.pipe_in);
+
+      phost->Control.state = CTRL_STATUS_IN_WAIT;
+
+      break;
+
+    case CTRL_STATUS_IN_WAIT:
+
+      URB_Status = USBH_LL_GetURBState(phost, phost->Control.pipe_in);
+
+      if (URB_Status == USBH_URB_DONE)
+      {
+        /* Control transfers completed, Exit the State Machine */
+        phost->Control.state = CTRL_COMPLETE;
+        status = USBH_OK;
+
+#if (USBH_USE_OS == 1U)
+        USBH_OS_PostEvent(phost, USBH_CONTROL_EVENT);
+#endif
+      }
+      else if (URB_Status == USBH_URB_ERROR)
+      {
+        phost->Control.state = CTRL_ERROR;
+
+#if (USBH_USE_OS == 1U)
+        USBH_OS_PostEvent(phost, USBH_CONTROL_EVENT);
+#endif
+      }
+      else
+      {
+        if (URB_Status == USBH_URB_STALL)
+        {
+          /* Control transfers completed, Exit the State Machine */
+          status = USBH_NOT_SUPPORTED;
+
+#if (USBH_USE_OS == 1U)
+          USBH_OS_PostEvent(phost, USBH_CONTROL_EVENT);
+#endif
+        }
+      }
+      break;
+
+    case CTRL_STATUS_OUT:
+      USBH_CtlSendData(phost, 0U, 0U, phost->Control.pipe_out, 1U);
+
+      phost->Control.state = CTRL_STATUS_OUT_WAIT;
+      break;
+
+    case CTRL_STATUS_OUT_WAIT:
+      URB_Status = USBH_LL_GetURBState(phost, phost->Control.pipe_out);
+      if (URB_Status == USBH_URB_DONE)
+      {
+        status = USBH_OK;
+        phost->Control.state = CTRL_COMPLETE;
+
+#if (USBH_USE_OS == 1U)
+        USBH_OS_PostEvent(phost, USBH_CONTROL_EVENT);
+#endif
+      }
+      else if (URB_Status == USBH_URB_NOTREADY)
+      {
+        phost->Control.state = CTRL_STATUS_OUT;
+
+#if (USBH_USE_OS == 1U)
+        USBH_OS_PostEvent(phost, USBH_CONTROL_EVENT);
+#endif
+      }
+      else
+      {
+        if (URB_Status == USBH_URB_ERROR)
+        {
+          phost->Control.state = CTRL_ERROR;
+
+#if (USBH_USE_OS == 1U)
+          USBH_OS_PostEvent(phost, USBH_CONTROL_EVENT);
+#endif
+        }
+      }
+      break;
+
+    case CTRL_ERROR:
+    case CTRL_TIMEOUT:
+      /*
+      After a halt condition is encountered or an error is detected by the
+      host, a control endpoint is allowed to recover by accepting the next Setup
+      PID; i.e., recovery actions via some other pipe are not required for control
+      endpoints. For the Default Control Pipe, a device reset will ultimately be
+      required to clear the halt or error condition if the next Setup PID is not
+      accepted.
+      */
+      if (++phost->Control.errorcount <= USBH_MAX_ERROR_COUNT)
+      {
+        /* Do the transmission again after a delay doubled at each retry,
+           starting from SETUP Packet */
+        delay = (uint32_t)USBH_CTL_RETRY_DELAY << (phost->Control.errorcount - 1U);
+        if (delay > USBH_CTL_RETRY_DELAY_MAX)
+        {
+          delay = USBH_CTL_RETRY_DELAY_MAX;
+        }
+        phost->Control.deadline = phost->Timer + delay;
+        phost->Control.state = CTRL_RETRY_WAIT;
+        phost->CtlStats.Retries++;
+      }
+      else
+      {
+        phost->pUser(phost, HOST_USER_UNRECOVERED_ERROR);
+        phost->Control.errorcount = 0U;
+        phost->CtlStats.Aborts++;
+        USBH_ErrLog("Control error: Device not responding");
+
+        /* Free control pipes, unless they are shared with the root port */
+        if (phost->pRoot == phost)
+        {
+          USBH_FreePipe(phost, phost->Control.pipe_out);
+          USBH_FreePipe(phost, phost->Control.pipe_in);
+        }
+
+        if ((phost->gState == HOST_CLASS) && (phost->pRoot == phost))
+        {
+          /* Restart the running device from its port reset, the class is
+             stopped as on a disconnection */
+          (void)USBH_ReEnumerate(phost);
+        }
+        else
+        {
+          phost->gState = HOST_IDLE;
+        }
+        status = USBH_FAIL;
+      }
+      break;
+
+    case CTRL_RETRY_WAIT:
+      if (((phost->Timer - phost->Control.deadline) & 0x80000000U) == 0U)
+      {
+        USBH_CtlOpenPipes(phost);
+        phost->Control.deadline = phost->Timer + USBH_CTL_TIMEOUT;
+        phost->Control.state = CTRL_SETUP;
+
+#if (USBH_USE_OS == 1U)
+        USBH_OS_PostEvent(phost, USBH_CONTROL_EVENT);
+#endif
+      }
+      break;
+
+    default:
+      break;
+  }
+
+  return status;
+}
+
+
+/**
+  * @brief  USBH_CtlOpenPipes
+  *         Open the EP0 pipes of the root port for the device, unless they
+  *         already address it.
+  * @param  phost: Host Handle
+  * @retval None
+  */
+static void USBH_CtlOpenPipes(USBH_HandleTypeDef *phost)
+{
+
+  if (phost->pPort->pCtlDevice != phost)
+  {
+    (void)USBH_OpenPipe(phost, phost->Control.pipe_in, 0x80U,
+                        phost->device.address, phost->device.speed,
+                        USBH_EP_CONTROL, (uint16_t)phost->Control.pipe_size);
+
+    (void)USBH_OpenPipe(phost, phost->Control.pipe_out, 0x00U,
+                        phost->device.address, phost->device.speed,
+                        USBH_EP_CONTROL, (uint16_t)phost->Control.pipe_size);
+
+    phost->pPort->pCtlDevice = phost;
+  }
+}
+
+
+/**
+  * @brief  USBH_CtlDone
+  *         Account for a control transfer that ended.
+  * @param  phost: Host Handle
+  * @retval None
+  */
+static void USBH_CtlDone(USBH_HandleTypeDef *phost)
+{
+  uint32_t time = phost->Timer - phost->Control.timer;
+
+  phost->CtlStats.Requests++;
+  if (time > phost->CtlStats.MaxTime)
+  {
+    phost->CtlStats.MaxTime = time;
+  }
+}
+
+/**
+* @}
+*/
+
+/**
+* @}
+*/
+
+/**
+* @}
+*/
+
+/**
+* @}
+*/
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
+
+
+
+
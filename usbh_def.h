@@ -1,500 +1,864 @@
-/**
-  ******************************************************************************
-  * @file    usbh_def.h
-  * @author  MCD Application Team
-  * @brief   Definitions used in the USB host library
-  ******************************************************************************
-  * @attention
-  *
-  * <h2><center>&copy; Copyright (c) 2015 STMicroelectronics.
-  * All rights reserved.</center></h2>
-  *
-  * This software component is licensed by ST under Ultimate Liberty license
-  * SLA0044, the "License"; You may not use this file except in compliance with
-  * the License. You may obtain a copy of the License at:
-  *                      www.st.com/SLA0044
-  *
-  ******************************************************************************
-  */
-
-/* Define to prevent recursive  ----------------------------------------------*/
-#ifndef  USBH_DEF_H
-#define  USBH_DEF_H
-
-#ifdef __cplusplus
-extern "C" {
-#endif
-
-/* Includes ------------------------------------------------------------------*/
-#include "usbh_conf.h"
-
-/** @addtogroup USBH_LIB
-  * @{
-  */
-
-/** @addtogroup USBH_LIB_CORE
-* @{
-*/
-
-/** @defgroup USBH_DEF
-  * @brief This file is includes USB descriptors
-  * @{
-  */
-
-#ifndef NULL
-#define NULL  0U
-#endif
-
-#ifndef FALSE
-#define FALSE 0U
-#endif
-
-#ifndef TRUE
-#define TRUE  1U
-#endif
-
-#ifndef USBH_DEV_RESET_TIMEOUT
-#define USBH_DEV_RESET_TIMEOUT                        1000U
-#endif
-
-#define ValBit(VAR,POS)                               (VAR & (1 << POS))
-#define SetBit(VAR,POS)                               (VAR |= (1 << POS))
-#define ClrBit(VAR,POS)                               (VAR &= ((1 << POS)^255))
-
-#define LE16(addr)        (((uint16_t)(addr)[0]) | \
-                           ((uint16_t)(((uint32_t)(addr)[1]) << 8)))
-
-#define LE24(addr)        (((uint32_t)(addr)[0]) | \
-                           (((uint32_t)(addr)[1]) << 8) | \
-                           (((uint32_t)(addr)[2]) << 16))
-
-#define LE32(addr)        (((uint32_t)(addr)[0]) | \
-                           (((uint32_t)(addr)[1]) << 8) | \
-                           (((uint32_t)(addr)[2]) << 16) | \
-                           (((uint32_t)(addr)[3]) << 24))
-
-#define LE64(addr)        (((uint64_t)(addr)[0]) | \
-                           (((uint64_t)(addr)[1]) << 8) | \
-                           (((uint64_t)(addr)[2]) << 16) | \
-                           (((uint64_t)(addr)[3]) << 24) | \
-                           (((uint64_t)(addr)[4]) << 32) | \
-                           (((uint64_t)(addr)[5]) << 40) | \
-                           (((uint64_t)(addr)[6]) << 48) | \
-                           (((uint64_t)(addr)[7]) << 56))
-
-#define LE16S(addr)       ((int16_t)(LE16((addr))))
-#define LE24S(addr)       ((int32_t)(LE24((addr))))
-#define LE32S(addr)       ((int32_t)(LE32((addr))))
-#define LE64S(addr)       ((int64_t)(LE64((addr))))
-
-
-
-#define  USB_LEN_DESC_HDR                                  0x02U
-#define  USB_LEN_DEV_DESC                                  0x12U
-#define  USB_LEN_CFG_DESC                                  0x09U
-#define  USB_LEN_IF_DESC                                   0x09U
-#define  USB_LEN_EP_DESC                                   0x07U
-#define  USB_LEN_OTG_DESC                                  0x03U
-#define  USB_LEN_SETUP_PKT                                 0x08U
-
-/* bmRequestType :D7 Data Phase Transfer Direction  */
-#define  USB_REQ_DIR_MASK                                  0x80U
-#define  USB_H2D                                           0x00U
-#define  USB_D2H                                           0x80U
-
-/* bmRequestType D6..5 Type */
-#define  USB_REQ_TYPE_STANDARD                             0x00U
-#define  USB_REQ_TYPE_CLASS                                0x20U
-#define  USB_REQ_TYPE_VENDOR                               0x40U
-#define  USB_REQ_TYPE_RESERVED                             0x60U
-
-/* bmRequestType D4..0 Recipient */
-#define  USB_REQ_RECIPIENT_DEVICE                          0x00U
-#define  USB_REQ_RECIPIENT_INTERFACE                       0x01U
-#define  USB_REQ_RECIPIENT_ENDPOINT                        0x02U
-#define  USB_REQ_RECIPIENT_OTHER                           0x03U
-
-/* Table 9-4. Standard Request Codes  */
-/* bRequest , Value */
-#define  USB_REQ_GET_STATUS                                0x00U
-#define  USB_REQ_CLEAR_FEATURE                             0x01U
-#define  USB_REQ_SET_FEATURE                               0x03U
-#define  USB_REQ_SET_ADDRESS                               0x05U
-#define  USB_REQ_GET_DESCRIPTOR                            0x06U
-#define  USB_REQ_SET_DESCRIPTOR                            0x07U
-#define  USB_REQ_GET_CONFIGURATION                         0x08U
-#define  USB_REQ_SET_CONFIGURATION                         0x09U
-#define  USB_REQ_GET_INTERFACE                             0x0AU
-#define  USB_REQ_SET_INTERFACE                             0x0BU
-#define  USB_REQ_SYNCH_FRAME                               0x0CU
-
-/* Table 9-5. Descriptor Types of USB Specifications */
-#define  USB_DESC_TYPE_DEVICE                              0x01U
-#define  USB_DESC_TYPE_CONFIGURATION                       0x02U
-#define  USB_DESC_TYPE_STRING                              0x03U
-#define  USB_DESC_TYPE_INTERFACE                           0x04U
-#define  USB_DESC_TYPE_ENDPOINT                            0x05U
-#define  USB_DESC_TYPE_DEVICE_QUALIFIER                    0x06U
-#define  USB_DESC_TYPE_OTHER_SPEED_CONFIGURATION           0x07U
-#define  USB_DESC_TYPE_INTERFACE_POWER                     0x08U
-#define  USB_DESC_TYPE_HID                                 0x21U
-#define  USB_DESC_TYPE_HID_REPORT                          0x22U
-
-
-#define USB_DEVICE_DESC_SIZE                               0x12U
-#define USB_CONFIGURATION_DESC_SIZE                        0x09U
-#define USB_HID_DESC_SIZE                                  0x09U
-#define USB_INTERFACE_DESC_SIZE                            0x09U
-#define USB_ENDPOINT_DESC_SIZE                             0x07U
-
-/* Descriptor Type and Descriptor Index  */
-/* Use the following values when calling the function USBH_GetDescriptor  */
-#define  USB_DESC_DEVICE                    ((USB_DESC_TYPE_DEVICE << 8) & 0xFF00U)
-#define  USB_DESC_CONFIGURATION             ((USB_DESC_TYPE_CONFIGURATION << 8) & 0xFF00U)
-#define  USB_DESC_STRING                    ((USB_DESC_TYPE_STRING << 8) & 0xFF00U)
-#define  USB_DESC_INTERFACE                 ((USB_DESC_TYPE_INTERFACE << 8) & 0xFF00U)
-#define  USB_DESC_ENDPOINT                  ((USB_DESC_TYPE_INTERFACE << 8) & 0xFF00U)
-#define  USB_DESC_DEVICE_QUALIFIER          ((USB_DESC_TYPE_DEVICE_QUALIFIER << 8) & 0xFF00U)
-#define  USB_DESC_OTHER_SPEED_CONFIGURATION ((USB_DESC_TYPE_OTHER_SPEED_CONFIGURATION << 8) & 0xFF00U)
-#define  USB_DESC_INTERFACE_POWER           ((USB_DESC_TYPE_INTERFACE_POWER << 8) & 0xFF00U)
-#define  USB_DESC_HID_REPORT                ((USB_DESC_TYPE_HID_REPORT << 8) & 0xFF00U)
-#define  USB_DESC_HID                       ((USB_DESC_TYPE_HID << 8) & 0xFF00U)
-
-
-#define  USB_EP_TYPE_CTRL                                  0x00U
-#define  USB_EP_TYPE_ISOC                                  0x01U
-#define  USB_EP_TYPE_BULK                                  0x02U
-#define  USB_EP_TYPE_INTR                                  0x03U
-
-#define  USB_EP_DIR_OUT                                    0x00U
-#define  USB_EP_DIR_IN                                     0x80U
-#define  USB_EP_DIR_MSK                                    0x80U
-
-#ifndef USBH_MAX_PIPES_NBR
-#define USBH_MAX_PIPES_NBR                                15U
-#endif /* USBH_MAX_PIPES_NBR */
-
-#define USBH_DEVICE_ADDRESS_DEFAULT                        0x00U
-#define USBH_DEVICE_ADDRESS                                0x01U
-
-#define USBH_MAX_ERROR_COUNT                               0x02U
-
-#if (USBH_USE_OS == 1U)
-#define MSGQUEUE_OBJECTS                                   10
-#endif
-
-
-/**
-  * @}
-  */
-
-
-#define USBH_CONFIGURATION_DESCRIPTOR_SIZE (USB_CONFIGURATION_DESC_SIZE \
-                                           + USB_INTERFACE_DESC_SIZE\
-                                           + (USBH_MAX_NUM_ENDPOINTS * USB_ENDPOINT_DESC_SIZE))
-
-
-#define CONFIG_DESC_wTOTAL_LENGTH (ConfigurationDescriptorData.ConfigDescfield.\
-                                          ConfigurationDescriptor.wTotalLength)
-
-
-typedef union
-{
-  uint16_t w;
-  struct BW
-  {
-    uint8_t msb;
-    uint8_t lsb;
-  }
-  bw;
-}
-uint16_t_uint8_t;
-
-
-typedef union _USB_Setup
-{
-  uint32_t d8[2];
-
-  struct _SetupPkt_Struc
-  {
-    uint8_t           bmRequestType;
-    uint8_t           bRequest;
-    uint16_t_uint8_t  wValue;
-    uint16_t_uint8_t  wIndex;
-    uint16_t_uint8_t  wLength;
-  } b;
-}
-USB_Setup_TypeDef;
-
-typedef  struct  _DescHeader
-{
-  uint8_t  bLength;
-  uint8_t  bDescriptorType;
-}
-USBH_DescHeader_t;
-
-typedef struct _DeviceDescriptor
-{
-  uint8_t   bLength;
-  uint8_t   bDescriptorType;
-  uint16_t  bcdUSB;        /* USB Specification Number which device complies too */
-  uint8_t   bDeviceClass;
-  uint8_t   bDeviceSubClass;
-  uint8_t   bDeviceProtocol;
-  /* If equal to Zero, each interface specifies its own class
-  code if equal to 0xFF, the class code is vendor specified.
-  Otherwise field is valid Class Code.*/
-  uint8_t   bMaxPacketSize;
-  uint16_t  idVendor;      /* Vendor ID (Assigned by USB Org) */
-  uint16_t  idProduct;     /* Product ID (Assigned by Manufacturer) */
-  uint16_t  bcdDevice;     /* Device Release Number */
-  uint8_t   iManufacturer;  /* Index of Manufacturer String Descriptor */
-  uint8_t   iProduct;       /* Index of Product String Descriptor */
-  uint8_t   iSerialNumber;  /* Index of Serial Number String Descriptor */
-  uint8_t   bNumConfigurations; /* Number of Possible Configurations */
-}
-USBH_DevDescTypeDef;
-
-typedef struct _EndpointDescriptor
-{
-  uint8_t   bLength;
-  uint8_t   bDescriptorType;
-  uint8_t   bEndpointAddress;   /* indicates what endpoint this descriptor is describing */
-  uint8_t   bmAttributes;       /* specifies the transfer type. */
-  uint16_t  wMaxPacketSize;    /* Maximum Packet Size this endpoint is capable of sending or receiving */
-  uint8_t   bInterval;          /* is used to specify the polling interval of certain transfers. */
-}
-USBH_EpDescTypeDef;
-
-typedef struct _InterfaceDescriptor
-{
-  uint8_t bLength;
-  uint8_t bDescriptorType;
-  uint8_t bInterfaceNumber;
-  uint8_t bAlternateSetting;    /* Value used to select alternative setting */
-  uint8_t bNumEndpoints;        /* Number of Endpoints used for this interface */
-  uint8_t bInterfaceClass;      /* Class Code (Assigned by USB Org) */
-  uint8_t bInterfaceSubClass;   /* Subclass Code (Assigned by USB Org) */
-  uint8_t bInterfaceProtocol;   /* Protocol Code */
-  uint8_t iInterface;           /* Index of String Descriptor Describing this interface */
-  USBH_EpDescTypeDef               Ep_Desc[USBH_MAX_NUM_ENDPOINTS];
-}
-USBH_InterfaceDescTypeDef;
-
-
-typedef struct _ConfigurationDescriptor
-{
-  uint8_t   bLength;
-  uint8_t   bDescriptorType;
-  uint16_t  wTotalLength;        /* Total Length of Data Returned */
-  uint8_t   bNumInterfaces;       /* Number of Interfaces */
-  uint8_t   bConfigurationValue;  /* Value to use as an argument to select this configuration*/
-  uint8_t   iConfiguration;       /*Index of String Descriptor Describing this configuration */
-  uint8_t   bmAttributes;         /* D7 Bus Powered , D6 Self Powered, D5 Remote Wakeup , D4..0 Reserved (0)*/
-  uint8_t   bMaxPower;            /*Maximum Power Consumption */
-  USBH_InterfaceDescTypeDef        Itf_Desc[USBH_MAX_NUM_INTERFACES];
-}
-USBH_CfgDescTypeDef;
-
-
-/* Following USB Host status */
-typedef enum
-{
-  USBH_OK = 0,
-  USBH_BUSY,
-  USBH_FAIL,
-  USBH_NOT_SUPPORTED,
-  USBH_UNRECOVERED_ERROR,
-  USBH_ERROR_SPEED_UNKNOWN,
-} USBH_StatusTypeDef;
-
-
-/** @defgroup USBH_CORE_Exported_Types
-  * @{
-  */
-
-typedef enum
-{
-  USBH_SPEED_HIGH  = 0U,
-  USBH_SPEED_FULL  = 1U,
-  USBH_SPEED_LOW   = 2U,
-
-} USBH_SpeedTypeDef;
-
-/* Following states are used for gState */
-typedef enum
-{
-  HOST_IDLE = 0U,
-  HOST_DEV_WAIT_FOR_ATTACHMENT,
-  HOST_DEV_ATTACHED,
-  HOST_DEV_DISCONNECTED,
-  HOST_DETECT_DEVICE_SPEED,
-  HOST_ENUMERATION,
-  HOST_CLASS_REQUEST,
-  HOST_INPUT,
-  HOST_SET_CONFIGURATION,
-  HOST_SET_WAKEUP_FEATURE,
-  HOST_CHECK_CLASS,
-  HOST_CLASS,
-  HOST_SUSPENDED,
-  HOST_ABORT_STATE,
-} HOST_StateTypeDef;
-
-/* Following states are used for EnumerationState */
-typedef enum
-{
-  ENUM_IDLE = 0U,
-  ENUM_GET_FULL_DEV_DESC,
-  ENUM_SET_ADDR,
-  ENUM_GET_CFG_DESC,
-  ENUM_GET_FULL_CFG_DESC,
-  ENUM_GET_MFC_STRING_DESC,
-  ENUM_GET_PRODUCT_STRING_DESC,
-  ENUM_GET_SERIALNUM_STRING_DESC,
-} ENUM_StateTypeDef;
-
-/* Following states are used for CtrlXferStateMachine */
-typedef enum
-{
-  CTRL_IDLE = 0U,
-  CTRL_SETUP,
-  CTRL_SETUP_WAIT,
-  CTRL_DATA_IN,
-  CTRL_DATA_IN_WAIT,
-  CTRL_DATA_OUT,
-  CTRL_DATA_OUT_WAIT,
-  CTRL_STATUS_IN,
-  CTRL_STATUS_IN_WAIT,
-  CTRL_STATUS_OUT,
-  CTRL_STATUS_OUT_WAIT,
-  CTRL_ERROR,
-  CTRL_STALLED,
-  CTRL_COMPLETE
-} CTRL_StateTypeDef;
-
-
-/* Following states are used for RequestState */
-typedef enum
-{
-  CMD_IDLE = 0U,
-  CMD_SEND,
-  CMD_WAIT
-} CMD_StateTypeDef;
-
-typedef enum
-{
-  USBH_URB_IDLE = 0U,
-  USBH_URB_DONE,
-  USBH_URB_NOTREADY,
-  USBH_URB_NYET,
-  USBH_URB_ERROR,
-  USBH_URB_STALL
-} USBH_URBStateTypeDef;
-
-typedef enum
-{
-  USBH_PORT_EVENT = 1U,
-  USBH_URB_EVENT,
-  USBH_CONTROL_EVENT,
-  USBH_CLASS_EVENT,
-  USBH_STATE_CHANGED_EVENT,
-}
-USBH_OSEventTypeDef;
-
-/* Control request structure */
-typedef struct
-{
-  uint8_t               pipe_in;
-  uint8_t               pipe_out;
-  uint8_t               pipe_size;
-  uint8_t               *buff;
-  uint16_t              length;
-  uint16_t              timer;
-  USB_Setup_TypeDef     setup;
-  CTRL_StateTypeDef     state;
-  uint8_t               errorcount;
-
-} USBH_CtrlTypeDef;
-
-/* Attached device structure */
-typedef struct
-{
-  uint8_t                           CfgDesc_Raw[USBH_MAX_SIZE_CONFIGURATION];
-  uint8_t                           Data[USBH_MAX_DATA_BUFFER];
-  uint8_t                           address;
-  uint8_t                           speed;
-  uint8_t                           EnumCnt;
-  uint8_t                           RstCnt;
-  __IO uint8_t                      is_connected;
-  __IO uint8_t                      is_disconnected;
-  __IO uint8_t                      is_ReEnumerated;
-  uint8_t                           PortEnabled;
-  uint8_t                           current_interface;
-  USBH_DevDescTypeDef               DevDesc;
-  USBH_CfgDescTypeDef               CfgDesc;
-} USBH_DeviceTypeDef;
-
-struct _USBH_HandleTypeDef;
-
-/* USB Host Class structure */
-typedef struct
-{
-  const char          *Name;
-  uint8_t              ClassCode;
-  USBH_StatusTypeDef(*Init)(struct _USBH_HandleTypeDef *phost);
-  USBH_StatusTypeDef(*DeInit)(struct _USBH_HandleTypeDef *phost);
-  USBH_StatusTypeDef(*Requests)(struct _USBH_HandleTypeDef *phost);
-  USBH_StatusTypeDef(*BgndProcess)(struct _USBH_HandleTypeDef *phost);
-  USBH_StatusTypeDef(*SOFProcess)(struct _USBH_HandleTypeDef *phost);
-  void                *pData;
-} USBH_ClassTypeDef;
-
-/* USB Host handle structure */
-typedef struct _USBH_HandleTypeDef
-{
-  __IO HOST_StateTypeDef     gState;       /*  Host State Machine Value */
-  ENUM_StateTypeDef     EnumState;    /* Enumeration state Machine */
-  CMD_StateTypeDef      RequestState;
-  USBH_CtrlTypeDef      Control;
-  USBH_DeviceTypeDef    device;
-  USBH_ClassTypeDef    *pClass[USBH_MAX_NUM_SUPPORTED_CLASS];
-  USBH_ClassTypeDef    *pActiveClass;
-  uint32_t              ClassNumber;
-  uint32_t              Pipes[16];
-  __IO uint32_t         Timer;
-  uint32_t              Timeout;
-  uint8_t               id;
-  void                 *pData;
-  void (* pUser)(struct _USBH_HandleTypeDef *pHandle, uint8_t id);
-
-#if (USBH_USE_OS == 1U)
-#if osCMSIS < 0x20000
-  osMessageQId          os_event;
-  osThreadId            thread;
-#else
-  osMessageQueueId_t    os_event;
-  osThreadId_t          thread;
-#endif
-  uint32_t              os_msg;
-#endif
-
-} USBH_HandleTypeDef;
-
-
-#if  defined ( __GNUC__ )
-#ifndef __weak
-#define __weak   __attribute__((weak))
-#endif /* __weak */
-#ifndef __packed
-#define __packed __attribute__((__packed__))
-#endif /* __packed */
-#endif /* __GNUC__ */
-
-#ifdef __cplusplus
-}
-#endif
-
-#endif /* USBH_DEF_H */
-
-/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
-
+/**
+  ******************************************************************************
+  * @file    usbh_def.h
+  * @author  MCD Application Team
+  * @brief   Definitions used in the USB host library
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2015 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under Ultimate Liberty license
+  * SLA0044, the "License"; You may not use this file except in compliance with
+  * the License. You may obtain a copy of the License at:
+  *                      www.st.com/SLA0044
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive  ----------------------------------------------*/
+#ifndef  USBH_DEF_H
+#define  USBH_DEF_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "usbh_conf.h"
+
+/** @addtogroup USBH_LIB
+  * @{
+  */
+
+/** @addtogroup USBH_LIB_CORE
+* @{
+*/
+
+/** @defgroup USBH_DEF
+  * @brief This file is includes USB descriptors
+  * @{
+  */
+
+#ifndef NULL
+#define NULL  0U
+#endif
+
+#ifndef FALSE
+#define FALSE 0U
+#endif
+
+#ifndef TRUE
+#define TRUE  1U
+#endif
+
+#ifndef USBH_DEV_RESET_TIMEOUT
+#define USBH_DEV_RESET_TIMEOUT                        1000U
+#endif
+
+/* Settle times used in fast attach mode (ms), USB 2.0 spec minimums */
+#ifndef USBH_ATTACH_DEBOUNCE_TIME
+#define USBH_ATTACH_DEBOUNCE_TIME                     100U  /* TATTDB */
+#endif
+
+#ifndef USBH_RESET_RECOVERY_TIME
+#define USBH_RESET_RECOVERY_TIME                      10U   /* TRSTRCY */
+#endif
+
+#ifndef USBH_SET_ADDRESS_RECOVERY_TIME
+#define USBH_SET_ADDRESS_RECOVERY_TIME                2U    /* TDSETADDR */
+#endif
+
+#define ValBit(VAR,POS)                               (VAR & (1 << POS))
+#define SetBit(VAR,POS)                               (VAR |= (1 << POS))
+#define ClrBit(VAR,POS)                               (VAR &= ((1 << POS)^255))
+
+#define LE16(addr)        (((uint16_t)(addr)[0]) | \
+                           ((uint16_t)(((uint32_t)(addr)[1]) << 8)))
+
+#define LE24(addr)        (((uint32_t)(addr)[0]) | \
+                           (((uint32_t)(addr)[1]) << 8) | \
+                           (((uint32_t)(addr)[2]) << 16))
+
+#define LE32(addr)        (((uint32_t)(addr)[0]) | \
+                           (((uint32_t)(addr)[1]) << 8) | \
+                           (((uint32_t)(addr)[2]) << 16) | \
+                           (((uint32_t)(addr)[3]) << 24))
+
+#define LE64(addr)        (((uint64_t)(addr)[0]) | \
+                           (((uint64_t)(addr)[1]) << 8) | \
+                           (((uint64_t)(addr)[2]) << 16) | \
+                           (((uint64_t)(addr)[3]) << 24) | \
+                           (((uint64_t)(addr)[4]) << 32) | \
+                           (((uint64_t)(addr)[5]) << 40) | \
+                           (((uint64_t)(addr)[6]) << 48) | \
+                           (((uint64_t)(addr)[7]) << 56))
+
+#define LE16S(addr)       ((int16_t)(LE16((addr))))
+#define LE24S(addr)       ((int32_t)(LE24((addr))))
+#define LE32S(addr)       ((int32_t)(LE32((addr))))
+#define LE64S(addr)       ((int64_t)(LE64((addr))))
+
+
+
+#define  USB_LEN_DESC_HDR                                  0x02U
+#define  USB_LEN_DEV_DESC                                  0x12U
+#define  USB_LEN_CFG_DESC                                  0x09U
+#define  USB_LEN_IF_DESC                                   0x09U
+#define  USB_LEN_EP_DESC                                   0x07U
+#define  USB_LEN_OTG_DESC                                  0x03U
+#define  USB_LEN_SETUP_PKT                                 0x08U
+
+/* bmRequestType :D7 Data Phase Transfer Direction  */
+#define  USB_REQ_DIR_MASK                                  0x80U
+#define  USB_H2D                                           0x00U
+#define  USB_D2H                                           0x80U
+
+/* bmRequestType D6..5 Type */
+#define  USB_REQ_TYPE_STANDARD                             0x00U
+#define  USB_REQ_TYPE_CLASS                                0x20U
+#define  USB_REQ_TYPE_VENDOR                               0x40U
+#define  USB_REQ_TYPE_RESERVED                             0x60U
+
+/* bmRequestType D4..0 Recipient */
+#define  USB_REQ_RECIPIENT_DEVICE                          0x00U
+#define  USB_REQ_RECIPIENT_INTERFACE                       0x01U
+#define  USB_REQ_RECIPIENT_ENDPOINT                        0x02U
+#define  USB_REQ_RECIPIENT_OTHER                           0x03U
+
+/* Table 9-4. Standard Request Codes  */
+/* bRequest , Value */
+#define  USB_REQ_GET_STATUS                                0x00U
+#define  USB_REQ_CLEAR_FEATURE                             0x01U
+#define  USB_REQ_SET_FEATURE                               0x03U
+#define  USB_REQ_SET_ADDRESS                               0x05U
+#define  USB_REQ_GET_DESCRIPTOR                            0x06U
+#define  USB_REQ_SET_DESCRIPTOR                            0x07U
+#define  USB_REQ_GET_CONFIGURATION                         0x08U
+#define  USB_REQ_SET_CONFIGURATION                         0x09U
+#define  USB_REQ_GET_INTERFACE                             0x0AU
+#define  USB_REQ_SET_INTERFACE                             0x0BU
+#define  USB_REQ_SYNCH_FRAME                               0x0CU
+
+/* Table 9-5. Descriptor Types of USB Specifications */
+#define  USB_DESC_TYPE_DEVICE                              0x01U
+#define  USB_DESC_TYPE_CONFIGURATION                       0x02U
+#define  USB_DESC_TYPE_STRING                              0x03U
+#define  USB_DESC_TYPE_INTERFACE                           0x04U
+#define  USB_DESC_TYPE_ENDPOINT                            0x05U
+#define  USB_DESC_TYPE_DEVICE_QUALIFIER                    0x06U
+#define  USB_DESC_TYPE_OTHER_SPEED_CONFIGURATION           0x07U
+#define  USB_DESC_TYPE_INTERFACE_POWER                     0x08U
+#define  USB_DESC_TYPE_IAD                                 0x0BU
+#define  USB_DESC_TYPE_HID                                 0x21U
+#define  USB_DESC_TYPE_HID_REPORT                          0x22U
+
+
+#define USB_DEVICE_DESC_SIZE                               0x12U
+#define USB_CONFIGURATION_DESC_SIZE                        0x09U
+#define USB_HID_DESC_SIZE                                  0x09U
+#define USB_INTERFACE_DESC_SIZE                            0x09U
+#define USB_ENDPOINT_DESC_SIZE                             0x07U
+
+/* Descriptor Type and Descriptor Index  */
+/* Use the following values when calling the function USBH_GetDescriptor  */
+#define  USB_DESC_DEVICE                    ((USB_DESC_TYPE_DEVICE << 8) & 0xFF00U)
+#define  USB_DESC_CONFIGURATION             ((USB_DESC_TYPE_CONFIGURATION << 8) & 0xFF00U)
+#define  USB_DESC_STRING                    ((USB_DESC_TYPE_STRING << 8) & 0xFF00U)
+#define  USB_DESC_INTERFACE                 ((USB_DESC_TYPE_INTERFACE << 8) & 0xFF00U)
+#define  USB_DESC_ENDPOINT                  ((USB_DESC_TYPE_INTERFACE << 8) & 0xFF00U)
+#define  USB_DESC_DEVICE_QUALIFIER          ((USB_DESC_TYPE_DEVICE_QUALIFIER << 8) & 0xFF00U)
+#define  USB_DESC_OTHER_SPEED_CONFIGURATION ((USB_DESC_TYPE_OTHER_SPEED_CONFIGURATION << 8) & 0xFF00U)
+#define  USB_DESC_INTERFACE_POWER           ((USB_DESC_TYPE_INTERFACE_POWER << 8) & 0xFF00U)
+#define  USB_DESC_HID_REPORT                ((USB_DESC_TYPE_HID_REPORT << 8) & 0xFF00U)
+#define  USB_DESC_HID                       ((USB_DESC_TYPE_HID << 8) & 0xFF00U)
+
+
+#define  USB_EP_TYPE_CTRL                                  0x00U
+#define  USB_EP_TYPE_ISOC                                  0x01U
+#define  USB_EP_TYPE_BULK                                  0x02U
+#define  USB_EP_TYPE_INTR                                  0x03U
+
+#define  USB_EP_DIR_OUT                                    0x00U
+#define  USB_EP_DIR_IN                                     0x80U
+#define  USB_EP_DIR_MSK                                    0x80U
+
+/* Host channels of the controller, see Host_channels in usbh_conf.c */
+#ifndef USBH_MAX_PIPES_NBR
+#define USBH_MAX_PIPES_NBR                                16U
+#endif /* USBH_MAX_PIPES_NBR */
+
+/* Virtual pipes of the interrupt endpoints. They hold no host channel and
+   borrow a free one for each transfer; 0 gives every endpoint a channel */
+#ifndef USBH_MAX_VPIPES_NBR
+#define USBH_MAX_VPIPES_NBR                               16U
+#endif /* USBH_MAX_VPIPES_NBR */
+
+/* Pipe numbers: the host channels, then the virtual pipes */
+#define USBH_NUM_PIPES                    (USBH_MAX_PIPES_NBR + USBH_MAX_VPIPES_NBR)
+
+#if (USBH_NUM_PIPES > 32U)
+#error "USBH_MAX_PIPES_NBR and USBH_MAX_VPIPES_NBR must fit the 32-bit pipe bitmap"
+#endif /* (USBH_NUM_PIPES > 32U) */
+
+/* Periodic schedule, see usbh_periodic.c: interrupt and isochronous
+   endpoints polled at once, 1 to 32 */
+#ifndef USBH_MAX_PERIODIC_NBR
+#define USBH_MAX_PERIODIC_NBR                             16U
+#endif /* USBH_MAX_PERIODIC_NBR */
+
+/* Frames of the schedule, a power of two: the longest polling interval */
+#ifndef USBH_PERIODIC_FRAMES
+#define USBH_PERIODIC_FRAMES                              32U
+#endif /* USBH_PERIODIC_FRAMES */
+
+/* Full-speed byte times per frame the periodic transfers may take, 90% of
+   the 1500 of a frame as the specification allows */
+#ifndef USBH_PERIODIC_BUDGET
+#define USBH_PERIODIC_BUDGET                              1350U
+#endif /* USBH_PERIODIC_BUDGET */
+
+#if ((USBH_MAX_PERIODIC_NBR == 0U) || (USBH_MAX_PERIODIC_NBR > 32U))
+#error "USBH_MAX_PERIODIC_NBR must fit the 32-bit schedule bitmaps"
+#endif /* USBH_MAX_PERIODIC_NBR */
+
+#if ((USBH_PERIODIC_FRAMES & (USBH_PERIODIC_FRAMES - 1U)) != 0U)
+#error "USBH_PERIODIC_FRAMES must be a power of two"
+#endif /* USBH_PERIODIC_FRAMES */
+
+/* Value of USBH_AllocPipe() and USBH_GetPipe() when there is no pipe */
+#define USBH_PIPE_NONE                                    0xFFU
+
+/* Index of an endpoint address in USBH_HandleTypeDef.EpPipe */
+#define USBH_EP_INDEX(ep_addr)    ((uint8_t)(((ep_addr) & 0x0FU) | (((ep_addr) & 0x80U) >> 3)))
+
+#ifndef USBH_MAX_NUM_TIMERS
+#define USBH_MAX_NUM_TIMERS                               (2U * USBH_MAX_NUM_DEVICES)
+#endif /* USBH_MAX_NUM_TIMERS */
+
+/* Host ports, one per handle given to USBH_Init() */
+#ifndef USBH_MAX_NUM_PORTS
+#define USBH_MAX_NUM_PORTS                                1U
+#endif /* USBH_MAX_NUM_PORTS */
+
+/* Control requests waiting in USBH_CtlSubmit() queue of a root port */
+#ifndef USBH_CTL_QUEUE_SIZE
+#define USBH_CTL_QUEUE_SIZE                               8U
+#endif /* USBH_CTL_QUEUE_SIZE */
+
+/* USBH_CtlSeqItemTypeDef.Flags */
+#define USBH_CTL_SEQ_STALL_OK                             0x01U  /* A stall does not end the sequence */
+#define USBH_CTL_SEQ_MORE                                 0x80U  /* Queue: the sequence goes on */
+
+/* Frames one attempt of a control transfer may take. An attempt past it
+   halts the EP0 channels and counts as an error. */
+#ifndef USBH_CTL_TIMEOUT
+#define USBH_CTL_TIMEOUT                                  500U
+#endif /* USBH_CTL_TIMEOUT */
+
+/* Frames before the first retry of a failed control transfer, doubled at
+   each retry up to USBH_CTL_RETRY_DELAY_MAX */
+#ifndef USBH_CTL_RETRY_DELAY
+#define USBH_CTL_RETRY_DELAY                              1U
+#endif /* USBH_CTL_RETRY_DELAY */
+
+#ifndef USBH_CTL_RETRY_DELAY_MAX
+#define USBH_CTL_RETRY_DELAY_MAX                          32U
+#endif /* USBH_CTL_RETRY_DELAY_MAX */
+
+#define USBH_DEVICE_ADDRESS_DEFAULT                        0x00U
+#define USBH_DEVICE_ADDRESS                                0x01U
+
+/* Retries of a control transfer before the device is given up. A request
+   takes at most (USBH_MAX_ERROR_COUNT + 1) x USBH_CTL_TIMEOUT frames plus
+   the retry delays. */
+#ifndef USBH_MAX_ERROR_COUNT
+#define USBH_MAX_ERROR_COUNT                               0x02U
+#endif /* USBH_MAX_ERROR_COUNT */
+
+#if (USBH_USE_OS == 1U)
+#define MSGQUEUE_OBJECTS                                   10
+
+/* One thread flag per USBH_OSEventTypeDef value */
+#define USBH_OS_EVENT_FLAGS_ALL                            0x0000FFFEU
+#endif
+
+
+/**
+  * @}
+  */
+
+
+/* Compile-time check of the configuration */
+#ifdef __cplusplus
+#define USBH_STATIC_ASSERT(expr, msg)   static_assert((expr), msg)
+#else
+#define USBH_STATIC_ASSERT(expr, msg)   _Static_assert((expr), msg)
+#endif
+
+#define USBH_CONFIGURATION_DESCRIPTOR_SIZE (USB_CONFIGURATION_DESC_SIZE \
+                                           + USB_INTERFACE_DESC_SIZE\
+                                           + (USBH_MAX_NUM_ENDPOINTS * USB_ENDPOINT_DESC_SIZE))
+
+
+#define CONFIG_DESC_wTOTAL_LENGTH (ConfigurationDescriptorData.ConfigDescfield.\
+                                          ConfigurationDescriptor.wTotalLength)
+
+
+typedef union
+{
+  uint16_t w;
+  struct BW
+  {
+    uint8_t msb;
+    uint8_t lsb;
+  }
+  bw;
+}
+uint16_t_uint8_t;
+
+
+typedef union _USB_Setup
+{
+  uint32_t d8[2];
+
+  struct _SetupPkt_Struc
+  {
+    uint8_t           bmRequestType;
+    uint8_t           bRequest;
+    uint16_t_uint8_t  wValue;
+    uint16_t_uint8_t  wIndex;
+    uint16_t_uint8_t  wLength;
+  } b;
+}
+USB_Setup_TypeDef;
+
+typedef  struct  _DescHeader
+{
+  uint8_t  bLength;
+  uint8_t  bDescriptorType;
+}
+USBH_DescHeader_t;
+
+typedef struct _DeviceDescriptor
+{
+  uint8_t   bLength;
+  uint8_t   bDescriptorType;
+  uint16_t  bcdUSB;        /* USB Specification Number which device complies too */
+  uint8_t   bDeviceClass;
+  uint8_t   bDeviceSubClass;
+  uint8_t   bDeviceProtocol;
+  /* If equal to Zero, each interface specifies its own class
+  code if equal to 0xFF, the class code is vendor specified.
+  Otherwise field is valid Class Code.*/
+  uint8_t   bMaxPacketSize;
+  uint16_t  idVendor;      /* Vendor ID (Assigned by USB Org) */
+  uint16_t  idProduct;     /* Product ID (Assigned by Manufacturer) */
+  uint16_t  bcdDevice;     /* Device Release Number */
+  uint8_t   iManufacturer;  /* Index of Manufacturer String Descriptor */
+  uint8_t   iProduct;       /* Index of Product String Descriptor */
+  uint8_t   iSerialNumber;  /* Index of Serial Number String Descriptor */
+  uint8_t   bNumConfigurations; /* Number of Possible Configurations */
+}
+USBH_DevDescTypeDef;
+
+typedef struct _EndpointDescriptor
+{
+  uint8_t   bLength;
+  uint8_t   bDescriptorType;
+  uint8_t   bEndpointAddress;   /* indicates what endpoint this descriptor is describing */
+  uint8_t   bmAttributes;       /* specifies the transfer type. */
+  uint16_t  wMaxPacketSize;    /* Maximum Packet Size this endpoint is capable of sending or receiving */
+  uint8_t   bInterval;          /* is used to specify the polling interval of certain transfers. */
+}
+USBH_EpDescTypeDef;
+
+typedef struct _InterfaceDescriptor
+{
+  uint8_t bLength;
+  uint8_t bDescriptorType;
+  uint8_t bInterfaceNumber;
+  uint8_t bAlternateSetting;    /* Value used to select alternative setting */
+  uint8_t bNumEndpoints;        /* Number of Endpoints used for this interface */
+  uint8_t bInterfaceClass;      /* Class Code (Assigned by USB Org) */
+  uint8_t bInterfaceSubClass;   /* Subclass Code (Assigned by USB Org) */
+  uint8_t bInterfaceProtocol;   /* Protocol Code */
+  uint8_t iInterface;           /* Index of String Descriptor Describing this interface */
+}
+USBH_InterfaceDescTypeDef;
+
+
+typedef struct _ConfigurationDescriptor
+{
+  uint8_t   bLength;
+  uint8_t   bDescriptorType;
+  uint16_t  wTotalLength;        /* Total Length of Data Returned */
+  uint8_t   bNumInterfaces;       /* Number of Interfaces */
+  uint8_t   bConfigurationValue;  /* Value to use as an argument to select this configuration*/
+  uint8_t   iConfiguration;       /*Index of String Descriptor Describing this configuration */
+  uint8_t   bmAttributes;         /* D7 Bus Powered , D6 Self Powered, D5 Remote Wakeup , D4..0 Reserved (0)*/
+  uint8_t   bMaxPower;            /*Maximum Power Consumption */
+}
+USBH_CfgDescTypeDef;
+
+/* Walk of the raw configuration descriptor, see USBH_DescIter_Init(). The
+   descriptors are read in place, CfgDesc_Raw holds the only copy. */
+typedef struct
+{
+  uint8_t   *pCfg;                /* Raw configuration descriptor */
+  uint16_t  Length;               /* Bytes of pCfg that can be walked */
+  uint16_t  Pos;                  /* Offset of the next descriptor */
+  uint8_t   *pItf;                /* Current interface descriptor, NULL before the first */
+  uint8_t   ItfIndex;             /* Index of pItf among the interface descriptors */
+}
+USBH_DescIterTypeDef;
+
+
+/* Following USB Host status */
+typedef enum
+{
+  USBH_OK = 0,
+  USBH_BUSY,
+  USBH_FAIL,
+  USBH_NOT_SUPPORTED,
+  USBH_UNRECOVERED_ERROR,
+  USBH_ERROR_SPEED_UNKNOWN,
+  USBH_TIMEOUT,
+} USBH_StatusTypeDef;
+
+
+/** @defgroup USBH_CORE_Exported_Types
+  * @{
+  */
+
+typedef enum
+{
+  USBH_SPEED_HIGH  = 0U,
+  USBH_SPEED_FULL  = 1U,
+  USBH_SPEED_LOW   = 2U,
+
+} USBH_SpeedTypeDef;
+
+/* Following states are used for gState */
+typedef enum
+{
+  HOST_IDLE = 0U,
+  HOST_DEV_WAIT_FOR_ATTACHMENT,
+  HOST_DEV_ATTACHED,
+  HOST_DEV_DISCONNECTED,
+  HOST_DETECT_DEVICE_SPEED,
+  HOST_ENUMERATION,
+  HOST_CLASS_REQUEST,
+  HOST_INPUT,
+  HOST_SET_CONFIGURATION,
+  HOST_SET_WAKEUP_FEATURE,
+  HOST_CHECK_CLASS,
+  HOST_CLASS,
+  HOST_SUSPENDED,
+  HOST_ABORT_STATE,
+} HOST_StateTypeDef;
+
+/* Following states are used for EnumerationState */
+typedef enum
+{
+  ENUM_IDLE = 0U,
+  ENUM_GET_FULL_DEV_DESC,
+  ENUM_SET_ADDR,
+  ENUM_GET_CFG_DESC,
+  ENUM_GET_FULL_CFG_DESC,
+  ENUM_GET_MFC_STRING_DESC,
+  ENUM_GET_PRODUCT_STRING_DESC,
+  ENUM_GET_SERIALNUM_STRING_DESC,
+  ENUM_CHECK_CACHE,
+} ENUM_StateTypeDef;
+
+/* Following states are used for CtrlXferStateMachine */
+typedef enum
+{
+  CTRL_IDLE = 0U,
+  CTRL_SETUP,
+  CTRL_SETUP_WAIT,
+  CTRL_DATA_IN,
+  CTRL_DATA_IN_WAIT,
+  CTRL_DATA_OUT,
+  CTRL_DATA_OUT_WAIT,
+  CTRL_STATUS_IN,
+  CTRL_STATUS_IN_WAIT,
+  CTRL_STATUS_OUT,
+  CTRL_STATUS_OUT_WAIT,
+  CTRL_ERROR,
+  CTRL_STALLED,
+  CTRL_COMPLETE,
+  CTRL_TIMEOUT,                 /* Attempt past its deadline */
+  CTRL_RETRY_WAIT               /* Waiting to retry from the SETUP stage */
+} CTRL_StateTypeDef;
+
+
+/* Following states are used for RequestState */
+typedef enum
+{
+  CMD_IDLE = 0U,
+  CMD_SEND,
+  CMD_WAIT
+} CMD_StateTypeDef;
+
+/* String descriptor read on request, see USBH_GetString() */
+typedef enum
+{
+  USBH_STRING_IDLE = 0U,
+  USBH_STRING_PENDING,
+} USBH_StringStateTypeDef;
+
+typedef struct
+{
+  USBH_StringStateTypeDef  State;
+  uint8_t                  Index;
+  uint16_t                 Size;
+  char                    *pBuff;       /* UTF-8 text, NUL-terminated */
+} USBH_StringReqTypeDef;
+
+typedef enum
+{
+  USBH_URB_IDLE = 0U,
+  USBH_URB_DONE,
+  USBH_URB_NOTREADY,
+  USBH_URB_NYET,
+  USBH_URB_ERROR,
+  USBH_URB_STALL
+} USBH_URBStateTypeDef;
+
+struct _USBH_HandleTypeDef;
+
+/* Completion callback of the class owning a pipe, called from USBH_Process
+   with the final URB state and the number of bytes transferred */
+typedef void (*USBH_PipeCallbackTypeDef)(struct _USBH_HandleTypeDef *phost, uint8_t pipe,
+                                         USBH_URBStateTypeDef urb_state, uint32_t length);
+
+/* Completion callback of a queued control request: USBH_OK, USBH_NOT_SUPPORTED
+   on a stall, USBH_TIMEOUT when the last retry timed out, or USBH_FAIL on
+   error or when the device left. For a sequence, the status of the request
+   that ended it. */
+typedef void (*USBH_CtlCallbackTypeDef)(struct _USBH_HandleTypeDef *phost,
+                                        USBH_StatusTypeDef status, void *pContext);
+
+typedef enum
+{
+  USBH_CTL_QUEUE_FREE = 0U,
+  USBH_CTL_QUEUE_WAITING,
+  USBH_CTL_QUEUE_ACTIVE,
+} USBH_CtlQueueStateTypeDef;
+
+/* Control request queued with USBH_CtlSubmit() */
+typedef struct
+{
+  USBH_CtlQueueStateTypeDef    State;
+  struct _USBH_HandleTypeDef  *phost;      /* Device addressed */
+  USB_Setup_TypeDef            setup;
+  uint8_t                     *buff;
+  USBH_CtlCallbackTypeDef      Callback;   /* Last request of a sequence only */
+  void                        *pContext;
+  uint32_t                     Seq;        /* Submission order */
+  uint8_t                      Flags;      /* USBH_CTL_SEQ_xxx */
+} USBH_CtlQueueEntryTypeDef;
+
+/* One request of a sequence submitted with USBH_CtlSubmitSeq() */
+typedef struct
+{
+  USB_Setup_TypeDef            setup;
+  uint8_t                     *buff;       /* wLength bytes */
+  uint8_t                      Flags;      /* USBH_CTL_SEQ_STALL_OK or 0 */
+} USBH_CtlSeqItemTypeDef;
+
+typedef enum
+{
+  USBH_PORT_EVENT = 1U,
+  USBH_URB_EVENT,
+  USBH_CONTROL_EVENT,
+  USBH_CLASS_EVENT,
+  USBH_STATE_CHANGED_EVENT,
+  USBH_TIMER_EVENT,
+  USBH_SOF_EVENT,
+}
+USBH_OSEventTypeDef;
+
+/* Host thread wake-up statistics */
+typedef struct
+{
+  uint32_t              Posted;       /* USBH_OS_PostEvent() calls */
+  uint32_t              Coalesced;    /* posts merged into an already pending wake-up */
+  uint32_t              Dropped;      /* posts lost, message queue full */
+  uint32_t              Wakeups;      /* USBH_Process() runs of the host thread */
+} USBH_OSStatsTypeDef;
+
+/* Control request structure */
+typedef struct
+{
+  uint8_t               pipe_in;
+  uint8_t               pipe_out;
+  uint8_t               pipe_size;
+  uint8_t               *buff;
+  uint16_t              length;
+  uint32_t              timer;          /* Frame the request started */
+  uint32_t              deadline;       /* Frame the attempt times out or the retry starts */
+  USB_Setup_TypeDef     setup;
+  CTRL_StateTypeDef     state;
+  uint8_t               errorcount;
+
+} USBH_CtrlTypeDef;
+
+/* Control transfer statistics of a device */
+typedef struct
+{
+  uint32_t              Requests;     /* Control transfers ended, whatever the outcome */
+  uint32_t              Retries;      /* Attempts restarted from the SETUP stage */
+  uint32_t              Timeouts;     /* Attempts past USBH_CTL_TIMEOUT */
+  uint32_t              Aborts;       /* Transfers given up, the device is reset */
+  uint32_t              MaxTime;      /* Longest transfer in frames, retries included */
+} USBH_CtlStatsTypeDef;
+
+typedef enum
+{
+  USBH_VPIPE_IDLE = 0U,
+  USBH_VPIPE_PENDING,           /* Waiting for a free host channel */
+  USBH_VPIPE_ACTIVE,            /* Transfer in flight on Channel */
+} USBH_VPipeStateTypeDef;
+
+/* Interrupt endpoint multiplexed on the host channels */
+typedef struct
+{
+  uint8_t               EpNum;
+  uint8_t               DevAddress;
+  uint8_t               Speed;
+  uint8_t               EpType;
+  uint16_t              Mps;
+  uint8_t               Toggle;       /* Data toggle of the next transfer */
+  uint8_t               Channel;      /* Channel of the transfer in flight or of the last one */
+  USBH_VPipeStateTypeDef State;
+  uint8_t               Direction;
+  uint16_t              Length;
+  uint8_t              *pBuff;
+  uint32_t              Interval;     /* bInterval in frames */
+  uint32_t              Submitted;    /* Frame the transfer was submitted */
+} USBH_VPipeTypeDef;
+
+/* Virtual pipe scheduling statistics of a root port */
+typedef struct
+{
+  uint32_t              Transfers;    /* Transfers started on a borrowed channel */
+  uint32_t              Switches;     /* Channels programmed for another endpoint */
+  uint32_t              Waits;        /* Transfers started a frame or more after submission */
+  uint32_t              MaxJitter;    /* Longest wait for a channel in frames */
+  uint32_t              Late;         /* Waits of a full interval or more */
+} USBH_VPipeStatsTypeDef;
+
+/* Endpoint polled by the periodic schedule */
+typedef struct
+{
+  struct _USBH_HandleTypeDef *phost;  /* Device the pipe belongs to */
+  uint8_t              *pBuff;
+  uint16_t              Length;
+  uint16_t              Cost;         /* Byte times per transfer */
+  uint16_t              Interval;     /* Frames, a power of two */
+  uint16_t              Phase;        /* First frame of the schedule it is due in */
+  uint8_t               Pipe;
+  uint8_t               EpType;
+  uint8_t               Direction;
+  uint32_t              Skipped;      /* Frames due without a transfer started */
+} USBH_PeriodicTypeDef;
+
+/* Periodic schedule statistics of a root port */
+typedef struct
+{
+  uint32_t              Issued;       /* Transfers started by the schedule */
+  uint32_t              Skipped;      /* Due while the previous transfer was in flight */
+  uint32_t              MaxLag;       /* Longest delay from due frame to start in frames */
+  uint32_t              Rejected;     /* Endpoints refused for lack of bandwidth */
+  uint32_t              PeakLoad;     /* Highest byte times reserved in a frame */
+} USBH_PeriodicStatsTypeDef;
+
+/* Attached device structure */
+typedef struct
+{
+  uint8_t                           CfgDesc_Raw[USBH_MAX_SIZE_CONFIGURATION];
+  uint8_t                           Data[USBH_MAX_DATA_BUFFER];
+  uint8_t                           address;
+  uint8_t                           speed;
+  uint8_t                           EnumCnt;
+  uint8_t                           RstCnt;
+  __IO uint8_t                      is_connected;
+  __IO uint8_t                      is_disconnected;
+  __IO uint8_t                      is_ReEnumerated;
+  uint8_t                           PortEnabled;
+  uint8_t                           current_interface;
+  uint8_t                           current_itf_number;  /* bInterfaceNumber of current_interface */
+  USBH_DevDescTypeDef               DevDesc;
+  USBH_CfgDescTypeDef               CfgDesc;
+#if (USBH_DESC_CACHE_ENTRIES > 0U)
+  uint8_t                           DevDesc_Raw[USB_DEVICE_DESC_SIZE];  /* Descriptor cache key */
+  uint8_t                           DescCacheEntry;  /* Entry of the device, 0xFF if none */
+#endif
+} USBH_DeviceTypeDef;
+
+struct _USBH_HandleTypeDef;
+
+/* Frame timer: Callback runs from USBH_Process() on the root handle, in
+   thread context, once phost->Timer has reached Frame. A timer is
+   identified by its callback and the device handle it was started for. */
+typedef struct
+{
+  uint32_t              Frame;
+  void (*Callback)(struct _USBH_HandleTypeDef *phost);
+  struct _USBH_HandleTypeDef *phost;
+} USBH_TimerTypeDef;
+
+/* USB Host Class structure */
+typedef struct
+{
+  const char          *Name;
+  uint8_t              ClassCode;
+  USBH_StatusTypeDef(*Init)(struct _USBH_HandleTypeDef *phost);
+  USBH_StatusTypeDef(*DeInit)(struct _USBH_HandleTypeDef *phost);
+  USBH_StatusTypeDef(*Requests)(struct _USBH_HandleTypeDef *phost);
+  USBH_StatusTypeDef(*BgndProcess)(struct _USBH_HandleTypeDef *phost);
+  USBH_StatusTypeDef(*SOFProcess)(struct _USBH_HandleTypeDef *phost);  /* Every frame, in the host thread; may be NULL */
+  void                *pData;
+} USBH_ClassTypeDef;
+
+/* Host port: the host channels, the periodic schedule, the control queue,
+   the frame timers and the host thread, shared by every device of the tree.
+   USBH_Init() takes one for the root handle, the devices behind hubs and the
+   functions of composite devices reach it through pPort. */
+typedef struct _USBH_PortTypeDef
+{
+  struct _USBH_HandleTypeDef *pRoot;       /* Handle of the root port, NULL when the port is free */
+  uint32_t              Pipes[USBH_NUM_PIPES];
+  uint32_t              PipeMap;           /* Bitmap of the allocated pipes */
+  USBH_PipeCallbackTypeDef  PipeCallback[USBH_NUM_PIPES];  /* Owner of each pipe */
+  __IO USBH_URBStateTypeDef PipeEvent[USBH_NUM_PIPES];     /* Completion not yet dispatched */
+  struct _USBH_HandleTypeDef *PipeDevice[USBH_NUM_PIPES];  /* Device the pipe was allocated for */
+  USBH_ClassTypeDef    *PipeClass[USBH_NUM_PIPES];   /* Class that allocated it, NULL for EP0 */
+#if (USBH_MAX_VPIPES_NBR > 0U)
+  USBH_VPipeTypeDef     VPipe[USBH_MAX_VPIPES_NBR];    /* Pipes from USBH_MAX_PIPES_NBR on */
+  uint8_t               ChanVPipe[USBH_MAX_PIPES_NBR]; /* Virtual pipe a channel is programmed for */
+  uint32_t              VChanMap;          /* Channels lent to a virtual pipe */
+  uint32_t              VChanCache;        /* Free channels still programmed for one */
+  uint32_t              VPipePending;      /* Virtual pipes waiting for a channel */
+  USBH_VPipeStatsTypeDef VPipeStats;
+#endif /* (USBH_MAX_VPIPES_NBR > 0U) */
+  USBH_PeriodicTypeDef  Periodic[USBH_MAX_PERIODIC_NBR];      /* Periodic schedule */
+  uint32_t              PeriodicSlot[USBH_PERIODIC_FRAMES];   /* Entries due in each frame */
+  uint16_t              PeriodicLoad[USBH_PERIODIC_FRAMES];   /* Byte times reserved */
+  uint32_t              PeriodicMap;       /* Entries in use */
+  __IO uint32_t         PeriodicEnabled;   /* Entries polled */
+  __IO uint32_t         PeriodicBusy;      /* Pipes with a transfer of the schedule in flight */
+  uint32_t              PeriodicPending;   /* Entries due, waiting for their pipe */
+  uint32_t              PeriodicFrame;     /* Last frame processed */
+  USBH_PeriodicStatsTypeDef PeriodicStats;
+  USBH_TimerTypeDef     Timers[USBH_MAX_NUM_TIMERS];  /* Sorted by Frame */
+  __IO uint8_t          TimerCount;
+  __IO uint32_t         TimerNext;         /* Frame of Timers[0], for the SOF interrupt */
+  uint32_t              SofFrame;          /* Last frame the SOF processes ran for */
+  __IO uint8_t          SofActive;         /* A class has a SOF process, for the SOF interrupt */
+  uint32_t              AddressMap;        /* Bus addresses in use */
+  struct _USBH_HandleTypeDef *pCtlOwner;   /* Device running a control transfer */
+  struct _USBH_HandleTypeDef *pCtlDevice;  /* Device the EP0 pipes are opened for */
+  USBH_CtlQueueEntryTypeDef CtlQueue[USBH_CTL_QUEUE_SIZE];  /* Queued control requests */
+  uint32_t              CtlQueueSeq;       /* Sequence of the next submission */
+
+#if (USBH_USE_OS == 1U)
+#if osCMSIS < 0x20000
+  osMessageQId          os_event;
+  osThreadId            thread;
+#else
+  osMessageQueueId_t    os_event;
+  osThreadId_t          thread;
+#endif
+  uint32_t              os_msg;
+#if (USBH_USE_OS_EVENT_FLAGS == 1U)
+  __IO uint32_t         os_pending;   /* event flags set and not yet consumed */
+#endif
+  USBH_OSStatsTypeDef   os_stats;
+#endif
+} USBH_PortTypeDef;
+
+/* USB Host handle structure: one device, or one function of a composite
+   device */
+typedef struct _USBH_HandleTypeDef
+{
+  __IO HOST_StateTypeDef     gState;       /*  Host State Machine Value */
+  ENUM_StateTypeDef     EnumState;    /* Enumeration state Machine */
+  CMD_StateTypeDef      RequestState;
+  USBH_CtrlTypeDef      Control;
+  USBH_CtlStatsTypeDef  CtlStats;
+  USBH_DeviceTypeDef    device;
+  USBH_ClassTypeDef    *pClass[USBH_MAX_NUM_SUPPORTED_CLASS];
+  USBH_ClassTypeDef    *pActiveClass;
+  USBH_ClassTypeDef     ActiveClass;  /* Instance of the class driving this device */
+  uint32_t              ClassNumber;
+  uint8_t               EpPipe[32];        /* Pipe + 1 of each endpoint of this device, 0 when none */
+  __IO uint32_t         Timer;
+  uint32_t              Timeout;
+  uint8_t               id;
+  void                 *pData;
+  void (* pUser)(struct _USBH_HandleTypeDef *pHandle, uint8_t id);
+  USBH_StringReqTypeDef StringReq;
+
+  /* Device tree. A device behind a hub has its own handle; the host
+     channels, EP0 pipes, frame timers and the host thread stay with the
+     port of the root handle. */
+  USBH_PortTypeDef     *pPort;             /* Port of the tree */
+  struct _USBH_HandleTypeDef *pRoot;       /* Handle of the root port, itself on the root port */
+  struct _USBH_HandleTypeDef *pParent;     /* Hub the device is attached to, NULL on the root port */
+  uint8_t               HubPort;           /* Port of pParent */
+  uint8_t               DevAddress;        /* Address given at ENUM_SET_ADDR */
+
+  /* Composite devices. Each class bound to the device beyond the first runs
+     on a function handle, a copy of the device handle sharing its address. */
+  struct _USBH_HandleTypeDef *pDevice;     /* Handle that enumerated the device, itself for a device */
+  uint8_t               ItfClaimed[32];    /* Device: bitmap of the interface numbers bound to a class */
+
+#if (USBH_FAST_ATTACH == 1U)
+  uint32_t              WaitStart;    /* USBH_GetTick() when the pending wait started */
+  uint32_t              WaitTime;     /* Length of the pending wait in ms */
+  uint8_t               WaitPending;
+#endif
+
+} USBH_HandleTypeDef;
+
+
+#if  defined ( __GNUC__ )
+#ifndef __weak
+#define __weak   __attribute__((weak))
+#endif /* __weak */
+#ifndef __packed
+#define __packed __attribute__((__packed__))
+#endif /* __packed */
+#endif /* __GNUC__ */
+
+/* Index of the lowest bit set of a non-zero word */
+#if  defined ( __GNUC__ )
+#define USBH_CTZ(x)    ((uint32_t)__builtin_ctz(x))
+#else
+#define USBH_CTZ(x)    ((uint32_t)__CLZ(__RBIT(x)))
+#endif /* __GNUC__ */
+
+/* Set or clear bits of a word the HCD interrupt reads or writes as well */
+#if  defined ( __GNUC__ )
+#define USBH_ATOMIC_SET(var, bits)    ((void)__atomic_fetch_or(&(var), (bits), __ATOMIC_SEQ_CST))
+#define USBH_ATOMIC_CLEAR(var, bits)  ((void)__atomic_fetch_and(&(var), ~(bits), __ATOMIC_SEQ_CST))
+#else
+#define USBH_ATOMIC_SET(var, bits)    do { uint32_t primask = __get_PRIMASK(); __disable_irq(); \
+                                           (var) |= (bits); __set_PRIMASK(primask); } while (0)
+#define USBH_ATOMIC_CLEAR(var, bits)  do { uint32_t primask = __get_PRIMASK(); __disable_irq(); \
+                                           (var) &= ~(bits); __set_PRIMASK(primask); } while (0)
+#endif /* __GNUC__ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* USBH_DEF_H */
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
+
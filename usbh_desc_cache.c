@@ -0,0 +1,616 @@
+/**
+  ******************************************************************************
+  * @file    usbh_desc_cache.c
+  * @brief   Descriptor cache of the devices seen last.
+  *
+  *          During a normal enumeration the core records the raw device,
+  *          configuration and string descriptors of the device in an entry.
+  *          When a device whose device descriptor (and serial number string,
+  *          if it has one) matches an entry is attached again, the core loads
+  *          the configuration from the entry and skips the configuration and
+  *          string requests. The table can be saved and restored through
+  *          USBH_DescCache_GetImage()/USBH_DescCache_SetImage(), for instance
+  *          to flash from USBH_DescCache_UpdateCallback().
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2015 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under Ultimate Liberty license
+  * SLA0044, the "License"; You may not use this file except in compliance with
+  * the License. You may obtain a copy of the License at:
+  *                      www.st.com/SLA0044
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "usbh_desc_cache.h"
+#include "usbh_ctlreq.h"
+
+#if (USBH_DESC_CACHE_ENTRIES > 0U)
+
+/** @addtogroup USBH_LIB
+  * @{
+  */
+
+/** @addtogroup USBH_LIB_CORE
+  * @{
+  */
+
+/** @defgroup USBH_DESC_CACHE
+  * @brief This file handles the descriptor cache
+  * @{
+  */
+
+
+/** @defgroup USBH_DESC_CACHE_Private_Variables
+  * @{
+  */
+static USBH_DescCacheTypeDef USBH_DescCache;
+static USBH_DescCacheStatsTypeDef USBH_DescCacheStats;
+
+/* Handle recording each FILLING entry, not part of the image */
+static USBH_HandleTypeDef *USBH_DescCacheOwner[USBH_DESC_CACHE_ENTRIES];
+/**
+  * @}
+  */
+
+
+/** @defgroup USBH_DESC_CACHE_Private_FunctionPrototypes
+  * @{
+  */
+static void USBH_DescCache_Format(void);
+static USBH_DescCacheEntryTypeDef *USBH_DescCache_Owned(USBH_HandleTypeDef *phost);
+static USBH_DescCacheEntryTypeDef *USBH_DescCache_Current(USBH_HandleTypeDef *phost);
+static uint8_t USBH_DescCache_StringSlot(USBH_HandleTypeDef *phost, uint8_t string_index);
+static uint8_t USBH_DescCache_SameString(const uint8_t *pstr, const uint8_t *pdesc);
+/**
+  * @}
+  */
+
+
+/** @defgroup USBH_DESC_CACHE_Exported_Functions
+  * @{
+  */
+
+/**
+  * @brief  USBH_DescCache_Clear
+  *         Drop every entry and reset the counters.
+  * @retval None
+  */
+void USBH_DescCache_Clear(void)
+{
+  USBH_DescCache_Format();
+  (void)USBH_memset(&USBH_DescCacheStats, 0, sizeof(USBH_DescCacheStats));
+}
+
+
+/**
+  * @brief  USBH_DescCache_GetStats
+  *         Return the hit/miss counters of the cache.
+  * @retval Counters, valid until the next USBH_DescCache_Clear()
+  */
+const USBH_DescCacheStatsTypeDef *USBH_DescCache_GetStats(void)
+{
+  return &USBH_DescCacheStats;
+}
+
+
+/**
+  * @brief  USBH_DescCache_GetImage
+  *         Return the table to save to a persistent store.
+  * @param  size: Returns the image size in bytes
+  * @retval Image address
+  */
+const void *USBH_DescCache_GetImage(uint32_t *size)
+{
+  if (USBH_DescCache.Magic != USBH_DESC_CACHE_MAGIC)
+  {
+    USBH_DescCache_Format();
+  }
+
+  *size = (uint32_t)sizeof(USBH_DescCache);
+
+  return &USBH_DescCache;
+}
+
+
+/**
+  * @brief  USBH_DescCache_SetImage
+  *         Restore a table saved with USBH_DescCache_GetImage(), before
+  *         USBH_Start(). Images of another layout or size are refused.
+  * @param  image: Image address
+  * @param  size: Image size in bytes
+  * @retval USBH_OK, USBH_FAIL if the image does not match this build
+  */
+USBH_StatusTypeDef USBH_DescCache_SetImage(const void *image, uint32_t size)
+{
+  const USBH_DescCacheTypeDef *pimg = (const USBH_DescCacheTypeDef *)image;
+  uint32_t idx;
+
+  if ((pimg == NULL) || (size != (uint32_t)sizeof(USBH_DescCache)) ||
+      (pimg->Magic != USBH_DESC_CACHE_MAGIC) ||
+      (pimg->Version != USBH_DESC_CACHE_VERSION) ||
+      (pimg->EntrySize != (uint16_t)sizeof(USBH_DescCacheEntryTypeDef)) ||
+      (pimg->NumEntries != USBH_DESC_CACHE_ENTRIES))
+  {
+    return USBH_FAIL;
+  }
+
+  (void)USBH_memcpy(&USBH_DescCache, pimg, sizeof(USBH_DescCache));
+
+  for (idx = 0U; idx < USBH_DESC_CACHE_ENTRIES; idx++)
+  {
+    /* An entry saved while recording is incomplete */
+    if ((USBH_DescCache.Entry[idx].State != (uint8_t)USBH_DESC_CACHE_VALID) ||
+        (USBH_DescCache.Entry[idx].CfgLength > USBH_MAX_SIZE_CONFIGURATION))
+    {
+      USBH_DescCache.Entry[idx].State = (uint8_t)USBH_DESC_CACHE_FREE;
+    }
+    USBH_DescCacheOwner[idx] = NULL;
+  }
+
+  return USBH_OK;
+}
+
+
+/**
+  * @brief  USBH_DescCache_UpdateCallback
+  *         Called when an entry has been recorded, with the image to save.
+  * @param  image: Image address, see USBH_DescCache_GetImage()
+  * @param  size: Image size in bytes
+  * @retval None
+  */
+__weak void USBH_DescCache_UpdateCallback(const void *image, uint32_t size)
+{
+  /* Prevent unused argument(s) compilation warning */
+  UNUSED(image);
+  UNUSED(size);
+}
+
+
+/**
+  * @brief  USBH_DescCache_Match
+  *         Check whether the device descriptor just read is known.
+  * @param  phost: Host Handle
+  * @retval 1 if at least one entry has the same device descriptor
+  */
+uint8_t USBH_DescCache_Match(USBH_HandleTypeDef *phost)
+{
+  uint32_t idx;
+
+  if (USBH_DescCache.Magic != USBH_DESC_CACHE_MAGIC)
+  {
+    return 0U;
+  }
+
+  for (idx = 0U; idx < USBH_DESC_CACHE_ENTRIES; idx++)
+  {
+    if ((USBH_DescCache.Entry[idx].State == (uint8_t)USBH_DESC_CACHE_VALID) &&
+        (USBH_memcmp(USBH_DescCache.Entry[idx].DevDesc, phost->device.DevDesc_Raw,
+                     USB_DEVICE_DESC_SIZE) == 0))
+    {
+      return 1U;
+    }
+  }
+
+  return 0U;
+}
+
+
+/**
+  * @brief  USBH_DescCache_Load
+  *         Load the configuration descriptor of a known device.
+  * @param  phost: Host Handle
+  * @param  pserial: Raw serial number string descriptor, NULL if the device
+  *         has none
+  * @retval USBH_OK on a hit, USBH_FAIL otherwise
+  */
+USBH_StatusTypeDef USBH_DescCache_Load(USBH_HandleTypeDef *phost, const uint8_t *pserial)
+{
+  USBH_DescCacheEntryTypeDef *pentry;
+  uint32_t idx;
+
+  for (idx = 0U; idx < USBH_DESC_CACHE_ENTRIES; idx++)
+  {
+    pentry = &USBH_DescCache.Entry[idx];
+
+    if ((pentry->State != (uint8_t)USBH_DESC_CACHE_VALID) ||
+        (USBH_memcmp(pentry->DevDesc, phost->device.DevDesc_Raw, USB_DEVICE_DESC_SIZE) != 0))
+    {
+      continue;
+    }
+
+    if ((pserial != NULL) &&
+        (USBH_DescCache_SameString(pentry->Str[USBH_DESC_CACHE_STR_SERIAL], pserial) == 0U))
+    {
+      continue;
+    }
+
+    if (USBH_Load_CfgDesc(phost, pentry->CfgDesc, pentry->CfgLength) != USBH_OK)
+    {
+      /* Unusable, record it again */
+      pentry->State = (uint8_t)USBH_DESC_CACHE_FREE;
+      break;
+    }
+
+    USBH_DescCache.Stamp++;
+    pentry->Stamp = USBH_DescCache.Stamp;
+    phost->device.DescCacheEntry = (uint8_t)idx;
+
+    USBH_DescCacheStats.Hits++;
+    USBH_DescCacheStats.SavedRequests += 2U;
+#if (USBH_LAZY_STRINGS == 0U)
+    if (phost->device.DevDesc.iManufacturer != 0U)
+    {
+      USBH_DescCacheStats.SavedRequests++;
+    }
+    if (phost->device.DevDesc.iProduct != 0U)
+    {
+      USBH_DescCacheStats.SavedRequests++;
+    }
+#endif
+
+    return USBH_OK;
+  }
+
+  return USBH_FAIL;
+}
+
+
+/**
+  * @brief  USBH_DescCache_Begin
+  *         Take an entry to record the device being enumerated by phost: a
+  *         free one, else the one used least recently.
+  * @param  phost: Host Handle
+  * @retval None
+  */
+void USBH_DescCache_Begin(USBH_HandleTypeDef *phost)
+{
+  USBH_DescCacheEntryTypeDef *pentry;
+  uint32_t slot = USBH_DESC_CACHE_ENTRIES;
+  uint32_t idx;
+
+  if (USBH_DescCache.Magic != USBH_DESC_CACHE_MAGIC)
+  {
+    USBH_DescCache_Format();
+  }
+
+  USBH_DescCache_Release(phost);
+  USBH_DescCacheStats.Misses++;
+
+  for (idx = 0U; idx < USBH_DESC_CACHE_ENTRIES; idx++)
+  {
+    pentry = &USBH_DescCache.Entry[idx];
+
+    if (pentry->State == (uint8_t)USBH_DESC_CACHE_FREE)
+    {
+      slot = idx;
+      break;
+    }
+
+    /* Entries recorded by other handles are left alone */
+    if ((pentry->State == (uint8_t)USBH_DESC_CACHE_VALID) &&
+        ((slot == USBH_DESC_CACHE_ENTRIES) ||
+         ((USBH_DescCache.Stamp - pentry->Stamp) >
+          (USBH_DescCache.Stamp - USBH_DescCache.Entry[slot].Stamp))))
+    {
+      slot = idx;
+    }
+  }
+
+  if (slot == USBH_DESC_CACHE_ENTRIES)
+  {
+    return;
+  }
+
+  pentry = &USBH_DescCache.Entry[slot];
+  if (pentry->State == (uint8_t)USBH_DESC_CACHE_VALID)
+  {
+    USBH_DescCacheStats.Evictions++;
+  }
+
+  (void)USBH_memset(pentry, 0, sizeof(USBH_DescCacheEntryTypeDef));
+  pentry->State = (uint8_t)USBH_DESC_CACHE_FILLING;
+  USBH_DescCacheOwner[slot] = phost;
+}
+
+
+/**
+  * @brief  USBH_DescCache_PutString
+  *         Record a raw string descriptor read by phost, if it is one of the
+  *         manufacturer, product or serial number strings, in the entry being
+  *         recorded or else in the entry the device was loaded from.
+  * @param  phost: Host Handle
+  * @param  string_index: String index of the request
+  * @param  pdesc: Raw string descriptor
+  * @retval None
+  */
+void USBH_DescCache_PutString(USBH_HandleTypeDef *phost, uint8_t string_index,
+                              const uint8_t *pdesc)
+{
+  USBH_DescCacheEntryTypeDef *pentry = USBH_DescCache_Owned(phost);
+  uint8_t slot = USBH_DescCache_StringSlot(phost, string_index);
+  uint8_t changed = 0U;
+  uint32_t length;
+  uint32_t str;
+
+  if (pentry == NULL)
+  {
+    pentry = USBH_DescCache_Current(phost);
+  }
+
+  if ((pentry == NULL) || (slot == 0U) ||
+      (pdesc[0] < 2U) || (pdesc[1] != USB_DESC_TYPE_STRING))
+  {
+    return;
+  }
+
+  /* Byte 0 keeps the full length, to tell a truncated string */
+  length = ((uint32_t)pdesc[0] < USBH_DESC_CACHE_STRING_SIZE) ? (uint32_t)pdesc[0] :
+           USBH_DESC_CACHE_STRING_SIZE;
+
+  for (str = 0U; str < USBH_DESC_CACHE_NUM_STRINGS; str++)
+  {
+    if (((slot & (1U << str)) != 0U) &&
+        (USBH_DescCache_SameString(pentry->Str[str], pdesc) == 0U))
+    {
+      (void)USBH_memcpy(pentry->Str[str], pdesc, length);
+      changed = 1U;
+    }
+  }
+
+  if ((changed != 0U) && (pentry->State == (uint8_t)USBH_DESC_CACHE_VALID))
+  {
+    USBH_DescCache_UpdateCallback(&USBH_DescCache, (uint32_t)sizeof(USBH_DescCache));
+  }
+}
+
+
+/**
+  * @brief  USBH_DescCache_GetString
+  *         Return a string descriptor of the device recorded in its entry.
+  * @param  phost: Host Handle
+  * @param  string_index: String index
+  * @retval Raw string descriptor, NULL if not recorded in full
+  */
+const uint8_t *USBH_DescCache_GetString(USBH_HandleTypeDef *phost, uint8_t string_index)
+{
+  USBH_DescCacheEntryTypeDef *pentry = USBH_DescCache_Current(phost);
+  uint8_t slot = USBH_DescCache_StringSlot(phost, string_index);
+  uint32_t str;
+
+  if (pentry == NULL)
+  {
+    return NULL;
+  }
+
+  for (str = 0U; str < USBH_DESC_CACHE_NUM_STRINGS; str++)
+  {
+    if (((slot & (1U << str)) != 0U) &&
+        (pentry->Str[str][0] >= 2U) && (pentry->Str[str][0] <= USBH_DESC_CACHE_STRING_SIZE))
+    {
+      return pentry->Str[str];
+    }
+  }
+
+  return NULL;
+}
+
+
+/**
+  * @brief  USBH_DescCache_Store
+  *         Complete the entry of phost once its enumeration succeeded.
+  * @param  phost: Host Handle
+  * @retval None
+  */
+void USBH_DescCache_Store(USBH_HandleTypeDef *phost)
+{
+  USBH_DescCacheEntryTypeDef *pentry = USBH_DescCache_Owned(phost);
+  uint16_t length = phost->device.CfgDesc.wTotalLength;
+
+  if (pentry == NULL)
+  {
+    return;
+  }
+
+  USBH_DescCache_Release(phost);
+
+  if ((length < USB_CONFIGURATION_DESC_SIZE) || (length > USBH_MAX_SIZE_CONFIGURATION))
+  {
+    return;
+  }
+
+  (void)USBH_memcpy(pentry->DevDesc, phost->device.DevDesc_Raw, USB_DEVICE_DESC_SIZE);
+  (void)USBH_memcpy(pentry->CfgDesc, phost->device.CfgDesc_Raw, length);
+  pentry->CfgLength = length;
+
+  USBH_DescCache.Stamp++;
+  pentry->Stamp = USBH_DescCache.Stamp;
+  pentry->State = (uint8_t)USBH_DESC_CACHE_VALID;
+  phost->device.DescCacheEntry = (uint8_t)(pentry - USBH_DescCache.Entry);
+  USBH_DescCacheStats.Stores++;
+
+  USBH_DescCache_UpdateCallback(&USBH_DescCache, (uint32_t)sizeof(USBH_DescCache));
+}
+
+
+/**
+  * @brief  USBH_DescCache_Release
+  *         Drop the entry phost is recording, if any.
+  * @param  phost: Host Handle
+  * @retval None
+  */
+void USBH_DescCache_Release(USBH_HandleTypeDef *phost)
+{
+  uint32_t idx;
+
+  for (idx = 0U; idx < USBH_DESC_CACHE_ENTRIES; idx++)
+  {
+    if (USBH_DescCacheOwner[idx] == phost)
+    {
+      USBH_DescCacheOwner[idx] = NULL;
+      if (USBH_DescCache.Entry[idx].State == (uint8_t)USBH_DESC_CACHE_FILLING)
+      {
+        USBH_DescCache.Entry[idx].State = (uint8_t)USBH_DESC_CACHE_FREE;
+      }
+    }
+  }
+}
+/**
+  * @}
+  */
+
+
+/** @defgroup USBH_DESC_CACHE_Private_Functions
+  * @{
+  */
+
+/**
+  * @brief  USBH_DescCache_Format
+  *         Initialize an empty table.
+  * @retval None
+  */
+static void USBH_DescCache_Format(void)
+{
+  (void)USBH_memset(&USBH_DescCache, 0, sizeof(USBH_DescCache));
+  (void)USBH_memset(USBH_DescCacheOwner, 0, sizeof(USBH_DescCacheOwner));
+
+  USBH_DescCache.Magic = USBH_DESC_CACHE_MAGIC;
+  USBH_DescCache.Version = USBH_DESC_CACHE_VERSION;
+  USBH_DescCache.EntrySize = (uint16_t)sizeof(USBH_DescCacheEntryTypeDef);
+  USBH_DescCache.NumEntries = USBH_DESC_CACHE_ENTRIES;
+}
+
+
+/**
+  * @brief  USBH_DescCache_Owned
+  *         Return the entry phost is recording.
+  * @param  phost: Host Handle
+  * @retval Entry, NULL if none
+  */
+static USBH_DescCacheEntryTypeDef *USBH_DescCache_Owned(USBH_HandleTypeDef *phost)
+{
+  uint32_t idx;
+
+  for (idx = 0U; idx < USBH_DESC_CACHE_ENTRIES; idx++)
+  {
+    if ((USBH_DescCacheOwner[idx] == phost) &&
+        (USBH_DescCache.Entry[idx].State == (uint8_t)USBH_DESC_CACHE_FILLING))
+    {
+      return &USBH_DescCache.Entry[idx];
+    }
+  }
+
+  return NULL;
+}
+
+
+/**
+  * @brief  USBH_DescCache_Current
+  *         Return the valid entry phost was loaded from or recorded in.
+  * @param  phost: Host Handle
+  * @retval Entry, NULL if none or if it now holds another device
+  */
+static USBH_DescCacheEntryTypeDef *USBH_DescCache_Current(USBH_HandleTypeDef *phost)
+{
+  USBH_DescCacheEntryTypeDef *pentry;
+
+  if (phost->device.DescCacheEntry >= USBH_DESC_CACHE_ENTRIES)
+  {
+    return NULL;
+  }
+
+  pentry = &USBH_DescCache.Entry[phost->device.DescCacheEntry];
+  if ((pentry->State != (uint8_t)USBH_DESC_CACHE_VALID) ||
+      (USBH_memcmp(pentry->DevDesc, phost->device.DevDesc_Raw, USB_DEVICE_DESC_SIZE) != 0))
+  {
+    return NULL;
+  }
+
+  return pentry;
+}
+
+
+/**
+  * @brief  USBH_DescCache_StringSlot
+  *         Tell which of the recorded strings a string index stands for.
+  * @param  phost: Host Handle
+  * @param  string_index: String index
+  * @retval Bit n set for string n, 0 if none
+  */
+static uint8_t USBH_DescCache_StringSlot(USBH_HandleTypeDef *phost, uint8_t string_index)
+{
+  USBH_DevDescTypeDef *pdev_desc = &phost->device.DevDesc;
+  uint8_t slot = 0U;
+
+  if (string_index == 0U)
+  {
+    return 0U;
+  }
+
+  if (string_index == pdev_desc->iManufacturer)
+  {
+    slot |= 1U << USBH_DESC_CACHE_STR_MFC;
+  }
+  if (string_index == pdev_desc->iProduct)
+  {
+    slot |= 1U << USBH_DESC_CACHE_STR_PRODUCT;
+  }
+  if (string_index == pdev_desc->iSerialNumber)
+  {
+    slot |= 1U << USBH_DESC_CACHE_STR_SERIAL;
+  }
+
+  return slot;
+}
+
+
+/**
+  * @brief  USBH_DescCache_SameString
+  *         Compare a recorded string with a raw string descriptor, over the
+  *         part that was kept.
+  * @param  pstr: Recorded string, byte 0 is the full length
+  * @param  pdesc: Raw string descriptor
+  * @retval 1 if they match
+  */
+static uint8_t USBH_DescCache_SameString(const uint8_t *pstr, const uint8_t *pdesc)
+{
+  uint32_t length;
+
+  if ((pdesc[0] < 2U) || (pdesc[1] != USB_DESC_TYPE_STRING))
+  {
+    return (pstr[0] == 0U) ? 1U : 0U;
+  }
+
+  length = ((uint32_t)pdesc[0] < USBH_DESC_CACHE_STRING_SIZE) ? (uint32_t)pdesc[0] :
+           USBH_DESC_CACHE_STRING_SIZE;
+
+  if ((pstr[0] != pdesc[0]) || (USBH_memcmp(&pstr[1], &pdesc[1], length - 1U) != 0))
+  {
+    return 0U;
+  }
+
+  return 1U;
+}
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+#endif /* (USBH_DESC_CACHE_ENTRIES > 0U) */
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
@@ -0,0 +1,157 @@
+/**
+  ******************************************************************************
+  * @file    usbh_desc_cache.h
+  * @brief   Header file for usbh_desc_cache.c
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2015 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under Ultimate Liberty license
+  * SLA0044, the "License"; You may not use this file except in compliance with
+  * the License. You may obtain a copy of the License at:
+  *                      www.st.com/SLA0044
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __USBH_DESC_CACHE_H
+#define __USBH_DESC_CACHE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "usbh_core.h"
+
+#if (USBH_DESC_CACHE_ENTRIES > 0U)
+
+/** @addtogroup USBH_LIB
+  * @{
+  */
+
+/** @addtogroup USBH_LIB_CORE
+  * @{
+  */
+
+/** @defgroup USBH_DESC_CACHE
+  * @brief This file is the header file for usbh_desc_cache.c
+  * @{
+  */
+
+
+/** @defgroup USBH_DESC_CACHE_Exported_Defines
+  * @{
+  */
+
+/* Image header, changes whenever the entry layout does */
+#define USBH_DESC_CACHE_MAGIC                         0x43445355U  /* "USDC" */
+#define USBH_DESC_CACHE_VERSION                       1U
+
+/* Strings kept per entry, in this order */
+#define USBH_DESC_CACHE_STR_MFC                       0U
+#define USBH_DESC_CACHE_STR_PRODUCT                   1U
+#define USBH_DESC_CACHE_STR_SERIAL                    2U
+#define USBH_DESC_CACHE_NUM_STRINGS                   3U
+
+/* USBH_DeviceTypeDef.DescCacheEntry of a device without entry */
+#define USBH_DESC_CACHE_NONE                          0xFFU
+/**
+  * @}
+  */
+
+
+/** @defgroup USBH_DESC_CACHE_Exported_Types
+  * @{
+  */
+
+typedef enum
+{
+  USBH_DESC_CACHE_FREE = 0U,
+  USBH_DESC_CACHE_FILLING,       /* Being recorded while its device enumerates */
+  USBH_DESC_CACHE_VALID,
+} USBH_DescCacheStateTypeDef;
+
+/* Raw descriptors of one device. The key is the device descriptor and, when
+   the device has one, the serial number string. */
+typedef struct
+{
+  uint8_t               State;
+  uint8_t               Reserved;
+  uint16_t              CfgLength;
+  uint32_t              Stamp;                  /* Last use, the oldest entry is replaced */
+  uint8_t               DevDesc[USB_DEVICE_DESC_SIZE];
+  uint8_t               Str[USBH_DESC_CACHE_NUM_STRINGS][USBH_DESC_CACHE_STRING_SIZE];
+  uint8_t               CfgDesc[USBH_MAX_SIZE_CONFIGURATION];
+} USBH_DescCacheEntryTypeDef;
+
+/* Persistent image of the cache, see USBH_DescCache_GetImage() */
+typedef struct
+{
+  uint32_t                    Magic;
+  uint16_t                    Version;
+  uint16_t                    EntrySize;
+  uint32_t                    NumEntries;
+  uint32_t                    Stamp;
+  USBH_DescCacheEntryTypeDef  Entry[USBH_DESC_CACHE_ENTRIES];
+} USBH_DescCacheTypeDef;
+
+typedef struct
+{
+  uint32_t              Hits;           /* Enumerations completed from the cache */
+  uint32_t              Misses;         /* Enumerations that read every descriptor */
+  uint32_t              Stores;         /* Entries recorded */
+  uint32_t              Evictions;      /* Valid entries replaced */
+  uint32_t              SavedRequests;  /* Control transfers skipped by the hits */
+} USBH_DescCacheStatsTypeDef;
+/**
+  * @}
+  */
+
+
+/** @defgroup USBH_DESC_CACHE_Exported_FunctionsPrototype
+  * @{
+  */
+void USBH_DescCache_Clear(void);
+const USBH_DescCacheStatsTypeDef *USBH_DescCache_GetStats(void);
+const void *USBH_DescCache_GetImage(uint32_t *size);
+USBH_StatusTypeDef USBH_DescCache_SetImage(const void *image, uint32_t size);
+void USBH_DescCache_UpdateCallback(const void *image, uint32_t size);
+
+/* Used by the core during enumeration */
+uint8_t USBH_DescCache_Match(USBH_HandleTypeDef *phost);
+USBH_StatusTypeDef USBH_DescCache_Load(USBH_HandleTypeDef *phost, const uint8_t *pserial);
+void USBH_DescCache_Begin(USBH_HandleTypeDef *phost);
+void USBH_DescCache_PutString(USBH_HandleTypeDef *phost, uint8_t string_index,
+                              const uint8_t *pdesc);
+const uint8_t *USBH_DescCache_GetString(USBH_HandleTypeDef *phost, uint8_t string_index);
+void USBH_DescCache_Store(USBH_HandleTypeDef *phost);
+void USBH_DescCache_Release(USBH_HandleTypeDef *phost);
+/**
+  * @}
+  */
+
+#endif /* (USBH_DESC_CACHE_ENTRIES > 0U) */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __USBH_DESC_CACHE_H */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
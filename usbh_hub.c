@@ -0,0 +1,864 @@
+/**
+  ******************************************************************************
+  * @file    usbh_hub.c
+  * @brief   This file is the HUB Layer Handlers for USB Host HUB class.
+  *
+  * @verbatim
+  *
+  *          ===================================================================
+  *                                HUB Class  Description
+  *          ===================================================================
+  *           This module manages the hub class following chapter 11 of the
+  *           "Universal Serial Bus Specification Revision 2.0".
+  *           This driver implements the following aspects of the specification:
+  *             - Port power switching and the power-on to power-good wait
+  *             - Status change endpoint polling
+  *             - Port debounce, reset and speed detection
+  *             - Enumeration of the downstream devices, each one running its
+  *               own class on a device handle given by USBH_AddDevice()
+  *
+  *  @endverbatim
+  *
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2015 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under Ultimate Liberty license
+  * SLA0044, the "License"; You may not use this file except in compliance with
+  * the License. You may obtain a copy of the License at:
+  *                      www.st.com/SLA0044
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "usbh_hub.h"
+
+
+/** @addtogroup USBH_LIB
+* @{
+*/
+
+/** @addtogroup USBH_CLASS
+* @{
+*/
+
+/** @addtogroup USBH_HUB_CLASS
+* @{
+*/
+
+/** @defgroup USBH_HUB_CORE
+* @brief    This file includes HUB Layer Handlers for USB Host HUB class.
+* @{
+*/
+
+/** @defgroup USBH_HUB_CORE_Private_TypesDefinitions
+* @{
+*/
+/**
+* @}
+*/
+
+
+/** @defgroup USBH_HUB_CORE_Private_Defines
+* @{
+*/
+/**
+* @}
+*/
+
+
+/** @defgroup USBH_HUB_CORE_Private_Macros
+* @{
+*/
+/**
+* @}
+*/
+
+
+/** @defgroup USBH_HUB_CORE_Private_Variables
+* @{
+*/
+
+/**
+* @}
+*/
+
+
+/** @defgroup USBH_HUB_CORE_Private_FunctionPrototypes
+* @{
+*/
+
+static USBH_StatusTypeDef USBH_HUB_InterfaceInit(USBH_HandleTypeDef *phost);
+static USBH_StatusTypeDef USBH_HUB_InterfaceDeInit(USBH_HandleTypeDef *phost);
+static USBH_StatusTypeDef USBH_HUB_ClassRequest(USBH_HandleTypeDef *phost);
+static USBH_StatusTypeDef USBH_HUB_Process(USBH_HandleTypeDef *phost);
+static void USBH_HUB_WaitCallback(USBH_HandleTypeDef *phost);
+static void USBH_HUB_PipeCallback(USBH_HandleTypeDef *phost, uint8_t pipe,
+                                  USBH_URBStateTypeDef urb_state, uint32_t length);
+static void USBH_HUB_Wait(USBH_HandleTypeDef *phost, uint32_t time);
+static uint8_t USBH_HUB_WaitDone(USBH_HandleTypeDef *phost);
+static void USBH_HUB_PortChanged(USBH_HandleTypeDef *phost);
+static void USBH_HUB_DetachPort(USBH_HandleTypeDef *phost, uint8_t port);
+
+USBH_ClassTypeDef  HUB_Class =
+{
+  "HUB",
+  USB_HUB_CLASS,
+  USBH_HUB_InterfaceInit,
+  USBH_HUB_InterfaceDeInit,
+  USBH_HUB_ClassRequest,
+  USBH_HUB_Process,
+  NULL,
+  NULL,
+};
+/**
+* @}
+*/
+
+
+/** @defgroup USBH_HUB_CORE_Private_Functions
+* @{
+*/
+
+
+/**
+  * @brief  USBH_HUB_InterfaceInit
+  *         The function init the HUB class.
+  * @param  phost: Host handle
+  * @retval USBH Status
+  */
+static USBH_StatusTypeDef USBH_HUB_InterfaceInit(USBH_HandleTypeDef *phost)
+{
+  USBH_StatusTypeDef status;
+  HUB_HandleTypeDef *HUB_Handle;
+  USBH_DescIterTypeDef iter;
+  USBH_EpDescTypeDef ep;
+  uint8_t interface;
+
+  interface = USBH_FindInterface(phost, phost->pActiveClass->ClassCode, 0x00U, 0xFFU);
+
+  if (interface == 0xFFU) /* No Valid Interface */
+  {
+    USBH_DbgLog("Cannot Find the interface for %s class.", phost->pActiveClass->Name);
+    return USBH_FAIL;
+  }
+
+  status = USBH_SelectInterface(phost, interface);
+
+  if (status != USBH_OK)
+  {
+    return USBH_FAIL;
+  }
+
+  phost->pActiveClass->pData = (HUB_HandleTypeDef *)USBH_malloc(sizeof(HUB_HandleTypeDef));
+  HUB_Handle = (HUB_HandleTypeDef *) phost->pActiveClass->pData;
+
+  if (HUB_Handle == NULL)
+  {
+    USBH_DbgLog("Cannot allocate memory for HUB Handle");
+    return USBH_FAIL;
+  }
+
+  /* Initialize hub handler */
+  USBH_memset(HUB_Handle, 0, sizeof(HUB_HandleTypeDef));
+
+  HUB_Handle->state     = HUB_IDLE;
+  HUB_Handle->ctl_state = HUB_REQ_INIT;
+
+  /* The hub interface has one endpoint, the status change endpoint */
+  (void)USBH_DescIter_SeekInterface(phost, &iter, interface, NULL);
+
+  if (USBH_DescIter_NextEndpoint(&iter, &ep) == USBH_OK)
+  {
+    HUB_Handle->InEp    = ep.bEndpointAddress;
+    HUB_Handle->length  = ep.wMaxPacketSize;
+    HUB_Handle->poll    = ep.bInterval;
+  }
+
+  if ((HUB_Handle->InEp & 0x80U) == 0U)
+  {
+    USBH_DbgLog("Hub status change endpoint not found");
+    return USBH_FAIL;
+  }
+
+  if (HUB_Handle->length > sizeof(HUB_Handle->StatusBuf))
+  {
+    HUB_Handle->length = sizeof(HUB_Handle->StatusBuf);
+  }
+
+  if (HUB_Handle->poll == 0U)
+  {
+    HUB_Handle->poll = 1U;
+  }
+
+  HUB_Handle->InPipe = USBH_AllocPipe(phost, HUB_Handle->InEp);
+
+  if (HUB_Handle->InPipe == USBH_PIPE_NONE)
+  {
+    return USBH_FAIL;
+  }
+
+  /* Open pipe for the status change endpoint */
+  USBH_OpenPipe(phost, HUB_Handle->InPipe, HUB_Handle->InEp, phost->device.address,
+                phost->device.speed, USB_EP_TYPE_INTR, HUB_Handle->length);
+
+  (void)USBH_SetToggle(phost, HUB_Handle->InPipe, 0U);
+
+  (void)USBH_RegisterPipeCallback(phost, HUB_Handle->InPipe, USBH_HUB_PipeCallback);
+
+  /* The status change endpoint is polled by the periodic schedule */
+  return USBH_PeriodicOpen(phost, HUB_Handle->InPipe, HUB_Handle->InEp, USB_EP_TYPE_INTR,
+                           HUB_Handle->poll, HUB_Handle->length);
+}
+
+/**
+  * @brief  USBH_HUB_InterfaceDeInit
+  *         The function DeInit the Pipes used for the HUB class and releases
+  *         the devices attached to the hub.
+  * @param  phost: Host handle
+  * @retval USBH Status
+  */
+static USBH_StatusTypeDef USBH_HUB_InterfaceDeInit(USBH_HandleTypeDef *phost)
+{
+  HUB_HandleTypeDef *HUB_Handle = (HUB_HandleTypeDef *) phost->pActiveClass->pData;
+  uint8_t port;
+
+  (void)USBH_TimerStop(phost, USBH_HUB_WaitCallback);
+
+  for (port = 1U; port <= HUB_Handle->NbrPorts; port++)
+  {
+    USBH_HUB_DetachPort(phost, port);
+  }
+
+  if (HUB_Handle->InPipe != 0x00U)
+  {
+    USBH_ClosePipe(phost, HUB_Handle->InPipe);
+    USBH_FreePipe(phost, HUB_Handle->InPipe);
+    HUB_Handle->InPipe = 0U;     /* Reset the pipe as Free */
+  }
+
+  if (phost->pActiveClass->pData)
+  {
+    USBH_free(phost->pActiveClass->pData);
+    phost->pActiveClass->pData = 0U;
+  }
+
+  return USBH_OK;
+}
+
+/**
+  * @brief  USBH_HUB_ClassRequest
+  *         The function is responsible for handling Standard requests
+  *         for HUB class: read the hub descriptor and power the ports.
+  * @param  phost: Host handle
+  * @retval USBH Status
+  */
+static USBH_StatusTypeDef USBH_HUB_ClassRequest(USBH_HandleTypeDef *phost)
+{
+  USBH_StatusTypeDef status         = USBH_BUSY;
+  USBH_StatusTypeDef classReqStatus = USBH_BUSY;
+  HUB_HandleTypeDef *HUB_Handle = (HUB_HandleTypeDef *) phost->pActiveClass->pData;
+
+  switch (HUB_Handle->ctl_state)
+  {
+    case HUB_REQ_INIT:
+    case HUB_REQ_GET_HUB_DESC:
+
+      classReqStatus = USBH_HUB_GetHubDescriptor(phost, USB_HUB_DESC_MAX_SIZE);
+      if (classReqStatus == USBH_OK)
+      {
+        /* The descriptor is available in phost->device.Data */
+        HUB_Handle->NbrPorts = phost->device.Data[2];
+        HUB_Handle->PwrOn2PwrGood = phost->device.Data[5];
+
+        if (HUB_Handle->NbrPorts > USBH_HUB_MAX_PORTS)
+        {
+          USBH_UsrLog("Hub has %d ports, %d used", HUB_Handle->NbrPorts, USBH_HUB_MAX_PORTS);
+          HUB_Handle->NbrPorts = USBH_HUB_MAX_PORTS;
+        }
+        else
+        {
+          USBH_UsrLog("Hub has %d ports", HUB_Handle->NbrPorts);
+        }
+
+        HUB_Handle->port = 1U;
+        HUB_Handle->ctl_state = HUB_REQ_SET_PORT_POWER;
+      }
+      else if (classReqStatus == USBH_NOT_SUPPORTED)
+      {
+        USBH_ErrLog("Control error: HUB: Get Hub Descriptor request failed");
+        status = USBH_FAIL;
+      }
+      else
+      {
+        /* .. */
+      }
+      break;
+
+    case HUB_REQ_SET_PORT_POWER:
+
+      if (HUB_Handle->port > HUB_Handle->NbrPorts)
+      {
+        /* bPwrOn2PwrGood is in 2 ms units */
+        USBH_HUB_Wait(phost, 2U * (uint32_t)HUB_Handle->PwrOn2PwrGood);
+        HUB_Handle->ctl_state = HUB_REQ_WAIT_POWER_GOOD;
+        break;
+      }
+
+      classReqStatus = USBH_HUB_SetPortFeature(phost, HUB_Handle->port, HUB_FEATURE_PORT_POWER);
+      if (classReqStatus == USBH_OK)
+      {
+        HUB_Handle->port++;
+      }
+      else if (classReqStatus == USBH_NOT_SUPPORTED)
+      {
+        USBH_ErrLog("Control error: HUB: Set Port Power request failed");
+        status = USBH_FAIL;
+      }
+      else
+      {
+        /* .. */
+      }
+      break;
+
+    case HUB_REQ_WAIT_POWER_GOOD:
+
+      if (USBH_HUB_WaitDone(phost) != 0U)
+      {
+        HUB_Handle->ctl_state = HUB_REQ_IDLE;
+        HUB_Handle->port = 0U;
+        (void)USBH_PeriodicStart(phost, HUB_Handle->InPipe,
+                                 (uint8_t *)(void *)&HUB_Handle->StatusBuf, HUB_Handle->length);
+
+        /* all requests performed */
+        phost->pUser(phost, HOST_USER_CLASS_ACTIVE);
+        status = USBH_OK;
+      }
+      break;
+
+    case HUB_REQ_IDLE:
+    default:
+      break;
+  }
+
+  return status;
+}
+
+/**
+  * @brief  USBH_HUB_Process
+  *         The function is for managing state machine for the hub ports and
+  *         runs the host state machine of the devices attached to the hub
+  * @param  phost: Host handle
+  * @retval USBH Status
+  */
+static USBH_StatusTypeDef USBH_HUB_Process(USBH_HandleTypeDef *phost)
+{
+  HUB_HandleTypeDef *HUB_Handle = (HUB_HandleTypeDef *) phost->pActiveClass->pData;
+  HUB_PortTypeDef *pPort;
+  USBH_StatusTypeDef status;
+  uint8_t idx;
+
+  /* Devices behind the hub enumerate and run their class from here */
+  for (idx = 0U; idx < HUB_Handle->NbrPorts; idx++)
+  {
+    if (HUB_Handle->Port[idx].pDev != NULL)
+    {
+      (void)USBH_Process(HUB_Handle->Port[idx].pDev);
+    }
+  }
+
+  /* The status change bitmap is merged in USBH_HUB_PipeCallback */
+  pPort = &HUB_Handle->Port[(HUB_Handle->port != 0U) ? (HUB_Handle->port - 1U) : 0U];
+
+  switch (HUB_Handle->state)
+  {
+    case HUB_IDLE:
+      /* Changes of the hub itself (local power, over-current) need no action */
+      HUB_Handle->ChangeMap &= ~1UL;
+
+      for (idx = 1U; idx <= HUB_Handle->NbrPorts; idx++)
+      {
+        if ((HUB_Handle->ChangeMap & (1UL << idx)) != 0U)
+        {
+          HUB_Handle->ChangeMap &= ~(1UL << idx);
+          HUB_Handle->port = idx;
+          HUB_Handle->state = HUB_GET_PORT_STATUS;
+#if (USBH_USE_OS == 1U)
+          USBH_OS_PostEvent(phost, USBH_STATE_CHANGED_EVENT);
+#endif
+          break;
+        }
+      }
+      break;
+
+    case HUB_GET_PORT_STATUS:
+      status = USBH_HUB_GetPortStatus(phost, HUB_Handle->port,
+                                      (uint8_t *)(void *)&HUB_Handle->PortBuf);
+      if (status == USBH_OK)
+      {
+        HUB_Handle->PortStatus = LE16((uint8_t *)(void *)&HUB_Handle->PortBuf);
+        HUB_Handle->PortChange = LE16((uint8_t *)(void *)&HUB_Handle->PortBuf + 2U);
+        HUB_Handle->ClearMap = HUB_Handle->PortChange & 0x1FU;
+        HUB_Handle->state = HUB_CLEAR_PORT_CHANGE;
+      }
+      else if ((status == USBH_NOT_SUPPORTED) || (status == USBH_FAIL))
+      {
+        USBH_ErrLog("Control error: HUB: Get Port Status request failed");
+        HUB_Handle->state = HUB_IDLE;
+      }
+      else
+      {
+        /* .. */
+      }
+      break;
+
+    case HUB_CLEAR_PORT_CHANGE:
+      /* Acknowledge the changes one by one, lowest first */
+      for (idx = 0U; idx < 5U; idx++)
+      {
+        if ((HUB_Handle->ClearMap & (1U << idx)) != 0U)
+        {
+          break;
+        }
+      }
+
+      if (idx == 5U)
+      {
+        HUB_Handle->state = HUB_PORT_CHANGED;
+        break;
+      }
+
+      status = USBH_HUB_ClearPortFeature(phost, HUB_Handle->port,
+                                         (uint16_t)(HUB_FEATURE_C_PORT_CONNECTION + idx));
+      if ((status == USBH_OK) || (status == USBH_NOT_SUPPORTED))
+      {
+        HUB_Handle->ClearMap &= ~(uint16_t)(1U << idx);
+      }
+      else if (status == USBH_FAIL)
+      {
+        HUB_Handle->state = HUB_IDLE;
+      }
+      else
+      {
+        /* .. */
+      }
+      break;
+
+    case HUB_PORT_CHANGED:
+      USBH_HUB_PortChanged(phost);
+      break;
+
+    case HUB_DEBOUNCE:
+      if (USBH_HUB_WaitDone(phost) != 0U)
+      {
+        HUB_Handle->state = HUB_RESET_PORT;
+      }
+      break;
+
+    case HUB_RESET_PORT:
+      status = USBH_HUB_SetPortFeature(phost, HUB_Handle->port, HUB_FEATURE_PORT_RESET);
+      if (status == USBH_OK)
+      {
+        pPort->state = HUB_PORT_RESETTING;
+        HUB_Handle->ResetPolls = 0U;
+        USBH_HUB_Wait(phost, HUB_RESET_POLL_TIME);
+        HUB_Handle->state = HUB_RESET_WAIT;
+      }
+      else if ((status == USBH_NOT_SUPPORTED) || (status == USBH_FAIL))
+      {
+        USBH_ErrLog("Control error: HUB: Port %d reset request failed", HUB_Handle->port);
+        pPort->state = HUB_PORT_FAILED;
+        HUB_Handle->state = HUB_IDLE;
+      }
+      else
+      {
+        /* .. */
+      }
+      break;
+
+    case HUB_RESET_WAIT:
+      if (USBH_HUB_WaitDone(phost) != 0U)
+      {
+        HUB_Handle->state = HUB_GET_PORT_STATUS;
+      }
+      break;
+
+    case HUB_RESET_RECOVERY:
+      if (USBH_HUB_WaitDone(phost) != 0U)
+      {
+        pPort->pDev = USBH_AddDevice(phost, HUB_Handle->port, pPort->speed);
+        if (pPort->pDev != NULL)
+        {
+          pPort->state = HUB_PORT_ENUMERATING;
+          HUB_Handle->state = HUB_ENUMERATE;
+        }
+        else
+        {
+          pPort->state = HUB_PORT_FAILED;
+          HUB_Handle->state = HUB_IDLE;
+        }
+      }
+      break;
+
+    case HUB_ENUMERATE:
+      /* The next port can be reset once this device left the default address */
+      if (pPort->pDev->device.address != USBH_DEVICE_ADDRESS_DEFAULT)
+      {
+        pPort->state = HUB_PORT_ACTIVE;
+        HUB_Handle->state = HUB_IDLE;
+      }
+      else if ((pPort->pDev->gState == HOST_IDLE) || (pPort->pDev->gState == HOST_ABORT_STATE))
+      {
+        USBH_RemoveDevice(pPort->pDev);
+        pPort->pDev = NULL;
+        pPort->retries++;
+
+        if (pPort->retries < HUB_MAX_ENUM_RETRIES)
+        {
+          USBH_UsrLog("Hub port %d enumeration failed, retrying", HUB_Handle->port);
+          HUB_Handle->state = HUB_RESET_PORT;
+        }
+        else
+        {
+          USBH_ErrLog("Hub port %d enumeration failed, please unplug the device", HUB_Handle->port);
+          pPort->state = HUB_PORT_FAILED;
+          HUB_Handle->state = HUB_IDLE;
+        }
+      }
+      else
+      {
+        /* .. */
+      }
+      break;
+
+    default:
+      break;
+  }
+
+  return USBH_OK;
+}
+
+/**
+  * @brief  USBH_HUB_PortChanged
+  *         Act on the port status once its changes are acknowledged
+  * @param  phost: Host handle
+  * @retval None
+  */
+static void USBH_HUB_PortChanged(USBH_HandleTypeDef *phost)
+{
+  HUB_HandleTypeDef *HUB_Handle = (HUB_HandleTypeDef *) phost->pActiveClass->pData;
+  HUB_PortTypeDef *pPort = &HUB_Handle->Port[HUB_Handle->port - 1U];
+
+  if ((HUB_Handle->PortStatus & HUB_PORT_STATUS_CONNECTION) == 0U)
+  {
+    USBH_HUB_DetachPort(phost, HUB_Handle->port);
+    HUB_Handle->state = HUB_IDLE;
+  }
+  else if (pPort->state == HUB_PORT_RESETTING)
+  {
+    if ((HUB_Handle->PortStatus & (HUB_PORT_STATUS_RESET | HUB_PORT_STATUS_ENABLE)) ==
+        HUB_PORT_STATUS_ENABLE)
+    {
+      if ((HUB_Handle->PortStatus & HUB_PORT_STATUS_LOW_SPEED) != 0U)
+      {
+        pPort->speed = (uint8_t)USBH_SPEED_LOW;
+      }
+      else if ((HUB_Handle->PortStatus & HUB_PORT_STATUS_HIGH_SPEED) != 0U)
+      {
+        pPort->speed = (uint8_t)USBH_SPEED_HIGH;
+      }
+      else
+      {
+        pPort->speed = (uint8_t)USBH_SPEED_FULL;
+      }
+
+      USBH_UsrLog("Hub port %d reset completed", HUB_Handle->port);
+      USBH_HUB_Wait(phost, HUB_RESET_RECOVERY_TIME);
+      HUB_Handle->state = HUB_RESET_RECOVERY;
+    }
+    else if (HUB_Handle->ResetPolls < HUB_RESET_MAX_POLLS)
+    {
+      HUB_Handle->ResetPolls++;
+      USBH_HUB_Wait(phost, HUB_RESET_POLL_TIME);
+      HUB_Handle->state = HUB_RESET_WAIT;
+    }
+    else
+    {
+      USBH_ErrLog("Hub port %d reset failed", HUB_Handle->port);
+      pPort->state = HUB_PORT_FAILED;
+      HUB_Handle->state = HUB_IDLE;
+    }
+  }
+  else if ((HUB_Handle->PortChange & HUB_PORT_CHANGE_CONNECTION) != 0U)
+  {
+    /* New device, or a device replaced between two polls */
+    USBH_HUB_DetachPort(phost, HUB_Handle->port);
+    USBH_UsrLog("Device attached on hub port %d", HUB_Handle->port);
+
+    pPort->retries = 0U;
+    USBH_HUB_Wait(phost, HUB_ATTACH_DEBOUNCE_TIME);
+    HUB_Handle->state = HUB_DEBOUNCE;
+  }
+  else
+  {
+    HUB_Handle->state = HUB_IDLE;
+  }
+}
+
+/**
+  * @brief  USBH_HUB_DetachPort
+  *         Release the device attached to a port
+  * @param  phost: Host handle
+  * @param  port: Port number, from 1
+  * @retval None
+  */
+static void USBH_HUB_DetachPort(USBH_HandleTypeDef *phost, uint8_t port)
+{
+  HUB_HandleTypeDef *HUB_Handle = (HUB_HandleTypeDef *) phost->pActiveClass->pData;
+  HUB_PortTypeDef *pPort = &HUB_Handle->Port[port - 1U];
+
+  if (pPort->pDev != NULL)
+  {
+    USBH_RemoveDevice(pPort->pDev);
+    pPort->pDev = NULL;
+  }
+
+  pPort->state = HUB_PORT_EMPTY;
+}
+
+/**
+  * @brief  USBH_HUB_WaitCallback
+  *         Frame timer: a port wait elapsed. Only wakes the host thread up,
+  *         the port state machine checks its deadline itself.
+  * @param  phost: Host handle
+  * @retval None
+  */
+static void USBH_HUB_WaitCallback(USBH_HandleTypeDef *phost)
+{
+  UNUSED(phost);
+}
+
+/**
+  * @brief  USBH_HUB_Wait
+  *         Start a port wait
+  * @param  phost: Host handle
+  * @param  time: Wait duration in frames (ms)
+  * @retval None
+  */
+static void USBH_HUB_Wait(USBH_HandleTypeDef *phost, uint32_t time)
+{
+  HUB_HandleTypeDef *HUB_Handle = (HUB_HandleTypeDef *) phost->pActiveClass->pData;
+
+  HUB_Handle->timer = phost->Timer + time;
+  (void)USBH_TimerStart(phost, HUB_Handle->timer, USBH_HUB_WaitCallback);
+}
+
+/**
+  * @brief  USBH_HUB_WaitDone
+  *         Check the port wait
+  * @param  phost: Host handle
+  * @retval 1 once the wait has elapsed
+  */
+static uint8_t USBH_HUB_WaitDone(USBH_HandleTypeDef *phost)
+{
+  HUB_HandleTypeDef *HUB_Handle = (HUB_HandleTypeDef *) phost->pActiveClass->pData;
+
+  return ((int32_t)(phost->Timer - HUB_Handle->timer) >= 0) ? 1U : 0U;
+}
+
+/**
+  * @brief  USBH_HUB_PipeCallback
+  *         Status change endpoint transfer completed
+  * @param  phost: Host handle
+  * @param  pipe: Pipe index
+  * @param  urb_state: Final URB state
+  * @param  length: Number of bytes received
+  * @retval None
+  */
+static void USBH_HUB_PipeCallback(USBH_HandleTypeDef *phost, uint8_t pipe,
+                                  USBH_URBStateTypeDef urb_state, uint32_t length)
+{
+  HUB_HandleTypeDef *HUB_Handle;
+  uint8_t *pbuf;
+  uint32_t idx;
+
+  UNUSED(pipe);
+
+  if ((phost->pActiveClass == NULL) || (phost->pActiveClass->pData == NULL))
+  {
+    return;
+  }
+
+  HUB_Handle = (HUB_HandleTypeDef *) phost->pActiveClass->pData;
+  pbuf = (uint8_t *)(void *)&HUB_Handle->StatusBuf;
+
+  if (urb_state == USBH_URB_DONE)
+  {
+    for (idx = 0U; (idx < length) && (idx < sizeof(HUB_Handle->StatusBuf)); idx++)
+    {
+      HUB_Handle->ChangeMap |= (uint32_t)pbuf[idx] << (8U * idx);
+    }
+
+#if (USBH_USE_OS == 1U)
+    USBH_OS_PostEvent(phost, USBH_URB_EVENT);
+#endif
+  }
+}
+
+/**
+* @}
+*/
+
+
+/** @defgroup USBH_HUB_CORE_Exported_Functions
+* @{
+*/
+
+/**
+  * @brief  USBH_HUB_GetHubDescriptor
+  *         Issue Get Hub Descriptor command to the device. Once the response
+  *         received, the descriptor is in phost->device.Data
+  * @param  phost: Host handle
+  * @param  length: length of the descriptor
+  * @retval USBH Status
+  */
+USBH_StatusTypeDef USBH_HUB_GetHubDescriptor(USBH_HandleTypeDef *phost,
+                                             uint16_t length)
+{
+  phost->Control.setup.b.bmRequestType = USB_D2H | USB_REQ_RECIPIENT_DEVICE | \
+                                         USB_REQ_TYPE_CLASS;
+
+  phost->Control.setup.b.bRequest = USB_REQ_GET_DESCRIPTOR;
+  phost->Control.setup.b.wValue.w = (uint16_t)USB_DESC_TYPE_HUB << 8;
+
+  phost->Control.setup.b.wIndex.w = 0U;
+  phost->Control.setup.b.wLength.w = length;
+
+  return USBH_CtlReq(phost, phost->device.Data, length);
+}
+
+/**
+  * @brief  USBH_HUB_GetPortStatus
+  *         Issue Get Port Status: wPortStatus then wPortChange
+  * @param  phost: Host handle
+  * @param  port: Port number, from 1
+  * @param  buff: 4-byte buffer
+  * @retval USBH Status
+  */
+USBH_StatusTypeDef USBH_HUB_GetPortStatus(USBH_HandleTypeDef *phost,
+                                          uint8_t port,
+                                          uint8_t *buff)
+{
+  phost->Control.setup.b.bmRequestType = USB_D2H | USB_REQ_RECIPIENT_OTHER | \
+                                         USB_REQ_TYPE_CLASS;
+
+  phost->Control.setup.b.bRequest = USB_REQ_GET_STATUS;
+  phost->Control.setup.b.wValue.w = 0U;
+
+  phost->Control.setup.b.wIndex.w = port;
+  phost->Control.setup.b.wLength.w = 4U;
+
+  return USBH_CtlReq(phost, buff, 4U);
+}
+
+/**
+  * @brief  USBH_HUB_SetPortFeature
+  *         Issue Set Port Feature
+  * @param  phost: Host handle
+  * @param  port: Port number, from 1
+  * @param  feature: HUB_FEATURE_PORT_xxx selector
+  * @retval USBH Status
+  */
+USBH_StatusTypeDef USBH_HUB_SetPortFeature(USBH_HandleTypeDef *phost,
+                                           uint8_t port,
+                                           uint16_t feature)
+{
+  phost->Control.setup.b.bmRequestType = USB_H2D | USB_REQ_RECIPIENT_OTHER | \
+                                         USB_REQ_TYPE_CLASS;
+
+  phost->Control.setup.b.bRequest = USB_REQ_SET_FEATURE;
+  phost->Control.setup.b.wValue.w = feature;
+
+  phost->Control.setup.b.wIndex.w = port;
+  phost->Control.setup.b.wLength.w = 0U;
+
+  return USBH_CtlReq(phost, 0U, 0U);
+}
+
+/**
+  * @brief  USBH_HUB_ClearPortFeature
+  *         Issue Clear Port Feature
+  * @param  phost: Host handle
+  * @param  port: Port number, from 1
+  * @param  feature: HUB_FEATURE_xxx selector
+  * @retval USBH Status
+  */
+USBH_StatusTypeDef USBH_HUB_ClearPortFeature(USBH_HandleTypeDef *phost,
+                                             uint8_t port,
+                                             uint16_t feature)
+{
+  phost->Control.setup.b.bmRequestType = USB_H2D | USB_REQ_RECIPIENT_OTHER | \
+                                         USB_REQ_TYPE_CLASS;
+
+  phost->Control.setup.b.bRequest = USB_REQ_CLEAR_FEATURE;
+  phost->Control.setup.b.wValue.w = feature;
+
+  phost->Control.setup.b.wIndex.w = port;
+  phost->Control.setup.b.wLength.w = 0U;
+
+  return USBH_CtlReq(phost, 0U, 0U);
+}
+
+/**
+  * @brief  USBH_HUB_GetPortDevice
+  *         Return the device attached to a hub port
+  * @param  phost: Host handle of the hub
+  * @param  port: Port number, from 1
+  * @retval Device handle, NULL when the port is empty
+  */
+USBH_HandleTypeDef *USBH_HUB_GetPortDevice(USBH_HandleTypeDef *phost,
+                                           uint8_t port)
+{
+  HUB_HandleTypeDef *HUB_Handle;
+
+  if ((phost->gState != HOST_CLASS) || (phost->pActiveClass == NULL) ||
+      (phost->pActiveClass->ClassCode != USB_HUB_CLASS) ||
+      (phost->pActiveClass->pData == NULL))
+  {
+    return NULL;
+  }
+
+  HUB_Handle = (HUB_HandleTypeDef *) phost->pActiveClass->pData;
+
+  if ((port == 0U) || (port > HUB_Handle->NbrPorts))
+  {
+    return NULL;
+  }
+
+  return HUB_Handle->Port[port - 1U].pDev;
+}
+
+/**
+* @}
+*/
+
+/**
+* @}
+*/
+
+/**
+* @}
+*/
+
+/**
+* @}
+*/
+
+/**
+* @}
+*/
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
@@ -0,0 +1,245 @@
+/**
+  ******************************************************************************
+  * @file    usbh_hub.h
+  * @brief   This file contains all the prototypes for the usbh_hub.c
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2015 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under Ultimate Liberty license
+  * SLA0044, the "License"; You may not use this file except in compliance with
+  * the License. You may obtain a copy of the License at:
+  *                      www.st.com/SLA0044
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive  ----------------------------------------------*/
+#ifndef __USBH_HUB_H
+#define __USBH_HUB_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "usbh_core.h"
+
+/** @addtogroup USBH_LIB
+  * @{
+  */
+
+/** @addtogroup USBH_CLASS
+  * @{
+  */
+
+/** @addtogroup USBH_HUB_CLASS
+  * @{
+  */
+
+/** @defgroup USBH_HUB_CORE
+  * @brief This file is the Header file for usbh_hub.c
+  * @{
+  */
+
+
+/** @defgroup USBH_HUB_CORE_Exported_Types
+  * @{
+  */
+
+/* Downstream ports served, the ports above are left unpowered */
+#ifndef USBH_HUB_MAX_PORTS
+#define USBH_HUB_MAX_PORTS                            7U
+#endif /* USBH_HUB_MAX_PORTS */
+
+/* Enumeration attempts of a device before its port is given up */
+#define HUB_MAX_ENUM_RETRIES                          3U
+
+/* Timings of USB 2.0 section 7.1.7.3 and 11.5.1.5, in ms */
+#define HUB_ATTACH_DEBOUNCE_TIME                      100U
+#define HUB_RESET_POLL_TIME                           10U
+#define HUB_RESET_RECOVERY_TIME                       10U
+#define HUB_RESET_MAX_POLLS                           10U
+
+/* States of the hub control requests */
+typedef enum
+{
+  HUB_REQ_INIT = 0,
+  HUB_REQ_GET_HUB_DESC,
+  HUB_REQ_SET_PORT_POWER,
+  HUB_REQ_WAIT_POWER_GOOD,
+  HUB_REQ_IDLE,
+}
+HUB_CtlStateTypeDef;
+
+/* States of the port service: one port at a time goes through reset and
+   enumeration, as only one device may answer at the default address */
+typedef enum
+{
+  HUB_IDLE = 0,
+  HUB_GET_PORT_STATUS,
+  HUB_CLEAR_PORT_CHANGE,
+  HUB_PORT_CHANGED,
+  HUB_DEBOUNCE,
+  HUB_RESET_PORT,
+  HUB_RESET_WAIT,
+  HUB_RESET_RECOVERY,
+  HUB_ENUMERATE,
+}
+HUB_StateTypeDef;
+
+typedef enum
+{
+  HUB_PORT_EMPTY = 0,
+  HUB_PORT_RESETTING,
+  HUB_PORT_ENUMERATING,
+  HUB_PORT_ACTIVE,
+  HUB_PORT_FAILED,
+}
+HUB_PortStateTypeDef;
+
+typedef struct
+{
+  HUB_PortStateTypeDef  state;
+  USBH_HandleTypeDef   *pDev;
+  uint8_t               speed;
+  uint8_t               retries;
+}
+HUB_PortTypeDef;
+
+/* Structure for HUB process */
+typedef struct _HUB_Process
+{
+  uint8_t              InPipe;
+  uint8_t              InEp;
+  uint16_t             length;
+  uint16_t             poll;
+  HUB_StateTypeDef     state;
+  HUB_CtlStateTypeDef  ctl_state;
+  uint8_t              NbrPorts;
+  uint8_t              PwrOn2PwrGood;
+  uint8_t              port;          /* Port being serviced, 1 to NbrPorts */
+  uint8_t              ResetPolls;
+  uint16_t             PortStatus;
+  uint16_t             PortChange;
+  uint16_t             ClearMap;      /* Changes still to acknowledge */
+  uint32_t             ChangeMap;     /* Bit 0 hub, bit n port n, not yet serviced */
+  uint32_t             timer;
+  uint32_t             StatusBuf;     /* Status change endpoint buffer */
+  uint32_t             PortBuf;       /* GET_STATUS port buffer */
+  HUB_PortTypeDef      Port[USBH_HUB_MAX_PORTS];
+}
+HUB_HandleTypeDef;
+
+/**
+  * @}
+  */
+
+/** @defgroup USBH_HUB_CORE_Exported_Defines
+  * @{
+  */
+
+/* HUB Class Codes */
+#define USB_HUB_CLASS                                 0x09U
+
+/* Hub class descriptor type */
+#define USB_DESC_TYPE_HUB                             0x29U
+#define USB_HUB_DESC_MAX_SIZE                         71U
+
+/* Hub class feature selectors, USB 2.0 table 11-17 */
+#define HUB_FEATURE_PORT_CONNECTION                   0U
+#define HUB_FEATURE_PORT_ENABLE                       1U
+#define HUB_FEATURE_PORT_SUSPEND                      2U
+#define HUB_FEATURE_PORT_OVER_CURRENT                 3U
+#define HUB_FEATURE_PORT_RESET                        4U
+#define HUB_FEATURE_PORT_POWER                        8U
+#define HUB_FEATURE_PORT_LOW_SPEED                    9U
+#define HUB_FEATURE_C_PORT_CONNECTION                 16U
+#define HUB_FEATURE_C_PORT_ENABLE                     17U
+#define HUB_FEATURE_C_PORT_SUSPEND                    18U
+#define HUB_FEATURE_C_PORT_OVER_CURRENT               19U
+#define HUB_FEATURE_C_PORT_RESET                      20U
+
+/* wPortStatus bits, USB 2.0 table 11-21 */
+#define HUB_PORT_STATUS_CONNECTION                    0x0001U
+#define HUB_PORT_STATUS_ENABLE                        0x0002U
+#define HUB_PORT_STATUS_RESET                         0x0010U
+#define HUB_PORT_STATUS_POWER                         0x0100U
+#define HUB_PORT_STATUS_LOW_SPEED                     0x0200U
+#define HUB_PORT_STATUS_HIGH_SPEED                    0x0400U
+
+/* wPortChange bits, USB 2.0 table 11-22 */
+#define HUB_PORT_CHANGE_CONNECTION                    0x0001U
+#define HUB_PORT_CHANGE_ENABLE                        0x0002U
+#define HUB_PORT_CHANGE_RESET                         0x0010U
+
+/**
+  * @}
+  */
+
+/** @defgroup USBH_HUB_CORE_Exported_Macros
+  * @{
+  */
+/**
+  * @}
+  */
+
+/** @defgroup USBH_HUB_CORE_Exported_Variables
+  * @{
+  */
+extern USBH_ClassTypeDef  HUB_Class;
+#define USBH_HUB_CLASS    &HUB_Class
+/**
+  * @}
+  */
+
+/** @defgroup USBH_HUB_CORE_Exported_FunctionsPrototype
+  * @{
+  */
+
+USBH_StatusTypeDef USBH_HUB_GetHubDescriptor(USBH_HandleTypeDef *phost,
+                                             uint16_t length);
+
+USBH_StatusTypeDef USBH_HUB_GetPortStatus(USBH_HandleTypeDef *phost,
+                                          uint8_t port,
+                                          uint8_t *buff);
+
+USBH_StatusTypeDef USBH_HUB_SetPortFeature(USBH_HandleTypeDef *phost,
+                                           uint8_t port,
+                                           uint16_t feature);
+
+USBH_StatusTypeDef USBH_HUB_ClearPortFeature(USBH_HandleTypeDef *phost,
+                                             uint8_t port,
+                                             uint16_t feature);
+
+USBH_HandleTypeDef *USBH_HUB_GetPortDevice(USBH_HandleTypeDef *phost,
+                                           uint8_t port);
+
+/**
+  * @}
+  */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __USBH_HUB_H */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
@@ -0,0 +1,564 @@
+/**
+  ******************************************************************************
+  * @file    usbh_periodic.c
+  * @brief   Periodic transfer schedule of a root port.
+  *
+  *          The classes register their interrupt and isochronous endpoints
+  *          with USBH_PeriodicOpen(). Each endpoint gets a polling interval,
+  *          bInterval rounded down to a power of two, and a phase in a table
+  *          of USBH_PERIODIC_FRAMES frames chosen so that the busiest frame
+  *          it lands in stays as light as possible. An endpoint that would
+  *          take a frame past USBH_PERIODIC_BUDGET is refused. Once started,
+  *          the core issues the transfers of the endpoint in its frames from
+  *          USBH_Process() and hands the completions to the pipe callback;
+  *          the classes no longer run polling timers.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2015 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under Ultimate Liberty license
+  * SLA0044, the "License"; You may not use this file except in compliance with
+  * the License. You may obtain a copy of the License at:
+  *                      www.st.com/SLA0044
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "usbh_periodic.h"
+
+/** @addtogroup USBH_LIB
+  * @{
+  */
+
+/** @addtogroup USBH_LIB_CORE
+  * @{
+  */
+
+/** @defgroup USBH_PERIODIC
+  * @brief This file handles the periodic transfer schedule
+  * @{
+  */
+
+
+/** @defgroup USBH_PERIODIC_Private_Defines
+  * @{
+  */
+#define USBH_PERIODIC_NONE                            0xFFU
+/**
+  * @}
+  */
+
+
+/** @defgroup USBH_PERIODIC_Private_FunctionPrototypes
+  * @{
+  */
+static uint8_t USBH_PeriodicFind(USBH_PortTypeDef *pport, uint8_t pipe);
+static uint16_t USBH_PeriodicCost(uint8_t speed, uint8_t ep_type, uint16_t mps);
+static void USBH_PeriodicIssue(USBH_PortTypeDef *pport, uint8_t idx, uint32_t lag);
+/**
+  * @}
+  */
+
+
+/** @defgroup USBH_PERIODIC_Exported_Functions
+  * @{
+  */
+
+/**
+  * @brief  USBH_PeriodicOpen
+  *         Reserve bandwidth for an interrupt or isochronous pipe. The pipe
+  *         is not polled before USBH_PeriodicStart().
+  * @param  phost: Host Handle of the device
+  * @param  pipe: Pipe number, opened for the endpoint
+  * @param  ep_addr: End point address, direction bit included
+  * @param  ep_type: USB_EP_TYPE_INTR or USB_EP_TYPE_ISOC
+  * @param  interval: Polling interval in frames
+  * @param  mps: Max packet size of the transfers
+  * @retval USBH_OK, USBH_FAIL when the schedule is full or a frame would
+  *         exceed its budget
+  */
+USBH_StatusTypeDef USBH_PeriodicOpen(USBH_HandleTypeDef *phost, uint8_t pipe,
+                                     uint8_t ep_addr, uint8_t ep_type,
+                                     uint32_t interval, uint16_t mps)
+{
+  USBH_PortTypeDef *pport = phost->pPort;
+  USBH_PeriodicTypeDef *entry;
+  uint32_t free_map;
+  uint32_t ival = 1U;
+  uint32_t peak;
+  uint32_t best_peak = 0xFFFFFFFFU;
+  uint32_t phase;
+  uint32_t best = 0U;
+  uint32_t frame;
+  uint16_t cost;
+  uint8_t idx;
+
+  if ((pipe >= USBH_NUM_PIPES) || (USBH_PeriodicFind(pport, pipe) != USBH_PERIODIC_NONE))
+  {
+    return USBH_FAIL;
+  }
+
+  free_map = ~pport->PeriodicMap;
+#if (USBH_MAX_PERIODIC_NBR < 32U)
+  free_map &= (1UL << USBH_MAX_PERIODIC_NBR) - 1U;
+#endif /* (USBH_MAX_PERIODIC_NBR < 32U) */
+
+  if (free_map == 0U)
+  {
+    USBH_ErrLog("Periodic schedule full, pipe %d not scheduled", pipe);
+    pport->PeriodicStats.Rejected++;
+    return USBH_FAIL;
+  }
+
+  /* Polling more often than bInterval is allowed, less often is not */
+  while (((ival << 1) <= interval) && ((ival << 1) <= USBH_PERIODIC_FRAMES))
+  {
+    ival <<= 1;
+  }
+
+  cost = USBH_PeriodicCost(phost->device.speed, ep_type, mps);
+
+  /* Phase whose busiest frame is the lightest */
+  for (phase = 0U; phase < ival; phase++)
+  {
+    peak = 0U;
+    for (frame = phase; frame < USBH_PERIODIC_FRAMES; frame += ival)
+    {
+      if (pport->PeriodicLoad[frame] > peak)
+      {
+        peak = pport->PeriodicLoad[frame];
+      }
+    }
+
+    if (peak < best_peak)
+    {
+      best_peak = peak;
+      best = phase;
+    }
+  }
+
+  if ((best_peak + cost) > USBH_PERIODIC_BUDGET)
+  {
+    USBH_ErrLog("No bandwidth for endpoint 0x%x: %d of %d byte times used",
+                ep_addr, (int)best_peak, (int)USBH_PERIODIC_BUDGET);
+    pport->PeriodicStats.Rejected++;
+    return USBH_FAIL;
+  }
+
+  idx = (uint8_t)USBH_CTZ(free_map);
+  entry = &pport->Periodic[idx];
+
+  entry->phost = phost;
+  entry->pBuff = NULL;
+  entry->Length = 0U;
+  entry->Cost = cost;
+  entry->Interval = (uint16_t)ival;
+  entry->Phase = (uint16_t)best;
+  entry->Pipe = pipe;
+  entry->EpType = ep_type;
+  entry->Direction = ep_addr & USB_EP_DIR_MSK;
+  entry->Skipped = 0U;
+
+  for (frame = best; frame < USBH_PERIODIC_FRAMES; frame += ival)
+  {
+    pport->PeriodicSlot[frame] |= 1UL << idx;
+    pport->PeriodicLoad[frame] += cost;
+
+    if (pport->PeriodicLoad[frame] > pport->PeriodicStats.PeakLoad)
+    {
+      pport->PeriodicStats.PeakLoad = pport->PeriodicLoad[frame];
+    }
+  }
+
+  pport->PeriodicMap |= 1UL << idx;
+
+  USBH_UsrLog("Endpoint 0x%x polled every %d frames from frame %d",
+              ep_addr, (int)ival, (int)best);
+
+  return USBH_OK;
+}
+
+
+/**
+  * @brief  USBH_PeriodicStart
+  *         Start polling a pipe registered with USBH_PeriodicOpen(), the
+  *         first transfer goes in its next frame
+  * @param  phost: Host Handle of the device
+  * @param  pipe: Pipe number
+  * @param  buff: Buffer of every transfer
+  * @param  length: Length of every transfer
+  * @retval USBH_OK, USBH_FAIL when the pipe is not registered
+  */
+USBH_StatusTypeDef USBH_PeriodicStart(USBH_HandleTypeDef *phost, uint8_t pipe,
+                                      uint8_t *buff, uint16_t length)
+{
+  USBH_PortTypeDef *pport = phost->pPort;
+  uint8_t idx = USBH_PeriodicFind(pport, pipe);
+
+  if (idx == USBH_PERIODIC_NONE)
+  {
+    return USBH_FAIL;
+  }
+
+  pport->Periodic[idx].pBuff = buff;
+  pport->Periodic[idx].Length = length;
+  USBH_ATOMIC_SET(pport->PeriodicEnabled, 1UL << idx);
+
+  return USBH_OK;
+}
+
+
+/**
+  * @brief  USBH_PeriodicStop
+  *         Stop polling a pipe, a transfer in flight still completes
+  * @param  phost: Host Handle of the device
+  * @param  pipe: Pipe number
+  * @retval USBH_OK, USBH_FAIL when the pipe is not registered
+  */
+USBH_StatusTypeDef USBH_PeriodicStop(USBH_HandleTypeDef *phost, uint8_t pipe)
+{
+  USBH_PortTypeDef *pport = phost->pPort;
+  uint8_t idx = USBH_PeriodicFind(pport, pipe);
+
+  if (idx == USBH_PERIODIC_NONE)
+  {
+    return USBH_FAIL;
+  }
+
+  USBH_ATOMIC_CLEAR(pport->PeriodicEnabled, 1UL << idx);
+  pport->PeriodicPending &= ~(1UL << idx);
+
+  return USBH_OK;
+}
+
+
+/**
+  * @brief  USBH_PeriodicClose
+  *         Give the bandwidth of a pipe back. Called by USBH_FreePipe().
+  * @param  phost: Host Handle
+  * @param  pipe: Pipe number
+  * @retval USBH Status
+  */
+USBH_StatusTypeDef USBH_PeriodicClose(USBH_HandleTypeDef *phost, uint8_t pipe)
+{
+  USBH_PortTypeDef *pport = phost->pPort;
+  USBH_PeriodicTypeDef *entry;
+  uint32_t frame;
+  uint8_t idx = USBH_PeriodicFind(pport, pipe);
+
+  if (idx != USBH_PERIODIC_NONE)
+  {
+    entry = &pport->Periodic[idx];
+
+    for (frame = entry->Phase; frame < USBH_PERIODIC_FRAMES; frame += entry->Interval)
+    {
+      pport->PeriodicSlot[frame] &= ~(1UL << idx);
+      pport->PeriodicLoad[frame] -= entry->Cost;
+    }
+
+    pport->PeriodicMap &= ~(1UL << idx);
+    USBH_ATOMIC_CLEAR(pport->PeriodicEnabled, 1UL << idx);
+    pport->PeriodicPending &= ~(1UL << idx);
+    USBH_ATOMIC_CLEAR(pport->PeriodicBusy, 1UL << pipe);
+    (void)USBH_memset(entry, 0, sizeof(USBH_PeriodicTypeDef));
+  }
+
+  return USBH_OK;
+}
+
+
+/**
+  * @brief  USBH_PeriodicGetInterval
+  *         Polling interval given to a pipe
+  * @param  phost: Host Handle
+  * @param  pipe: Pipe number
+  * @retval Interval in frames, 0 when the pipe is not registered
+  */
+uint8_t USBH_PeriodicGetInterval(USBH_HandleTypeDef *phost, uint8_t pipe)
+{
+  USBH_PortTypeDef *pport = phost->pPort;
+  uint8_t idx = USBH_PeriodicFind(pport, pipe);
+
+  if (idx == USBH_PERIODIC_NONE)
+  {
+    return 0U;
+  }
+
+  return (uint8_t)pport->Periodic[idx].Interval;
+}
+
+
+/**
+  * @brief  USBH_PeriodicGetSkipped
+  *         Frames a pipe was due in without a transfer being started, its
+  *         previous one still in flight a whole interval later or the host
+  *         late by more than its interval
+  * @param  phost: Host Handle
+  * @param  pipe: Pipe number
+  * @retval Count since USBH_PeriodicOpen()
+  */
+uint32_t USBH_PeriodicGetSkipped(USBH_HandleTypeDef *phost, uint8_t pipe)
+{
+  USBH_PortTypeDef *pport = phost->pPort;
+  uint8_t idx = USBH_PeriodicFind(pport, pipe);
+
+  if (idx == USBH_PERIODIC_NONE)
+  {
+    return 0U;
+  }
+
+  return pport->Periodic[idx].Skipped;
+}
+
+
+/**
+  * @brief  USBH_PeriodicInit
+  *         Empty the schedule of a root port
+  * @param  phost: Host Handle
+  * @retval None
+  */
+void USBH_PeriodicInit(USBH_HandleTypeDef *phost)
+{
+  USBH_PortTypeDef *pport = phost->pPort;
+  (void)USBH_memset(pport->Periodic, 0, sizeof(pport->Periodic));
+  (void)USBH_memset(pport->PeriodicSlot, 0, sizeof(pport->PeriodicSlot));
+  (void)USBH_memset(pport->PeriodicLoad, 0, sizeof(pport->PeriodicLoad));
+  pport->PeriodicMap = 0U;
+  pport->PeriodicEnabled = 0U;
+  pport->PeriodicBusy = 0U;
+  pport->PeriodicPending = 0U;
+  pport->PeriodicFrame = phost->Timer;
+}
+
+
+/**
+  * @brief  USBH_PeriodicProcess
+  *         Issue the transfers due in the frames elapsed since the last
+  *         call. A pipe due more than once in them gets one transfer, for
+  *         the latest, the others count as skipped. A pipe whose previous
+  *         transfer is still in flight gets its transfer once that one
+  *         completed, unless it is due again before.
+  * @param  phost: Host Handle of the root port
+  * @retval None
+  */
+void USBH_PeriodicProcess(USBH_HandleTypeDef *phost)
+{
+  USBH_PortTypeDef *pport = phost->pPort;
+  USBH_PeriodicTypeDef *entry;
+  uint32_t now = phost->Timer;
+  uint32_t elapsed = now - pport->PeriodicFrame;
+  uint32_t enabled = pport->PeriodicEnabled;
+  uint32_t pending;
+  uint32_t since;
+  uint32_t missed;
+  uint8_t idx;
+
+  if (elapsed != 0U)
+  {
+    pport->PeriodicFrame = now;
+
+    while (enabled != 0U)
+    {
+      idx = (uint8_t)USBH_CTZ(enabled);
+      enabled &= enabled - 1U;
+      entry = &pport->Periodic[idx];
+
+      /* Frames since the latest one the entry was due in */
+      since = (now - entry->Phase) & (entry->Interval - 1U);
+
+      if (since < elapsed)
+      {
+        missed = (elapsed - 1U - since) / entry->Interval;
+
+        if ((pport->PeriodicPending & (1UL << idx)) != 0U)
+        {
+          /* The previous turn never started */
+          missed++;
+        }
+
+        entry->Skipped += missed;
+        pport->PeriodicStats.Skipped += missed;
+        pport->PeriodicPending |= 1UL << idx;
+      }
+    }
+  }
+
+  /* Transfers started as soon as their pipe is free: a frame interval
+     transfer completes after the SOF that makes it due again */
+  pending = pport->PeriodicPending & pport->PeriodicEnabled;
+
+  while (pending != 0U)
+  {
+    idx = (uint8_t)USBH_CTZ(pending);
+    pending &= pending - 1U;
+    entry = &pport->Periodic[idx];
+
+    if ((pport->PeriodicBusy & (1UL << entry->Pipe)) == 0U)
+    {
+      pport->PeriodicPending &= ~(1UL << idx);
+      USBH_PeriodicIssue(pport, idx, (now - entry->Phase) & (entry->Interval - 1U));
+    }
+  }
+}
+
+
+/**
+  * @brief  USBH_PeriodicDue
+  *         Check for transfers due in the current frame, used to wake the
+  *         host thread from USBH_LL_IncTimer()
+  * @param  phost: Host Handle of the root port
+  * @retval 1 when a started pipe is due
+  */
+uint8_t USBH_PeriodicDue(USBH_HandleTypeDef *phost)
+{
+  return ((phost->pPort->PeriodicSlot[phost->Timer & (USBH_PERIODIC_FRAMES - 1U)] &
+           phost->pPort->PeriodicEnabled) != 0U) ? 1U : 0U;
+}
+/**
+  * @}
+  */
+
+
+/** @defgroup USBH_PERIODIC_Private_Functions
+  * @{
+  */
+
+/**
+  * @brief  USBH_PeriodicFind
+  *         Schedule entry of a pipe
+  * @param  pport: Host port
+  * @param  pipe: Pipe number
+  * @retval Entry index, USBH_PERIODIC_NONE when the pipe has none
+  */
+static uint8_t USBH_PeriodicFind(USBH_PortTypeDef *pport, uint8_t pipe)
+{
+  uint32_t map = pport->PeriodicMap;
+  uint8_t idx;
+
+  while (map != 0U)
+  {
+    idx = (uint8_t)USBH_CTZ(map);
+    map &= map - 1U;
+
+    if (pport->Periodic[idx].Pipe == pipe)
+    {
+      return idx;
+    }
+  }
+
+  return USBH_PERIODIC_NONE;
+}
+
+
+/**
+  * @brief  USBH_PeriodicCost
+  *         Bus time of one transfer in full-speed byte times, worst case
+  *         bit stuffing included
+  * @param  speed: Device speed
+  * @param  ep_type: USB_EP_TYPE_INTR or USB_EP_TYPE_ISOC
+  * @param  mps: Max packet size
+  * @retval Byte times
+  */
+static uint16_t USBH_PeriodicCost(uint8_t speed, uint8_t ep_type, uint16_t mps)
+{
+  uint32_t cost = (((uint32_t)mps * 7U) + 5U) / 6U;
+
+  cost += (ep_type == USB_EP_TYPE_ISOC) ? USBH_PERIODIC_ISOC_OVERHEAD : USBH_PERIODIC_INTR_OVERHEAD;
+
+  if (speed == (uint8_t)USBH_SPEED_LOW)
+  {
+    /* Low-speed bits are 8 times as long */
+    cost *= 8U;
+  }
+  else if (speed == (uint8_t)USBH_SPEED_HIGH)
+  {
+    /* High-speed bits are 40 times as short */
+    cost = (cost + 39U) / 40U;
+  }
+  else
+  {
+    /* .. */
+  }
+
+  return (uint16_t)cost;
+}
+
+
+/**
+  * @brief  USBH_PeriodicIssue
+  *         Start the transfer of a due entry
+  * @param  pport: Host port
+  * @param  idx: Entry index
+  * @param  lag: Frames since the transfer was due
+  * @retval None
+  */
+static void USBH_PeriodicIssue(USBH_PortTypeDef *pport, uint8_t idx, uint32_t lag)
+{
+  USBH_PeriodicTypeDef *entry = &pport->Periodic[idx];
+  USBH_StatusTypeDef status;
+
+  /* Busy before the submit: the transfer may complete, and its completion
+     be kept for USBH_HandlePipeEvents(), before the submit returns */
+  USBH_ATOMIC_SET(pport->PeriodicBusy, 1UL << entry->Pipe);
+
+  if (entry->EpType == USB_EP_TYPE_ISOC)
+  {
+    if (entry->Direction == USB_EP_DIR_IN)
+    {
+      status = USBH_IsocReceiveData(entry->phost, entry->pBuff, entry->Length, entry->Pipe);
+    }
+    else
+    {
+      status = USBH_IsocSendData(entry->phost, entry->pBuff, entry->Length, entry->Pipe);
+    }
+  }
+  else
+  {
+    if (entry->Direction == USB_EP_DIR_IN)
+    {
+      status = USBH_InterruptReceiveData(entry->phost, entry->pBuff,
+                                         (uint8_t)entry->Length, entry->Pipe);
+    }
+    else
+    {
+      status = USBH_InterruptSendData(entry->phost, entry->pBuff,
+                                      (uint8_t)entry->Length, entry->Pipe);
+    }
+  }
+
+  if (status == USBH_OK)
+  {
+    pport->PeriodicStats.Issued++;
+
+    if (lag > pport->PeriodicStats.MaxLag)
+    {
+      pport->PeriodicStats.MaxLag = lag;
+    }
+  }
+  else
+  {
+    USBH_ATOMIC_CLEAR(pport->PeriodicBusy, 1UL << entry->Pipe);
+    entry->Skipped++;
+    pport->PeriodicStats.Skipped++;
+  }
+}
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
@@ -0,0 +1,96 @@
+/**
+  ******************************************************************************
+  * @file    usbh_periodic.h
+  * @brief   Header file for usbh_periodic.c
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2015 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under Ultimate Liberty license
+  * SLA0044, the "License"; You may not use this file except in compliance with
+  * the License. You may obtain a copy of the License at:
+  *                      www.st.com/SLA0044
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __USBH_PERIODIC_H
+#define __USBH_PERIODIC_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "usbh_core.h"
+
+/** @addtogroup USBH_LIB
+  * @{
+  */
+
+/** @addtogroup USBH_LIB_CORE
+  * @{
+  */
+
+/** @defgroup USBH_PERIODIC
+  * @brief This file is the header file for usbh_periodic.c
+  * @{
+  */
+
+
+/** @defgroup USBH_PERIODIC_Exported_Defines
+  * @{
+  */
+
+/* Bus overhead of one transaction in full-speed byte times: tokens,
+   handshake, inter-packet delays and CRC */
+#define USBH_PERIODIC_INTR_OVERHEAD                   13U
+#define USBH_PERIODIC_ISOC_OVERHEAD                   9U
+/**
+  * @}
+  */
+
+
+/** @defgroup USBH_PERIODIC_Exported_FunctionsPrototype
+  * @{
+  */
+USBH_StatusTypeDef USBH_PeriodicOpen(USBH_HandleTypeDef *phost, uint8_t pipe,
+                                     uint8_t ep_addr, uint8_t ep_type,
+                                     uint32_t interval, uint16_t mps);
+USBH_StatusTypeDef USBH_PeriodicStart(USBH_HandleTypeDef *phost, uint8_t pipe,
+                                      uint8_t *buff, uint16_t length);
+USBH_StatusTypeDef USBH_PeriodicStop(USBH_HandleTypeDef *phost, uint8_t pipe);
+USBH_StatusTypeDef USBH_PeriodicClose(USBH_HandleTypeDef *phost, uint8_t pipe);
+uint8_t USBH_PeriodicGetInterval(USBH_HandleTypeDef *phost, uint8_t pipe);
+uint32_t USBH_PeriodicGetSkipped(USBH_HandleTypeDef *phost, uint8_t pipe);
+
+/* Used by the core */
+void USBH_PeriodicInit(USBH_HandleTypeDef *phost);
+void USBH_PeriodicProcess(USBH_HandleTypeDef *phost);
+uint8_t USBH_PeriodicDue(USBH_HandleTypeDef *phost);
+/**
+  * @}
+  */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __USBH_PERIODIC_H */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
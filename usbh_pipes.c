@@ -1,188 +1,696 @@
-/**
-  ******************************************************************************
-  * @file    usbh_pipes.c
-  * @author  MCD Application Team
-  * @brief   This file implements functions for opening and closing Pipes
-  ******************************************************************************
-  * @attention
-  *
-  * <h2><center>&copy; Copyright (c) 2015 STMicroelectronics.
-  * All rights reserved.</center></h2>
-  *
-  * This software component is licensed by ST under Ultimate Liberty license
-  * SLA0044, the "License"; You may not use this file except in compliance with
-  * the License. You may obtain a copy of the License at:
-  *                      www.st.com/SLA0044
-  *
-  ******************************************************************************
-  */
-
-/* Includes ------------------------------------------------------------------*/
-#include "usbh_pipes.h"
-
-/** @addtogroup USBH_LIB
-  * @{
-  */
-
-/** @addtogroup USBH_LIB_CORE
-* @{
-*/
-
-/** @defgroup USBH_PIPES
-  * @brief This file includes opening and closing Pipes
-  * @{
-  */
-
-/** @defgroup USBH_PIPES_Private_Defines
-  * @{
-  */
-/**
-  * @}
-  */
-
-/** @defgroup USBH_PIPES_Private_TypesDefinitions
-  * @{
-  */
-/**
-  * @}
-  */
-
-
-/** @defgroup USBH_PIPES_Private_Macros
-  * @{
-  */
-/**
-  * @}
-  */
-
-
-/** @defgroup USBH_PIPES_Private_Variables
-  * @{
-  */
-
-/**
-  * @}
-  */
-
-
-/** @defgroup USBH_PIPES_Private_Functions
-  * @{
-  */
-static uint16_t USBH_GetFreePipe(USBH_HandleTypeDef *phost);
-
-
-/**
-  * @brief  USBH_Open_Pipe
-  *         Open a  pipe
-  * @param  phost: Host Handle
-  * @param  pipe_num: Pipe Number
-  * @param  dev_address: USB Device address allocated to attached device
-  * @param  speed : USB device speed (Full/Low)
-  * @param  ep_type: end point type (Bulk/int/ctl)
-  * @param  mps: max pkt size
-  * @retval USBH Status
-  */
-USBH_StatusTypeDef USBH_OpenPipe(USBH_HandleTypeDef *phost, uint8_t pipe_num,
-                                 uint8_t epnum, uint8_t dev_address,
-                                 uint8_t speed, uint8_t ep_type, uint16_t mps)
-{
-  USBH_LL_OpenPipe(phost, pipe_num, epnum, dev_address, speed, ep_type, mps);
-
-  return USBH_OK;
-}
-
-
-/**
-  * @brief  USBH_ClosePipe
-  *         Close a  pipe
-  * @param  phost: Host Handle
-  * @param  pipe_num: Pipe Number
-  * @retval USBH Status
-  */
-USBH_StatusTypeDef USBH_ClosePipe(USBH_HandleTypeDef *phost, uint8_t pipe_num)
-{
-  USBH_LL_ClosePipe(phost, pipe_num);
-
-  return USBH_OK;
-}
-
-
-/**
-  * @brief  USBH_Alloc_Pipe
-  *         Allocate a new Pipe
-  * @param  phost: Host Handle
-  * @param  ep_addr: End point for which the Pipe to be allocated
-  * @retval Pipe number
-  */
-uint8_t USBH_AllocPipe(USBH_HandleTypeDef *phost, uint8_t ep_addr)
-{
-  uint16_t pipe;
-
-  pipe =  USBH_GetFreePipe(phost);
-
-  if (pipe != 0xFFFFU)
-  {
-    phost->Pipes[pipe & 0xFU] = 0x8000U | ep_addr;
-  }
-
-  return (uint8_t)pipe;
-}
-
-
-/**
-  * @brief  USBH_Free_Pipe
-  *         Free the USB Pipe
-  * @param  phost: Host Handle
-  * @param  idx: Pipe number to be freed
-  * @retval USBH Status
-  */
-USBH_StatusTypeDef USBH_FreePipe(USBH_HandleTypeDef *phost, uint8_t idx)
-{
-  if (idx < 11U)
-  {
-    phost->Pipes[idx] &= 0x7FFFU;
-  }
-
-  return USBH_OK;
-}
-
-
-/**
-  * @brief  USBH_GetFreePipe
-  * @param  phost: Host Handle
-  *         Get a free Pipe number for allocation to a device endpoint
-  * @retval idx: Free Pipe number
-  */
-static uint16_t USBH_GetFreePipe(USBH_HandleTypeDef *phost)
-{
-  uint8_t idx = 0U;
-
-  for (idx = 0U ; idx < 11U ; idx++)
-  {
-    if ((phost->Pipes[idx] & 0x8000U) == 0U)
-    {
-      return (uint16_t)idx;
-    }
-  }
-
-  return 0xFFFFU;
-}
-/**
-* @}
-*/
-
-/**
-* @}
-*/
-
-/**
-* @}
-*/
-
-/**
-* @}
-*/
-
-/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
-
-
+/**
+  ******************************************************************************
+  * @file    usbh_pipes.c
+  * @author  MCD Application Team
+  * @brief   This file implements functions for opening and closing Pipes
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2015 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under Ultimate Liberty license
+  * SLA0044, the "License"; You may not use this file except in compliance with
+  * the License. You may obtain a copy of the License at:
+  *                      www.st.com/SLA0044
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "usbh_pipes.h"
+
+/** @addtogroup USBH_LIB
+  * @{
+  */
+
+/** @addtogroup USBH_LIB_CORE
+* @{
+*/
+
+/** @defgroup USBH_PIPES
+  * @brief This file includes opening and closing Pipes
+  * @{
+  */
+
+/** @defgroup USBH_PIPES_Private_Defines
+  * @{
+  */
+/**
+  * @}
+  */
+
+/** @defgroup USBH_PIPES_Private_TypesDefinitions
+  * @{
+  */
+/**
+  * @}
+  */
+
+
+/** @defgroup USBH_PIPES_Private_Macros
+  * @{
+  */
+/**
+  * @}
+  */
+
+
+/** @defgroup USBH_PIPES_Private_Variables
+  * @{
+  */
+
+/**
+  * @}
+  */
+
+
+/** @defgroup USBH_PIPES_Private_Functions
+  * @{
+  */
+static uint8_t USBH_GetFreePipe(USBH_HandleTypeDef *phost);
+#if (USBH_MAX_VPIPES_NBR > 0U)
+static uint8_t USBH_GetFreeVPipe(USBH_HandleTypeDef *phost);
+static uint32_t USBH_GetEpInterval(USBH_HandleTypeDef *phost, uint8_t ep_addr);
+static void USBH_VPipeStart(USBH_HandleTypeDef *phost, uint8_t idx, uint32_t free_map);
+static void USBH_VPipeStop(USBH_HandleTypeDef *phost, uint8_t idx);
+#endif /* (USBH_MAX_VPIPES_NBR > 0U) */
+
+
+/**
+  * @brief  USBH_Open_Pipe
+  *         Open a  pipe
+  * @param  phost: Host Handle
+  * @param  pipe_num: Pipe Number
+  * @param  dev_address: USB Device address allocated to attached device
+  * @param  speed : USB device speed (Full/Low)
+  * @param  ep_type: end point type (Bulk/int/ctl)
+  * @param  mps: max pkt size
+  * @note   A virtual pipe only records the settings, they are programmed on
+  *         the host channel it borrows for each transfer
+  * @retval USBH Status
+  */
+USBH_StatusTypeDef USBH_OpenPipe(USBH_HandleTypeDef *phost, uint8_t pipe_num,
+                                 uint8_t epnum, uint8_t dev_address,
+                                 uint8_t speed, uint8_t ep_type, uint16_t mps)
+{
+#if (USBH_MAX_VPIPES_NBR > 0U)
+  USBH_VPipeTypeDef *vp;
+
+  if ((pipe_num >= USBH_MAX_PIPES_NBR) && (pipe_num < USBH_NUM_PIPES))
+  {
+    vp = &phost->pPort->VPipe[pipe_num - USBH_MAX_PIPES_NBR];
+    vp->EpNum = epnum;
+    vp->DevAddress = dev_address;
+    vp->Speed = speed;
+    vp->EpType = ep_type;
+    vp->Mps = mps;
+    vp->Toggle = 0U;
+
+    return USBH_OK;
+  }
+#endif /* (USBH_MAX_VPIPES_NBR > 0U) */
+
+  if (pipe_num >= USBH_MAX_PIPES_NBR)
+  {
+    return USBH_FAIL;
+  }
+
+  USBH_LL_OpenPipe(phost, pipe_num, epnum, dev_address, speed, ep_type, mps);
+
+  return USBH_OK;
+}
+
+
+/**
+  * @brief  USBH_ClosePipe
+  *         Close a  pipe
+  * @param  phost: Host Handle
+  * @param  pipe_num: Pipe Number
+  * @retval USBH Status
+  */
+USBH_StatusTypeDef USBH_ClosePipe(USBH_HandleTypeDef *phost, uint8_t pipe_num)
+{
+#if (USBH_MAX_VPIPES_NBR > 0U)
+  if ((pipe_num >= USBH_MAX_PIPES_NBR) && (pipe_num < USBH_NUM_PIPES))
+  {
+    USBH_VPipeStop(phost->pRoot, pipe_num - USBH_MAX_PIPES_NBR);
+
+    return USBH_OK;
+  }
+#endif /* (USBH_MAX_VPIPES_NBR > 0U) */
+
+  if (pipe_num >= USBH_MAX_PIPES_NBR)
+  {
+    return USBH_FAIL;
+  }
+
+  USBH_LL_ClosePipe(phost, pipe_num);
+
+  return USBH_OK;
+}
+
+
+/**
+  * @brief  USBH_Alloc_Pipe
+  *         Allocate a new Pipe
+  * @param  phost: Host Handle
+  * @param  ep_addr: End point for which the Pipe to be allocated
+  * @note   Host channels belong to the root port, devices behind a hub
+  *         allocate from the same table. The pipe is tagged with the class
+  *         running on the device, USBH_CheckPipeLeaks() relies on it.
+  *         An interrupt endpoint of the configuration gets a virtual pipe
+  *         while there are some left.
+  * @retval Pipe number, USBH_PIPE_NONE when every channel is in use
+  */
+uint8_t USBH_AllocPipe(USBH_HandleTypeDef *phost, uint8_t ep_addr)
+{
+  USBH_HandleTypeDef *proot = phost->pRoot;
+  USBH_PortTypeDef *pport = phost->pPort;
+  uint8_t pipe = USBH_PIPE_NONE;
+#if (USBH_MAX_VPIPES_NBR > 0U)
+  uint32_t interval = USBH_GetEpInterval(phost, ep_addr);
+
+  if (interval != 0U)
+  {
+    pipe = USBH_GetFreeVPipe(proot);
+  }
+#endif /* (USBH_MAX_VPIPES_NBR > 0U) */
+
+  if (pipe == USBH_PIPE_NONE)
+  {
+    pipe =  USBH_GetFreePipe(proot);
+  }
+
+  if (pipe != USBH_PIPE_NONE)
+  {
+#if (USBH_MAX_VPIPES_NBR > 0U)
+    if (pipe >= USBH_MAX_PIPES_NBR)
+    {
+      (void)USBH_memset(&pport->VPipe[pipe - USBH_MAX_PIPES_NBR], 0, sizeof(USBH_VPipeTypeDef));
+      pport->VPipe[pipe - USBH_MAX_PIPES_NBR].Channel = USBH_PIPE_NONE;
+      pport->VPipe[pipe - USBH_MAX_PIPES_NBR].Interval = interval;
+    }
+    else
+    {
+      pport->ChanVPipe[pipe] = USBH_PIPE_NONE;
+      pport->VChanCache &= ~(1UL << pipe);
+    }
+#endif /* (USBH_MAX_VPIPES_NBR > 0U) */
+
+    pport->PipeMap |= 1UL << pipe;
+    pport->Pipes[pipe] = 0x8000U | ep_addr;
+    pport->PipeCallback[pipe] = NULL;
+    pport->PipeEvent[pipe] = USBH_URB_IDLE;
+    pport->PipeDevice[pipe] = phost;
+    pport->PipeClass[pipe] = phost->pActiveClass;
+    phost->EpPipe[USBH_EP_INDEX(ep_addr)] = (uint8_t)(pipe + 1U);
+  }
+  else
+  {
+    USBH_ErrLog("No free pipe for endpoint 0x%02X", ep_addr);
+  }
+
+  return pipe;
+}
+
+
+/**
+  * @brief  USBH_Free_Pipe
+  *         Free the USB Pipe and its place in the periodic schedule
+  * @param  phost: Host Handle
+  * @param  idx: Pipe number to be freed
+  * @retval USBH Status
+  */
+USBH_StatusTypeDef USBH_FreePipe(USBH_HandleTypeDef *phost, uint8_t idx)
+{
+  USBH_HandleTypeDef *proot = phost->pRoot;
+  USBH_PortTypeDef *pport = phost->pPort;
+  USBH_HandleTypeDef *pdev;
+  uint8_t ep_idx;
+
+  if ((idx < USBH_NUM_PIPES) && ((pport->PipeMap & (1UL << idx)) != 0U))
+  {
+    (void)USBH_PeriodicClose(proot, idx);
+
+#if (USBH_MAX_VPIPES_NBR > 0U)
+    if (idx >= USBH_MAX_PIPES_NBR)
+    {
+      USBH_VPipeStop(proot, idx - USBH_MAX_PIPES_NBR);
+    }
+#endif /* (USBH_MAX_VPIPES_NBR > 0U) */
+
+    /* Drop the endpoint from the map of the device, unless it moved on */
+    pdev = pport->PipeDevice[idx];
+    ep_idx = USBH_EP_INDEX(pport->Pipes[idx]);
+
+    if ((pdev != NULL) && (pdev->EpPipe[ep_idx] == (idx + 1U)))
+    {
+      pdev->EpPipe[ep_idx] = 0U;
+    }
+
+    pport->PipeMap &= ~(1UL << idx);
+    pport->Pipes[idx] &= 0x7FFFU;
+    pport->PipeCallback[idx] = NULL;
+    pport->PipeEvent[idx] = USBH_URB_IDLE;
+    pport->PipeDevice[idx] = NULL;
+    pport->PipeClass[idx] = NULL;
+  }
+
+  return USBH_OK;
+}
+
+
+/**
+  * @brief  USBH_GetPipe
+  *         Pipe allocated by a device for one of its endpoints
+  * @param  phost: Host Handle
+  * @param  ep_addr: End point address, direction bit included
+  * @retval Pipe number, USBH_PIPE_NONE when the endpoint has none
+  */
+uint8_t USBH_GetPipe(USBH_HandleTypeDef *phost, uint8_t ep_addr)
+{
+  uint8_t pipe = phost->EpPipe[USBH_EP_INDEX(ep_addr)];
+
+  return (pipe != 0U) ? (pipe - 1U) : USBH_PIPE_NONE;
+}
+
+
+/**
+  * @brief  USBH_CheckPipeLeaks
+  *         Release the pipes a class still holds on a device once it has
+  *         been stopped. EP0 pipes, allocated by the core, are left alone.
+  * @param  phost: Host Handle
+  * @retval Number of pipes released
+  */
+uint8_t USBH_CheckPipeLeaks(USBH_HandleTypeDef *phost)
+{
+  USBH_PortTypeDef *pport = phost->pPort;
+  uint32_t map = pport->PipeMap;
+  uint8_t count = 0U;
+  uint8_t idx;
+
+  while (map != 0U)
+  {
+    idx = (uint8_t)USBH_CTZ(map);
+    map &= map - 1U;
+
+    if ((pport->PipeDevice[idx] == phost) && (pport->PipeClass[idx] != NULL))
+    {
+      USBH_ErrLog("Pipe %d of endpoint 0x%02X left open by %s", idx,
+                  (unsigned int)(pport->Pipes[idx] & 0xFFU), pport->PipeClass[idx]->Name);
+      (void)USBH_ClosePipe(phost, idx);
+      (void)USBH_FreePipe(phost, idx);
+      count++;
+    }
+  }
+
+  return count;
+}
+
+
+/**
+  * @brief  USBH_RegisterPipeCallback
+  *         Register the class owning a pipe for its URB completions
+  * @param  phost: Host Handle
+  * @param  idx: Pipe number
+  * @param  callback: Completion callback, NULL to stop the notifications
+  * @retval USBH Status
+  */
+USBH_StatusTypeDef USBH_RegisterPipeCallback(USBH_HandleTypeDef *phost, uint8_t idx,
+                                             USBH_PipeCallbackTypeDef callback)
+{
+  if (idx >= USBH_NUM_PIPES)
+  {
+    return USBH_FAIL;
+  }
+
+  /* The completion of a virtual pipe also returns its channel, keep it */
+  if (idx < USBH_MAX_PIPES_NBR)
+  {
+    phost->pPort->PipeEvent[idx] = USBH_URB_IDLE;
+  }
+  phost->pPort->PipeCallback[idx] = callback;
+
+  return USBH_OK;
+}
+
+
+/**
+  * @brief  USBH_SetToggle
+  *         Set the data toggle of the next transfer of a pipe
+  * @param  phost: Host Handle
+  * @param  idx: Pipe number
+  * @param  toggle: Data toggle (0/1)
+  * @retval USBH Status
+  */
+USBH_StatusTypeDef USBH_SetToggle(USBH_HandleTypeDef *phost, uint8_t idx, uint8_t toggle)
+{
+#if (USBH_MAX_VPIPES_NBR > 0U)
+  if ((idx >= USBH_MAX_PIPES_NBR) && (idx < USBH_NUM_PIPES))
+  {
+    phost->pPort->VPipe[idx - USBH_MAX_PIPES_NBR].Toggle = toggle;
+
+    return USBH_OK;
+  }
+#endif /* (USBH_MAX_VPIPES_NBR > 0U) */
+
+  if (idx >= USBH_MAX_PIPES_NBR)
+  {
+    return USBH_FAIL;
+  }
+
+  return USBH_LL_SetToggle(phost, idx, toggle);
+}
+
+
+#if (USBH_MAX_VPIPES_NBR > 0U)
+/**
+  * @brief  USBH_VPipeSubmit
+  *         Queue a transfer on a virtual pipe, it starts as soon as a host
+  *         channel is free
+  * @param  phost: Host Handle
+  * @param  idx: Pipe number
+  * @param  direction: 0 OUT, 1 IN
+  * @param  buff: Data buffer
+  * @param  length: Length of the transfer
+  * @retval USBH Status, USBH_BUSY while the previous transfer is not over
+  */
+USBH_StatusTypeDef USBH_VPipeSubmit(USBH_HandleTypeDef *phost, uint8_t idx, uint8_t direction,
+                                    uint8_t *buff, uint16_t length)
+{
+  USBH_HandleTypeDef *proot = phost->pRoot;
+  USBH_VPipeTypeDef *vp;
+
+  if ((idx < USBH_MAX_PIPES_NBR) || (idx >= USBH_NUM_PIPES))
+  {
+    return USBH_FAIL;
+  }
+
+  idx -= USBH_MAX_PIPES_NBR;
+  vp = &phost->pPort->VPipe[idx];
+
+  if (vp->State != USBH_VPIPE_IDLE)
+  {
+    return USBH_BUSY;
+  }
+
+  vp->Direction = direction;
+  vp->pBuff = buff;
+  vp->Length = length;
+  vp->Submitted = proot->Timer;
+  vp->State = USBH_VPIPE_PENDING;
+  phost->pPort->VPipePending |= 1UL << idx;
+
+  USBH_VPipeSchedule(proot);
+
+  return USBH_OK;
+}
+
+
+/**
+  * @brief  USBH_VPipeSchedule
+  *         Start the waiting virtual pipe transfers on the free host channels,
+  *         the one whose interval ends first goes first
+  * @param  phost: Host Handle
+  * @retval None
+  */
+void USBH_VPipeSchedule(USBH_HandleTypeDef *phost)
+{
+  USBH_HandleTypeDef *proot = phost->pRoot;
+  USBH_PortTypeDef *pport = phost->pPort;
+  USBH_VPipeTypeDef *vp;
+  uint32_t free_map;
+  uint32_t pending;
+  uint32_t deadline;
+  uint32_t best_deadline;
+  uint8_t best;
+  uint8_t idx;
+
+  while (pport->VPipePending != 0U)
+  {
+    free_map = ~(pport->PipeMap | pport->VChanMap);
+#if (USBH_MAX_PIPES_NBR < 32U)
+    free_map &= (1UL << USBH_MAX_PIPES_NBR) - 1U;
+#endif /* (USBH_MAX_PIPES_NBR < 32U) */
+
+    if (free_map == 0U)
+    {
+      break;
+    }
+
+    pending = pport->VPipePending;
+    best = (uint8_t)USBH_CTZ(pending);
+    best_deadline = pport->VPipe[best].Submitted + pport->VPipe[best].Interval;
+
+    while (pending != 0U)
+    {
+      idx = (uint8_t)USBH_CTZ(pending);
+      pending &= pending - 1U;
+      vp = &pport->VPipe[idx];
+      deadline = vp->Submitted + vp->Interval;
+
+      if ((int32_t)(deadline - best_deadline) < 0)
+      {
+        best = idx;
+        best_deadline = deadline;
+      }
+    }
+
+    USBH_VPipeStart(proot, best, free_map);
+  }
+}
+
+
+/**
+  * @brief  USBH_VPipeRelease
+  *         Return the host channel of a completed virtual pipe transfer,
+  *         the data toggle is kept for the next one
+  * @param  phost: Host Handle
+  * @param  idx: Pipe number
+  * @retval Size of the transfer
+  */
+uint32_t USBH_VPipeRelease(USBH_HandleTypeDef *phost, uint8_t idx)
+{
+  USBH_HandleTypeDef *proot = phost->pRoot;
+  USBH_VPipeTypeDef *vp = &phost->pPort->VPipe[idx - USBH_MAX_PIPES_NBR];
+  uint32_t size = 0U;
+
+  if (vp->State == USBH_VPIPE_ACTIVE)
+  {
+    size = USBH_LL_GetLastXferSize(proot, vp->Channel);
+    vp->Toggle = USBH_LL_GetToggle(proot, vp->Channel);
+    phost->pPort->VChanMap &= ~(1UL << vp->Channel);
+    vp->State = USBH_VPIPE_IDLE;
+  }
+
+  return size;
+}
+#endif /* (USBH_MAX_VPIPES_NBR > 0U) */
+
+
+/**
+  * @brief  USBH_GetFreePipe
+  * @param  phost: Host Handle
+  *         Get a free Pipe number for allocation to a device endpoint
+  * @retval idx: Free Pipe number, USBH_PIPE_NONE when there is none
+  */
+static uint8_t USBH_GetFreePipe(USBH_HandleTypeDef *phost)
+{
+  USBH_PortTypeDef *pport = phost->pPort;
+#if (USBH_MAX_VPIPES_NBR > 0U)
+  /* A channel lent to a virtual pipe is back within a frame or two */
+  uint32_t free_map = ~(pport->PipeMap | pport->VChanMap);
+#else
+  uint32_t free_map = ~pport->PipeMap;
+#endif /* (USBH_MAX_VPIPES_NBR > 0U) */
+
+#if (USBH_MAX_PIPES_NBR < 32U)
+  free_map &= (1UL << USBH_MAX_PIPES_NBR) - 1U;
+#endif /* (USBH_MAX_PIPES_NBR < 32U) */
+
+  if (free_map == 0U)
+  {
+    return USBH_PIPE_NONE;
+  }
+
+  return (uint8_t)USBH_CTZ(free_map);
+}
+
+
+#if (USBH_MAX_VPIPES_NBR > 0U)
+/**
+  * @brief  USBH_GetFreeVPipe
+  * @param  phost: Host Handle
+  *         Get a free virtual pipe number
+  * @retval idx: Free Pipe number, USBH_PIPE_NONE when there is none
+  */
+static uint8_t USBH_GetFreeVPipe(USBH_HandleTypeDef *phost)
+{
+  uint32_t free_map = ~(phost->pPort->PipeMap >> USBH_MAX_PIPES_NBR);
+
+  free_map &= (1UL << USBH_MAX_VPIPES_NBR) - 1U;
+
+  if (free_map == 0U)
+  {
+    return USBH_PIPE_NONE;
+  }
+
+  return (uint8_t)(USBH_MAX_PIPES_NBR + USBH_CTZ(free_map));
+}
+
+
+/**
+  * @brief  USBH_GetEpInterval
+  *         Polling interval of an interrupt endpoint of the configuration
+  * @param  phost: Host Handle
+  * @param  ep_addr: End point address
+  * @retval Interval in frames, 0 when the endpoint is not an interrupt one
+  */
+static uint32_t USBH_GetEpInterval(USBH_HandleTypeDef *phost, uint8_t ep_addr)
+{
+  USBH_DescIterTypeDef iter;
+  uint8_t *pdesc;
+  uint32_t interval;
+
+  /* EP0 has no descriptor, the configuration may be the previous device's */
+  if ((ep_addr & 0x7FU) == 0U)
+  {
+    return 0U;
+  }
+
+  USBH_DescIter_Init(phost, &iter);
+
+  while ((pdesc = USBH_DescIter_Next(&iter)) != NULL)
+  {
+    if ((pdesc[1] == USB_DESC_TYPE_ENDPOINT) && (pdesc[0] >= USB_LEN_EP_DESC) &&
+        (pdesc[2] == ep_addr))
+    {
+      if ((pdesc[3] & 0x03U) != USB_EP_TYPE_INTR)
+      {
+        return 0U;
+      }
+
+      interval = pdesc[6];
+
+      /* High speed: 2^(bInterval-1) micro-frames */
+      if ((phost->device.speed == USBH_SPEED_HIGH) && (interval != 0U))
+      {
+        interval = (1UL << ((interval - 1U) & 0x0FU)) / 8U;
+      }
+
+      return (interval != 0U) ? interval : 1U;
+    }
+  }
+
+  return 0U;
+}
+
+
+/**
+  * @brief  USBH_VPipeStart
+  *         Start the transfer of a virtual pipe on a free host channel. The
+  *         channel it used last is taken when still programmed for it,
+  *         otherwise a channel no other virtual pipe is programmed on, if
+  *         any, is opened for the endpoint.
+  * @param  phost: Root Host Handle
+  * @param  idx: Virtual pipe index
+  * @param  free_map: Free host channels, not empty
+  * @retval None
+  */
+static void USBH_VPipeStart(USBH_HandleTypeDef *phost, uint8_t idx, uint32_t free_map)
+{
+  USBH_PortTypeDef *pport = phost->pPort;
+  USBH_VPipeTypeDef *vp = &pport->VPipe[idx];
+  uint32_t wait = phost->Timer - vp->Submitted;
+  uint32_t spare_map = free_map & ~pport->VChanCache;
+  uint8_t ch = vp->Channel;
+
+  if ((ch >= USBH_MAX_PIPES_NBR) || ((free_map & (1UL << ch)) == 0U) ||
+      (pport->ChanVPipe[ch] != idx))
+  {
+    ch = (uint8_t)USBH_CTZ((spare_map != 0U) ? spare_map : free_map);
+    (void)USBH_LL_OpenPipe(phost, ch, vp->EpNum, vp->DevAddress, vp->Speed,
+                           vp->EpType, vp->Mps);
+    pport->ChanVPipe[ch] = idx;
+    pport->VChanCache |= 1UL << ch;
+    pport->VPipeStats.Switches++;
+  }
+
+  (void)USBH_LL_SetToggle(phost, ch, vp->Toggle);
+
+  pport->VPipeStats.Transfers++;
+  if (wait != 0U)
+  {
+    pport->VPipeStats.Waits++;
+    if (wait > pport->VPipeStats.MaxJitter)
+    {
+      pport->VPipeStats.MaxJitter = wait;
+    }
+    if (wait >= vp->Interval)
+    {
+      pport->VPipeStats.Late++;
+    }
+  }
+
+  /* The completion is routed to the pipe once the channel is marked */
+  vp->Channel = ch;
+  vp->State = USBH_VPIPE_ACTIVE;
+  pport->VChanMap |= 1UL << ch;
+  pport->VPipePending &= ~(1UL << idx);
+
+  (void)USBH_LL_SubmitURB(phost, ch, vp->Direction, vp->EpType, USBH_PID_DATA,
+                          vp->pBuff, vp->Length, 0U);
+}
+
+
+/**
+  * @brief  USBH_VPipeStop
+  *         Drop the transfer of a virtual pipe, waiting or in flight
+  * @param  phost: Root Host Handle
+  * @param  idx: Virtual pipe index
+  * @retval None
+  */
+static void USBH_VPipeStop(USBH_HandleTypeDef *phost, uint8_t idx)
+{
+  USBH_PortTypeDef *pport = phost->pPort;
+  USBH_VPipeTypeDef *vp = &pport->VPipe[idx];
+
+  if (vp->State == USBH_VPIPE_ACTIVE)
+  {
+    (void)USBH_LL_ClosePipe(phost, vp->Channel);
+    pport->VChanMap &= ~(1UL << vp->Channel);
+  }
+
+  if ((vp->Channel < USBH_MAX_PIPES_NBR) && (pport->ChanVPipe[vp->Channel] == idx))
+  {
+    pport->ChanVPipe[vp->Channel] = USBH_PIPE_NONE;
+    pport->VChanCache &= ~(1UL << vp->Channel);
+  }
+
+  pport->VPipePending &= ~(1UL << idx);
+  pport->PipeEvent[USBH_MAX_PIPES_NBR + idx] = USBH_URB_IDLE;
+  vp->State = USBH_VPIPE_IDLE;
+
+  USBH_VPipeSchedule(phost);
+}
+#endif /* (USBH_MAX_VPIPES_NBR > 0U) */
+/**
+* @}
+*/
+
+/**
+* @}
+*/
+
+/**
+* @}
+*/
+
+/**
+* @}
+*/
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
+
+